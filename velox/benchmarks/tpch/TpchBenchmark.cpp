@@ -145,6 +145,11 @@ DEFINE_int32(
     8,
     "Checkpoint every n "
     "GB new data in cache");
+DEFINE_int32(
+    ssd_prewarm_gb,
+    0,
+    "Loads up to n GB of the hottest SSD cache entries restored from "
+    "checkpoint into memory in the background at startup");
 DEFINE_bool(
     clear_ram_cache,
     false,
@@ -241,6 +246,14 @@ class TpchBenchmark {
       cache_ =
           cache::AsyncDataCache::create(allocator_.get(), std::move(ssdCache));
       cache::AsyncDataCache::setInstance(cache_.get());
+      if (FLAGS_ssd_cache_gb && FLAGS_ssd_prewarm_gb) {
+        cacheExecutor_->add([cache = cache_.get()]() {
+          const auto bytes = cache->prewarmFromSsd(
+              static_cast<uint64_t>(FLAGS_ssd_prewarm_gb) << 30);
+          LOG(INFO) << "Loaded " << succinctBytes(bytes)
+                    << " from SSD cache into memory";
+        });
+      }
       memory::MemoryAllocator::setDefaultInstance(allocator_.get());
     }
     functions::prestosql::registerAllScalarFunctions();
@@ -22,6 +22,7 @@
 #include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::cache {
 
@@ -60,7 +61,8 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
   if ((ssdFile_ == nullptr) && (shard_->cache()->ssdCache() != nullptr)) {
     auto* ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
-    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
+    if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_) &&
+        shard_->shouldSaveToSsd(*this)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
     }
@@ -157,6 +159,7 @@ CachePin CacheShard::findOrCreate(
   {
     std::lock_guard<std::mutex> l(mutex_);
     ++eventCounter_;
+    evictionPolicy_->recordAccess(std::hash<RawFileCacheKey>()(key));
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* found = it->second;
@@ -204,6 +207,7 @@ CachePin CacheShard::findOrCreate(
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
       entries_.push_back(std::move(newEntry));
+      evictionPolicy_->ensureCapacity(entries_.size());
     } else {
       const auto index = emptySlots_.back();
       emptySlots_.pop_back();
@@ -228,6 +232,27 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+int32_t CacheShard::removeFileEntries(uint64_t fileNum) {
+  std::lock_guard<std::mutex> l(mutex_);
+  int32_t numRemoved = 0;
+  for (auto i = 0; i < entries_.size(); ++i) {
+    auto* entry = entries_[i].get();
+    if (entry == nullptr || !entry->key_.fileNum.hasValue() ||
+        entry->key_.fileNum.id() != fileNum) {
+      continue;
+    }
+    if (entry->numPins_ != 0) {
+      entry->makeEvictable();
+      continue;
+    }
+    removeEntryLocked(entry);
+    emptySlots_.push_back(i);
+    tryAddFreeEntry(std::move(entries_[i]));
+    ++numRemoved;
+  }
+  return numRemoved;
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -385,7 +410,7 @@ uint64_t CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           (score = this->score(*candidate, now)) >= evictionThreshold_)) {
         if (skipSsdSaveable && candidate->ssdSaveable() && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -464,7 +489,7 @@ void CacheShard::calibrateThreshold() {
   evictionThreshold_ = percentile<int32_t>(
       [&]() -> int32_t {
         AsyncDataCacheEntry* element = iter->get();
-        int32_t score = element ? element->score(now) : 0;
+        int32_t score = element ? this->score(*element, now) : 0;
         if (entryIndex + step >= entries_.size()) {
           entryIndex = (entryIndex + step) % entries_.size();
           iter = entries_.begin() + entryIndex;
@@ -478,6 +503,24 @@ void CacheShard::calibrateThreshold() {
       80);
 }
 
+int32_t CacheShard::score(const AsyncDataCacheEntry& entry, AccessTime now)
+    const {
+  return evictionPolicy_->score(
+      bits::hashMix(entry.key_.fileNum.id(), entry.key_.offset),
+      entry.accessStats_,
+      now,
+      entry.size_);
+}
+
+bool CacheShard::shouldSaveToSsd(const AsyncDataCacheEntry& entry) const {
+  if (!evictionPolicy_->filtersSsdSaves()) {
+    return true;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  return evictionPolicy_->shouldSaveToSsd(
+      bits::hashMix(entry.key_.fileNum.id(), entry.key_.offset));
+}
+
 void CacheShard::updateStats(CacheStats& stats) {
   std::lock_guard<std::mutex> l(mutex_);
   for (auto& entry : entries_) {
@@ -515,6 +558,16 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.allocClocks += allocClocks_;
 }
 
+void CacheShard::addToSummary(CacheSummary& summary) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& entry : entries_) {
+    if (entry && entry->key_.fileNum.hasValue() && !entry->isExclusive()) {
+      summary.add(
+          entry->key_.fileNum.id(), entry->offset(), entry->size(), false);
+    }
+  }
+}
+
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   std::lock_guard<std::mutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch.If SSD save
@@ -540,10 +593,20 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
 
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache)
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheEvictionPolicyFactory evictionPolicyFactory)
     : allocator_(allocator), ssdCache_(std::move(ssdCache)), cachedPages_(0) {
   for (auto i = 0; i < kNumShards; ++i) {
-    shards_.push_back(std::make_unique<CacheShard>(this));
+    shards_.push_back(std::make_unique<CacheShard>(
+        this,
+        evictionPolicyFactory ? evictionPolicyFactory()
+                              : std::make_unique<ClockEvictionPolicy>()));
+  }
+  if (ssdCache_ != nullptr) {
+    // Stale entries restored from an SSD checkpoint may have been loaded into
+    // memory before they were invalidated.
+    ssdCache_->setFileInvalidatedCallback(
+        [this](uint64_t fileNum) { removeFileEntries(fileNum); });
   }
 }
 
@@ -552,8 +615,10 @@ AsyncDataCache::~AsyncDataCache() {}
 // static
 std::shared_ptr<AsyncDataCache> AsyncDataCache::create(
     memory::MemoryAllocator* allocator,
-    std::unique_ptr<SsdCache> ssdCache) {
-  auto cache = std::make_shared<AsyncDataCache>(allocator, std::move(ssdCache));
+    std::unique_ptr<SsdCache> ssdCache,
+    CacheEvictionPolicyFactory evictionPolicyFactory) {
+  auto cache = std::make_shared<AsyncDataCache>(
+      allocator, std::move(ssdCache), std::move(evictionPolicyFactory));
   allocator->registerCache(cache);
   return cache;
 }
@@ -598,6 +663,91 @@ bool AsyncDataCache::exists(RawFileCacheKey key) const {
   return shards_[shard]->exists(key);
 }
 
+int32_t AsyncDataCache::removeFileEntries(uint64_t fileNum) {
+  int32_t numRemoved = 0;
+  for (auto& shard : shards_) {
+    numRemoved += shard->removeFileEntries(fileNum);
+  }
+  return numRemoved;
+}
+
+std::shared_ptr<const CacheSummary> AsyncDataCache::summary(
+    uint64_t maxAgeMs) {
+  std::lock_guard<std::mutex> l(summaryMutex_);
+  const auto now = getCurrentTimeMs();
+  if (summary_ != nullptr && maxAgeMs > 0 &&
+      summary_->createTimeMs() + maxAgeMs >= now) {
+    return summary_;
+  }
+  auto summary = std::make_shared<CacheSummary>(now);
+  for (const auto& shard : shards_) {
+    shard->addToSummary(*summary);
+  }
+  if (ssdCache_ != nullptr) {
+    ssdCache_->addToSummary(*summary);
+  }
+  summary->finish();
+  summary_ = std::move(summary);
+  return summary_;
+}
+
+uint64_t AsyncDataCache::prewarmFromSsd(uint64_t maxBytes) {
+  if (ssdCache_ == nullptr) {
+    return 0;
+  }
+  // Loads are issued per this many bytes so that a failed load loses little
+  // and the exclusive pins do not block readers for long.
+  constexpr uint64_t kLoadBatchBytes = 32 << 20;
+  uint64_t bytesLoaded = 0;
+  for (const auto& keys : ssdCache_->hottestEntries(maxBytes)) {
+    std::vector<SsdPin> ssdPins;
+    std::vector<CachePin> pins;
+    uint64_t batchBytes = 0;
+    const auto loadBatch = [&]() {
+      if (pins.empty()) {
+        return;
+      }
+      try {
+        ssdPins[0].file()->load(ssdPins, pins);
+        for (auto& pin : pins) {
+          pin.checkedEntry()->setExclusiveToShared();
+        }
+        bytesLoaded += batchBytes;
+      } catch (const std::exception& e) {
+        LOG(WARNING) << "Failed to load SSD cache entries into memory: "
+                     << e.what();
+      }
+      ssdPins.clear();
+      pins.clear();
+      batchBytes = 0;
+    };
+    for (const auto& key : keys) {
+      const RawFileCacheKey rawKey{key.fileNum.id(), key.offset};
+      if (exists(rawKey)) {
+        continue;
+      }
+      auto ssdPin = ssdCache_->file(rawKey.fileNum).find(rawKey);
+      if (ssdPin.empty()) {
+        continue;
+      }
+      const auto size = ssdPin.run().dataSize();
+      auto pin = findOrCreate(rawKey, size, nullptr);
+      if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+        continue;
+      }
+      pin.checkedEntry()->setPrefetch(true);
+      ssdPins.push_back(std::move(ssdPin));
+      pins.push_back(std::move(pin));
+      batchBytes += size;
+      if (batchBytes >= kLoadBatchBytes) {
+        loadBatch();
+      }
+    }
+    loadBatch();
+  }
+  return bytesLoaded;
+}
+
 bool AsyncDataCache::makeSpace(
     MachinePageCount numPages,
     std::function<bool(memory::Allocation& allocation)> allocate) {
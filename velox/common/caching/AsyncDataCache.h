@@ -26,6 +26,8 @@
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheEvictionPolicy.h"
+#include "velox/common/caching/CacheSummary.h"
 #include "velox/common/caching/FileGroupStats.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
@@ -46,52 +48,6 @@ class SsdCache;
 class SsdCacheStats;
 class SsdFile;
 
-// Type for tracking last access. This is based on CPU clock and
-// scaled to be around 1ms resolution. This can wrap around and is
-// only comparable to other values of the same type. This is a
-// ballpark figure and factors like variability of clock speed do not
-// count.
-using AccessTime = int32_t;
-
-inline AccessTime accessTime() {
-  // Divide by 2M. hardware_timestamp is either clocks or
-  // nanoseconds. This division brings the resolution to between 0.5
-  // and 2 ms.
-  return folly::hardware_timestamp() >> 21;
-}
-
-struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
-
-  // Retention score. A higher number means less worth retaining. This
-  // works well with a typical formula of time over use count going to
-  // zero as uses go up and time goes down. 'now' is the current
-  // accessTime(), passed from the caller since getting the time is
-  // expensive and many entries are checked one after the other. lastUse == 0
-  // means explicitly evictable.
-  int32_t score(AccessTime now, uint64_t /*size*/) const {
-    if (!lastUse) {
-      return std::numeric_limits<int32_t>::max();
-    }
-    return (now - lastUse) / (1 + numUses);
-  }
-
-  // Resets the access tracking to not accessed. This is used after
-  // evicting the previous contents of the entry, so that the new data
-  // does not inherit the history of the previous.
-  void reset() {
-    lastUse = accessTime();
-    numUses = 0;
-  }
-
-  // Updates the last access.
-  void touch() {
-    lastUse = accessTime();
-    ++numUses;
-  }
-};
-
 // Owning reference to a file id and an offset.
 struct FileCacheKey {
   StringIdLease fileNum;
@@ -189,8 +145,8 @@ class AsyncDataCacheEntry {
     accessStats_.touch();
   }
 
-  int32_t score(AccessTime now) const {
-    return accessStats_.score(now, size_);
+  const AccessStats& accessStats() const {
+    return accessStats_;
   }
 
   bool isShared() const {
@@ -530,7 +486,10 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* cache) : cache_(cache) {}
+  CacheShard(
+      AsyncDataCache* cache,
+      std::unique_ptr<CacheEvictionPolicy> evictionPolicy)
+      : cache_(cache), evictionPolicy_(std::move(evictionPolicy)) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -541,6 +500,10 @@ class CacheShard {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Removes the unpinned entries of 'fileNum' and makes the pinned ones
+  /// immediately evictable. Returns the number of removed entries.
+  int32_t removeFileEntries(uint64_t fileNum);
+
   AsyncDataCache* cache() const {
     return cache_;
   }
@@ -575,6 +538,9 @@ class CacheShard {
   // Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  // Adds the loaded entries of 'this' to 'summary'.
+  void addToSummary(CacheSummary& summary) const;
+
   // Appends a batch of non-saved SSD saveable entries in 'this' to
   // 'pins'. This may have to be called several times since this keeps
   // limits on the batch to write at one time. The saveable entries
@@ -586,12 +552,18 @@ class CacheShard {
     return allocClocks_;
   }
 
+  /// Returns true if the eviction policy admits 'entry' to SSD.
+  bool shouldSaveToSsd(const AsyncDataCacheEntry& entry) const;
+
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
 
   void calibrateThreshold();
 
+  // Returns the eviction score of 'entry' from 'evictionPolicy_'.
+  int32_t score(const AsyncDataCacheEntry& entry, AccessTime now) const;
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found.
@@ -607,6 +579,8 @@ class CacheShard {
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
   AsyncDataCache* const cache_;
+  // Decides what to evict. Serialized by 'mutex_'.
+  const std::unique_ptr<CacheEvictionPolicy> evictionPolicy_;
 
   mutable std::mutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
@@ -647,15 +621,19 @@ class CacheShard {
 
 class AsyncDataCache : public memory::Cache {
  public:
+  /// 'evictionPolicyFactory' makes the eviction policy of each shard. If
+  /// not set, the shards use ClockEvictionPolicy.
   AsyncDataCache(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheEvictionPolicyFactory evictionPolicyFactory = nullptr);
 
   ~AsyncDataCache() override;
 
   static std::shared_ptr<AsyncDataCache> create(
       memory::MemoryAllocator* allocator,
-      std::unique_ptr<SsdCache> ssdCache = nullptr);
+      std::unique_ptr<SsdCache> ssdCache = nullptr,
+      CacheEvictionPolicyFactory evictionPolicyFactory = nullptr);
 
   static AsyncDataCache* getInstance();
 
@@ -701,6 +679,12 @@ class AsyncDataCache : public memory::Cache {
   /// Returns true if there is an entry for 'key'. Updates access time.
   bool exists(RawFileCacheKey key) const;
 
+  /// Removes the entries of 'fileNum' from all shards. Used when the data
+  /// cached for a file is found to be stale, e.g. when entries restored from
+  /// an SSD checkpoint are invalidated because the file changed. Returns the
+  /// number of removed entries. See CacheShard::removeFileEntries().
+  int32_t removeFileEntries(uint64_t fileNum);
+
   CacheStats refreshStats() const;
 
   /// If 'details' is true, returns the stats of the backing memory allocator
@@ -721,6 +705,25 @@ class AsyncDataCache : public memory::Cache {
     return ssdCache_.get();
   }
 
+  static constexpr uint64_t kDefaultSummaryMaxAgeMs = 10'000;
+
+  /// Returns a summary of the file data in memory and on SSD for routing
+  /// splits to workers with warm caches. The summary is shared between
+  /// callers and remade when older than 'maxAgeMs'. 0 remakes it always.
+  std::shared_ptr<const CacheSummary> summary(
+      uint64_t maxAgeMs = kDefaultSummaryMaxAgeMs);
+
+  /// Loads up to 'maxBytes' of the entries in the hottest regions of
+  /// 'ssdCache_' into memory, e.g. after restarting from an SSD cache
+  /// checkpoint, so that the memory cache does not start cold. Entries that
+  /// are already in memory are skipped, as are entries of files that have
+  /// not been opened since restart and so cannot be validated against the
+  /// file identity in the checkpoint. The loaded entries count as
+  /// prefetched. Returns the number of bytes loaded. Runs on the calling
+  /// thread. Hosts that want the restart to proceed meanwhile call this on a
+  /// background executor.
+  uint64_t prewarmFromSsd(uint64_t maxBytes);
+
   /// Updates stats for creation of a new cache entry of 'size' bytes,
   /// i.e. a cache miss. Periodically updates SSD admission criteria,
   /// i.e. reconsider criteria every half cache capacity worth of misses.
@@ -807,6 +810,11 @@ class AsyncDataCache : public memory::Cache {
   CacheStats stats_;
 
   std::function<void(const AsyncDataCacheEntry&)> verifyHook_;
+
+  // Serializes making 'summary_'.
+  std::mutex summaryMutex_;
+  std::shared_ptr<const CacheSummary> summary_;
+
   // Count of skipped saves to 'ssdCache_' due to 'ssdCache_' being
   // busy with write.
   tsan_atomic<int32_t> numSkippedSaves_{0};
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheEvictionPolicy.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// Minimum number of counters per row of a FrequencySketch.
+constexpr size_t kMinSketchWidth = 1024;
+} // namespace
+
+FrequencySketch::FrequencySketch(size_t numKeys) {
+  const auto width = bits::nextPowerOfTwo(std::max(kMinSketchWidth, numKeys));
+  mask_ = width - 1;
+  counters_.resize(kNumRows * width);
+  // Same as in W-TinyLFU: the counts are halved after 10 increments per
+  // counter of a row.
+  sampleSize_ = 10 * width;
+}
+
+void FrequencySketch::increment(uint64_t hash) {
+  for (auto row = 0; row < kNumRows; ++row) {
+    auto& counter = counters_[counterIndex(hash, row)];
+    if (counter < kMaxCount) {
+      ++counter;
+    }
+  }
+  if (++numIncrements_ >= sampleSize_) {
+    halve();
+  }
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kNumRows; ++row) {
+    count = std::min<int32_t>(count, counters_[counterIndex(hash, row)]);
+  }
+  return count;
+}
+
+void FrequencySketch::grow(size_t numKeys) {
+  const auto oldWidth = width();
+  const auto newWidth =
+      bits::nextPowerOfTwo(std::max(kMinSketchWidth, numKeys));
+  if (newWidth <= oldWidth) {
+    return;
+  }
+  // The widths are powers of 2, so the counter of a hash in the old row is at
+  // the index in the new row modulo the old width.
+  std::vector<uint8_t> counters(kNumRows * newWidth);
+  for (auto row = 0; row < kNumRows; ++row) {
+    for (size_t i = 0; i < newWidth; ++i) {
+      counters[row * newWidth + i] =
+          counters_[row * oldWidth + (i & mask_)] >> 1;
+    }
+  }
+  counters_ = std::move(counters);
+  mask_ = newWidth - 1;
+  sampleSize_ = 10 * newWidth;
+  numIncrements_ /= 2;
+  ++numResets_;
+}
+
+void FrequencySketch::halve() {
+  for (auto& counter : counters_) {
+    counter >>= 1;
+  }
+  numIncrements_ /= 2;
+  ++numResets_;
+}
+
+TinyLfuEvictionPolicy::TinyLfuEvictionPolicy(
+    size_t numEntries,
+    int32_t minSsdFrequency)
+    : minSsdFrequency_(minSsdFrequency),
+      sketch_(std::make_unique<FrequencySketch>(numEntries)) {
+  VELOX_CHECK_GE(minSsdFrequency_, 0);
+  VELOX_CHECK_LE(minSsdFrequency_, FrequencySketch::kMaxCount);
+}
+
+void TinyLfuEvictionPolicy::recordAccess(uint64_t keyHash) {
+  sketch_->increment(keyHash);
+}
+
+void TinyLfuEvictionPolicy::ensureCapacity(size_t numEntries) {
+  // The sketch grows to twice the needed width so that this does not grow it
+  // for each new entry.
+  if (numEntries > sketch_->width()) {
+    sketch_->grow(2 * numEntries);
+  }
+}
+
+int32_t TinyLfuEvictionPolicy::score(
+    uint64_t keyHash,
+    const AccessStats& stats,
+    AccessTime now,
+    uint64_t /*size*/) const {
+  if (!stats.lastUse) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  const int64_t age = std::max<int64_t>(0, now - stats.lastUse);
+  const auto frequency = sketch_->estimate(keyHash);
+  if (frequency <= 1) {
+    return kProbationScore + std::min<int64_t>(age, kProbationScore - 2);
+  }
+  return std::min<int64_t>(age / frequency, kProbationScore - 1);
+}
+
+bool TinyLfuEvictionPolicy::shouldSaveToSsd(uint64_t keyHash) const {
+  return sketch_->estimate(keyHash) >= minSsdFrequency_;
+}
+
+std::string TinyLfuEvictionPolicy::toString() const {
+  return fmt::format(
+      "TinyLFU sketch width {} resets {}",
+      sketch_->width(),
+      sketch_->numResets());
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <folly/chrono/Hardware.h>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+// Type for tracking last access. This is based on CPU clock and
+// scaled to be around 1ms resolution. This can wrap around and is
+// only comparable to other values of the same type. This is a
+// ballpark figure and factors like variability of clock speed do not
+// count.
+using AccessTime = int32_t;
+
+inline AccessTime accessTime() {
+  // Divide by 2M. hardware_timestamp is either clocks or
+  // nanoseconds. This division brings the resolution to between 0.5
+  // and 2 ms.
+  return folly::hardware_timestamp() >> 21;
+}
+
+struct AccessStats {
+  AccessTime lastUse{0};
+  int32_t numUses{0};
+
+  // Retention score. A higher number means less worth retaining. This
+  // works well with a typical formula of time over use count going to
+  // zero as uses go up and time goes down. 'now' is the current
+  // accessTime(), passed from the caller since getting the time is
+  // expensive and many entries are checked one after the other. lastUse == 0
+  // means explicitly evictable.
+  int32_t score(AccessTime now, uint64_t /*size*/) const {
+    if (!lastUse) {
+      return std::numeric_limits<int32_t>::max();
+    }
+    return (now - lastUse) / (1 + numUses);
+  }
+
+  // Resets the access tracking to not accessed. This is used after
+  // evicting the previous contents of the entry, so that the new data
+  // does not inherit the history of the previous.
+  void reset() {
+    lastUse = accessTime();
+    numUses = 0;
+  }
+
+  // Updates the last access.
+  void touch() {
+    lastUse = accessTime();
+    ++numUses;
+  }
+};
+
+/// Decides which entries a CacheShard evicts and which of its entries are
+/// worth saving to SSD. Each shard has its own policy and serializes the calls
+/// to it with the shard mutex. Keys are given as the hash of the file number
+/// and offset of the entry.
+class CacheEvictionPolicy {
+ public:
+  virtual ~CacheEvictionPolicy() = default;
+
+  /// Records a lookup of the key with 'keyHash', hit or miss.
+  virtual void recordAccess(uint64_t keyHash) = 0;
+
+  /// Tells the policy that the shard has 'numEntries' entries. Called when
+  /// the shard grows.
+  virtual void ensureCapacity(size_t /*numEntries*/) {}
+
+  /// Returns the retention score of the entry with 'keyHash' and 'stats'. A
+  /// higher number means less worth retaining. The shard evicts entries with a
+  /// score above a percentile of sampled scores.
+  virtual int32_t score(
+      uint64_t keyHash,
+      const AccessStats& stats,
+      AccessTime now,
+      uint64_t size) const = 0;
+
+  /// Returns true if the newly loaded entry with 'keyHash' should be written
+  /// to SSD.
+  virtual bool shouldSaveToSsd(uint64_t /*keyHash*/) const {
+    return true;
+  }
+
+  /// Returns true if shouldSaveToSsd() may return false. If not, the shard
+  /// does not consult the policy, which would be serialized on the shard
+  /// mutex.
+  virtual bool filtersSsdSaves() const {
+    return false;
+  }
+
+  virtual std::string toString() const = 0;
+};
+
+using CacheEvictionPolicyFactory =
+    std::function<std::unique_ptr<CacheEvictionPolicy>()>;
+
+/// The default policy. Scores entries by time since last use divided by the
+/// number of uses since the entry was loaded.
+class ClockEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  void recordAccess(uint64_t /*keyHash*/) override {}
+
+  int32_t score(
+      uint64_t /*keyHash*/,
+      const AccessStats& stats,
+      AccessTime now,
+      uint64_t size) const override {
+    return stats.score(now, size);
+  }
+
+  std::string toString() const override {
+    return "clock";
+  }
+};
+
+/// Approximate access counts of keys in a count-min sketch. Each key has a
+/// counter in each of 4 rows of counters that saturate at kMaxCount and its
+/// count is the least of these. All counts are halved after a number of
+/// increments proportional to the width so that old accesses fade out.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxCount = 15;
+
+  /// Makes a sketch for tracking about 'numKeys' keys.
+  explicit FrequencySketch(size_t numKeys);
+
+  void increment(uint64_t hash);
+
+  /// Returns the estimated count of 'hash', between 0 and kMaxCount.
+  int32_t estimate(uint64_t hash) const;
+
+  /// Widens the rows for tracking about 'numKeys' keys if they are narrower.
+  /// The counts are carried over halved, like after a reset, so that what
+  /// was learned while the cache warms up is not lost.
+  void grow(size_t numKeys);
+
+  /// Number of counters per row.
+  size_t width() const {
+    return mask_ + 1;
+  }
+
+  /// Number of times all counts have been halved.
+  uint64_t numResets() const {
+    return numResets_;
+  }
+
+ private:
+  static constexpr int32_t kNumRows = 4;
+
+  // Returns the index of the counter of 'hash' in 'row'.
+  size_t counterIndex(uint64_t hash, int32_t row) const {
+    return row * width() + (bits::hashMix(hash, kSeeds[row]) & mask_);
+  }
+
+  void halve();
+
+  static constexpr uint64_t kSeeds[kNumRows] = {
+      0xc3a5c85c97cb3127ULL,
+      0xb492b66fbe98f273ULL,
+      0x9ae16a3b2f90404fULL,
+      0xcbf29ce484222325ULL};
+
+  uint64_t mask_;
+  // 'kNumRows' rows of 'width()' counters.
+  std::vector<uint8_t> counters_;
+  // Number of increments after which the counts are halved.
+  uint64_t sampleSize_;
+  uint64_t numIncrements_{0};
+  uint64_t numResets_{0};
+};
+
+/// Scan resistant policy using the frequency sketch of W-TinyLFU. The access
+/// frequency of keys is kept in a FrequencySketch, which remembers keys after
+/// their entries are evicted. Entries whose key has been seen only once, e.g.
+/// data of a one-off large scan, are on probation and are evicted before any
+/// entry that has been seen more often. The other entries are scored by time
+/// since last use divided by the sketch frequency. Only entries seen at least
+/// 'minSsdFrequency' times are saved to SSD, so that a scan does not flush the
+/// SSD cache either.
+///
+/// Unlike W-TinyLFU, there is no admission window and no comparison of the
+/// frequency of an eviction victim with that of the candidate replacing it:
+/// a CacheShard must admit every entry that is read, and probation takes
+/// the place of the window. The SSD save filter is the admission decision.
+class TinyLfuEvictionPolicy : public CacheEvictionPolicy {
+ public:
+  /// Added to the time since last use of entries on probation. This is above
+  /// the score of any other entry.
+  static constexpr int32_t kProbationScore = 1 << 30;
+
+  explicit TinyLfuEvictionPolicy(
+      size_t numEntries = 1024,
+      int32_t minSsdFrequency = 2);
+
+  void recordAccess(uint64_t keyHash) override;
+
+  void ensureCapacity(size_t numEntries) override;
+
+  int32_t score(
+      uint64_t keyHash,
+      const AccessStats& stats,
+      AccessTime now,
+      uint64_t size) const override;
+
+  bool shouldSaveToSsd(uint64_t keyHash) const override;
+
+  bool filtersSsdSaves() const override {
+    return minSsdFrequency_ > 0;
+  }
+
+  std::string toString() const override;
+
+  const FrequencySketch& sketch() const {
+    return *sketch_;
+  }
+
+ private:
+  const int32_t minSsdFrequency_;
+  std::unique_ptr<FrequencySketch> sketch_;
+};
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheSummary.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/FileIds.h"
+
+namespace facebook::velox::cache {
+
+void CacheSummary::add(
+    uint64_t fileId,
+    uint64_t offset,
+    uint64_t size,
+    bool ssd) {
+  (ssd ? ssdBytes_ : memoryBytes_) += size;
+  // Splits the entry at chunk boundaries.
+  const auto end = offset + size;
+  while (offset < end) {
+    const auto chunkIndex = offset >> kChunkBits;
+    const auto chunkEnd = std::min(end, (chunkIndex + 1) << kChunkBits);
+    auto& chunk = chunks_[ChunkKey(fileId, chunkIndex)];
+    auto& lastChunk = lastChunks_[fileId];
+    lastChunk = std::max(lastChunk, chunkIndex);
+    (ssd ? chunk.ssdBytes : chunk.memoryBytes) += chunkEnd - offset;
+    offset = chunkEnd;
+  }
+}
+
+void CacheSummary::finish() {
+  filter_.reset(std::max<int32_t>(1, chunks_.size()));
+  folly::F14FastMap<uint64_t, std::string> paths;
+  for (const auto& [key, chunk] : chunks_) {
+    auto it = paths.find(key.first);
+    if (it == paths.end()) {
+      it = paths.emplace(key.first, fileIds().string(key.first)).first;
+    }
+    filter_.insert(chunkHash(it->second, key.second));
+  }
+}
+
+uint64_t CacheSummary::cachedBytes(
+    uint64_t fileId,
+    uint64_t offset,
+    uint64_t length) const {
+  const auto lastChunkIt = lastChunks_.find(fileId);
+  if (lastChunkIt == lastChunks_.end() || length == 0) {
+    return 0;
+  }
+  const auto end = offset + std::min(length, ~0UL - offset);
+  const auto lastChunk = std::min(lastChunkIt->second, (end - 1) >> kChunkBits);
+  uint64_t bytes = 0;
+  for (auto chunkIndex = offset >> kChunkBits; chunkIndex <= lastChunk;
+       ++chunkIndex) {
+    const auto it = chunks_.find(ChunkKey(fileId, chunkIndex));
+    if (it == chunks_.end()) {
+      continue;
+    }
+    const auto chunkBytes =
+        std::max(it->second.memoryBytes, it->second.ssdBytes);
+    const auto chunkBegin = chunkIndex << kChunkBits;
+    const auto overlap = std::min(end, chunkBegin + kChunkSize) -
+        std::max(offset, chunkBegin);
+    bytes += overlap == kChunkSize
+        ? chunkBytes
+        : static_cast<uint64_t>(
+              static_cast<double>(chunkBytes) * overlap / kChunkSize);
+  }
+  return bytes;
+}
+
+std::string CacheSummary::toString() const {
+  return fmt::format(
+      "<CacheSummary {} chunks memory {} ssd {} filter {}>",
+      chunks_.size(),
+      succinctBytes(memoryBytes_),
+      succinctBytes(ssdBytes_),
+      succinctBytes(filter_.serializedSize()));
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/base/BloomFilter.h"
+
+namespace facebook::velox::cache {
+
+/// Summary of the file data held by an AsyncDataCache and its SsdCache, for
+/// routing splits to the workers that have their data cached. Files are
+/// divided in chunks of kChunkSize bytes and the summary has the cached bytes
+/// of each chunk with any cached data. The chunks are also in a Bloom filter
+/// keyed on file path and chunk, which can be serialized and checked in
+/// another process where the ids of fileIds() do not apply.
+class CacheSummary {
+ public:
+  static constexpr int32_t kChunkBits = 23;
+  static constexpr uint64_t kChunkSize = 1UL << kChunkBits;
+
+  explicit CacheSummary(uint64_t createTimeMs) : createTimeMs_(createTimeMs) {}
+
+  /// Adds an entry of 'size' bytes at 'offset' in the file with 'fileId'.
+  /// 'ssd' is true if the entry is on SSD, false if in memory.
+  void add(uint64_t fileId, uint64_t offset, uint64_t size, bool ssd);
+
+  /// Makes the Bloom filter of the added chunks. Called after the last add().
+  void finish();
+
+  /// Returns the estimated number of bytes of the range of 'length' bytes at
+  /// 'offset' in the file with 'fileId' that are in memory or on SSD. Data in
+  /// both is counted once as far as possible: a chunk counts the larger of
+  /// its memory and SSD bytes. Chunks partly in range count in proportion.
+  uint64_t cachedBytes(uint64_t fileId, uint64_t offset, uint64_t length)
+      const;
+
+  /// Returns true if the chunk of 'offset' in the file at 'path' may have
+  /// cached data. May give false positives but never false negatives.
+  bool mayContain(std::string_view path, uint64_t offset) const {
+    return filter_.mayContain(chunkHash(path, offset >> kChunkBits));
+  }
+
+  /// Returns the hash of 'chunk' of the file at 'path' in filter().
+  static uint64_t chunkHash(std::string_view path, uint64_t chunk) {
+    return bits::hashMix(
+        folly::hash::fnv64_buf(path.data(), path.size()), chunk);
+  }
+
+  const BloomFilter<>& filter() const {
+    return filter_;
+  }
+
+  /// Time of making the summary in ms since epoch.
+  uint64_t createTimeMs() const {
+    return createTimeMs_;
+  }
+
+  uint64_t numChunks() const {
+    return chunks_.size();
+  }
+
+  uint64_t memoryBytes() const {
+    return memoryBytes_;
+  }
+
+  uint64_t ssdBytes() const {
+    return ssdBytes_;
+  }
+
+  std::string toString() const;
+
+ private:
+  struct Chunk {
+    uint64_t memoryBytes{0};
+    uint64_t ssdBytes{0};
+  };
+
+  using ChunkKey = std::pair<uint64_t, uint64_t>;
+
+  const uint64_t createTimeMs_;
+  // Cached bytes by file id and chunk index.
+  folly::F14FastMap<ChunkKey, Chunk, folly::hasher<ChunkKey>> chunks_;
+  // Index of the last chunk with cached data by file id.
+  folly::F14FastMap<uint64_t, uint64_t> lastChunks_;
+  uint64_t memoryBytes_{0};
+  uint64_t ssdBytes_{0};
+  BloomFilter<> filter_;
+};
+
+} // namespace facebook::velox::cache
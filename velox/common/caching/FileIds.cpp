@@ -16,11 +16,67 @@
 
 #include "velox/common/caching/FileIds.h"
 
+#include <algorithm>
+
+#include <fmt/format.h>
+#include <folly/Synchronized.h>
 #include <gflags/gflags.h>
 
 namespace facebook::velox {
+namespace {
+// Number of recorded identities above which the identities of ids no longer
+// in fileIds() are dropped.
+constexpr size_t kMinIdentitiesToPrune = 100'000;
+
+struct FileIdentities {
+  folly::F14FastMap<uint64_t, FileIdentity> identities;
+  size_t pruneThreshold{kMinIdentitiesToPrune};
+};
+
+folly::Synchronized<FileIdentities>& fileIdentities() {
+  static auto* identities = new folly::Synchronized<FileIdentities>();
+  return *identities;
+}
+} // namespace
+
 StringIdMap& fileIds() {
   static StringIdMap* ids = new StringIdMap();
   return *ids;
 }
+
+std::string FileIdentity::toString() const {
+  return fmt::format(
+      "<FileIdentity size {} mtime {} etag \"{}\">",
+      size,
+      modificationTime,
+      etag);
+}
+
+void setFileIdentity(uint64_t fileId, FileIdentity identity) {
+  auto locked = fileIdentities().wlock();
+  locked->identities[fileId] = std::move(identity);
+  if (locked->identities.size() < locked->pruneThreshold) {
+    return;
+  }
+  // Ids are not reused, so the identities of released ids are garbage.
+  for (auto it = locked->identities.begin();
+       it != locked->identities.end();) {
+    if (fileIds().string(it->first).empty()) {
+      it = locked->identities.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  locked->pruneThreshold =
+      std::max(kMinIdentitiesToPrune, 2 * locked->identities.size());
+}
+
+std::optional<FileIdentity> fileIdentity(uint64_t fileId) {
+  auto locked = fileIdentities().rlock();
+  const auto it = locked->identities.find(fileId);
+  if (it == locked->identities.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
 } // namespace facebook::velox
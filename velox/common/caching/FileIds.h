@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <optional>
+#include <string>
+
 #include "velox/common/caching/StringIdMap.h"
 
 namespace facebook::velox {
@@ -21,4 +24,33 @@ namespace facebook::velox {
 // Returns a process-wide map of file path to id and id to file path.
 StringIdMap& fileIds();
 
+// Version of a file. Data cached from a file, e.g. in a persistent SSD cache,
+// is only valid for the identity the file had when the data was read. Fields
+// not known to the file system are 0 or empty.
+struct FileIdentity {
+  uint64_t size{0};
+  // Modification time in the units of the file system.
+  int64_t modificationTime{0};
+  // Entity tag of an object store object.
+  std::string etag;
+
+  bool operator==(const FileIdentity& other) const {
+    return size == other.size && modificationTime == other.modificationTime &&
+        etag == other.etag;
+  }
+
+  bool operator!=(const FileIdentity& other) const {
+    return !(*this == other);
+  }
+
+  std::string toString() const;
+};
+
+// Records 'identity' for the file with 'fileId' in fileIds(). Called when the
+// file is opened.
+void setFileIdentity(uint64_t fileId, FileIdentity identity);
+
+// Returns the identity recorded for 'fileId' or std::nullopt if none.
+std::optional<FileIdentity> fileIdentity(uint64_t fileId);
+
 } // namespace facebook::velox
@@ -18,6 +18,7 @@
 #include <folly/portability/SysUio.h>
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -34,7 +35,9 @@ SsdCache::SsdCache(
     int32_t numShards,
     folly::Executor* executor,
     int64_t checkpointIntervalBytes,
-    bool disableFileCow)
+    bool disableFileCow,
+    common::CompressionKind compressionKind,
+    bool checksumEnabled)
     : filePrefix_(filePrefix),
       numShards_(numShards),
       groupStats_(std::make_unique<FileGroupStats>()),
@@ -59,7 +62,10 @@ SsdCache::SsdCache(
         i,
         fileMaxRegions,
         checkpointIntervalBytes / numShards,
-        disableFileCow));
+        disableFileCow,
+        nullptr,
+        compressionKind,
+        checksumEnabled));
   }
 }
 
@@ -143,6 +149,29 @@ SsdCacheStats SsdCache::stats() const {
   return stats;
 }
 
+std::vector<std::vector<FileCacheKey>> SsdCache::hottestEntries(
+    uint64_t maxBytes) {
+  std::vector<std::vector<FileCacheKey>> keys;
+  keys.reserve(files_.size());
+  for (auto& file : files_) {
+    keys.push_back(file->hottestEntries(maxBytes / files_.size()));
+  }
+  return keys;
+}
+
+void SsdCache::setFileInvalidatedCallback(
+    std::function<void(uint64_t)> callback) {
+  for (auto& file : files_) {
+    file->setFileInvalidatedCallback(callback);
+  }
+}
+
+void SsdCache::addToSummary(CacheSummary& summary) const {
+  for (const auto& file : files_) {
+    file->addToSummary(summary);
+  }
+}
+
 void SsdCache::clear() {
   for (auto& file : files_) {
     file->clear();
@@ -157,6 +186,15 @@ std::string SsdCache::toString() const {
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
+  if (data.entriesCompressed > 0) {
+    out << " Compression ratio " << data.compressionRatio() << ".";
+  }
+  if (data.readChecksumErrors > 0) {
+    out << " " << data.readChecksumErrors << " checksum errors.";
+  }
+  if (auto* ioUring = IoUring::instanceIfCreated()) {
+    out << "\n" << ioUring->stats().toString();
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
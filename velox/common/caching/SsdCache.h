@@ -43,13 +43,20 @@ class SsdCache {
   /// write) feature if the underlying filesystem (such as brtfs) supports it.
   /// This prevents the actual cache space usage on disk from exceeding the
   /// 'maxBytes' limit and stop working.
+  /// If 'compressionKind' is CompressionKind_LZ4 or CompressionKind_ZSTD,
+  /// entries that get at least 1/8 smaller are stored compressed.
+  /// If 'checksumEnabled' is true, each entry is stored with a CRC32C that is
+  /// verified when the entry is loaded. An entry with a mismatch is dropped
+  /// and the load fails.
   SsdCache(
       std::string_view filePrefix,
       uint64_t maxBytes,
       int32_t numShards,
       folly::Executor* executor,
       int64_t checkpointIntervalBytes = 0,
-      bool disableFileCow = false);
+      bool disableFileCow = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE,
+      bool checksumEnabled = false);
 
   /// Returns the shard corresponding to 'fileId'. 'fileId' is a file id from
   /// e.g. FileCacheKey.
@@ -79,6 +86,18 @@ class SsdCache {
   /// Returns stats aggregated from all shards.
   SsdCacheStats stats() const;
 
+  /// Returns the keys of the hottest entries of each shard, up to 'maxBytes'
+  /// in total. See SsdFile::hottestEntries().
+  std::vector<std::vector<FileCacheKey>> hottestEntries(uint64_t maxBytes);
+
+  /// Sets a function to call with the file number of a file whose entries
+  /// restored from checkpoint were dropped because the file changed. See
+  /// SsdFile::setFileInvalidatedCallback().
+  void setFileInvalidatedCallback(std::function<void(uint64_t)> callback);
+
+  /// Adds the entries of all shards to 'summary'.
+  void addToSummary(CacheSummary& summary) const;
+
   FileGroupStats& groupStats() const {
     return *groupStats_;
   }
@@ -16,11 +16,15 @@
 
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
+#include <folly/ScopeGuard.h>
+#include <folly/hash/Checksum.h>
+#include <folly/io/Cursor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -79,6 +83,36 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+void addIOBufToIovecs(const folly::IOBuf& data, std::vector<iovec>& iovecs) {
+  for (const auto& range : data) {
+    if (!range.empty()) {
+      iovecs.push_back(
+          {const_cast<uint8_t*>(range.data()),
+           static_cast<size_t>(range.size())});
+    }
+  }
+}
+
+// Returns the CRC32C of the data in 'iovecs' from 'begin' to 'end'.
+uint32_t checksumIovecs(
+    const std::vector<iovec>& iovecs,
+    size_t begin,
+    size_t end) {
+  uint32_t checksum = ~0U;
+  for (auto i = begin; i < end; ++i) {
+    checksum = folly::crc32c(
+        reinterpret_cast<const uint8_t*>(iovecs[i].iov_base),
+        iovecs[i].iov_len,
+        checksum);
+  }
+  return checksum;
+}
+
+// Compressed entries must save at least 1 / kMinCompressionSaving of their
+// size. Entries that do not compress well are stored uncompressed so that
+// reading them does not pay for decompression.
+constexpr int32_t kMinCompressionSaving = 8;
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -122,12 +156,22 @@ SsdFile::SsdFile(
     int32_t maxRegions,
     int64_t checkpointIntervalBytes,
     bool disableFileCow,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    common::CompressionKind compressionKind,
+    bool checksumEnabled)
     : fileName_(filename),
+      compressionKind_(compressionKind),
+      checksumEnabled_(checksumEnabled),
       maxRegions_(maxRegions),
       shardId_(shardId),
       checkpointIntervalBytes_(checkpointIntervalBytes),
       executor_(executor) {
+  VELOX_CHECK(
+      compressionKind_ == common::CompressionKind_NONE ||
+          compressionKind_ == common::CompressionKind_LZ4 ||
+          compressionKind_ == common::CompressionKind_ZSTD,
+      "Unsupported SSD cache compression: {}",
+      common::compressionKindToString(compressionKind_));
   int32_t oDirect = 0;
 #ifdef linux
   oDirect = FLAGS_ssd_odirect ? O_DIRECT : 0;
@@ -186,18 +230,28 @@ void SsdFile::unpinRegion(uint64_t offset) {
 SsdPin SsdFile::find(RawFileCacheKey key) {
   FileCacheKey ssdKey{StringIdLease(fileIds(), key.fileNum), key.offset};
   SsdRun run;
+  bool invalidated = false;
   {
     std::lock_guard<std::shared_mutex> l(mutex_);
     if (suspended_) {
       return SsdPin();
     }
     tracker_.fileTouched(entries_.size());
-    auto it = entries_.find(ssdKey);
-    if (it == entries_.end()) {
-      return SsdPin();
+    invalidated = !validateFileLocked(key.fileNum);
+    if (!invalidated) {
+      auto it = entries_.find(ssdKey);
+      if (it == entries_.end()) {
+        return SsdPin();
+      }
+      run = it->second;
+      pinRegionLocked(run.offset());
     }
-    run = it->second;
-    pinRegionLocked(run.offset());
+  }
+  if (invalidated) {
+    if (fileInvalidatedCallback_) {
+      fileInvalidatedCallback_(key.fileNum);
+    }
+    return SsdPin();
   }
   return SsdPin(*this, run);
 }
@@ -213,6 +267,43 @@ bool SsdFile::erase(RawFileCacheKey key) {
   return true;
 }
 
+bool SsdFile::validateFileLocked(uint64_t fileNum) {
+  if (checkpointIdentities_.empty()) {
+    return true;
+  }
+  const auto it = checkpointIdentities_.find(fileNum);
+  if (it == checkpointIdentities_.end()) {
+    return true;
+  }
+  const auto identity = fileIdentity(fileNum);
+  if (!identity.has_value()) {
+    // The file has not been opened since restart. It is checked on a later
+    // lookup.
+    return true;
+  }
+  const bool valid = identity.value() == it->second;
+  if (!valid) {
+    uint64_t numErased = 0;
+    for (auto entryIt = entries_.begin(); entryIt != entries_.end();) {
+      if (entryIt->first.fileNum.id() == fileNum) {
+        entryIt = entries_.erase(entryIt);
+        ++numErased;
+      } else {
+        ++entryIt;
+      }
+    }
+    stats_.entriesInvalidated += numErased;
+    VELOX_SSD_CACHE_LOG(WARNING) << fmt::format(
+        "Dropped {} entries of {} restored from checkpoint: {} is now {}",
+        numErased,
+        fileIds().string(fileNum),
+        it->second.toString(),
+        identity->toString());
+  }
+  checkpointIdentities_.erase(it);
+  return valid;
+}
+
 CoalesceIoStats SsdFile::load(
     const std::vector<SsdPin>& ssdPins,
     const std::vector<CachePin>& pins) {
@@ -221,40 +312,134 @@ CoalesceIoStats SsdFile::load(
     return CoalesceIoStats();
   }
   int payloadTotal = 0;
+  // Compressed entries are read into these and decompressed into the entry
+  // after the read. Empty for uncompressed entries.
+  std::vector<std::string> compressed(pins.size());
+  bool hasCompressed = false;
   for (auto i = 0; i < pins.size(); ++i) {
-    const auto runSize = ssdPins[i].run().size();
+    const auto run = ssdPins[i].run();
     auto* entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
+    if (FOLLY_UNLIKELY(run.dataSize() < entry->size())) {
       ++stats_.readSsdErrors;
       VELOX_FAIL(
           "IOERR: SSD cache cache entry {} short than requested range {}",
-          succinctBytes(runSize),
+          succinctBytes(run.dataSize()),
           succinctBytes(entry->size()));
     }
+    if (run.compressed()) {
+      compressed[i].resize(run.size());
+      hasCompressed = true;
+    }
     payloadTotal += entry->size();
-    regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
+    regionRead(regionIndex(run.offset()), run.size());
     ++stats_.entriesRead;
     stats_.bytesRead += entry->size();
   }
 
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  std::vector<uint64_t> readSizes;
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
   // gap. For longer payloads this is ~50-100K.
-  auto stats = readPins(
-      pins,
-      payloadTotal / pins.size() < 10000 ? 25000 : 50000,
-      // Max ranges in one preadv call. Longest gap + longest cache entry are
-      // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
-      // of 1000 is safe.
-      900,
-      [&](int32_t index) { return ssdPins[index].run().offset(); },
-      [&](const std::vector<CachePin>& /*pins*/,
-          int32_t /*begin*/,
-          int32_t /*end*/,
-          uint64_t offset,
-          const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
-      });
+  CoalesceIoStats stats;
+  try {
+    stats = coalesceIo<CachePin, folly::Range<char*>>(
+        pins,
+        payloadTotal / pins.size() < 10000 ? 25000 : 50000,
+        // Max ranges in one preadv call. Longest gap + longest cache entry are
+        // under 12 ranges. If a system has a limit of 1K ranges, coalesce limit
+        // of 1000 is safe.
+        900,
+        [&](int32_t index) { return ssdPins[index].run().offset(); },
+        [&](int32_t index) -> uint64_t {
+          if (!compressed[index].empty()) {
+            return compressed[index].size();
+          }
+          return pins[index].checkedEntry()->size();
+        },
+        [&](int32_t index) {
+          if (!compressed[index].empty()) {
+            return 1;
+          }
+          return std::max<int32_t>(
+              1, pins[index].checkedEntry()->data().numRuns());
+        },
+        [&](const CachePin& pin, std::vector<folly::Range<char*>>& ranges) {
+          const auto index = &pin - pins.data();
+          if (!compressed[index].empty()) {
+            ranges.push_back(folly::Range<char*>(
+                compressed[index].data(), compressed[index].size()));
+            return;
+          }
+          std::vector<iovec> iovecs;
+          addEntryToIovecs(*pin.checkedEntry(), iovecs);
+          for (const auto& iov : iovecs) {
+            ranges.push_back(folly::Range<char*>(
+                reinterpret_cast<char*>(iov.iov_base), iov.iov_len));
+          }
+        },
+        [&](int32_t size, std::vector<folly::Range<char*>>& ranges) {
+          // Stores the size of the gap in the Range without allocating a buffer
+          // for it. See readPins().
+          ranges.push_back(folly::Range<char*>(nullptr, (char*)(uint64_t)size));
+        },
+        [&](const std::vector<CachePin>& /*pins*/,
+            int32_t /*begin*/,
+            int32_t /*end*/,
+            uint64_t offset,
+            const std::vector<folly::Range<char*>>& buffers) {
+          if (readFile_->hasPreadvAsync()) {
+            uint64_t size = 0;
+            for (const auto& buffer : buffers) {
+              size += buffer.size();
+            }
+            readSizes.push_back(size);
+            reads.push_back(readFile_->preadvAsync(offset, buffers));
+          } else {
+            read(offset, buffers);
+          }
+        });
+  } catch (const std::exception&) {
+    ++stats_.readSsdErrors;
+    // The reads issued so far write into the entries, which may be freed
+    // after the error.
+    folly::collectAll(std::move(reads)).wait();
+    throw;
+  }
+  // The asynchronous reads of the coalesced ranges are in flight at the same
+  // time. All must be complete before the buffers can be used or freed.
+  if (!reads.empty()) {
+    auto results = folly::collectAll(std::move(reads)).get();
+    for (auto i = 0; i < results.size(); ++i) {
+      if (results[i].hasException()) {
+        ++stats_.readSsdErrors;
+        results[i].throwUnlessValue();
+      }
+      if (FOLLY_UNLIKELY(results[i].value() != readSizes[i])) {
+        ++stats_.readSsdErrors;
+        VELOX_FAIL(
+            "IOERR: Short read from SSD cache file {}: {} bytes, expected {}",
+            fileName_,
+            results[i].value(),
+            readSizes[i]);
+      }
+    }
+  }
+
+  if (checksumEnabled_ || hasCompressed) {
+    // The codec is not thread safe, so each load makes its own.
+    std::unique_ptr<folly::io::Codec> codec;
+    if (hasCompressed) {
+      codec = common::compressionKindToCodec(compressionKind_);
+    }
+    for (auto i = 0; i < pins.size(); ++i) {
+      checkAndDecompress(
+          *pins[i].checkedEntry(),
+          ssdPins[i].run(),
+          compressed[i],
+          codec.get());
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -262,6 +447,53 @@ CoalesceIoStats SsdFile::load(
   return stats;
 }
 
+void SsdFile::checkAndDecompress(
+    AsyncDataCacheEntry& entry,
+    SsdRun run,
+    const std::string& compressed,
+    folly::io::Codec* codec) {
+  if (checksumEnabled_) {
+    uint32_t checksum;
+    if (run.compressed()) {
+      checksum = folly::crc32c(
+          reinterpret_cast<const uint8_t*>(compressed.data()),
+          compressed.size(),
+          ~0U);
+    } else if (entry.size() == run.size()) {
+      std::vector<iovec> iovecs;
+      addEntryToIovecs(entry, iovecs);
+      checksum = checksumIovecs(iovecs, 0, iovecs.size());
+    } else {
+      // Only a prefix of the entry was read. There is nothing to check.
+      checksum = run.checksum();
+    }
+    if (FOLLY_UNLIKELY(checksum != run.checksum())) {
+      ++stats_.readChecksumErrors;
+      erase(RawFileCacheKey{entry.key().fileNum.id(), entry.key().offset});
+      VELOX_FAIL(
+          "IOERR: Corrupt SSD cache entry {} at offset {} of {}: checksum {} expected {}",
+          entry.toString(),
+          run.offset(),
+          fileName_,
+          checksum,
+          run.checksum());
+    }
+  }
+  if (!run.compressed()) {
+    return;
+  }
+  VELOX_CHECK_NOT_NULL(codec);
+  auto input =
+      folly::IOBuf::wrapBufferAsValue(compressed.data(), compressed.size());
+  const auto data = codec->uncompress(&input, run.dataSize());
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  folly::io::Cursor cursor(data.get());
+  for (const auto& iov : iovecs) {
+    cursor.pull(iov.iov_base, iov.iov_len);
+  }
+}
+
 void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
@@ -270,6 +502,7 @@ void SsdFile::read(
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& sizes,
     int32_t begin) {
   int32_t next = begin;
   std::lock_guard<std::shared_mutex> l(mutex_);
@@ -285,12 +518,11 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
     for (; next < pins.size(); ++next) {
-      auto* entry = pins[next].checkedEntry();
-      if (entry->size() > available) {
+      if (sizes[next] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[next];
+      toWrite += sizes[next];
     }
     if (toWrite > 0) {
       // At least some pins got space from this region. If the region is full
@@ -360,77 +592,225 @@ void SsdFile::write(std::vector<CachePin>& pins) {
   // Sorts the pins by their file/offset. In this way what is adjacent in
   // storage is likely adjacent on SSD.
   std::sort(pins.begin(), pins.end());
-  uint64_t total = 0;
   for (const auto& pin : pins) {
     auto* entry = pin.checkedEntry();
     VELOX_CHECK_NULL(entry->ssdFile());
-    total += entry->size();
   }
 
+  // The compressed data of the entries that get smaller with compression.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  // The size on SSD of each entry.
+  std::vector<uint32_t> sizes(pins.size());
+  std::unique_ptr<folly::io::Codec> codec;
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    codec = common::compressionKindToCodec(compressionKind_);
+  }
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto* entry = pins[i].checkedEntry();
+    if (codec != nullptr) {
+      compressed[i] = compressEntry(*entry, *codec);
+    }
+    sizes[i] = compressed[i] != nullptr
+        ? compressed[i]->computeChainDataLength()
+        : entry->size();
+  }
+
+  // With io_uring, the writes for consecutive pieces of space are in flight
+  // at the same time. The entries of a write are added after it completes.
+  // Its region is pinned meanwhile so that it is not evicted.
+  auto* ioUring = IoUring::instance();
+  struct PendingWrite {
+    int32_t begin;
+    int32_t numWritten;
+    uint64_t offset;
+    uint64_t bytes;
+    int32_t numIovecs;
+    std::vector<uint32_t> checksums;
+    folly::SemiFuture<uint64_t> result;
+  };
+  std::vector<PendingWrite> pendingWrites;
+  // Each write has at least one entry. Reserved so that adding a write in
+  // flight does not throw.
+  pendingWrites.reserve(pins.size());
+  // Number of leading 'pendingWrites' that have been waited for.
+  size_t numFinished = 0;
+  // If this exits with an exception, waits for the writes in flight so that
+  // the kernel does not read memory of 'pins' after they are freed, and
+  // unpins their regions.
+  SCOPE_EXIT {
+    for (; numFinished < pendingWrites.size(); ++numFinished) {
+      auto& write = pendingWrites[numFinished];
+      std::move(write.result).wait();
+      unpinRegion(write.offset);
+    }
+  };
+  bool failed = false;
+
   int32_t storeIndex = 0;
   while (storeIndex < pins.size()) {
-    auto space = getSpace(pins, storeIndex);
+    auto space = getSpace(pins, sizes, storeIndex);
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
-      return;
+      break;
     }
 
     auto [offset, available] = space.value();
     int32_t numWritten = 0;
     int32_t bytes = 0;
     std::vector<iovec> iovecs;
+    // Checksum of each written entry.
+    std::vector<uint32_t> checksums;
     for (auto i = storeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
-      const auto entrySize = entry->size();
-      if (bytes + entrySize > available) {
+      if (bytes + sizes[i] > static_cast<uint32_t>(available)) {
         break;
       }
-      addEntryToIovecs(*entry, iovecs);
-      bytes += entrySize;
+      const auto firstIovec = iovecs.size();
+      if (compressed[i] != nullptr) {
+        addIOBufToIovecs(*compressed[i], iovecs);
+      } else {
+        addEntryToIovecs(*entry, iovecs);
+      }
+      checksums.push_back(
+          checksumEnabled_ ? checksumIovecs(iovecs, firstIovec, iovecs.size())
+                           : 0);
+      bytes += sizes[i];
       ++numWritten;
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
 
+    if (ioUring != nullptr && iovecs.size() <= IOV_MAX) {
+      pinRegion(offset);
+      const int32_t numIovecs = iovecs.size();
+      auto result = folly::SemiFuture<uint64_t>::makeEmpty();
+      try {
+        result = ioUring->pwritev(fd_, offset, std::move(iovecs));
+      } catch (const std::exception&) {
+        unpinRegion(offset);
+        throw;
+      }
+      pendingWrites.push_back(
+          {storeIndex,
+           numWritten,
+           offset,
+           bytes,
+           numIovecs,
+           std::move(checksums),
+           std::move(result)});
+      storeIndex += numWritten;
+      continue;
+    }
+
     const auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
     if (rc != bytes) {
-      VELOX_SSD_CACHE_LOG(ERROR)
-          << "Failed to write to SSD, file name: " << fileName_
-          << ", fd: " << fd_ << ", size: " << iovecs.size()
-          << ", offset: " << offset << ", error code: " << errno
-          << ", error string: " << folly::errnoStr(errno);
-      ++stats_.writeSsdErrors;
+      logWriteError(offset, iovecs.size(), folly::errnoStr(errno));
       // If write fails, we return without adding the pins to the cache. The
       // entries are unchanged.
-      return;
-    }
-
-    {
-      std::lock_guard<std::shared_mutex> l(mutex_);
-      for (auto i = storeIndex; i < storeIndex + numWritten; ++i) {
-        auto* entry = pins[i].checkedEntry();
-        entry->setSsdFile(this, offset);
-        const auto size = entry->size();
-        FileCacheKey key = {
-            entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
-        if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
-        }
-        offset += size;
-        ++stats_.entriesWritten;
-        stats_.bytesWritten += size;
-        bytesAfterCheckpoint_ += size;
-      }
+      failed = true;
+      break;
     }
+    addWrittenEntries(pins, sizes, storeIndex, numWritten, offset, checksums);
     storeIndex += numWritten;
   }
 
+  while (numFinished < pendingWrites.size()) {
+    auto& write = pendingWrites[numFinished++];
+    auto result = std::move(write.result).getTry();
+    SCOPE_EXIT {
+      unpinRegion(write.offset);
+    };
+    if (result.hasException() || result.value() != write.bytes) {
+      logWriteError(
+          write.offset,
+          write.numIovecs,
+          result.hasException() ? result.exception().what().toStdString()
+                                : "short write");
+      failed = true;
+    } else {
+      addWrittenEntries(
+          pins,
+          sizes,
+          write.begin,
+          write.numWritten,
+          write.offset,
+          write.checksums);
+    }
+  }
+  if (failed) {
+    return;
+  }
+
   if ((checkpointIntervalBytes_ > 0) &&
       (bytesAfterCheckpoint_ >= checkpointIntervalBytes_)) {
     checkpoint();
   }
 }
 
+void SsdFile::addWrittenEntries(
+    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& sizes,
+    int32_t begin,
+    int32_t numWritten,
+    uint64_t offset,
+    const std::vector<uint32_t>& checksums) {
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  for (auto i = begin; i < begin + numWritten; ++i) {
+    auto* entry = pins[i].checkedEntry();
+    entry->setSsdFile(this, offset);
+    const auto size = sizes[i];
+    const SsdRun run(offset, size, checksums[i - begin], entry->size());
+    FileCacheKey key = {
+        entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
+    entries_[std::move(key)] = run;
+    if (FLAGS_ssd_verify_write && !run.compressed()) {
+      verifyWrite(*entry, run);
+    }
+    if (run.compressed()) {
+      ++stats_.entriesCompressed;
+      stats_.bytesBeforeCompression += entry->size();
+      stats_.bytesAfterCompression += size;
+    }
+    offset += size;
+    ++stats_.entriesWritten;
+    stats_.bytesWritten += size;
+    bytesAfterCheckpoint_ += size;
+  }
+}
+
+void SsdFile::logWriteError(
+    uint64_t offset,
+    int32_t numIovecs,
+    const std::string& error) {
+  VELOX_SSD_CACHE_LOG(ERROR)
+      << "Failed to write to SSD, file name: " << fileName_ << ", fd: " << fd_
+      << ", size: " << numIovecs << ", offset: " << offset
+      << ", error string: " << error;
+  ++stats_.writeSsdErrors;
+}
+
+std::unique_ptr<folly::IOBuf> SsdFile::compressEntry(
+    AsyncDataCacheEntry& entry,
+    folly::io::Codec& codec) {
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  std::unique_ptr<folly::IOBuf> input;
+  for (const auto& iov : iovecs) {
+    auto buffer = folly::IOBuf::wrapBuffer(iov.iov_base, iov.iov_len);
+    if (input == nullptr) {
+      input = std::move(buffer);
+    } else {
+      input->prependChain(std::move(buffer));
+    }
+  }
+  auto result = codec.compress(input.get());
+  const auto size = result->computeChainDataLength();
+  if (size > entry.size() - entry.size() / kMinCompressionSaving ||
+      size >= (1 << SsdRun::kSizeBits)) {
+    return nullptr;
+  }
+  return result;
+}
+
 namespace {
 int32_t indexOfFirstMismatch(char* x, char* y, int n) {
   for (auto i = 0; i < n; ++i) {
@@ -496,11 +876,20 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.readChecksumErrors += stats_.readChecksumErrors;
+
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.bytesBeforeCompression += stats_.bytesBeforeCompression;
+  stats.bytesAfterCompression += stats_.bytesAfterCompression;
+
+  stats.entriesRestored += stats_.entriesRestored;
+  stats.entriesInvalidated += stats_.entriesInvalidated;
 }
 
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
   entries_.clear();
+  checkpointIdentities_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
@@ -579,6 +968,74 @@ inline const char* asChar(const T* ptr) {
 }
 } // namespace
 
+void SsdFile::addToSummary(CacheSummary& summary) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  for (const auto& [key, run] : entries_) {
+    summary.add(key.fileNum.id(), key.offset, run.dataSize(), true);
+  }
+}
+
+std::vector<FileCacheKey> SsdFile::hottestEntries(uint64_t maxBytes) {
+  struct Entry {
+    const FileCacheKey* key;
+    uint64_t offset;
+    uint32_t dataSize;
+  };
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  // Files with entries restored from checkpoint and no identity known yet.
+  // Their entries may be stale and are not returned.
+  folly::F14FastMap<uint64_t, bool> unvalidatedFiles;
+  const auto isUnvalidated = [&](uint64_t fileNum) {
+    if (checkpointIdentities_.empty()) {
+      return false;
+    }
+    auto it = unvalidatedFiles.find(fileNum);
+    if (it == unvalidatedFiles.end()) {
+      it = unvalidatedFiles
+               .emplace(
+                   fileNum,
+                   checkpointIdentities_.count(fileNum) != 0 &&
+                       !fileIdentity(fileNum).has_value())
+               .first;
+    }
+    return it->second;
+  };
+  std::vector<std::vector<Entry>> regionEntries(numRegions_);
+  for (const auto& [key, run] : entries_) {
+    if (isUnvalidated(key.fileNum.id())) {
+      continue;
+    }
+    regionEntries[regionIndex(run.offset())].push_back(
+        {&key, run.offset(), run.dataSize()});
+  }
+  const auto scores = tracker_.copyScores();
+  std::vector<int32_t> regions;
+  for (auto i = 0; i < numRegions_; ++i) {
+    if (!regionEntries[i].empty()) {
+      regions.push_back(i);
+    }
+  }
+  std::sort(regions.begin(), regions.end(), [&](int32_t left, int32_t right) {
+    return scores[left] > scores[right];
+  });
+  std::vector<FileCacheKey> keys;
+  uint64_t totalBytes = 0;
+  for (auto region : regions) {
+    auto& entries = regionEntries[region];
+    std::sort(entries.begin(), entries.end(), [](auto& left, auto& right) {
+      return left.offset < right.offset;
+    });
+    for (const auto& entry : entries) {
+      if (totalBytes + entry.dataSize > maxBytes) {
+        return keys;
+      }
+      totalBytes += entry.dataSize;
+      keys.push_back(*entry.key);
+    }
+  }
+  return keys;
+}
+
 void SsdFile::checkpoint(bool force) {
   std::lock_guard<std::shared_mutex> l(mutex_);
   if (!force && (bytesAfterCheckpoint_ < checkpointIntervalBytes_)) {
@@ -612,14 +1069,21 @@ void SsdFile::checkpoint(bool force) {
     // int32_t The 4 bytes of kCheckpointMagic,
     // int32_t maxRegions,
     // int32_t numRegions,
+    // int32_t 1 if checksums are enabled, otherwise 0,
+    // int32_t the CompressionKind of compressed entries,
     // regionScores from the 'tracker_',
-    // {fileId, fileName} pairs,
+    // {fileId, fileName, int32_t 1 if the file identity is known, otherwise 0,
+    // [size, modificationTime, etag]} tuples,
     // kMapMarker,
-    // {fileId, offset, SSdRun} triples,
+    // {fileId, offset, SSdRun bits, checksum, dataSize} tuples,
     // kEndMarker.
     state.write(kCheckpointMagic, sizeof(int32_t));
     state.write(asChar(&maxRegions_), sizeof(maxRegions_));
     state.write(asChar(&numRegions_), sizeof(numRegions_));
+    const int32_t checksumEnabled = checksumEnabled_;
+    state.write(asChar(&checksumEnabled), sizeof(checksumEnabled));
+    const int32_t compressionKind = compressionKind_;
+    state.write(asChar(&compressionKind), sizeof(compressionKind));
 
     // Copy the region scores before writing out for tsan.
     const auto scoresCopy = tracker_.copyScores();
@@ -633,6 +1097,23 @@ void SsdFile::checkpoint(bool force) {
         const int32_t length = name.size();
         state.write(asChar(&length), sizeof(length));
         state.write(name.data(), length);
+        // A file not validated since restore keeps its checkpointed identity
+        // until it is checked against its current one.
+        auto identityIt = checkpointIdentities_.find(fileNum);
+        const auto identity = identityIt != checkpointIdentities_.end()
+            ? std::make_optional(identityIt->second)
+            : fileIdentity(fileNum);
+        const int32_t hasIdentity = identity.has_value();
+        state.write(asChar(&hasIdentity), sizeof(hasIdentity));
+        if (hasIdentity) {
+          state.write(asChar(&identity->size), sizeof(identity->size));
+          state.write(
+              asChar(&identity->modificationTime),
+              sizeof(identity->modificationTime));
+          const int32_t etagLength = identity->etag.size();
+          state.write(asChar(&etagLength), sizeof(etagLength));
+          state.write(identity->etag.data(), etagLength);
+        }
       }
     }
 
@@ -644,6 +1125,10 @@ void SsdFile::checkpoint(bool force) {
       state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
       auto offsetAndSize = pair.second.bits();
       state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      const auto checksum = pair.second.checksum();
+      state.write(asChar(&checksum), sizeof(checksum));
+      const auto dataSize = pair.second.dataSize();
+      state.write(asChar(&dataSize), sizeof(dataSize));
     }
 
     // NOTE: we need to ensure cache file data sync update completes before
@@ -760,9 +1245,19 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       maxRegions_,
       "Trying to start from checkpoint with a different capacity");
   numRegions_ = readNumber<int32_t>(state);
+  const bool checksumEnabled = readNumber<int32_t>(state) != 0;
+  VELOX_CHECK_EQ(
+      checksumEnabled,
+      checksumEnabled_,
+      "Trying to start from checkpoint with a different checksum setting");
+  // Compressed entries can only be read with the codec they were written
+  // with. Uncompressed entries are kept if the codec has changed.
+  const bool dropCompressed =
+      readNumber<int32_t>(state) != static_cast<int32_t>(compressionKind_);
   std::vector<int64_t> scores(maxRegions);
   state.read(asChar(scores.data()), maxRegions_ * sizeof(uint64_t));
   std::unordered_map<uint64_t, StringIdLease> idMap;
+  folly::F14FastMap<uint64_t, FileIdentity> identities;
   for (;;) {
     auto id = readNumber<uint64_t>(state);
     if (id == kCheckpointMapMarker) {
@@ -772,6 +1267,14 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     name.resize(readNumber<int32_t>(state));
     state.read(name.data(), name.size());
     auto lease = StringIdLease(fileIds(), name);
+    if (readNumber<int32_t>(state) != 0) {
+      FileIdentity identity;
+      identity.size = readNumber<uint64_t>(state);
+      identity.modificationTime = readNumber<int64_t>(state);
+      identity.etag.resize(readNumber<int32_t>(state));
+      state.read(identity.etag.data(), identity.etag.size());
+      identities[lease.id()] = std::move(identity);
+    }
     idMap[id] = std::move(lease);
   }
 
@@ -789,7 +1292,13 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
       break;
     }
     const uint64_t offset = readNumber<uint64_t>(state);
-    const auto run = SsdRun(readNumber<uint64_t>(state));
+    const auto bits = SsdRun(readNumber<uint64_t>(state));
+    const auto checksum = readNumber<uint32_t>(state);
+    const auto dataSize = readNumber<uint32_t>(state);
+    const auto run = SsdRun(bits.offset(), bits.size(), checksum, dataSize);
+    if (dropCompressed && run.compressed()) {
+      continue;
+    }
     // Check that the recovered entry does not fall in an evicted region.
     if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
       // The file may have a different id on restore.
@@ -808,6 +1317,10 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     writableRegions_.push_back(region);
   }
   tracker_.setRegionScores(scores);
+  // The entries of a file are validated against its identity when the file is
+  // next looked up.
+  checkpointIdentities_ = std::move(identities);
+  stats_.entriesRestored += entries_.size();
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
       "Starting shard {} from checkpoint with {} entries, {} regions with {} free.",
       shardId_,
@@ -17,7 +17,9 @@
 #pragma once
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 
 #include <gflags/gflags.h>
@@ -27,41 +29,69 @@ DECLARE_bool(ssd_verify_write);
 
 namespace facebook::velox::cache {
 
-// A 64 bit word describing a SSD cache entry in an SsdFile. The low
-// 23 bits are the size, for a maximum entry size of 8MB. The high
-// bits are the offset.
+// Describes a SSD cache entry in an SsdFile. The low 23 bits of the 64 bit
+// word are the size on SSD, for a maximum entry size of 8MB. The high
+// bits are the offset. If the entry is compressed, 'dataSize' is the size of
+// the entry before compression. 'checksum' is the CRC32C of the bytes on SSD
+// if the file has checksums enabled.
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
 
-  SsdRun() : bits_(0) {}
+  SsdRun() : bits_(0), checksum_(0), dataSize_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size)
-      : bits_((offset << kSizeBits) | ((size - 1))) {
+  SsdRun(
+      uint64_t offset,
+      uint32_t size,
+      uint32_t checksum = 0,
+      uint32_t dataSize = 0)
+      : bits_((offset << kSizeBits) | ((size - 1))),
+        checksum_(checksum),
+        dataSize_(dataSize == 0 ? size : dataSize) {
     VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
     VELOX_CHECK_LT(size - 1, 1 << kSizeBits);
+    VELOX_CHECK_GE(dataSize_, size);
   }
 
-  SsdRun(uint64_t bits) : bits_(bits) {}
+  SsdRun(uint64_t bits) : bits_(bits), checksum_(0), dataSize_(size()) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
 
   void operator=(const SsdRun& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
+    dataSize_ = other.dataSize_;
   }
   void operator=(SsdRun&& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
+    dataSize_ = other.dataSize_;
   }
 
   uint64_t offset() const {
     return (bits_ >> kSizeBits);
   }
 
+  // Returns the number of bytes on SSD.
   uint32_t size() const {
     return (bits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
+  // Returns the size of the cache entry. This is more than size() if the
+  // entry is compressed.
+  uint32_t dataSize() const {
+    return dataSize_;
+  }
+
+  bool compressed() const {
+    return dataSize_ > size();
+  }
+
+  uint32_t checksum() const {
+    return checksum_;
+  }
+
   // Returns raw bits for serialization.
   uint64_t bits() const {
     return bits_;
@@ -69,6 +99,8 @@ class SsdRun {
 
  private:
   uint64_t bits_;
+  uint32_t checksum_;
+  uint32_t dataSize_;
 };
 
 // Represents an SsdFile entry that is planned for load or being
@@ -144,6 +176,22 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    readChecksumErrors = tsanAtomicValue(other.readChecksumErrors);
+
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    bytesBeforeCompression = tsanAtomicValue(other.bytesBeforeCompression);
+    bytesAfterCompression = tsanAtomicValue(other.bytesAfterCompression);
+
+    entriesRestored = tsanAtomicValue(other.entriesRestored);
+    entriesInvalidated = tsanAtomicValue(other.entriesInvalidated);
+  }
+
+  /// Returns the ratio of the size of the compressed entries before and after
+  /// compression. 1 if no entry is compressed.
+  double compressionRatio() const {
+    return bytesAfterCompression == 0
+        ? 1
+        : static_cast<double>(bytesBeforeCompression) / bytesAfterCompression;
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -163,6 +211,21 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  // Number of entries read from SSD whose checksum did not match.
+  tsan_atomic<uint32_t> readChecksumErrors{0};
+
+  // Number of entries written compressed. Entries that do not get smaller
+  // are written uncompressed.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  // Sizes of the entries written compressed before and after compression.
+  tsan_atomic<uint64_t> bytesBeforeCompression{0};
+  tsan_atomic<uint64_t> bytesAfterCompression{0};
+
+  // Number of entries restored from checkpoint at startup.
+  tsan_atomic<uint64_t> entriesRestored{0};
+  // Number of restored entries dropped because their file had changed since
+  // the checkpoint.
+  tsan_atomic<uint64_t> entriesInvalidated{0};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -178,14 +241,19 @@ class SsdFile {
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
   // Constructs a cache backed by filename. Discards any previous
-  // contents of filename.
+  // contents of filename. If 'compressionKind' is not
+  // CompressionKind_NONE, entries are compressed with it if this makes
+  // them smaller. If 'checksumEnabled' is true, a checksum of each entry
+  // is stored with the entry and verified on load().
   SsdFile(
       const std::string& filename,
       int32_t shardId,
       int32_t maxRegions,
       int64_t checkpointInternalBytes = 0,
       bool disableFileCow = false,
-      folly::Executor* executor = nullptr);
+      folly::Executor* executor = nullptr,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE,
+      bool checksumEnabled = false);
 
   // Adds entries of  'pins'  to this file. 'pins' must be in read mode and
   // those pins that are successfully added to SSD are marked as being on SSD.
@@ -193,13 +261,25 @@ class SsdFile {
   void write(std::vector<CachePin>& pins);
 
   // Finds an entry for 'key'. If no entry is found, the returned pin is empty.
+  // If the entries of the file of 'key' were restored from checkpoint and the
+  // file now has a different FileIdentity, erases them and returns an empty
+  // pin.
   SsdPin find(RawFileCacheKey key);
 
+  // Sets a function to call with the file number of a file whose entries
+  // restored from checkpoint were erased by find() because the file changed.
+  // Called outside of 'mutex_'.
+  void setFileInvalidatedCallback(std::function<void(uint64_t)> callback) {
+    fileInvalidatedCallback_ = std::move(callback);
+  }
+
   // Erases 'key'
   bool erase(RawFileCacheKey key);
 
   // Copies the data in 'ssdPins' into 'pins'. Coalesces IO for nearby
-  // entries if they are in ascending order and near enough.
+  // entries if they are in ascending order and near enough. Decompresses
+  // compressed entries. Throws and erases the entry if its checksum does not
+  // match.
   CoalesceIoStats load(
       const std::vector<SsdPin>& ssdPins,
       const std::vector<CachePin>& pins);
@@ -245,6 +325,17 @@ class SsdFile {
   // Deletes the backing file. Used in testing.
   void deleteFile();
 
+  // Returns the keys of the entries in the regions with the highest access
+  // scores, hottest region first, up to a total entry size of 'maxBytes'.
+  // Within a region the keys are in ascending order of offset on SSD. Used
+  // for loading the data most likely to be hit into memory after restart.
+  // Entries restored from checkpoint for files that have not been opened
+  // since restart are left out since they cannot yet be validated.
+  std::vector<FileCacheKey> hottestEntries(uint64_t maxBytes);
+
+  // Adds the entries of 'this' to 'summary'.
+  void addToSummary(CacheSummary& summary) const;
+
   // Writes a checkpoint state that can be recovered from. The
   // checkpoint is serialized on 'mutex_'. If 'force' is false,
   // rechecks that at least 'checkpointIntervalBytes_' have been
@@ -257,7 +348,7 @@ class SsdFile {
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
   // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
+  static constexpr const char* kCheckpointMagic = "CPT4";
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -271,13 +362,20 @@ class SsdFile {
   }
 
   // Returns [offset, size] of contiguous space for storing data of a number of
-  // contiguous 'pins' starting with the pin at index 'begin'.  Returns nullopt
+  // contiguous 'pins' starting with the pin at index 'begin'. 'sizes' has the
+  // size on SSD of each pin.  Returns nullopt
   // if there is no space. The space does not necessarily cover all the pins, so
   // multiple calls starting at the first unwritten pin may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
       const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& sizes,
       int32_t begin);
 
+  // Returns false if 'fileNum' has entries restored from checkpoint and a
+  // FileIdentity different from the checkpointed one. Erases the entries of
+  // 'fileNum' in this case. Caller must hold 'mutex_' for writing.
+  bool validateFileLocked(uint64_t fileNum);
+
   // Removes all 'entries_' that reference data in regions described by
   // 'regionIndices'.
   void clearRegionEntriesLocked(const std::vector<int32_t>& regions);
@@ -289,9 +387,38 @@ class SsdFile {
   // Reads the backing file with ReadFile::preadv().
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
+  // Adds the entries for 'numWritten' pins starting at 'begin' that were
+  // written at 'offset'. 'checksums' has the checksum of each written entry.
+  void addWrittenEntries(
+      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& sizes,
+      int32_t begin,
+      int32_t numWritten,
+      uint64_t offset,
+      const std::vector<uint32_t>& checksums);
+
+  // Logs and counts a failed write of 'numIovecs' iovecs at 'offset'.
+  void
+  logWriteError(uint64_t offset, int32_t numIovecs, const std::string& error);
+
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
+  // Compresses the data of 'entry' with 'codec'. Returns nullptr if the
+  // compressed data is not smaller.
+  std::unique_ptr<folly::IOBuf> compressEntry(
+      AsyncDataCacheEntry& entry,
+      folly::io::Codec& codec);
+
+  // Checks the checksum of the data read for 'run' into 'entry' or
+  // 'compressed' and decompresses 'compressed' into 'entry' if 'run' is
+  // compressed. Erases the entry and throws if the checksum does not match.
+  void checkAndDecompress(
+      AsyncDataCacheEntry& entry,
+      SsdRun run,
+      const std::string& compressed,
+      folly::io::Codec* codec);
+
   // Deletes checkpoint files. If 'keepLog' is true, truncates and syncs the
   // eviction log and leaves this open.
   void deleteCheckpoint(bool keepLog = false);
@@ -322,6 +449,12 @@ class SsdFile {
   // Name of cache file, used as prefix for checkpoint files.
   const std::string fileName_;
 
+  // Compression of the entries written to this file.
+  const common::CompressionKind compressionKind_;
+
+  // True if entries are checksummed.
+  const bool checksumEnabled_;
+
   // Maximum size of the backing file in kRegionSize units.
   const int32_t maxRegions_;
 
@@ -356,6 +489,14 @@ class SsdFile {
   // Map of file number and offset to location in file.
   folly::F14FastMap<FileCacheKey, SsdRun> entries_;
 
+  // The identities recorded in the checkpoint for the files with entries
+  // restored from it. A file is removed on first lookup, when it is checked
+  // against its current identity.
+  folly::F14FastMap<uint64_t, FileIdentity> checkpointIdentities_;
+
+  // See setFileInvalidatedCallback().
+  std::function<void(uint64_t)> fileInvalidatedCallback_;
+
   // File descriptor. 0 (stdin) means file not open.
   int32_t fd_{0};
 
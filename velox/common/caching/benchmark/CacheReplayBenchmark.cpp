@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
+
+#include <fstream>
+
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+DEFINE_string(
+    trace,
+    "",
+    "File with one cache access per line as '<file name> <offset> <size>'. "
+    "If empty, replays a synthetic trace of repeated reads of a small hot "
+    "set interleaved with large one-off scans");
+DEFINE_int64(cache_mb, 256, "Cache capacity in MB. At least 64");
+DEFINE_int32(
+    num_queries,
+    100,
+    "Number of queries in the synthetic trace. Each reads the hot set");
+DEFINE_int32(
+    scan_every,
+    10,
+    "Every --scan_every'th query of the synthetic trace is a scan of twice "
+    "the cache capacity");
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+namespace {
+
+struct Access {
+  StringIdLease file;
+  uint64_t offset;
+  int32_t size;
+};
+
+std::vector<Access> readTrace(const std::string& path) {
+  std::ifstream in(path);
+  VELOX_CHECK(in.good(), "Cannot open trace {}", path);
+  std::vector<Access> trace;
+  std::string name;
+  uint64_t offset;
+  int32_t size;
+  while (in >> name >> offset >> size) {
+    trace.push_back({StringIdLease(fileIds(), name), offset, size});
+  }
+  return trace;
+}
+
+// Makes a trace where each query reads a set of hot dimension table files of
+// 1/4 of the cache and every --scan_every'th query also scans a new fact
+// table file of twice the cache size.
+std::vector<Access> makeSyntheticTrace(uint64_t cacheBytes) {
+  constexpr int32_t kEntrySize = 1 << 20;
+  const int32_t numHot = cacheBytes / 4 / kEntrySize;
+  const int32_t numScan = 2 * cacheBytes / kEntrySize;
+  std::vector<StringIdLease> hotFiles;
+  for (auto i = 0; i < 8; ++i) {
+    hotFiles.push_back(StringIdLease(fileIds(), fmt::format("dim_{}", i)));
+  }
+  std::vector<Access> trace;
+  for (auto query = 0; query < FLAGS_num_queries; ++query) {
+    for (auto i = 0; i < numHot; ++i) {
+      trace.push_back(
+          {hotFiles[i % hotFiles.size()],
+           static_cast<uint64_t>(i / hotFiles.size()) * kEntrySize,
+           kEntrySize});
+    }
+    if (query % FLAGS_scan_every == 0) {
+      StringIdLease scanFile(fileIds(), fmt::format("fact_{}", query));
+      for (auto i = 0; i < numScan; ++i) {
+        trace.push_back(
+            {scanFile, static_cast<uint64_t>(i) * kEntrySize, kEntrySize});
+      }
+    }
+  }
+  return trace;
+}
+
+struct ReplayResult {
+  uint64_t numHits{0};
+  uint64_t hitBytes{0};
+  uint64_t numAccesses{0};
+  uint64_t accessBytes{0};
+  uint64_t micros{0};
+};
+
+// Replays 'trace' against a cache of 'cacheBytes' with the eviction policy
+// made by 'factory'.
+ReplayResult replay(
+    const std::vector<Access>& trace,
+    uint64_t cacheBytes,
+    CacheEvictionPolicyFactory factory) {
+  memory::MmapAllocator::Options options;
+  options.capacity = cacheBytes;
+  auto allocator = std::make_shared<memory::MmapAllocator>(options);
+  auto cache =
+      AsyncDataCache::create(allocator.get(), nullptr, std::move(factory));
+  ReplayResult result;
+  {
+    MicrosecondTimer timer(&result.micros);
+    for (const auto& access : trace) {
+      ++result.numAccesses;
+      result.accessBytes += access.size;
+      folly::SemiFuture<bool> wait(false);
+      auto pin = cache->findOrCreate(
+          {access.file.id(), access.offset}, access.size, &wait);
+      if (pin.empty()) {
+        continue;
+      }
+      if (pin.checkedEntry()->isExclusive()) {
+        pin.checkedEntry()->setExclusiveToShared();
+      } else {
+        ++result.numHits;
+        result.hitBytes += access.size;
+      }
+    }
+  }
+  cache->shutdown();
+  return result;
+}
+
+void printResult(const std::string& policy, const ReplayResult& result) {
+  const auto numAccesses = std::max<uint64_t>(1, result.numAccesses);
+  const auto accessBytes = std::max<uint64_t>(1, result.accessBytes);
+  std::cout << fmt::format(
+                   "{:>8}: hit rate {:.2f}% byte hit rate {:.2f}% "
+                   "{} accesses in {} ms",
+                   policy,
+                   100.0 * result.numHits / numAccesses,
+                   100.0 * result.hitBytes / accessBytes,
+                   result.numAccesses,
+                   result.micros / 1000)
+            << std::endl;
+}
+
+} // namespace
+
+// Measures the hit rate of AsyncDataCache with each eviction policy on a
+// recorded or synthetic trace of cache accesses.
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  const uint64_t cacheBytes = std::max<int64_t>(64, FLAGS_cache_mb) << 20;
+  const auto trace = FLAGS_trace.empty() ? makeSyntheticTrace(cacheBytes)
+                                         : readTrace(FLAGS_trace);
+  printResult("clock", replay(trace, cacheBytes, nullptr));
+  printResult("TinyLFU", replay(trace, cacheBytes, []() {
+                return std::make_unique<TinyLfuEvictionPolicy>();
+              }));
+  return 0;
+}
@@ -86,7 +86,10 @@ class AsyncDataCacheTest : public testing::Test {
     }
   }
 
-  void initializeCache(uint64_t maxBytes, int64_t ssdBytes = 0) {
+  void initializeCache(
+      uint64_t maxBytes,
+      int64_t ssdBytes = 0,
+      CacheEvictionPolicyFactory evictionPolicyFactory = nullptr) {
     if (cache_ != nullptr) {
       cache_->shutdown();
     }
@@ -114,7 +117,10 @@ class AsyncDataCacheTest : public testing::Test {
     memory::MmapAllocator::Options options;
     options.capacity = maxBytes;
     allocator_ = std::make_shared<memory::MmapAllocator>(options);
-    cache_ = AsyncDataCache::create(allocator_.get(), std::move(ssdCache));
+    cache_ = AsyncDataCache::create(
+        allocator_.get(),
+        std::move(ssdCache),
+        std::move(evictionPolicyFactory));
     if (filenames_.empty()) {
       for (auto i = 0; i < kNumFiles; ++i) {
         auto name = fmt::format("testing_file_{}", i);
@@ -701,6 +707,50 @@ void corruptFile(const std::string& path) {
 }
 } // namespace
 
+TEST_F(AsyncDataCacheTest, scanResistance) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kEntrySize = 64 << 10;
+  // The hot entries take 1/8 of the cache.
+  constexpr int32_t kNumHot = kMaxBytes / kEntrySize / 8;
+  // The scan is 4x the cache.
+  constexpr int32_t kNumScan = 4 * kMaxBytes / kEntrySize;
+
+  auto load = [&](uint64_t fileNum, uint64_t offset) {
+    folly::SemiFuture<bool> wait(false);
+    auto pin = cache_->findOrCreate({fileNum, offset}, kEntrySize, &wait);
+    if (!pin.empty() && pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+  // Returns the number of hot entries that survive a scan.
+  auto numHotRetained = [&](CacheEvictionPolicyFactory factory) {
+    initializeCache(kMaxBytes, 0, std::move(factory));
+    const auto hotFile = filenames_[0].id();
+    const auto scanFile = filenames_[1].id();
+    for (auto repeat = 0; repeat < 3; ++repeat) {
+      for (auto i = 0; i < kNumHot; ++i) {
+        load(hotFile, i * kEntrySize);
+      }
+    }
+    for (auto i = 0; i < kNumScan; ++i) {
+      load(scanFile, static_cast<uint64_t>(i) * kEntrySize);
+    }
+    int32_t numRetained = 0;
+    for (auto i = 0; i < kNumHot; ++i) {
+      numRetained += cache_->exists({hotFile, i * kEntrySize});
+    }
+    return numRetained;
+  };
+
+  const auto numClockRetained = numHotRetained(nullptr);
+  const auto numTinyLfuRetained = numHotRetained(
+      []() { return std::make_unique<TinyLfuEvictionPolicy>(); });
+  LOG(INFO) << "Hot entries retained after scan: clock " << numClockRetained
+            << " TinyLFU " << numTinyLfuRetained << " of " << kNumHot;
+  EXPECT_GE(numTinyLfuRetained, kNumHot / 2);
+  EXPECT_GE(numTinyLfuRetained, numClockRetained);
+}
+
 TEST_F(AsyncDataCacheTest, DISABLED_ssd) {
 #ifdef TSAN_BUILD
   // NOTE: scale down the test data set to prevent tsan tester from running out
@@ -776,6 +826,117 @@ TEST_F(AsyncDataCacheTest, DISABLED_ssd) {
   ASSERT_EQ(ssdStatsFromCP.readCheckpointErrors, 1);
 }
 
+TEST_F(AsyncDataCacheTest, prewarmFromSsd) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 256UL << 20;
+  initializeCache(kRamBytes, kSsdBytes);
+  EXPECT_EQ(0, cache_->prewarmFromSsd(kRamBytes));
+
+  // Loads twice the memory capacity so that entries get written to SSD.
+  loadLoop(0, 2 * kRamBytes);
+  cache_->ssdCache()->shutdown();
+  const auto ssdStats = cache_->ssdCache()->stats();
+  ASSERT_LT(0, ssdStats.entriesCached);
+
+  // Restarts from the checkpoint with empty memory.
+  initializeCache(kRamBytes, kSsdBytes);
+  cache_->setVerifyHook(
+      [&](const AsyncDataCacheEntry& entry) { checkContents(entry); });
+  EXPECT_EQ(
+      ssdStats.entriesCached, cache_->ssdCache()->stats().entriesRestored);
+  EXPECT_EQ(0, cache_->refreshStats().numEntries);
+
+  const auto bytesLoaded = cache_->prewarmFromSsd(kRamBytes / 2);
+  EXPECT_LT(0, bytesLoaded);
+  EXPECT_GE(kRamBytes / 2, bytesLoaded);
+  const auto stats = cache_->refreshStats();
+  EXPECT_EQ(0, stats.numExclusive);
+  EXPECT_EQ(bytesLoaded, stats.prefetchBytes);
+  EXPECT_EQ(stats.numEntries, stats.numPrefetch);
+
+  // The loaded entries are skipped by a second call.
+  EXPECT_EQ(0, cache_->prewarmFromSsd(kRamBytes / 2));
+}
+
+TEST_F(AsyncDataCacheTest, prewarmFromSsdChangedFile) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 256UL << 20;
+  initializeCache(kRamBytes, kSsdBytes);
+  for (const auto& filename : filenames_) {
+    setFileIdentity(filename.id(), {1 << 20, 1, ""});
+  }
+  loadLoop(0, 2 * kRamBytes);
+  cache_->ssdCache()->shutdown();
+  ASSERT_LT(0, cache_->ssdCache()->stats().entriesCached);
+
+  // Restarts from the checkpoint. The file of the hottest entry is rewritten
+  // after some of its data was read into memory.
+  initializeCache(kRamBytes, kSsdBytes);
+  std::vector<FileCacheKey> ssdKeys;
+  for (auto& keys : cache_->ssdCache()->hottestEntries(kSsdBytes)) {
+    ssdKeys.insert(ssdKeys.end(), keys.begin(), keys.end());
+  }
+  ASSERT_FALSE(ssdKeys.empty());
+  const RawFileCacheKey staleKey{ssdKeys[0].fileNum.id(), ssdKeys[0].offset};
+  {
+    auto pin = cache_->findOrCreate(staleKey, sizeAtOffset(staleKey.offset));
+    ASSERT_FALSE(pin.empty());
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+  ASSERT_TRUE(cache_->exists(staleKey));
+  setFileIdentity(staleKey.fileNum, {1 << 20, 2, ""});
+
+  cache_->prewarmFromSsd(kRamBytes);
+  EXPECT_TRUE(
+      cache_->ssdCache()->file(staleKey.fileNum).find(staleKey).empty());
+  EXPECT_LT(0, cache_->ssdCache()->stats().entriesInvalidated);
+  // Neither the entries read before the rewrite nor any prewarmed ones of the
+  // rewritten file are in memory.
+  for (const auto& key : ssdKeys) {
+    if (key.fileNum.id() == staleKey.fileNum) {
+      EXPECT_FALSE(
+          cache_->exists(RawFileCacheKey{key.fileNum.id(), key.offset}));
+    }
+  }
+}
+
+TEST_F(AsyncDataCacheTest, summary) {
+  constexpr uint64_t kEntrySize = 1 << 20;
+  initializeCache(64 << 20);
+  StringIdLease file(fileIds(), "summary_test_file");
+  // Caches 4MB at the start of the file and 1MB at 12MB.
+  for (auto i : {0, 1, 2, 3, 12}) {
+    auto pin = cache_->findOrCreate({file.id(), i * kEntrySize}, kEntrySize);
+    ASSERT_TRUE(pin.checkedEntry()->isExclusive());
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+  auto summary = cache_->summary();
+  EXPECT_EQ(5 * kEntrySize, summary->memoryBytes());
+  EXPECT_EQ(0, summary->ssdBytes());
+  EXPECT_EQ(2, summary->numChunks());
+  EXPECT_EQ(
+      5 * kEntrySize,
+      summary->cachedBytes(file.id(), 0, std::numeric_limits<uint64_t>::max()));
+  EXPECT_EQ(
+      4 * kEntrySize,
+      summary->cachedBytes(file.id(), 0, CacheSummary::kChunkSize));
+  // Chunks partly in range count in proportion.
+  EXPECT_EQ(
+      2 * kEntrySize,
+      summary->cachedBytes(file.id(), 0, CacheSummary::kChunkSize / 2));
+  EXPECT_EQ(0, summary->cachedBytes(file.id(), 16 * kEntrySize, kEntrySize));
+  EXPECT_TRUE(summary->mayContain("summary_test_file", 0));
+  EXPECT_TRUE(summary->mayContain("summary_test_file", 12 * kEntrySize));
+  EXPECT_FALSE(summary->mayContain("other_file", 0));
+
+  // The summary is reused until it is older than the max age.
+  cache_->findOrCreate({file.id(), 20 * kEntrySize}, kEntrySize)
+      .checkedEntry()
+      ->setExclusiveToShared();
+  EXPECT_EQ(summary, cache_->summary());
+  EXPECT_EQ(6 * kEntrySize, cache_->summary(0)->memoryBytes());
+}
+
 TEST_F(AsyncDataCacheTest, invalidSsdPath) {
   auto testPath = "hdfs:/test/prefix_";
   uint64_t ssdBytes = 256UL << 20;
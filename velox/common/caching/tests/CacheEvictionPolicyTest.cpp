@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/CacheEvictionPolicy.h"
+
+#include <folly/hash/Hash.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::cache;
+
+TEST(CacheEvictionPolicyTest, frequencySketch) {
+  FrequencySketch sketch(1000);
+  EXPECT_EQ(1024, sketch.width());
+  for (uint64_t key = 0; key < 100; ++key) {
+    for (auto i = 0; i < key % 10; ++i) {
+      sketch.increment(folly::hash::twang_mix64(key));
+    }
+  }
+  // A count-min sketch never underestimates.
+  int32_t numExact = 0;
+  for (uint64_t key = 0; key < 100; ++key) {
+    const auto estimate = sketch.estimate(folly::hash::twang_mix64(key));
+    EXPECT_GE(estimate, key % 10);
+    numExact += estimate == key % 10;
+  }
+  EXPECT_GE(numExact, 95);
+
+  // Counts saturate.
+  const auto hot = folly::hash::twang_mix64(1'000);
+  for (auto i = 0; i < 100; ++i) {
+    sketch.increment(hot);
+  }
+  EXPECT_EQ(FrequencySketch::kMaxCount, sketch.estimate(hot));
+
+  // Counts are halved after 10 increments per counter of a row.
+  const auto other = folly::hash::twang_mix64(1'001);
+  while (sketch.numResets() == 0) {
+    sketch.increment(other);
+  }
+  EXPECT_EQ(FrequencySketch::kMaxCount / 2, sketch.estimate(hot));
+
+  // Growing keeps the counts halved. A smaller size is ignored.
+  sketch.grow(4'000);
+  EXPECT_EQ(4096, sketch.width());
+  EXPECT_EQ(FrequencySketch::kMaxCount / 4, sketch.estimate(hot));
+  sketch.grow(1'000);
+  EXPECT_EQ(4096, sketch.width());
+}
+
+TEST(CacheEvictionPolicyTest, tinyLfu) {
+  TinyLfuEvictionPolicy policy;
+  const uint64_t once = folly::hash::twang_mix64(1);
+  const uint64_t frequent = folly::hash::twang_mix64(2);
+  policy.recordAccess(once);
+  for (auto i = 0; i < 5; ++i) {
+    policy.recordAccess(frequent);
+  }
+  EXPECT_FALSE(policy.shouldSaveToSsd(once));
+  EXPECT_TRUE(policy.shouldSaveToSsd(frequent));
+
+  // An entry seen once scores above a much older frequently seen entry.
+  const AccessTime now = 100'000;
+  AccessStats recent{now - 1, 1};
+  AccessStats old{now - 1'000, 5};
+  EXPECT_GT(
+      policy.score(once, recent, now, 0), policy.score(frequent, old, now, 0));
+  // Among frequent entries, the older scores higher.
+  EXPECT_GT(
+      policy.score(frequent, old, now, 0),
+      policy.score(frequent, recent, now, 0));
+  // An explicitly evictable entry.
+  EXPECT_EQ(
+      std::numeric_limits<int32_t>::max(),
+      policy.score(frequent, AccessStats{}, now, 0));
+
+  // Growing the shard widens the sketch and keeps the counts halved.
+  policy.ensureCapacity(10'000);
+  EXPECT_EQ(32 << 10, policy.sketch().width());
+  EXPECT_EQ(2, policy.sketch().estimate(frequent));
+  EXPECT_EQ(0, policy.sketch().estimate(once));
+  EXPECT_TRUE(policy.shouldSaveToSsd(frequent));
+  EXPECT_TRUE(policy.filtersSsdSaves());
+  EXPECT_FALSE(ClockEvictionPolicy().filtersSsdSaves());
+}
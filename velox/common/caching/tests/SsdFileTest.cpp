@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -53,7 +56,9 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      common::CompressionKind compressionKind = common::CompressionKind_NONE,
+      bool checksumEnabled = false) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(MemoryAllocator::getInstance());
@@ -66,7 +71,10 @@ class SsdFileTest : public testing::Test {
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
         0, // checkpointInternalBytes
-        setNoCowFlag);
+        setNoCowFlag,
+        nullptr,
+        compressionKind,
+        checksumEnabled);
   }
 
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
@@ -87,6 +95,17 @@ class SsdFileTest : public testing::Test {
     }
   }
 
+  // Zeroes the data of the entries of 'pins', so that reading them back from
+  // SSD is checked by checkContents().
+  static void clearContents(const std::vector<CachePin>& pins) {
+    for (auto& pin : pins) {
+      auto& data = pin.entry()->data();
+      for (auto i = 0; i < data.numRuns(); ++i) {
+        memset(data.runAt(i).data(), 0, data.runAt(i).numBytes());
+      }
+    }
+  }
+
   // Checks that the contents are consistent with what is set in
   // initializeContents.
   static void checkContents(const memory::Allocation& alloc, int32_t numBytes) {
@@ -224,6 +243,12 @@ class SsdFileTest : public testing::Test {
     readAndCheckPins(pins);
   }
 
+  SsdCacheStats stats() const {
+    SsdCacheStats stats;
+    ssdFile_->updateStats(stats);
+    return stats;
+  }
+
   std::shared_ptr<exec::test::TempDirectoryPath> tempDirectory_;
 
   std::shared_ptr<AsyncDataCache> cache_;
@@ -299,6 +324,224 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, compression) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  for (auto kind :
+       {common::CompressionKind_LZ4, common::CompressionKind_ZSTD}) {
+    SCOPED_TRACE(common::compressionKindToString(kind));
+    if (ssdFile_) {
+      ssdFile_->deleteFile();
+    }
+    initializeCache(128 * kMB, kSsdSize, false, kind, true);
+    auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 32 * kMB);
+    ssdFile_->write(pins);
+    int64_t bytes = 0;
+    for (auto& pin : pins) {
+      EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      bytes += pin.entry()->size();
+    }
+    const auto writeStats = stats();
+    EXPECT_EQ(pins.size(), writeStats.entriesWritten);
+    EXPECT_GT(writeStats.entriesCompressed, 0);
+    EXPECT_GT(writeStats.compressionRatio(), 1.2);
+    EXPECT_LT(writeStats.bytesWritten, bytes);
+    EXPECT_EQ(writeStats.bytesWritten, writeStats.bytesCached);
+
+    // Drops the entries from memory and reads them back from SSD into zeroed
+    // entries.
+    pins.clear();
+    cache_->clear();
+    pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 32 * kMB);
+    clearContents(pins);
+    readAndCheckPins(pins);
+    EXPECT_EQ(0, stats().readChecksumErrors);
+  }
+}
+
+TEST_F(SsdFileTest, checksum) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(
+      128 * kMB, kSsdSize, false, common::CompressionKind_NONE, true);
+  auto pins = makePins(fileName_.id(), 0, 4096, 4096, 40 * 4096);
+  ssdFile_->write(pins);
+  const auto corruptOffset = pins[10].entry()->key().offset;
+  const auto ssdOffset = pins[10].entry()->ssdOffset();
+  pins.clear();
+  cache_->clear();
+
+  // Flips a byte of one entry on SSD.
+  const auto path = fmt::format("{}/ssdtest", tempDirectory_->path);
+  const auto fd = ::open(path.c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  char byte;
+  ASSERT_EQ(1, ::pread(fd, &byte, 1, ssdOffset + 100));
+  byte = ~byte;
+  ASSERT_EQ(1, ::pwrite(fd, &byte, 1, ssdOffset + 100));
+  ::close(fd);
+
+  for (auto i = 0; i < 40; ++i) {
+    const uint64_t offset = i * 4096;
+    std::vector<CachePin> loadPins;
+    loadPins.push_back(cache_->findOrCreate(
+        RawFileCacheKey{fileName_.id(), offset}, 4096, nullptr));
+    ASSERT_TRUE(loadPins.back().entry()->isExclusive());
+    std::vector<SsdPin> ssdPins;
+    ssdPins.push_back(ssdFile_->find(RawFileCacheKey{fileName_.id(), offset}));
+    ASSERT_FALSE(ssdPins.back().empty());
+    if (offset == corruptOffset) {
+      VELOX_ASSERT_THROW(
+          ssdFile_->load(ssdPins, loadPins), "Corrupt SSD cache entry");
+    } else {
+      ssdFile_->load(ssdPins, loadPins);
+      checkContents(loadPins[0].entry()->data(), 4096);
+    }
+  }
+  EXPECT_EQ(1, stats().readChecksumErrors);
+  // The corrupt entry is dropped.
+  EXPECT_TRUE(
+      ssdFile_->find(RawFileCacheKey{fileName_.id(), corruptOffset}).empty());
+}
+
+TEST_F(SsdFileTest, ioUring) {
+  auto* ioUring = IoUring::instance();
+  if (ioUring == nullptr) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  EXPECT_EQ(ioUring, IoUring::instanceIfCreated());
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize);
+  const auto statsBefore = ioUring->stats();
+  auto pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  ssdFile_->write(pins);
+  for (auto& pin : pins) {
+    EXPECT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+  }
+  pins.clear();
+  cache_->clear();
+
+  pins = makePins(fileName_.id(), 0, 4096, 2048 * 1025, 16 * kMB);
+  clearContents(pins);
+  readAndCheckPins(pins);
+  const auto statsAfter = ioUring->stats();
+  EXPECT_GT(statsAfter.numWrites, statsBefore.numWrites);
+  EXPECT_GT(statsAfter.numReads, statsBefore.numReads);
+  EXPECT_EQ(statsAfter.numErrors, statsBefore.numErrors);
+}
+
+TEST_F(SsdFileTest, checkpointCompressionKind) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize);
+  const auto makeSsdFile = [&](common::CompressionKind kind) {
+    return std::make_unique<SsdFile>(
+        fmt::format("{}/ssdtest", tempDirectory_->path),
+        0, // shardId
+        kSsdSize / SsdFile::kRegionSize,
+        kSsdSize, // checkpointInternalBytes
+        false,
+        nullptr,
+        kind);
+  };
+  ssdFile_ = makeSsdFile(common::CompressionKind_LZ4);
+  auto pins = makePins(fileName_.id(), 0, 4096, 4096, 20 * 4096);
+  ssdFile_->write(pins);
+  pins.clear();
+  const auto writeStats = stats();
+  ASSERT_GT(writeStats.entriesCompressed, 0);
+  const auto numUncompressed =
+      writeStats.entriesWritten - writeStats.entriesCompressed;
+  ssdFile_->checkpoint(true);
+  cache_->clear();
+
+  // Restarts with the same compression kind. All entries are restored and
+  // read back into zeroed entries.
+  ssdFile_ = makeSsdFile(common::CompressionKind_LZ4);
+  EXPECT_EQ(writeStats.entriesWritten, stats().entriesRestored);
+  pins = makePins(fileName_.id(), 0, 4096, 4096, 20 * 4096);
+  clearContents(pins);
+  readAndCheckPins(pins);
+  pins.clear();
+  cache_->clear();
+
+  // Restarts with a different compression kind. The compressed entries are
+  // dropped.
+  ssdFile_ = makeSsdFile(common::CompressionKind_ZSTD);
+  EXPECT_EQ(numUncompressed, stats().entriesRestored);
+  EXPECT_EQ(0, stats().readCheckpointErrors);
+  ssdFile_ = makeSsdFile(common::CompressionKind_NONE);
+  EXPECT_EQ(numUncompressed, stats().entriesRestored);
+  for (auto i = 0; i < 20; ++i) {
+    auto pin = ssdFile_->find(RawFileCacheKey{fileName_.id(), i * 4096UL});
+    if (!pin.empty()) {
+      EXPECT_FALSE(pin.run().compressed());
+    }
+  }
+}
+
+TEST_F(SsdFileTest, checkpointFileIdentity) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize);
+  const auto makeSsdFile = [&]() {
+    return std::make_unique<SsdFile>(
+        fmt::format("{}/ssdtest", tempDirectory_->path),
+        0, // shardId
+        kSsdSize / SsdFile::kRegionSize,
+        kSsdSize); // checkpointInternalBytes
+  };
+  ssdFile_ = makeSsdFile();
+  StringIdLease changedFile(fileIds(), "changedFileInStorage");
+  StringIdLease unknownFile(fileIds(), "unknownFileInStorage");
+  // Not opened after restart, so that its identity is not known then.
+  std::optional<StringIdLease> pendingFile;
+  pendingFile.emplace(fileIds(), "pendingFileInStorage");
+  setFileIdentity(fileName_.id(), {1 << 20, 1, "etag1"});
+  setFileIdentity(changedFile.id(), {1 << 20, 1, ""});
+  setFileIdentity(pendingFile->id(), {1 << 20, 1, ""});
+  for (auto fileId :
+       {fileName_.id(),
+        changedFile.id(),
+        unknownFile.id(),
+        pendingFile->id()}) {
+    auto pins = makePins(fileId, 0, 4096, 4096, 20 * 4096);
+    ssdFile_->write(pins);
+  }
+  ssdFile_->checkpoint(true);
+  cache_->clear();
+
+  // Restarts from the checkpoint after 'changedFile' has been rewritten with
+  // the same size. Releasing all leases of 'pendingFile' gives it a new id
+  // without identity on restore.
+  pendingFile.reset();
+  ssdFile_.reset();
+  ssdFile_ = makeSsdFile();
+  EXPECT_EQ(80, stats().entriesRestored);
+  StringIdLease restoredPendingFile(fileIds(), "pendingFileInStorage");
+  EXPECT_FALSE(fileIdentity(restoredPendingFile.id()).has_value());
+  setFileIdentity(changedFile.id(), {1 << 20, 2, ""});
+  EXPECT_FALSE(ssdFile_->find(RawFileCacheKey{fileName_.id(), 0}).empty());
+  EXPECT_FALSE(ssdFile_->find(RawFileCacheKey{unknownFile.id(), 0}).empty());
+  EXPECT_TRUE(ssdFile_->find(RawFileCacheKey{changedFile.id(), 0}).empty());
+  EXPECT_TRUE(
+      ssdFile_->find(RawFileCacheKey{changedFile.id(), 4096}).empty());
+  EXPECT_EQ(20, stats().entriesInvalidated);
+  EXPECT_EQ(60, stats().entriesCached);
+
+  auto pins = makePins(fileName_.id(), 0, 4096, 4096, 20 * 4096);
+  readAndCheckPins(pins);
+  pins.clear();
+
+  // All entries are in one region and come in the order of writing.
+  const auto keys = ssdFile_->hottestEntries(8 * 4096);
+  ASSERT_EQ(8, keys.size());
+  for (const auto& key : keys) {
+    EXPECT_EQ(fileName_.id(), key.fileNum.id());
+  }
+
+  // The entries of 'pendingFile' are left out until its identity is known.
+  EXPECT_EQ(40, ssdFile_->hottestEntries(kSsdSize).size());
+  setFileIdentity(restoredPendingFile.id(), {1 << 20, 1, ""});
+  EXPECT_EQ(60, ssdFile_->hottestEntries(kSsdSize).size());
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
@@ -21,6 +21,7 @@ SpillConfig::SpillConfig(
     const std::string& _filePath,
     uint64_t _maxFileSize,
     uint64_t _writeBufferSize,
+    uint64_t _readAheadBytes,
     uint64_t _minSpillRunSize,
     folly::Executor* _executor,
     int32_t _minSpillableReservationPct,
@@ -37,6 +38,7 @@ SpillConfig::SpillConfig(
           _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
                             : _maxFileSize),
       writeBufferSize(_writeBufferSize),
+      readAheadBytes(_readAheadBytes),
       minSpillRunSize(_minSpillRunSize),
       executor(_executor),
       minSpillableReservationPct(_minSpillableReservationPct),
@@ -27,6 +27,7 @@ struct SpillConfig {
       const std::string& _filePath,
       uint64_t _maxFileSize,
       uint64_t _writeBufferSize,
+      uint64_t _readAheadBytes,
       uint64_t _minSpillRunSize,
       folly::Executor* _executor,
       int32_t _minSpillableReservationPct,
@@ -61,6 +62,14 @@ struct SpillConfig {
   /// storage system for io efficiency.
   uint64_t writeBufferSize;
 
+  /// The memory budget (bytes) for reading ahead the spill files of a sorted
+  /// merge. It is divided among the merged spill files. Each one reads its
+  /// next buffer asynchronously while the current one is consumed, so that a
+  /// merge of many sorted runs does not wait on disk for every buffer. If it
+  /// is zero or too small for the number of merged files, the spill files are
+  /// read synchronously.
+  uint64_t readAheadBytes;
+
   /// The min spill run size (bytes) limit used to select partitions for
   /// spilling. The spiller tries to spill a previously spilled partitions if
   /// its data size exceeds this limit, otherwise it spills the partition with
@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -24,6 +25,7 @@
 
 #include <fcntl.h>
 #include <folly/portability/SysUio.h>
+#include <sys/stat.h>
 
 namespace facebook::velox {
 
@@ -112,6 +114,15 @@ LocalReadFile::LocalReadFile(std::string_view path) : path_(path) {
       path,
       folly::errnoStr(errno));
   size_ = rc;
+  struct stat fileStat;
+  if (fstat(fd_, &fileStat) == 0) {
+#ifdef __APPLE__
+    const auto& mtime = fileStat.st_mtimespec;
+#else
+    const auto& mtime = fileStat.st_mtim;
+#endif
+    modificationTime_ = mtime.tv_sec * 1'000'000'000L + mtime.tv_nsec;
+  }
 }
 
 LocalReadFile::LocalReadFile(int32_t fd) : fd_(fd) {}
@@ -198,6 +209,78 @@ uint64_t LocalReadFile::preadv(
   return totalBytesRead;
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto* ioUring = IoUring::instance();
+  if (ioUring == nullptr) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  // Skipped ranges are read into a buffer shared by all reads. Its content is
+  // never used.
+  static std::vector<char> droppedBytes(16 * 1024);
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  std::vector<struct iovec> iovecs;
+  uint64_t iovecsBytes = 0;
+  auto submit = [&]() {
+    reads.push_back(ioUring->preadv(fd_, offset, std::move(iovecs)));
+    iovecs.clear();
+    offset += iovecsBytes;
+    iovecsBytes = 0;
+  };
+  auto addIovec = [&](char* data, size_t size) {
+    if (iovecs.size() >= IOV_MAX) {
+      submit();
+    }
+    iovecs.push_back({data, size});
+    iovecsBytes += size;
+  };
+
+  try {
+    for (auto& range : buffers) {
+      if (!range.data()) {
+        auto skipSize = range.size();
+        while (skipSize) {
+          auto bytes = std::min<size_t>(droppedBytes.size(), skipSize);
+          addIovec(droppedBytes.data(), bytes);
+          skipSize -= bytes;
+        }
+      } else {
+        addIovec(range.data(), range.size());
+      }
+    }
+    if (!iovecs.empty()) {
+      submit();
+    }
+  } catch (const std::exception&) {
+    // The reads submitted so far write into 'buffers', which the caller may
+    // free after the error.
+    folly::collectAll(std::move(reads)).wait();
+    throw;
+  }
+
+  if (reads.empty()) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+  if (reads.size() == 1) {
+    return std::move(reads[0]);
+  }
+  // Waits for all reads so that no IO into 'buffers' is pending when the
+  // future is complete, also on error.
+  return folly::collectAll(std::move(reads))
+      .deferValue([](std::vector<folly::Try<uint64_t>>&& results) {
+        uint64_t totalBytesRead = 0;
+        for (auto& result : results) {
+          totalBytesRead += result.value();
+        }
+        return totalBytesRead;
+      });
+}
+
+bool LocalReadFile::hasPreadvAsync() const {
+  return IoUring::instance() != nullptr;
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
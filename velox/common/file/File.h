@@ -108,6 +108,19 @@ class ReadFile {
   // Number of bytes in the file.
   virtual uint64_t size() const = 0;
 
+  // Modification time of the file in nanoseconds since the epoch, or 0 if not
+  // known. Together with size() and etag(), tells apart versions of a file
+  // with the same name, e.g. for invalidating cached data.
+  virtual int64_t modificationTime() const {
+    return 0;
+  }
+
+  // Entity tag or generation of an object in an object store, or empty if not
+  // known.
+  virtual std::string etag() const {
+    return "";
+  }
+
   // An estimate for the total amount of memory *this uses.
   virtual uint64_t memoryUsage() const = 0;
 
@@ -236,10 +249,21 @@ class LocalReadFile final : public ReadFile {
 
   uint64_t size() const final;
 
+  int64_t modificationTime() const final {
+    return modificationTime_;
+  }
+
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  // Reads with io_uring if available. Otherwise reads synchronously.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override;
+
+  bool hasPreadvAsync() const override;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -264,6 +288,7 @@ class LocalReadFile final : public ReadFile {
   std::string path_;
   int32_t fd_;
   long size_;
+  int64_t modificationTime_{0};
 };
 
 class LocalWriteFile final : public WriteFile {
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <folly/portability/SysUio.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+#ifdef VELOX_ENABLE_IO_URING
+#include <liburing.h>
+#endif
+
+namespace facebook::velox {
+
+struct IoUring::Request {
+  bool isWrite;
+  std::vector<iovec> iovecs;
+  uint64_t startUs;
+  folly::Promise<uint64_t> promise;
+};
+
+namespace {
+// The ring returned by instance() once it is created.
+std::atomic<IoUring*> createdInstance{nullptr};
+
+#ifdef VELOX_ENABLE_IO_URING
+inline io_uring* asRing(const std::unique_ptr<char[]>& ring) {
+  return reinterpret_cast<io_uring*>(ring.get());
+}
+#endif
+} // namespace
+
+IoUring::IoUring(int32_t queueDepth) : queueDepth_(queueDepth) {
+  VELOX_CHECK_GT(queueDepth_, 0);
+#ifdef VELOX_ENABLE_IO_URING
+  ring_ = std::make_unique<char[]>(sizeof(io_uring));
+  const auto rc = io_uring_queue_init(queueDepth_, asRing(ring_), 0);
+  VELOX_CHECK_EQ(
+      rc, 0, "io_uring_queue_init failed: {}", folly::errnoStr(-rc));
+  completionThread_ = std::thread([this]() { completionLoop(); });
+#else
+  VELOX_FAIL("Velox is built without io_uring support");
+#endif
+}
+
+IoUring::~IoUring() {
+#ifdef VELOX_ENABLE_IO_URING
+  {
+    std::unique_lock<std::mutex> l(submitMutex_);
+    // Waits for the requests in flight so that no promise is left behind.
+    notFull_.wait(l, [&]() { return inFlight_.empty(); });
+    stopping_ = true;
+    // A nop with null user data wakes up and stops the completion thread.
+    auto* sqe = io_uring_get_sqe(asRing(ring_));
+    VELOX_CHECK_NOT_NULL(sqe);
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    io_uring_submit(asRing(ring_));
+  }
+  completionThread_.join();
+  io_uring_queue_exit(asRing(ring_));
+#endif
+}
+
+// static
+IoUring* IoUring::instance() {
+#ifdef VELOX_ENABLE_IO_URING
+  static IoUring* instance = []() -> IoUring* {
+    try {
+      // Leaked on purpose so that IO may complete during static destruction.
+      auto* ring = new IoUring(kDefaultQueueDepth);
+      createdInstance = ring;
+      return ring;
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring is not available, using synchronous IO: "
+                   << e.what();
+      return nullptr;
+    }
+  }();
+  return instance;
+#else
+  return nullptr;
+#endif
+}
+
+// static
+IoUring* IoUring::instanceIfCreated() {
+  return createdInstance;
+}
+
+// static
+int32_t IoUring::latencyBucket(uint64_t micros) {
+  const int32_t bucket = micros == 0 ? 0 : 64 - __builtin_clzll(micros);
+  return std::min(bucket, kNumLatencyBuckets - 1);
+}
+
+folly::SemiFuture<uint64_t>
+IoUring::preadv(int32_t fd, uint64_t offset, std::vector<iovec> iovecs) {
+  return submit(false, fd, offset, std::move(iovecs));
+}
+
+folly::SemiFuture<uint64_t>
+IoUring::pwritev(int32_t fd, uint64_t offset, std::vector<iovec> iovecs) {
+  return submit(true, fd, offset, std::move(iovecs));
+}
+
+folly::SemiFuture<uint64_t> IoUring::submit(
+    bool isWrite,
+    int32_t fd,
+    uint64_t offset,
+    std::vector<iovec> iovecs) {
+  VELOX_CHECK_LE(iovecs.size(), IOV_MAX);
+  auto request = std::make_unique<Request>();
+  request->isWrite = isWrite;
+  request->iovecs = std::move(iovecs);
+  auto future = request->promise.getSemiFuture();
+#ifdef VELOX_ENABLE_IO_URING
+  int32_t queueDepth;
+  {
+    std::unique_lock<std::mutex> l(submitMutex_);
+    VELOX_CHECK(!stopping_);
+    notFull_.wait(
+        l, [&]() { return failed_ || inFlight_.size() < (size_t)queueDepth_; });
+    VELOX_CHECK(!failed_, "io_uring completion thread has failed");
+    auto* sqe = io_uring_get_sqe(asRing(ring_));
+    VELOX_CHECK_NOT_NULL(sqe, "io_uring submission queue is full");
+    if (isWrite) {
+      io_uring_prep_writev(
+          sqe, fd, request->iovecs.data(), request->iovecs.size(), offset);
+    } else {
+      io_uring_prep_readv(
+          sqe, fd, request->iovecs.data(), request->iovecs.size(), offset);
+    }
+    request->startUs = getCurrentTimeMicro();
+    io_uring_sqe_set_data(sqe, request.get());
+    const auto rc = io_uring_submit(asRing(ring_));
+    if (rc < 0) {
+      // The sqe stays in the submission queue and goes out with the next
+      // submit. It must then not reference 'request', which is freed here.
+      // A nop without user data is ignored by the completion thread.
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      VELOX_FAIL("io_uring_submit failed: {}", folly::errnoStr(-rc));
+    }
+    // The completion thread owns the request from here on.
+    inFlight_.insert(request.release());
+    queueDepth = inFlight_.size();
+  }
+  std::lock_guard<std::mutex> l(statsMutex_);
+  stats_.queueDepth = queueDepth;
+  stats_.maxQueueDepth = std::max(stats_.maxQueueDepth, queueDepth);
+#else
+  VELOX_UNREACHABLE();
+#endif
+  return future;
+}
+
+void IoUring::completionLoop() {
+#ifdef VELOX_ENABLE_IO_URING
+  for (;;) {
+    io_uring_cqe* cqe;
+    const auto rc = io_uring_wait_cqe(asRing(ring_), &cqe);
+    if (rc == -EINTR) {
+      continue;
+    }
+    if (rc != 0) {
+      // This runs on a bare thread, so an exception would terminate the
+      // process.
+      const auto error =
+          fmt::format("io_uring_wait_cqe failed: {}", folly::errnoStr(-rc));
+      LOG(ERROR) << error;
+      failInFlight(error);
+      return;
+    }
+    auto* request = reinterpret_cast<Request*>(io_uring_cqe_get_data(cqe));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(asRing(ring_), cqe);
+    if (request == nullptr) {
+      // Either the nop that stops this thread or one left by a failed
+      // submit.
+      std::lock_guard<std::mutex> l(submitMutex_);
+      if (stopping_) {
+        return;
+      }
+      continue;
+    }
+    complete(std::unique_ptr<Request>(request), result);
+  }
+#endif
+}
+
+void IoUring::failInFlight(const std::string& error) {
+  std::unordered_set<Request*> requests;
+  {
+    std::lock_guard<std::mutex> l(submitMutex_);
+    failed_ = true;
+    requests = std::move(inFlight_);
+    inFlight_.clear();
+  }
+  notFull_.notify_all();
+  {
+    std::lock_guard<std::mutex> l(statsMutex_);
+    stats_.queueDepth = 0;
+    stats_.numErrors += requests.size();
+  }
+  for (auto* request : requests) {
+    std::unique_ptr<Request>(request)->promise.setException(
+        std::runtime_error(error));
+  }
+}
+
+void IoUring::complete(std::unique_ptr<Request> request, int32_t result) {
+  const auto latencyUs = getCurrentTimeMicro() - request->startUs;
+  int32_t queueDepth;
+  {
+    std::lock_guard<std::mutex> l(submitMutex_);
+    inFlight_.erase(request.get());
+    queueDepth = inFlight_.size();
+  }
+  notFull_.notify_all();
+  {
+    std::lock_guard<std::mutex> l(statsMutex_);
+    stats_.queueDepth = queueDepth;
+    ++stats_.latencyHistogram[latencyBucket(latencyUs)];
+    if (result < 0) {
+      ++stats_.numErrors;
+    } else if (request->isWrite) {
+      ++stats_.numWrites;
+      stats_.bytesWritten += result;
+    } else {
+      ++stats_.numReads;
+      stats_.bytesRead += result;
+    }
+  }
+  if (result < 0) {
+    request->promise.setException(std::runtime_error(fmt::format(
+        "io_uring {} failed: {}",
+        request->isWrite ? "pwritev" : "preadv",
+        folly::errnoStr(-result))));
+    return;
+  }
+  request->promise.setValue(result);
+}
+
+IoUring::Stats IoUring::stats() const {
+  std::lock_guard<std::mutex> l(statsMutex_);
+  return stats_;
+}
+
+std::string IoUring::Stats::toString() const {
+  std::string histogram;
+  for (auto i = 0; i < kNumLatencyBuckets; ++i) {
+    if (latencyHistogram[i] != 0) {
+      histogram += i == kNumLatencyBuckets - 1
+          ? fmt::format(" >={}us:{}", 1UL << (i - 1), latencyHistogram[i])
+          : fmt::format(" <{}us:{}", 1UL << i, latencyHistogram[i]);
+    }
+  }
+  return fmt::format(
+      "io_uring reads: {} ({} bytes) writes: {} ({} bytes) errors: {} "
+      "queue depth: {} max: {} latency:{}",
+      numReads,
+      bytesRead,
+      numWrites,
+      bytesWritten,
+      numErrors,
+      queueDepth,
+      maxQueueDepth,
+      histogram);
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <folly/futures/Future.h>
+#include <sys/uio.h>
+
+namespace facebook::velox {
+
+/// Asynchronous positional IO on local files with io_uring. Requests are
+/// queued on a submission ring and completed by a dedicated thread that
+/// fulfills the returned futures, so that the thread issuing the IO is free
+/// to do other work or to issue more IO until it needs the data.
+///
+/// io_uring is used only if Velox is built with VELOX_ENABLE_IO_URING and the
+/// kernel supports it. Otherwise instance() returns nullptr and callers do
+/// synchronous IO.
+class IoUring {
+ public:
+  /// Latency buckets are powers of 2 microseconds, i.e. bucket i counts the
+  /// requests that took [2^(i-1), 2^i) us.
+  static constexpr int32_t kNumLatencyBuckets = 24;
+
+  static constexpr int32_t kDefaultQueueDepth = 256;
+
+  struct Stats {
+    uint64_t numReads{0};
+    uint64_t numWrites{0};
+    uint64_t bytesRead{0};
+    uint64_t bytesWritten{0};
+    uint64_t numErrors{0};
+    /// Number of requests submitted and not yet completed.
+    int32_t queueDepth{0};
+    /// Highest value of 'queueDepth' since creation.
+    int32_t maxQueueDepth{0};
+    /// Histogram of the request latencies from submission to completion.
+    std::array<uint64_t, kNumLatencyBuckets> latencyHistogram{};
+
+    std::string toString() const;
+  };
+
+  /// Creates a ring with 'queueDepth' entries. Throws if io_uring is not
+  /// available.
+  explicit IoUring(int32_t queueDepth = kDefaultQueueDepth);
+
+  ~IoUring();
+
+  /// Returns the process-wide ring or nullptr if io_uring is not available.
+  static IoUring* instance();
+
+  /// Returns the process-wide ring if instance() has created it, otherwise
+  /// nullptr. Does not create the ring.
+  static IoUring* instanceIfCreated();
+
+  /// Reads from 'fd' at 'offset' into 'iovecs'. The memory referenced by
+  /// 'iovecs' must stay live until the returned future is complete. The
+  /// future has the number of bytes read, which may be less than requested
+  /// at end of file. 'iovecs' must not be longer than IOV_MAX.
+  folly::SemiFuture<uint64_t>
+  preadv(int32_t fd, uint64_t offset, std::vector<iovec> iovecs);
+
+  /// Writes 'iovecs' to 'fd' at 'offset'. Same rules as preadv().
+  folly::SemiFuture<uint64_t>
+  pwritev(int32_t fd, uint64_t offset, std::vector<iovec> iovecs);
+
+  Stats stats() const;
+
+  /// Returns the latency bucket for 'micros'.
+  static int32_t latencyBucket(uint64_t micros);
+
+ private:
+  struct Request;
+
+  folly::SemiFuture<uint64_t>
+  submit(bool isWrite, int32_t fd, uint64_t offset, std::vector<iovec> iovecs);
+
+  // Loop of 'completionThread_'. Reaps completions and fulfills the promises
+  // of their requests. If the ring fails, fails the promises of the requests
+  // in flight and returns.
+  void completionLoop();
+
+  // Fails the promises of the requests in flight with 'error' and makes
+  // later submissions fail.
+  void failInFlight(const std::string& error);
+
+  void complete(std::unique_ptr<Request> request, int32_t result);
+
+  const int32_t queueDepth_;
+
+  // The io_uring struct of liburing. Opaque here so that users of this
+  // header do not depend on liburing.
+  std::unique_ptr<char[]> ring_;
+
+  // Serializes access to the submission queue. Submitters wait on
+  // 'notFull_' while 'queueDepth_' requests are in flight.
+  std::mutex submitMutex_;
+  std::condition_variable notFull_;
+  // The submitted requests that are not completed. Owned by the completion
+  // thread.
+  std::unordered_set<Request*> inFlight_;
+  bool stopping_{false};
+  // Set if the completion thread failed. No more requests are accepted.
+  bool failed_{false};
+
+  std::thread completionThread_;
+
+  mutable std::mutex statsMutex_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/ParallelRangeReader.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fmt/format.h>
+#include <folly/executors/QueuedImmediateExecutor.h>
+#include <folly/futures/Future.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+namespace facebook::velox {
+
+namespace {
+// Copies the bytes of 'buffers' from 'data'. Ranges without data are gaps that
+// are skipped.
+void copyToBuffers(
+    const char* data,
+    const std::vector<folly::Range<char*>>& buffers) {
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      ::memcpy(range.data(), data, range.size());
+    }
+    data += range.size();
+  }
+}
+
+uint64_t totalLength(const std::vector<folly::Range<char*>>& buffers) {
+  uint64_t length = 0;
+  for (const auto& range : buffers) {
+    length += range.size();
+  }
+  return length;
+}
+} // namespace
+
+// A part of a hedged read. There may be two requests for the part. The first
+// to succeed copies its data to 'destination' and fulfills 'promise'.
+struct ParallelRangeReader::HedgedPart {
+  ReadFunction read;
+  uint64_t offset;
+  uint64_t length;
+  char* destination;
+
+  std::mutex mutex;
+  int32_t numPending{0};
+  bool done{false};
+  folly::Promise<folly::Unit> promise;
+
+  // Returns true if a request may be started.
+  bool addAttempt() {
+    std::lock_guard<std::mutex> l(mutex);
+    if (done) {
+      return false;
+    }
+    ++numPending;
+    return true;
+  }
+
+  // Completes the part with 'data' if no other request did. Returns true if
+  // 'data' was used.
+  bool succeed(const char* data) {
+    std::lock_guard<std::mutex> l(mutex);
+    --numPending;
+    if (done) {
+      return false;
+    }
+    done = true;
+    ::memcpy(destination, data, length);
+    promise.setValue();
+    return true;
+  }
+
+  // Fails the part with 'error' unless another request is pending or has
+  // completed the part.
+  void fail(folly::exception_wrapper error) {
+    std::lock_guard<std::mutex> l(mutex);
+    --numPending;
+    if (done || numPending > 0) {
+      return;
+    }
+    done = true;
+    promise.setException(std::move(error));
+  }
+};
+
+ParallelRangeReader::ParallelRangeReader(
+    folly::Executor* executor,
+    Options options)
+    : executor_(executor), options_(options) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK_GE(options_.hedgePercentile, 0);
+  VELOX_CHECK_LT(options_.hedgePercentile, 100);
+  if (options_.hedgePercentile > 0) {
+    timekeeper_ = std::make_unique<folly::ThreadWheelTimekeeper>();
+  }
+}
+
+ParallelRangeReader::~ParallelRangeReader() {
+  // Cancels the pending hedges before the state they use is destroyed.
+  timekeeper_.reset();
+}
+
+uint64_t ParallelRangeReader::preadv(
+    const ReadFunction& read,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) {
+  const auto length = totalLength(buffers);
+  if (isParallel(length)) {
+    return preadvAsync(read, offset, buffers).get();
+  }
+  if (buffers.size() == 1 && buffers[0].data() != nullptr) {
+    read(offset, length, buffers[0].data());
+    return length;
+  }
+  std::string scratch(length, 0);
+  read(offset, length, scratch.data());
+  copyToBuffers(scratch.data(), buffers);
+  return length;
+}
+
+folly::SemiFuture<uint64_t> ParallelRangeReader::preadvAsync(
+    ReadFunction read,
+    uint64_t offset,
+    std::vector<folly::Range<char*>> buffers) {
+  const auto length = totalLength(buffers);
+  if (length == 0) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+  // A single range is read in place. Ranges with gaps are read in one piece
+  // into 'scratch' and copied.
+  std::shared_ptr<std::string> scratch;
+  char* destination;
+  if (buffers.size() == 1 && buffers[0].data() != nullptr) {
+    destination = buffers[0].data();
+  } else {
+    scratch = std::make_shared<std::string>(length, 0);
+    destination = scratch->data();
+  }
+  const auto parts = numParts(length);
+  std::vector<folly::SemiFuture<folly::Unit>> partFutures;
+  partFutures.reserve(parts);
+  for (auto i = 0; i < parts; ++i) {
+    const uint64_t begin = length * i / parts;
+    const uint64_t end = length * (i + 1) / parts;
+    partFutures.push_back(
+        readPart(read, offset + begin, end - begin, destination + begin));
+  }
+  return folly::collectAll(std::move(partFutures))
+      .deferValue([scratch = std::move(scratch),
+                   buffers = std::move(buffers),
+                   length](std::vector<folly::Try<folly::Unit>>&& results) {
+        // All parts are complete, so none writes to the buffers any more.
+        for (auto& result : results) {
+          result.throwUnlessValue();
+        }
+        if (scratch != nullptr) {
+          copyToBuffers(scratch->data(), buffers);
+        }
+        return length;
+      });
+}
+
+folly::SemiFuture<folly::Unit> ParallelRangeReader::readPart(
+    const ReadFunction& read,
+    uint64_t offset,
+    uint64_t length,
+    char* destination) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numParts;
+  }
+  if (timekeeper_ == nullptr) {
+    return folly::via(
+               executor_,
+               [this, read, offset, length, destination]() {
+                 const auto startMs = getCurrentTimeMs();
+                 try {
+                   read(offset, length, destination);
+                 } catch (const std::exception&) {
+                   recordError();
+                   throw;
+                 }
+                 recordLatency(getCurrentTimeMs() - startMs);
+               })
+        .semi();
+  }
+
+  auto part = std::make_shared<HedgedPart>();
+  part->read = read;
+  part->offset = offset;
+  part->length = length;
+  part->destination = destination;
+  auto future = part->promise.getSemiFuture();
+  startAttempt(part, false);
+  if (const auto delayMs = hedgeDelayMs()) {
+    // Runs on the timer thread. Does nothing if the part is done by then or
+    // if the timer is cancelled.
+    timekeeper_->after(std::chrono::milliseconds(*delayMs))
+        .via(&folly::QueuedImmediateExecutor::instance())
+        .thenValue([this, part](auto&&) { startAttempt(part, true); });
+  }
+  return future;
+}
+
+void ParallelRangeReader::startAttempt(
+    std::shared_ptr<HedgedPart> part,
+    bool isHedge) {
+  if (!part->addAttempt()) {
+    return;
+  }
+  if (isHedge) {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numHedges;
+  }
+  executor_->add([this, part = std::move(part), isHedge]() {
+    // Each request reads into its own buffer since the other request for the
+    // same part may be in progress.
+    auto buffer = std::make_unique<char[]>(part->length);
+    const auto startMs = getCurrentTimeMs();
+    try {
+      part->read(part->offset, part->length, buffer.get());
+    } catch (const std::exception& e) {
+      recordError();
+      part->fail(folly::exception_wrapper(std::current_exception(), e));
+      return;
+    }
+    recordLatency(getCurrentTimeMs() - startMs);
+    if (part->succeed(buffer.get()) && isHedge) {
+      std::lock_guard<std::mutex> l(mutex_);
+      ++stats_.numHedgeWins;
+    }
+  });
+}
+
+void ParallelRangeReader::recordLatency(uint64_t latencyMs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (latencies_.size() < kNumLatencySamples) {
+    latencies_.push_back(latencyMs);
+  } else {
+    latencies_[numLatencies_ % kNumLatencySamples] = latencyMs;
+  }
+  ++numLatencies_;
+  if (options_.hedgePercentile == 0 || numLatencies_ < kMinLatencySamples ||
+      (hedgeDelayMs_.has_value() &&
+       numLatencies_ % kHedgeDelayUpdateInterval != 0)) {
+    return;
+  }
+  auto sorted = latencies_;
+  const auto index = std::min<size_t>(
+      sorted.size() - 1, sorted.size() * options_.hedgePercentile / 100);
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  hedgeDelayMs_ = std::max(options_.minHedgeDelayMs, sorted[index]);
+}
+
+void ParallelRangeReader::recordError() {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stats_.numErrors;
+}
+
+std::optional<uint64_t> ParallelRangeReader::hedgeDelayMs() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return hedgeDelayMs_;
+}
+
+ParallelRangeReader::Stats ParallelRangeReader::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return stats_;
+}
+
+std::string ParallelRangeReader::Stats::toString() const {
+  return fmt::format(
+      "parts: {} hedges: {} hedge wins: {} errors: {}",
+      numParts,
+      numHedges,
+      numHedgeWins,
+      numErrors);
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <folly/Executor.h>
+#include <folly/Range.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/ThreadWheelTimekeeper.h>
+
+namespace facebook::velox {
+
+/// Reads byte ranges of remote files, e.g. object store objects, with
+/// requests on an executor. A range of at least twice 'partSize' bytes is
+/// split into parts of about 'partSize' bytes that are read in parallel, so
+/// that one slow request only delays its part. If hedging is on, a part that
+/// is not read after the 'hedgePercentile' latency of recent parts is
+/// requested again and the first result to arrive is used. One reader is
+/// shared by the files of a file system so that the latencies reflect the
+/// store.
+class ParallelRangeReader {
+ public:
+  struct Options {
+    /// Size of the parts of a split range. 0 means that ranges are not split.
+    uint64_t partSize{0};
+
+    /// Percentile of recent part latencies after which a part is requested
+    /// again, e.g. 95. 0 means no hedging.
+    double hedgePercentile{0};
+
+    /// Minimum time before requesting a part again.
+    uint64_t minHedgeDelayMs{10};
+  };
+
+  struct Stats {
+    uint64_t numParts{0};
+    /// Number of parts requested twice.
+    uint64_t numHedges{0};
+    /// Number of parts where the second request was first.
+    uint64_t numHedgeWins{0};
+    uint64_t numErrors{0};
+
+    std::string toString() const;
+  };
+
+  /// Reads 'length' bytes at 'offset' of a file into 'buffer'. Throws on
+  /// error. Must be thread safe.
+  using ReadFunction =
+      std::function<void(uint64_t offset, uint64_t length, char* buffer)>;
+
+  /// Makes a reader that runs the reads on 'executor'. 'executor' must
+  /// outlive 'this'.
+  ParallelRangeReader(folly::Executor* executor, Options options);
+
+  /// The reads started by 'this' must be complete, e.g. by joining
+  /// 'executor', before destruction.
+  ~ParallelRangeReader();
+
+  /// Reads into 'buffers' with 'read' starting at 'offset' with the
+  /// semantics of ReadFile::preadv(). Returns the number of bytes read,
+  /// including the gaps.
+  uint64_t preadv(
+      const ReadFunction& read,
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+  /// Asynchronous preadv(). The memory of 'buffers' and the state used by
+  /// 'read' must stay live until the future is complete.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      ReadFunction read,
+      uint64_t offset,
+      std::vector<folly::Range<char*>> buffers);
+
+  /// Returns true if reading 'length' bytes is split or hedged.
+  bool isParallel(uint64_t length) const {
+    return numParts(length) > 1 || options_.hedgePercentile > 0;
+  }
+
+  Stats stats() const;
+
+  /// Returns the time after which a part is requested again or
+  /// std::nullopt if there are not enough latency samples.
+  std::optional<uint64_t> hedgeDelayMs() const;
+
+ private:
+  // Number of latencies the hedge delay is computed from.
+  static constexpr int32_t kNumLatencySamples = 1024;
+  // Minimum number of latencies for hedging.
+  static constexpr int32_t kMinLatencySamples = 32;
+  // The hedge delay is recomputed after this many new latencies.
+  static constexpr int32_t kHedgeDelayUpdateInterval = 64;
+
+  struct HedgedPart;
+
+  int32_t numParts(uint64_t length) const {
+    if (options_.partSize == 0 || length < 2 * options_.partSize) {
+      return 1;
+    }
+    return length / options_.partSize;
+  }
+
+  // Reads 'length' bytes at 'offset' into 'destination' on 'executor_',
+  // hedging if configured.
+  folly::SemiFuture<folly::Unit> readPart(
+      const ReadFunction& read,
+      uint64_t offset,
+      uint64_t length,
+      char* destination);
+
+  // Runs a request for 'part' on 'executor_'.
+  void startAttempt(std::shared_ptr<HedgedPart> part, bool isHedge);
+
+  void recordLatency(uint64_t latencyMs);
+
+  void recordError();
+
+  folly::Executor* const executor_;
+  const Options options_;
+
+  // Fires the hedges. Set if hedging is on.
+  std::unique_ptr<folly::ThreadWheelTimekeeper> timekeeper_;
+
+  mutable std::mutex mutex_;
+  // Ring buffer of the latencies of the last parts.
+  std::vector<uint64_t> latencies_;
+  uint64_t numLatencies_{0};
+  std::optional<uint64_t> hedgeDelayMs_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox
@@ -15,9 +15,11 @@
  */
 
 #include <fcntl.h>
+#include <folly/portability/SysUio.h>
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -126,6 +128,51 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+TEST(LocalFile, preadvAsync) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  LocalReadFile readFile(filename);
+  // The read is asynchronous if io_uring is available and the result is the
+  // same either way.
+  EXPECT_EQ(IoUring::instance() != nullptr, readFile.hasPreadvAsync());
+  char head[12];
+  char tail[7];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(uint64_t)(15 + kOneMB - sizeof(head) - sizeof(tail))),
+      folly::Range<char*>(tail, sizeof(tail))};
+  ASSERT_EQ(15 + kOneMB, readFile.preadvAsync(0, buffers).get());
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  // More ranges than fit in one preadv.
+  std::vector<char> data(3 * IOV_MAX);
+  buffers.clear();
+  for (auto i = 0; i < data.size(); ++i) {
+    buffers.push_back(folly::Range<char*>(&data[i], 1));
+  }
+  ASSERT_EQ(data.size(), readFile.preadvAsync(10, buffers).get());
+  EXPECT_EQ(
+      std::string(data.data(), data.size()), std::string(data.size(), 'c'));
+}
+
+TEST(LocalFile, ioUringLatencyBucket) {
+  EXPECT_EQ(0, IoUring::latencyBucket(0));
+  EXPECT_EQ(1, IoUring::latencyBucket(1));
+  EXPECT_EQ(2, IoUring::latencyBucket(3));
+  EXPECT_EQ(11, IoUring::latencyBucket(1'500));
+  EXPECT_EQ(
+      IoUring::kNumLatencyBuckets - 1,
+      IoUring::latencyBucket(std::numeric_limits<uint64_t>::max()));
+}
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/ParallelRangeReader.h"
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/time/Timer.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace facebook::velox;
+
+namespace {
+
+char byteAt(uint64_t offset) {
+  return static_cast<char>(offset % 251);
+}
+
+class ParallelRangeReaderTest : public testing::Test {
+ protected:
+  void TearDown() override {
+    // The reads must be complete before the reader is destroyed.
+    executor_->join();
+    reader_.reset();
+  }
+
+  void makeReader(
+      uint64_t partSize,
+      double hedgePercentile = 0,
+      uint64_t minHedgeDelayMs = 10) {
+    ParallelRangeReader::Options options;
+    options.partSize = partSize;
+    options.hedgePercentile = hedgePercentile;
+    options.minHedgeDelayMs = minHedgeDelayMs;
+    reader_ = std::make_unique<ParallelRangeReader>(executor_.get(), options);
+  }
+
+  // Returns a read function that fills the buffer with byteAt() of the
+  // offsets and records the requests. 'slowOffset' is the offset of a part
+  // whose first request takes 'slowMs'.
+  ParallelRangeReader::ReadFunction makeRead(
+      uint64_t slowOffset = ~0UL,
+      uint64_t slowMs = 0) {
+    return [this, slowOffset, slowMs](
+               uint64_t offset, uint64_t length, char* buffer) {
+      bool slow;
+      {
+        std::lock_guard<std::mutex> l(mutex_);
+        requests_.push_back({offset, length});
+        slow = offset == slowOffset && !slowDone_;
+        slowDone_ |= slow;
+      }
+      if (slow) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(slowMs));
+      }
+      for (uint64_t i = 0; i < length; ++i) {
+        buffer[i] = byteAt(offset + i);
+      }
+    };
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> requests() {
+    std::lock_guard<std::mutex> l(mutex_);
+    return requests_;
+  }
+
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(4)};
+  std::unique_ptr<ParallelRangeReader> reader_;
+
+  std::mutex mutex_;
+  std::vector<std::pair<uint64_t, uint64_t>> requests_;
+  bool slowDone_{false};
+};
+
+TEST_F(ParallelRangeReaderTest, noSplit) {
+  makeReader(0);
+  EXPECT_FALSE(reader_->isParallel(1 << 30));
+  std::string data(1000, 0);
+  const auto callerThread = std::this_thread::get_id();
+  std::thread::id readThread;
+  auto read = makeRead();
+  EXPECT_EQ(
+      1000,
+      reader_->preadv(
+          [&](uint64_t offset, uint64_t length, char* buffer) {
+            readThread = std::this_thread::get_id();
+            read(offset, length, buffer);
+          },
+          10,
+          {folly::Range<char*>(data.data(), data.size())}));
+  // A read that is neither split nor hedged runs on the caller thread.
+  EXPECT_EQ(callerThread, readThread);
+  for (auto i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(byteAt(10 + i), data[i]);
+  }
+  EXPECT_EQ(1, requests().size());
+}
+
+TEST_F(ParallelRangeReaderTest, split) {
+  makeReader(100);
+  EXPECT_FALSE(reader_->isParallel(199));
+  EXPECT_TRUE(reader_->isParallel(200));
+
+  // Two ranges with a gap. The spanning 1000 bytes are read in 10 parts.
+  std::string first(300, 0);
+  std::string second(600, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(first.data(), first.size()),
+      folly::Range<char*>(nullptr, 100),
+      folly::Range<char*>(second.data(), second.size())};
+  EXPECT_EQ(1000, reader_->preadv(makeRead(), 1000, buffers));
+  for (auto i = 0; i < first.size(); ++i) {
+    ASSERT_EQ(byteAt(1000 + i), first[i]);
+  }
+  for (auto i = 0; i < second.size(); ++i) {
+    ASSERT_EQ(byteAt(1400 + i), second[i]);
+  }
+  auto parts = requests();
+  ASSERT_EQ(10, parts.size());
+  std::sort(parts.begin(), parts.end());
+  uint64_t offset = 1000;
+  for (const auto& [partOffset, partLength] : parts) {
+    EXPECT_EQ(offset, partOffset);
+    EXPECT_EQ(100, partLength);
+    offset += partLength;
+  }
+  EXPECT_EQ(10, reader_->stats().numParts);
+
+  // A single range is read in place in parts of at least 'partSize'.
+  std::string data(250, 0);
+  EXPECT_EQ(
+      250,
+      reader_
+          ->preadvAsync(
+              makeRead(), 7, {folly::Range<char*>(data.data(), data.size())})
+          .get());
+  for (auto i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(byteAt(7 + i), data[i]);
+  }
+  EXPECT_EQ(12, reader_->stats().numParts);
+}
+
+TEST_F(ParallelRangeReaderTest, error) {
+  makeReader(100);
+  std::string data(1000, 0);
+  auto read = makeRead();
+  VELOX_ASSERT_THROW(
+      reader_->preadv(
+          [&](uint64_t offset, uint64_t length, char* buffer) {
+            VELOX_CHECK_NE(offset, 500, "Injected error");
+            read(offset, length, buffer);
+          },
+          0,
+          {folly::Range<char*>(data.data(), data.size())}),
+      "Injected error");
+  EXPECT_EQ(1, reader_->stats().numErrors);
+}
+
+TEST_F(ParallelRangeReaderTest, hedge) {
+  makeReader(0, 90, 1);
+  EXPECT_TRUE(reader_->isParallel(1));
+  std::string data(100, 0);
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(data.data(), data.size())};
+  // There is no hedging until there are enough latency samples.
+  EXPECT_FALSE(reader_->hedgeDelayMs().has_value());
+  for (auto i = 0; i < 100; ++i) {
+    reader_->preadv(makeRead(), i, buffers);
+  }
+  ASSERT_TRUE(reader_->hedgeDelayMs().has_value());
+  const auto statsBefore = reader_->stats();
+
+  // The first request for the part takes 3s. The hedge completes the read.
+  uint64_t micros = 0;
+  {
+    MicrosecondTimer timer(&micros);
+    EXPECT_EQ(100, reader_->preadv(makeRead(1000, 3'000), 1000, buffers));
+  }
+  EXPECT_LT(micros, 2'000'000);
+  for (auto i = 0; i < data.size(); ++i) {
+    ASSERT_EQ(byteAt(1000 + i), data[i]);
+  }
+  const auto stats = reader_->stats();
+  EXPECT_EQ(1, stats.numHedges - statsBefore.numHedges);
+  EXPECT_EQ(1, stats.numHedgeWins - statsBefore.numHedgeWins);
+  EXPECT_EQ(0, stats.numErrors);
+
+  // A hedged part fails only if both requests fail.
+  int32_t numFailures = 0;
+  VELOX_ASSERT_THROW(
+      reader_->preadv(
+          [&](uint64_t, uint64_t, char*) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            std::lock_guard<std::mutex> l(mutex_);
+            VELOX_FAIL("Injected error {}", ++numFailures);
+          },
+          0,
+          buffers),
+      "Injected error 2");
+}
+
+} // namespace
@@ -39,6 +39,7 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
+      reservationCacheBytes_(options.reservationCacheBytes),
       poolDestructionCb_([&](MemoryPool* pool) { dropPool(pool); }),
       defaultRoot_{std::make_shared<MemoryPoolImpl>(
           this,
@@ -54,7 +55,8 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
               .maxCapacity = kMaxMemory,
               .trackUsage = options.trackDefaultUsage,
               .checkUsageLeak = options.checkUsageLeak,
-              .debugEnabled = options.debugEnabled})} {
+              .debugEnabled = options.debugEnabled,
+              .reservationCacheBytes = options.reservationCacheBytes})} {
   VELOX_CHECK_NOT_NULL(allocator_);
   VELOX_CHECK_NOT_NULL(arbitrator_);
   VELOX_CHECK_EQ(
@@ -116,6 +118,7 @@ std::shared_ptr<MemoryPool> MemoryManager::addRootPool(
   options.trackUsage = true;
   options.checkUsageLeak = checkUsageLeak_;
   options.debugEnabled = debugEnabled_;
+  options.reservationCacheBytes = reservationCacheBytes_;
 
   folly::SharedMutex::WriteHolder guard{mutex_};
   if (pools_.find(poolName) != pools_.end()) {
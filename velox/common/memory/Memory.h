@@ -93,6 +93,11 @@ struct MemoryManagerOptions {
   /// testing purpose.
   bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
 
+  /// If not zero, the thread-safe leaf memory pools reserve memory from their
+  /// parents in chunks of this many bytes and cache the unused reservation up
+  /// to this size. See MemoryPool::Options::reservationCacheBytes.
+  uint64_t reservationCacheBytes{0};
+
   /// Specifies the backing memory allocator.
   MemoryAllocator* allocator{MemoryAllocator::getInstance()};
 
@@ -221,6 +226,7 @@ class MemoryManager {
   const uint16_t alignment_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  const uint64_t reservationCacheBytes_;
   // The destruction callback set for the allocated root memory pools which are
   // tracked by 'pools_'. It is invoked on the root pool destruction and removes
   // the pool from 'pools_'.
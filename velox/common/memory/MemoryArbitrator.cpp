@@ -196,10 +196,12 @@ MemoryReclaimer::reclaim(MemoryPool* pool, uint64_t targetBytes, Stats& stats) {
     return 0;
   }
 
-  // Sort the child pools based on their reserved memory and reclaim from the
-  // child pool with most reservation first.
+  // Sort the child pools based on their reclaim cost and reserved memory, and
+  // reclaim from the child pool with the lowest cost and then the most
+  // reservation first.
   struct Candidate {
     std::shared_ptr<memory::MemoryPool> pool;
+    int32_t reclaimCost;
     int64_t reservedBytes;
   };
   std::vector<Candidate> candidates;
@@ -209,8 +211,12 @@ MemoryReclaimer::reclaim(MemoryPool* pool, uint64_t targetBytes, Stats& stats) {
     for (auto& entry : pool->children_) {
       auto child = entry.second.lock();
       if (child != nullptr) {
+        const int32_t reclaimCost = child->reclaimer() == nullptr
+            ? 0
+            : child->reclaimer()->reclaimCost();
         const int64_t reservedBytes = child->reservedBytes();
-        candidates.push_back(Candidate{std::move(child), reservedBytes});
+        candidates.push_back(
+            Candidate{std::move(child), reclaimCost, reservedBytes});
       }
     }
   }
@@ -219,6 +225,9 @@ MemoryReclaimer::reclaim(MemoryPool* pool, uint64_t targetBytes, Stats& stats) {
       candidates.begin(),
       candidates.end(),
       [](const auto& lhs, const auto& rhs) {
+        if (lhs.reclaimCost != rhs.reclaimCost) {
+          return lhs.reclaimCost < rhs.reclaimCost;
+        }
         return lhs.reservedBytes > rhs.reservedBytes;
       });
 
@@ -326,8 +326,29 @@ class MemoryReclaimer {
   /// error exposure.
   virtual void abort(MemoryPool* pool, const std::exception_ptr& error);
 
+  /// Returns the priority of the query of the memory pool of this reclaimer.
+  /// Set on the query and task memory pools. The memory arbitrator never
+  /// reclaims from or aborts a query of higher priority than the requestor's.
+  int32_t queryPriority() const {
+    return queryPriority_;
+  }
+
+  /// Returns the cost of reclaiming from the memory pool of this reclaimer.
+  /// Set on the plan node memory pools of a task. A parent memory pool
+  /// reclaims from the child pools with lower cost first.
+  int32_t reclaimCost() const {
+    return reclaimCost_;
+  }
+
  protected:
   MemoryReclaimer() = default;
+
+  MemoryReclaimer(int32_t queryPriority, int32_t reclaimCost)
+      : queryPriority_(queryPriority), reclaimCost_(reclaimCost) {}
+
+ private:
+  const int32_t queryPriority_{0};
+  const int32_t reclaimCost_{0};
 };
 
 /// The memory arbitration context which is set on per-thread local variable by
@@ -202,8 +202,14 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       checkUsageLeak_(options.checkUsageLeak),
-      debugEnabled_(options.debugEnabled) {
+      debugEnabled_(options.debugEnabled),
+      reservationCacheBytes_(options.reservationCacheBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
+  VELOX_CHECK_EQ(
+      reservationCacheBytes_ % kMB,
+      0,
+      "Memory pool {} reservation cache size must be a multiple of 1MB",
+      name_);
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
   MemoryAllocator::alignmentCheck(0, alignment_);
@@ -392,6 +398,9 @@ MemoryPoolImpl::~MemoryPoolImpl() {
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
   }
+  if (reservationCacheBytes_ != 0 && isLeaf()) {
+    releaseReservationCache();
+  }
   if (checkUsageLeak_) {
     VELOX_CHECK(
         (usedReservationBytes_ == 0) && (reservationBytes_ == 0) &&
@@ -640,7 +649,8 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .checkUsageLeak = checkUsageLeak_,
-          .debugEnabled = debugEnabled_});
+          .debugEnabled = debugEnabled_,
+          .reservationCacheBytes = reservationCacheBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -702,7 +712,9 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
     TestValue::adjust(
         "facebook::velox::memory::MemoryPoolImpl::reserveThreadSafe", this);
     try {
-      incrementReservationThreadSafe(this, increment);
+      if (reserveOnly || !maybeIncrementReservationCache(increment)) {
+        incrementReservationThreadSafe(this, increment);
+      }
     } catch (const std::exception& e) {
       // When race with concurrent memory reservation free, we might end up with
       // unused reservation but no used reservation if a retry memory
@@ -745,6 +757,13 @@ bool MemoryPoolImpl::incrementReservationThreadSafe(
   }
   VELOX_CHECK_NULL(parent_);
 
+  // Takes back the reservations cached by the leaf memory pools before
+  // resorting to memory arbitration.
+  if (reservationCacheBytes_ != 0 && releaseReservationCache() != 0 &&
+      maybeIncrementReservation(size)) {
+    return true;
+  }
+
   if (manager_->growPool(requestor, size)) {
     TestValue::adjust(
         "facebook::velox::memory::MemoryPoolImpl::incrementReservationThreadSafe::AfterGrowCallback",
@@ -771,6 +790,27 @@ bool MemoryPoolImpl::incrementReservationThreadSafe(
       treeMemoryUsage()));
 }
 
+bool MemoryPoolImpl::maybeIncrementReservationCache(uint64_t increment) {
+  if (reservationCacheBytes_ == 0) {
+    return false;
+  }
+  const uint64_t size = bits::roundUp(increment, reservationCacheBytes_);
+  if (size == increment) {
+    return false;
+  }
+  return tryIncrementReservationThreadSafe(size);
+}
+
+bool MemoryPoolImpl::tryIncrementReservationThreadSafe(uint64_t size) {
+  if (parent_ != nullptr &&
+      !toImpl(parent_)->tryIncrementReservationThreadSafe(size)) {
+    return false;
+  }
+  // NOTE: only the root memory pool can fail the increment and it does so
+  // before any of its child memory pools has been incremented.
+  return maybeIncrementReservation(size);
+}
+
 bool MemoryPoolImpl::maybeIncrementReservation(uint64_t size) {
   std::lock_guard<std::mutex> l(mutex_);
   return maybeIncrementReservationLocked(size);
@@ -823,7 +863,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationCacheBytes_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -832,7 +872,9 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      // Keeps up to 'reservationCacheBytes_' of unused reservation for the
+      // next allocations.
+      newQuantized = quantizedSize(newCap) + reservationCacheBytes_;
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -845,6 +887,36 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
   }
 }
 
+uint64_t MemoryPoolImpl::releaseReservationCache() {
+  if (!isLeaf()) {
+    uint64_t releasedBytes{0};
+    visitChildren([&](MemoryPool* child) {
+      releasedBytes += toImpl(child)->releaseReservationCache();
+      return true;
+    });
+    return releasedBytes;
+  }
+  // NOTE: only the thread-safe leaf memory pools cache reservations and the
+  // others can't be updated from this thread.
+  if (!trackUsage_ || !threadSafe_) {
+    return 0;
+  }
+  int64_t freeable;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    const int64_t newQuantized = quantizedSize(
+        std::max<int64_t>(minReservationBytes_, usedReservationBytes_));
+    freeable = reservationBytes_ - newQuantized;
+    if (freeable <= 0) {
+      return 0;
+    }
+    reservationBytes_ = newQuantized;
+    sanityCheckLocked();
+  }
+  toImpl(parent_)->decrementReservation(freeable);
+  return freeable;
+}
+
 void MemoryPoolImpl::decrementReservation(uint64_t size) noexcept {
   VELOX_CHECK_GT(size, 0);
 
@@ -955,6 +1027,9 @@ uint64_t MemoryPoolImpl::shrink(uint64_t targetBytes) {
   if (parent_ != nullptr) {
     return parent_->shrink(targetBytes);
   }
+  if (reservationCacheBytes_ != 0) {
+    releaseReservationCache();
+  }
   std::lock_guard<std::mutex> l(mutex_);
   // We don't expect to shrink a memory pool without capacity limit.
   VELOX_CHECK_NE(capacity_, kMaxMemory);
@@ -160,6 +160,15 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// If true, tracks the allocation and free call stacks to detect the source
     /// of memory leak for testing purpose.
     bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
+
+    /// If not zero, a thread-safe leaf memory pool reserves from its parent in
+    /// chunks of this many bytes and keeps up to this many unused reserved
+    /// bytes on free. This cuts the reservation updates up the memory pool
+    /// tree when many drivers allocate from the same query concurrently. The
+    /// cached reservations are returned on release(), on destruction, and when
+    /// the root memory pool runs out of capacity or is shrunk by the memory
+    /// arbitrator. Must be a multiple of 1MB.
+    uint64_t reservationCacheBytes{0};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -355,7 +364,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// If a minimum reservation has been set with maybeReserve(), resets the
   /// minimum reservation. If the current usage is below the minimum
   /// reservation, decreases reservation and usage down to the rounded actual
-  /// usage.
+  /// usage. Also returns the reservation cached by this memory pool if
+  /// Options::reservationCacheBytes is set.
   virtual void release() = 0;
 
   /// Memory arbitration related interfaces.
@@ -524,6 +534,7 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  const uint64_t reservationCacheBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -684,6 +695,11 @@ class MemoryPoolImpl : public MemoryPool {
     return minReservationBytes_;
   }
 
+  /// Returns the unused reservations cached by the thread-safe leaf memory
+  /// pools in the subtree of this memory pool to their parents. Returns the
+  /// number of bytes released.
+  uint64_t releaseReservationCache();
+
   /// Structure to store allocation details in debug mode.
   struct AllocationRecord {
     uint64_t size;
@@ -796,6 +812,17 @@ class MemoryPoolImpl : public MemoryPool {
   // the GrowCallback fails.
   bool incrementReservationThreadSafe(MemoryPool* requestor, uint64_t size);
 
+  // Tries to increment the reservation by 'increment' rounded up to
+  // 'reservationCacheBytes_' for a leaf memory pool with reservation cache. The
+  // function returns false without any change if that exceeds the root memory
+  // pool capacity, as the cached reservation must not trigger memory
+  // arbitration.
+  bool maybeIncrementReservationCache(uint64_t increment);
+
+  // Increments the reservation by 'size' in this and the parent memory pools
+  // if it is within the root memory pool capacity, otherwise returns false.
+  bool tryIncrementReservationThreadSafe(uint64_t size);
+
   FOLLY_ALWAYS_INLINE bool incrementReservationNonThreadSafe(
       MemoryPool* requestor,
       uint64_t size) {
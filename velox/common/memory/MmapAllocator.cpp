@@ -20,11 +20,14 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/Numa.h"
 
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      numNumaNodes_(options.numNumaNodes),
+      useHugeTlb_(options.useHugeTlb),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -33,8 +36,15 @@ MmapAllocator::MmapAllocator(const Options& options)
       capacity_(bits::roundUp(
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
-  for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+  VELOX_CHECK_GE(numNumaNodes_, 1);
+  VELOX_CHECK(
+      !(useHugeTlb_ && useMmapArena_),
+      "useHugeTlb is not supported with useMmapArena");
+  for (auto node = 0; node < numNumaNodes_; ++node) {
+    for (const auto& size : sizeClassSizes_) {
+      sizeClasses_.push_back(std::make_unique<SizeClass>(
+          capacity_ / size, size, numNumaNodes_ > 1 ? node : -1));
+    }
   }
 
   if (useMmapArena_) {
@@ -114,14 +124,15 @@ bool MmapAllocator::allocateNonContiguousWithoutRetry(
     }
   }
   MachinePageCount newMapsNeeded = 0;
+  const auto node = allocationNode();
   for (int i = 0; i < mix.numSizes; ++i) {
     bool success;
     stats_.recordAllocate(
         AllocationTraits::pageBytes(sizeClassSizes_[mix.sizeIndices[i]]),
         mix.sizeCounts[i],
         [&]() {
-          success = sizeClasses_[mix.sizeIndices[i]]->allocate(
-              mix.sizeCounts[i], newMapsNeeded, out);
+          success = sizeClass(node, mix.sizeIndices[i])
+                        .allocate(mix.sizeCounts[i], newMapsNeeded, out);
         });
     if (success && ((i > 0) || (mix.numSizes == 1)) &&
         testingHasInjectedFailure(InjectedFailure::kAllocate)) {
@@ -223,8 +234,8 @@ MachinePageCount MmapAllocator::freeNonContiguousInternal(
       // Increment the free time only if the allocation contained
       // pages in the class. Note that size class indices in the
       // allocator are not necessarily the same as in the stats.
-      const auto sizeIndex =
-          Stats::sizeIndex(AllocationTraits::pageBytes(sizeClassSizes_[i]));
+      const auto sizeIndex = Stats::sizeIndex(AllocationTraits::pageBytes(
+          sizeClassSizes_[i % sizeClassSizes_.size()]));
       stats_.sizes[sizeIndex].freeClocks += clocks;
     }
     numFreed += pages;
@@ -279,12 +290,14 @@ bool MmapAllocator::allocateContiguousImpl(
   }
   const auto numLargeCollateralPages = allocation.numPages();
   if (numLargeCollateralPages > 0) {
-    useHugePages(allocation, false);
+    if (!isHugeTlbSize(allocation.maxSize())) {
+      useHugePages(allocation, false);
+    }
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
       managedArenas_->free(allocation.data(), allocation.maxSize());
     } else {
-      if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
+      if (::munmap(allocation.data(), mapBytes(allocation.maxSize())) < 0) {
         VELOX_MEM_LOG(ERROR) << "munmap got " << folly::errnoStr(errno)
                              << " for " << allocation.toString();
       }
@@ -388,16 +401,9 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mmapContiguous(AllocationTraits::pageBytes(maxPages));
     }
   }
-  // TODO: add handling of MAP_FAILED.
   if (data == nullptr) {
     const std::string errorMsg = fmt::format(
         "Mmap failed with {} pages use MmapArena {}",
@@ -414,10 +420,65 @@ bool MmapAllocator::allocateContiguousImpl(
       data,
       AllocationTraits::pageBytes(numPages),
       AllocationTraits::pageBytes(maxPages));
-  useHugePages(allocation, true);
+  if (!isHugeTlbSize(allocation.maxSize())) {
+    useHugePages(allocation, true);
+  }
   return true;
 }
 
+void* MmapAllocator::mmapContiguous(uint64_t bytes) {
+  void* data = MAP_FAILED;
+  if (isHugeTlbSize(bytes)) {
+    data = ::mmap(
+        nullptr,
+        mapBytes(bytes),
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+        -1,
+        0);
+    if (data == MAP_FAILED) {
+      ++numHugeTlbFallbacks_;
+    } else {
+      ++numHugeTlbAllocations_;
+    }
+  }
+  if (data == MAP_FAILED) {
+    // A regular mapping of the same size as the huge page one so that the
+    // allocation is freed the same way.
+    data = ::mmap(
+        nullptr,
+        mapBytes(bytes),
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS,
+        -1,
+        0);
+  }
+  if (data == MAP_FAILED) {
+    VELOX_MEM_LOG(ERROR) << "mmap of " << bytes
+                         << " bytes got: " << folly::errnoStr(errno);
+    return nullptr;
+  }
+  if (numNumaNodes_ > 1) {
+    // The pages are not touched yet, so they all get backed by 'node'.
+    preferNumaNode(data, mapBytes(bytes), allocationNode());
+  }
+  return data;
+}
+
+int32_t MmapAllocator::allocationNode() {
+  if (numNumaNodes_ == 1) {
+    return 0;
+  }
+  const auto currentNode = currentNumaNode() % numNumaNodes_;
+  const auto node = scopedNumaNode();
+  if (node < 0 || node % numNumaNodes_ == currentNode) {
+    ++numLocalAllocations_;
+    return currentNode;
+  }
+  ++numRemoteAllocations_;
+  return node % numNumaNodes_;
+}
+
 void MmapAllocator::freeContiguous(ContiguousAllocation& allocation) {
   stats_.recordFree(
       allocation.size(), [&]() { freeContiguousImpl(allocation); });
@@ -427,12 +488,14 @@ void MmapAllocator::freeContiguousImpl(ContiguousAllocation& allocation) {
   if (allocation.empty()) {
     return;
   }
-  useHugePages(allocation, false);
+  if (!isHugeTlbSize(allocation.maxSize())) {
+    useHugePages(allocation, false);
+  }
   if (useMmapArena_) {
     std::lock_guard<std::mutex> l(arenaMutex_);
     managedArenas_->free(allocation.data(), allocation.maxSize());
   } else {
-    if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
+    if (::munmap(allocation.data(), mapBytes(allocation.maxSize())) < 0) {
       VELOX_MEM_LOG(ERROR) << "munmap returned " << folly::errnoStr(errno)
                            << " for " << allocation.toString();
     }
@@ -581,7 +644,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -610,6 +676,11 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         unitSize_);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  if (numaNode >= 0 && !preferNumaNode(ptr, byteSize_, numaNode)) {
+    VELOX_MEM_LOG(WARNING) << "Could not bind sizeClass " << unitSize_
+                           << " to NUMA node " << numaNode << ": "
+                           << folly::errnoStr(errno);
+  }
 }
 
 MmapAllocator::SizeClass::~SizeClass() {
@@ -1033,6 +1104,15 @@ std::string MmapAllocator::toString() const {
       << ((capacity_ == kMaxMemory) ? "UNLIMITED" : succinctBytes(capacity_))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
       << " external mapped pages " << numExternalMapped_ << std::endl;
+  if (numNumaNodes_ > 1) {
+    out << "NUMA nodes " << numNumaNodes_ << " local allocations "
+        << numLocalAllocations_ << " remote allocations "
+        << numRemoteAllocations_ << std::endl;
+  }
+  if (useHugeTlb_) {
+    out << "MAP_HUGETLB allocations " << numHugeTlbAllocations_
+        << " fallbacks " << numHugeTlbFallbacks_ << std::endl;
+  }
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
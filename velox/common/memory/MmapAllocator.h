@@ -46,6 +46,11 @@ using ClassPageCount = int32_t;
 /// mmap of the requested size (ContiguousAllocation). Small contiguous memory
 /// allocations less than 3/4 of smallest size class are still delegated to
 /// malloc.
+///
+/// On hosts with more than one NUMA node, the allocator can keep a set of size
+/// classes per node. The memory of these is preferably backed by their node
+/// and a thread allocates from the size classes of the node given by
+/// scopedNumaNode(), or else of the node it runs on.
 class MmapAllocator : public MemoryAllocator {
  public:
   struct Options {
@@ -75,6 +80,19 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// Number of NUMA nodes to keep separate size classes for. Contiguous
+    /// allocations are also backed by the allocating thread's node unless
+    /// 'useMmapArena' is set. 1 disables NUMA awareness. numaNodeCount() gives
+    /// the count of the host.
+    int32_t numNumaNodes = 1;
+
+    /// If true, contiguous allocations of at least a huge page are mapped with
+    /// MAP_HUGETLB from the huge pages reserved on the host. These are not
+    /// subject to transparent huge page compaction. Falls back to regular
+    /// pages when no huge pages are free. Must not be set together with
+    /// 'useMmapArena', whose contiguous allocations come from the arena.
+    bool useHugeTlb = false;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -155,6 +173,34 @@ class MmapAllocator : public MemoryAllocator {
     return stats;
   }
 
+  int32_t numNumaNodes() const {
+    return numNumaNodes_;
+  }
+
+  /// Number of allocations from the size classes or contiguous mappings of
+  /// the node the allocating thread ran on. Counted only with more than one
+  /// NUMA node.
+  uint64_t numLocalAllocations() const {
+    return numLocalAllocations_;
+  }
+
+  /// Number of allocations for a thread running on a node other than its
+  /// scopedNumaNode().
+  uint64_t numRemoteAllocations() const {
+    return numRemoteAllocations_;
+  }
+
+  /// Number of contiguous allocations mapped with MAP_HUGETLB.
+  uint64_t numHugeTlbAllocations() const {
+    return numHugeTlbAllocations_;
+  }
+
+  /// Number of contiguous allocations that fell back to regular pages because
+  /// there were no free huge pages.
+  uint64_t numHugeTlbFallbacks() const {
+    return numHugeTlbFallbacks_;
+  }
+
   std::string toString() const override;
 
  private:
@@ -164,7 +210,9 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    // Makes a size class whose memory is backed by 'numaNode' if it is not
+    // -1.
+    SizeClass(size_t capacity, MachinePageCount unitSize, int32_t numaNode);
 
     ~SizeClass();
 
@@ -372,6 +420,32 @@ class MmapAllocator : public MemoryAllocator {
 
   bool useMalloc(uint64_t bytes);
 
+  // Returns the NUMA node to allocate from for the calling thread and counts
+  // the allocation as local or remote. Returns 0 if there is one node.
+  int32_t allocationNode();
+
+  // Returns the size class of 'node' for the size at 'sizeIndex' in
+  // 'sizeClassSizes_'.
+  SizeClass& sizeClass(int32_t node, int32_t sizeIndex) {
+    return *sizeClasses_[node * sizeClassSizes_.size() + sizeIndex];
+  }
+
+  // True if a contiguous mapping of 'bytes' is made with MAP_HUGETLB.
+  bool isHugeTlbSize(uint64_t bytes) const {
+    return useHugeTlb_ && bytes >= AllocationTraits::kHugePageSize;
+  }
+
+  // Returns the size of the mapping for a contiguous allocation of 'bytes'.
+  uint64_t mapBytes(uint64_t bytes) const {
+    return isHugeTlbSize(bytes)
+        ? bits::roundUp(bytes, AllocationTraits::kHugePageSize)
+        : bytes;
+  }
+
+  // Maps 'bytes' for a contiguous allocation outside of the size classes.
+  // Returns nullptr on failure.
+  void* mmapContiguous(uint64_t bytes);
+
   const Kind kind_;
 
   // If set true, allocations larger than the largest size class size will be
@@ -379,6 +453,10 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  const int32_t numNumaNodes_;
+
+  const bool useHugeTlb_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
@@ -408,6 +486,7 @@ class MmapAllocator : public MemoryAllocator {
   // to std::malloc().
   const MachinePageCount capacity_ = 0;
 
+  // The size classes of 'sizeClassSizes_' for each NUMA node, node by node.
   std::vector<std::unique_ptr<SizeClass>> sizeClasses_;
 
   // Statistics.
@@ -415,6 +494,10 @@ class MmapAllocator : public MemoryAllocator {
   std::atomic<uint64_t> numAllocatedPages_ = 0;
   std::atomic<uint64_t> numAdvisedPages_ = 0;
   std::atomic<uint64_t> numMallocBytes_ = 0;
+  std::atomic<uint64_t> numLocalAllocations_ = 0;
+  std::atomic<uint64_t> numRemoteAllocations_ = 0;
+  std::atomic<uint64_t> numHugeTlbAllocations_ = 0;
+  std::atomic<uint64_t> numHugeTlbFallbacks_ = 0;
 
   // Allocations that are larger than largest size classes will be delegated to
   // ManagedMmapArenas, to avoid calling mmap on every allocation.
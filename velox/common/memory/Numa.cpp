@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/Numa.h"
+
+#include <fstream>
+#include <string>
+
+#include <folly/portability/SysSyscall.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#endif
+
+namespace facebook::velox::memory {
+namespace {
+thread_local int32_t threadNumaNode{-1};
+
+int32_t readNumaNodeCount() {
+  // The online nodes are listed as ranges, e.g. "0-1" or "0,2-3".
+  std::ifstream in("/sys/devices/system/node/online");
+  std::string nodes;
+  if (!(in >> nodes) || nodes.empty()) {
+    return 1;
+  }
+  const auto lastStart = nodes.find_last_of(",-");
+  try {
+    return std::stoi(
+               lastStart == std::string::npos ? nodes
+                                              : nodes.substr(lastStart + 1)) +
+        1;
+  } catch (const std::exception&) {
+    return 1;
+  }
+}
+} // namespace
+
+int32_t numaNodeCount() {
+  static const int32_t count = readNumaNodeCount();
+  return count;
+}
+
+int32_t currentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu;
+  unsigned node;
+  if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+int32_t scopedNumaNode() {
+  return threadNumaNode;
+}
+
+ScopedNumaNode::ScopedNumaNode(int32_t node) : savedNode_(threadNumaNode) {
+  threadNumaNode = node;
+}
+
+ScopedNumaNode::~ScopedNumaNode() {
+  threadNumaNode = savedNode_;
+}
+
+bool preferNumaNode(void* address, size_t bytes, int32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  if (node < 0 || node >= 64) {
+    return false;
+  }
+  const unsigned long nodeMask = 1UL << node;
+  return ::syscall(
+             SYS_mbind,
+             address,
+             bytes,
+             MPOL_PREFERRED,
+             &nodeMask,
+             sizeof(nodeMask) * 8,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace facebook::velox::memory
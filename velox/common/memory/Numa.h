@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace facebook::velox::memory {
+
+/// Returns the number of NUMA nodes of the host, 1 if this is not known.
+int32_t numaNodeCount();
+
+/// Returns the NUMA node of the CPU the calling thread runs on, 0 if this is
+/// not known.
+int32_t currentNumaNode();
+
+/// Returns the NUMA node set by the innermost ScopedNumaNode of the calling
+/// thread, -1 if none.
+int32_t scopedNumaNode();
+
+/// Sets the NUMA node the calling thread allocates memory from for the
+/// lifetime of 'this'. A driver sets this to the node it first ran on so that
+/// its memory stays on one node even if it later runs on another.
+class ScopedNumaNode {
+ public:
+  explicit ScopedNumaNode(int32_t node);
+
+  ~ScopedNumaNode();
+
+ private:
+  const int32_t savedNode_;
+};
+
+/// Asks the kernel to back the pages of [address, address + bytes) with memory
+/// of 'node' when it has free memory. 'address' must be page aligned. Returns
+/// false if this is not supported.
+bool preferNumaNode(void* address, size_t bytes, int32_t node);
+
+} // namespace facebook::velox::memory
@@ -18,6 +18,7 @@
 
 #include "velox/common/memory/Memory.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/memory/Numa.h"
 #include "velox/common/time/Timer.h"
 
 DEFINE_uint64(
@@ -38,6 +39,15 @@ DEFINE_uint32(
     num_runs,
     32,
     "The number of benchmark runs and reports the average results");
+DEFINE_int32(
+    numa_nodes,
+    1,
+    "Number of NUMA nodes the mmap allocator keeps size classes for. 0 means "
+    "the count of the host");
+DEFINE_bool(
+    use_huge_tlb,
+    false,
+    "Map large contiguous allocations of the mmap allocator with MAP_HUGETLB");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -150,6 +160,8 @@ class MemoryAllocationBenchMark {
     uint64_t allocationBytes;
     uint32_t numThreads;
     uint32_t numOpsPerThread;
+    int32_t numNumaNodes{1};
+    bool useHugeTlb{false};
   };
 
   explicit MemoryAllocationBenchMark(const Options& options)
@@ -159,6 +171,8 @@ class MemoryAllocationBenchMark {
       case Type::kMmap: {
         memory::MmapAllocator::Options mmapOptions;
         mmapOptions.capacity = maxMemory;
+        mmapOptions.numNumaNodes = options_.numNumaNodes;
+        mmapOptions.useHugeTlb = options_.useHugeTlb;
         allocator_ = std::make_shared<MmapAllocator>(mmapOptions);
         manager_ = std::make_shared<MemoryManager>(MemoryManagerOptions{
             .capacity = maxMemory, .allocator = allocator_.get()});
@@ -235,6 +249,11 @@ void MemoryAllocationBenchMark::printStats() {
   LOG(INFO) << "\n\t\tSIZE\t\tTIME\t\tCLOCK\n\t\t"
             << succinctBytes(options_.allocationBytes) << "\t\t"
             << succinctMillis(avgRunTimeMs) << "\t\t" << avgClockCount;
+  if (allocator_ != nullptr && allocator_->numNumaNodes() > 1) {
+    LOG(INFO) << "NUMA nodes " << allocator_->numNumaNodes()
+              << " local allocations " << allocator_->numLocalAllocations()
+              << " remote allocations " << allocator_->numRemoteAllocations();
+  }
 }
 } // namespace
 
@@ -248,6 +267,9 @@ int main(int argc, char* argv[]) {
       ? MemoryAllocationBenchMark::Type::kMalloc
       : MemoryAllocationBenchMark::Type::kMmap;
   options.numOpsPerThread = FLAGS_num_allocations_per_thread;
+  options.numNumaNodes =
+      FLAGS_numa_nodes == 0 ? numaNodeCount() : FLAGS_numa_nodes;
+  options.useHugeTlb = FLAGS_use_huge_tlb;
   auto benchmark = std::make_unique<MemoryAllocationBenchMark>(options);
   for (int i = 0; i < FLAGS_num_runs; ++i) {
     benchmark->run();
@@ -25,10 +25,20 @@
 #include "folly/Random.h"
 
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/memory/Numa.h"
 
 DEFINE_int64(volume_gb, 2048, "Total GB to allocate during test");
 DEFINE_int64(size_cap_gb, 24, "Size cap: total GB resident at one time");
 DEFINE_bool(use_mmap, true, "Use mmap and madvise to manage fragmentation");
+DEFINE_int32(
+    numa_nodes,
+    1,
+    "Number of NUMA nodes the mmap allocator keeps size classes for. 0 means "
+    "the count of the host");
+DEFINE_bool(
+    use_huge_tlb,
+    false,
+    "Map large contiguous allocations of the mmap allocator with MAP_HUGETLB");
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -150,6 +160,9 @@ class FragmentationTest {
   void initMemory(size_t sizeCap) {
     MmapAllocator::Options options;
     options.capacity = sizeCap + (64 << 20);
+    options.numNumaNodes =
+        FLAGS_numa_nodes == 0 ? numaNodeCount() : FLAGS_numa_nodes;
+    options.useHugeTlb = FLAGS_use_huge_tlb;
     memory_ = std::make_shared<MmapAllocator>(options);
   }
 
@@ -184,6 +197,9 @@ class FragmentationTest {
       std::cout << sizeString(pair.first << 10) << " = "
                 << sizeString(pair.second << 10) << std::endl;
     }
+    if (memory_ != nullptr) {
+      std::cout << memory_->toString() << std::endl;
+    }
   }
 
  protected:
@@ -21,6 +21,7 @@
 #include "velox/common/memory/MallocAllocator.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/common/memory/MmapArena.h"
+#include "velox/common/memory/Numa.h"
 #include "velox/common/testutil/TestValue.h"
 
 #include <folly/Random.h>
@@ -464,6 +465,110 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNuma) {
+  if (!useMmap_) {
+    return;
+  }
+  EXPECT_EQ(-1, scopedNumaNode());
+  {
+    ScopedNumaNode outer(1);
+    {
+      ScopedNumaNode inner(0);
+      EXPECT_EQ(0, scopedNumaNode());
+    }
+    EXPECT_EQ(1, scopedNumaNode());
+  }
+  EXPECT_EQ(-1, scopedNumaNode());
+  EXPECT_GE(numaNodeCount(), 1);
+
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.maxMallocBytes = 0;
+  options.numNumaNodes = 2;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+  EXPECT_EQ(2, allocator->numNumaNodes());
+  const auto localNode = currentNumaNode() % 2;
+
+  Allocation local;
+  ASSERT_TRUE(allocator->allocateNonContiguous(100, local));
+  Allocation remote;
+  ContiguousAllocation remoteContiguous;
+  {
+    ScopedNumaNode scopedNode(1 - localNode);
+    ASSERT_TRUE(allocator->allocateNonContiguous(100, remote));
+    ASSERT_TRUE(allocator->allocateContiguous(1000, nullptr, remoteContiguous));
+  }
+  ::memset(remoteContiguous.data(), 1, remoteContiguous.size());
+  if (numaNodeCount() == 1) {
+    EXPECT_EQ(1, allocator->numLocalAllocations());
+    EXPECT_EQ(2, allocator->numRemoteAllocations());
+    EXPECT_THAT(
+        allocator->toString(),
+        testing::HasSubstr(
+            "NUMA nodes 2 local allocations 1 remote allocations 2"));
+  }
+  EXPECT_EQ(
+      3,
+      allocator->numLocalAllocations() + allocator->numRemoteAllocations());
+  EXPECT_TRUE(allocator->checkConsistency());
+
+  allocator->freeNonContiguous(local);
+  allocator->freeNonContiguous(remote);
+  allocator->freeContiguous(remoteContiguous);
+  EXPECT_EQ(0, allocator->numAllocated());
+  EXPECT_TRUE(allocator->checkConsistency());
+}
+
+TEST_P(MemoryAllocatorTest, mmapAllocatorHugeTlb) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useHugeTlb = true;
+  auto allocator = std::make_shared<MmapAllocator>(options);
+
+  // Smaller than a huge page.
+  ContiguousAllocation small;
+  ASSERT_TRUE(allocator->allocateContiguous(100, nullptr, small));
+  EXPECT_EQ(0, allocator->numHugeTlbAllocations());
+  EXPECT_EQ(0, allocator->numHugeTlbFallbacks());
+
+  // Uses huge pages if the host has free ones and regular pages otherwise.
+  ContiguousAllocation large;
+  const auto numPages = AllocationTraits::numPagesInHugePage() * 2 + 1;
+  ASSERT_TRUE(allocator->allocateContiguous(numPages, nullptr, large));
+  EXPECT_EQ(
+      1,
+      allocator->numHugeTlbAllocations() + allocator->numHugeTlbFallbacks());
+  ::memset(large.data(), 1, large.size());
+
+  // The mapping is replaced with the collateral freed.
+  ASSERT_TRUE(allocator->allocateContiguous(numPages * 2, nullptr, large));
+  EXPECT_EQ(
+      2,
+      allocator->numHugeTlbAllocations() + allocator->numHugeTlbFallbacks());
+  ::memset(large.data(), 1, large.size());
+
+  allocator->freeContiguous(small);
+  allocator->freeContiguous(large);
+  EXPECT_EQ(0, allocator->numAllocated());
+  EXPECT_EQ(0, allocator->numMapped());
+}
+
+TEST_P(MemoryAllocatorTest, mmapAllocatorHugeTlbWithArena) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useMmapArena = true;
+  options.useHugeTlb = true;
+  VELOX_ASSERT_THROW(
+      std::make_shared<MmapAllocator>(options),
+      "useHugeTlb is not supported with useMmapArena");
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
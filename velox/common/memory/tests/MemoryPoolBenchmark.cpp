@@ -238,6 +238,57 @@ BENCHMARK(FlatSticks, iters) {
   });
 }
 
+namespace {
+// Allocates and frees from 'numLeaves' leaf memory pools of the same query
+// memory pool in parallel, one thread per leaf memory pool like the operator
+// memory pools of the drivers of a query. Each allocation crosses the 1MB
+// reservation quantum so that without reservation cache every allocation and
+// free updates the reservations up to the root memory pool.
+void runContendedQuery(
+    size_t iters,
+    size_t numLeaves,
+    uint64_t reservationCacheBytes) {
+  constexpr int64_t kAllocationSize = 64 << 10;
+  folly::BenchmarkSuspender suspender;
+  MemoryManager manager{{.reservationCacheBytes = reservationCacheBytes}};
+  auto query = manager.addRootPool("query");
+  auto task = query->addAggregateChild("query.task");
+  std::vector<std::shared_ptr<MemoryPool>> leaves;
+  for (size_t i = 0; i < numLeaves; ++i) {
+    leaves.push_back(
+        task->addLeafChild("query.task.op_" + folly::to<std::string>(i)));
+  }
+  folly::CPUThreadPoolExecutor threadPool(numLeaves);
+  suspender.dismiss();
+  for (auto& leaf : leaves) {
+    threadPool.add([iters, pool = leaf.get()]() {
+      for (size_t i = 0; i < iters; ++i) {
+        void* p = pool->allocate(kAllocationSize);
+        pool->free(p, kAllocationSize);
+      }
+    });
+  }
+  threadPool.join();
+  suspender.rehire();
+}
+} // namespace
+
+BENCHMARK(ContendedQuery64, iters) {
+  runContendedQuery(iters, 64, 0);
+}
+
+BENCHMARK_RELATIVE(ContendedQuery64ReservationCache, iters) {
+  runContendedQuery(iters, 64, 8 << 20);
+}
+
+BENCHMARK(ContendedQuery128, iters) {
+  runContendedQuery(iters, 128, 0);
+}
+
+BENCHMARK_RELATIVE(ContendedQuery128ReservationCache, iters) {
+  runContendedQuery(iters, 128, 8 << 20);
+}
+
 int main(int argc, char* argv[]) {
   folly::init(&argc, &argv);
   folly::runBenchmarks();
@@ -3307,6 +3307,72 @@ TEST_P(MemoryPoolTest, quantizedSize) {
   }
 }
 
+TEST_P(MemoryPoolTest, reservationCache) {
+  constexpr uint64_t kCacheBytes = 8 * MB;
+  setupMemory(
+      {.capacity = kDefaultCapacity, .reservationCacheBytes = kCacheBytes});
+  MemoryManager& manager = *getMemoryManager();
+
+  // Non-thread-safe leaf memory pools don't cache reservations.
+  {
+    auto root = manager.addRootPool("reservationCache.nonThreadSafe");
+    auto leaf = root->addLeafChild("nonThreadSafe", false);
+    void* buffer = leaf->allocate(KB);
+    ASSERT_EQ(leaf->reservedBytes(), MB);
+    ASSERT_EQ(root->reservedBytes(), MB);
+    leaf->free(buffer, KB);
+    ASSERT_EQ(root->reservedBytes(), 0);
+  }
+
+  auto root = manager.addRootPool("reservationCache", 32 * MB);
+  auto leaf = root->addLeafChild("leaf");
+
+  // The first allocation reserves a whole chunk from the root.
+  void* buffer = leaf->allocate(KB);
+  ASSERT_EQ(leaf->currentBytes(), KB);
+  ASSERT_EQ(leaf->reservedBytes(), kCacheBytes);
+  ASSERT_EQ(root->reservedBytes(), kCacheBytes);
+
+  // Allocations and frees within the chunk don't update the root.
+  void* buffer2 = leaf->allocate(4 * MB);
+  ASSERT_EQ(root->reservedBytes(), kCacheBytes);
+  leaf->free(buffer2, 4 * MB);
+  leaf->free(buffer, KB);
+  ASSERT_EQ(leaf->currentBytes(), 0);
+  ASSERT_EQ(leaf->reservedBytes(), kCacheBytes);
+  ASSERT_EQ(root->reservedBytes(), kCacheBytes);
+
+  // Explicit release returns the cached reservation.
+  leaf->release();
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  // A reservation that doesn't fit the root capacity takes back the cached
+  // reservation of the other leaf memory pools.
+  buffer = leaf->allocate(20 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 24 * MB);
+  auto otherLeaf = root->addLeafChild("otherLeaf");
+  buffer2 = otherLeaf->allocate(10 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 20 * MB);
+  ASSERT_EQ(otherLeaf->reservedBytes(), 10 * MB);
+  ASSERT_EQ(root->reservedBytes(), 30 * MB);
+
+  leaf->free(buffer, 20 * MB);
+  otherLeaf->free(buffer2, 10 * MB);
+  ASSERT_EQ(root->reservedBytes(), 2 * kCacheBytes);
+  ASSERT_EQ(root->freeBytes(), 32 * MB - 2 * kCacheBytes);
+
+  // Destruction returns the cached reservation.
+  otherLeaf.reset();
+  ASSERT_EQ(root->reservedBytes(), kCacheBytes);
+
+  // Shrink by the memory arbitrator returns the cached reservation.
+  ASSERT_EQ(root->shrink(), 32 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+  ASSERT_EQ(root->capacity(), 0);
+}
+
 namespace {
 class MockMemoryReclaimer : public MemoryReclaimer {
  public:
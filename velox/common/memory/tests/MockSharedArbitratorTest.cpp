@@ -66,11 +66,15 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
-    MemoryReclaimer(const std::shared_ptr<MockTask>& task) : task_(task) {}
+    MemoryReclaimer(
+        const std::shared_ptr<MockTask>& task,
+        int32_t queryPriority)
+        : memory::MemoryReclaimer(queryPriority, 0), task_(task) {}
 
     static std::unique_ptr<MemoryReclaimer> create(
-        const std::shared_ptr<MockTask>& task) {
-      return std::make_unique<MemoryReclaimer>(task);
+        const std::shared_ptr<MockTask>& task,
+        int32_t priority = 0) {
+      return std::make_unique<MemoryReclaimer>(task, priority);
     }
 
     void abort(MemoryPool* pool, const std::exception_ptr& error) override {
@@ -86,11 +90,14 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
     std::weak_ptr<MockTask> task_;
   };
 
-  void initTaskPool(MemoryManager* manager, uint64_t capacity) {
+  void initTaskPool(
+      MemoryManager* manager,
+      uint64_t capacity,
+      int32_t priority = 0) {
     root_ = manager->addRootPool(
         fmt::format("RootPool-{}", poolId_++),
         capacity,
-        MemoryReclaimer::create(shared_from_this()));
+        MemoryReclaimer::create(shared_from_this(), priority));
   }
 
   MemoryPool* pool() const {
@@ -426,9 +433,11 @@ class MockSharedArbitrationTest : public testing::Test {
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
   }
 
-  std::shared_ptr<MockTask> addTask(int64_t capacity = kMaxMemory) {
+  std::shared_ptr<MockTask> addTask(
+      int64_t capacity = kMaxMemory,
+      int32_t priority = 0) {
     auto task = std::make_shared<MockTask>();
-    task->initTaskPool(manager_.get(), capacity);
+    task->initTaskPool(manager_.get(), capacity, priority);
     return task;
   }
 
@@ -588,6 +597,105 @@ TEST_F(MockSharedArbitrationTest, arbitrationFailsTask) {
   growOp->freeAll();
 }
 
+TEST_F(MockSharedArbitrationTest, arbitrationAbortsLowPriorityTask) {
+  auto batchTask = addTask(kMemoryCapacity, 0);
+  auto batchOp = batchTask->addMemoryOp(false);
+  batchOp->allocate(128 * MB);
+  auto interactiveTask = addTask(kMemoryCapacity, 1);
+  auto interactiveOp = interactiveTask->addMemoryOp(false);
+  interactiveOp->allocate(256 * MB);
+
+  // The batch task is the victim even though the interactive task has more
+  // capacity.
+  auto growTask = addTask(kMemoryCapacity, 1);
+  auto growOp = growTask->addMemoryOp(false);
+  growOp->allocate(128 * MB);
+  ASSERT_TRUE(manager_->growPool(growOp->pool(), 64 * MB));
+  ASSERT_NE(batchTask->error(), nullptr);
+  ASSERT_EQ(interactiveTask->error(), nullptr);
+  ASSERT_EQ(arbitrator_->stats().numAborted, 1);
+  batchOp->freeAll();
+  interactiveOp->freeAll();
+  growOp->freeAll();
+}
+
+TEST_F(MockSharedArbitrationTest, arbitrationNotAbortHighPriorityTask) {
+  auto interactiveTask = addTask(kMemoryCapacity, 1);
+  auto interactiveOp = interactiveTask->addMemoryOp(false);
+  interactiveOp->allocate(384 * MB);
+
+  // A batch requestor fails the arbitration instead of aborting a larger
+  // interactive task.
+  auto batchTask = addTask(kMemoryCapacity, 0);
+  auto batchOp = batchTask->addMemoryOp(false);
+  batchOp->allocate(128 * MB);
+  ASSERT_FALSE(manager_->growPool(batchOp->pool(), 64 * MB));
+  ASSERT_EQ(interactiveTask->error(), nullptr);
+  ASSERT_FALSE(batchOp->pool()->aborted());
+  ASSERT_EQ(arbitrator_->stats().numAborted, 0);
+  ASSERT_EQ(arbitrator_->stats().numFailures, 1);
+  interactiveOp->freeAll();
+  batchOp->freeAll();
+}
+
+TEST_F(MockSharedArbitrationTest, arbitrationReclaimsLowPriorityTask) {
+  const int allocateSize = 8 * MB;
+  auto batchTask = addTask(kMemoryCapacity, 0);
+  auto batchOp = batchTask->addMemoryOp(true);
+  while (batchOp->pool()->currentBytes() < 128 * MB) {
+    batchOp->allocate(allocateSize);
+  }
+  auto interactiveTask = addTask(kMemoryCapacity, 1);
+  auto interactiveOp = interactiveTask->addMemoryOp(true);
+  while (interactiveOp->pool()->currentBytes() < 256 * MB) {
+    interactiveOp->allocate(allocateSize);
+  }
+  auto growTask = addTask(kMemoryCapacity, 1);
+  auto growOp = growTask->addMemoryOp(false);
+  growOp->allocate(128 * MB);
+
+  // The memory is reclaimed from the smaller batch task first.
+  growOp->allocate(64 * MB);
+  ASSERT_EQ(interactiveOp->pool()->currentBytes(), 256 * MB);
+  ASSERT_LE(batchOp->pool()->currentBytes(), 64 * MB);
+  ASSERT_EQ(interactiveOp->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(arbitrator_->stats().numAborted, 0);
+
+  // A batch requestor does not reclaim from the interactive task.
+  VELOX_ASSERT_THROW(batchOp->allocate(128 * MB), "");
+  ASSERT_EQ(interactiveOp->pool()->currentBytes(), 256 * MB);
+  ASSERT_EQ(interactiveTask->error(), nullptr);
+}
+
+TEST_F(MockSharedArbitrationTest, queryStats) {
+  auto task = addTask(kMemoryCapacity, 1);
+  auto* op = task->addMemoryOp();
+  op->allocate(64 * MB);
+  op->allocate(64 * MB);
+  const auto numRequests = arbitrator_->stats().numRequests;
+  ASSERT_GT(numRequests, 0);
+  auto queryStats = arbitrator_->queryStats();
+  ASSERT_EQ(queryStats.size(), 1);
+  const auto& stats = queryStats.at(task->pool()->name());
+  ASSERT_EQ(stats.priority, 1);
+  ASSERT_EQ(stats.numRequests, numRequests);
+  uint64_t numHistogramRequests{0};
+  for (const auto count : stats.latencyHistogram) {
+    numHistogramRequests += count;
+  }
+  ASSERT_EQ(numHistogramRequests, numRequests);
+  ASSERT_EQ(SharedArbitrator::latencyBucket(0), 0);
+  ASSERT_EQ(SharedArbitrator::latencyBucket(1), 1);
+  ASSERT_EQ(SharedArbitrator::latencyBucket(1000), 10);
+  ASSERT_EQ(
+      SharedArbitrator::latencyBucket(std::numeric_limits<uint64_t>::max()),
+      SharedArbitrator::kNumLatencyBuckets - 1);
+
+  // The stats are dropped with the query root memory pool.
+  task.reset();
+  ASSERT_TRUE(arbitrator_->queryStats().empty());
+}
+
 TEST_F(MockSharedArbitrationTest, shrinkMemory) {
   std::vector<std::shared_ptr<MemoryPool>> pools;
   ASSERT_THROW(arbitrator_->shrinkMemory(pools, 128), VeloxException);
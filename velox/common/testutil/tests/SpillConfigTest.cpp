@@ -30,6 +30,7 @@ TEST(SpillConfig, spillLevel) {
       0,
       0,
       0,
+      0,
       nullptr,
       0,
       0,
@@ -114,6 +115,7 @@ TEST(SpillConfig, spillLevelLimit) {
         0,
         0,
         0,
+        0,
         nullptr,
         0,
         0,
@@ -159,6 +161,7 @@ TEST(SpillConfig, spillableReservationPercentages) {
           0,
           0,
           0,
+          0,
           nullptr,
           testData.minPct,
           testData.growthPct,
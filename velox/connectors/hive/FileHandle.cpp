@@ -47,6 +47,13 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
                            ->openFileForRead(filename);
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
+    // Cached data of a previous version of the file, e.g. restored from an
+    // SSD cache checkpoint, is dropped if the identity does not match.
+    setFileIdentity(
+        fileHandle->uuid.id(),
+        {fileHandle->file->size(),
+         fileHandle->file->modificationTime(),
+         fileHandle->file->etag()});
     VLOG(1) << "Generating file handle for: " << filename
             << " uuid: " << fileHandle->uuid.id();
   }
@@ -141,6 +141,26 @@ std::string HiveConfig::gcsCredentials(const Config* config) {
   return config->get<std::string>(kGCSCredentials, std::string(""));
 }
 
+// static
+int32_t HiveConfig::remoteReadThreads(const Config* config) {
+  return config->get<int32_t>(kRemoteReadThreads, 8);
+}
+
+// static
+uint64_t HiveConfig::remoteReadPartSize(const Config* config) {
+  return config->get<uint64_t>(kRemoteReadPartSize, 0);
+}
+
+// static
+double HiveConfig::remoteReadHedgePercentile(const Config* config) {
+  return config->get<double>(kRemoteReadHedgePercentile, 0);
+}
+
+// static
+uint64_t HiveConfig::remoteReadMinHedgeDelayMs(const Config* config) {
+  return config->get<uint64_t>(kRemoteReadMinHedgeDelayMs, 10);
+}
+
 // static.
 bool HiveConfig::isOrcUseColumnNames(const Config* config) {
   return config->get<bool>(kOrcUseColumnNames, false);
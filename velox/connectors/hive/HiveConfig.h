@@ -90,6 +90,25 @@ class HiveConfig {
   /// The GCS service account configuration as json string
   static constexpr const char* kGCSCredentials = "hive.gcs.credentials";
 
+  /// Number of threads per S3 or GCS file system that read the parts of
+  /// split or hedged reads.
+  static constexpr const char* kRemoteReadThreads = "hive.remote-read.threads";
+
+  /// Reads of S3 and GCS objects of at least twice this many bytes are split
+  /// into parts of about this size that are read in parallel. 0 disables
+  /// splitting.
+  static constexpr const char* kRemoteReadPartSize =
+      "hive.remote-read.part-size";
+
+  /// Percentile of recent S3 or GCS part read latencies after which a part is
+  /// requested again and the first response is used. 0 disables hedging.
+  static constexpr const char* kRemoteReadHedgePercentile =
+      "hive.remote-read.hedge-percentile";
+
+  /// Minimum time in ms before a hedged part is requested again.
+  static constexpr const char* kRemoteReadMinHedgeDelayMs =
+      "hive.remote-read.min-hedge-delay-ms";
+
   /// Maps table field names to file field names using names, not indices.
   static constexpr const char* kOrcUseColumnNames = "hive.orc.use-column-names";
 
@@ -158,6 +177,14 @@ class HiveConfig {
 
   static std::string gcsCredentials(const Config* config);
 
+  static int32_t remoteReadThreads(const Config* config);
+
+  static uint64_t remoteReadPartSize(const Config* config);
+
+  static double remoteReadHedgePercentile(const Config* config);
+
+  static uint64_t remoteReadMinHedgeDelayMs(const Config* config);
+
   static bool isOrcUseColumnNames(const Config* config);
 
   static bool isFileColumnNamesReadAsLowerCase(const Config* config);
@@ -80,6 +80,20 @@ HiveConnector::HiveConnector(
   }
 }
 
+// static
+uint64_t HiveConnector::cachedBytes(
+    const HiveConnectorSplit& split,
+    cache::AsyncDataCache* cache) {
+  if (cache == nullptr) {
+    return 0;
+  }
+  const auto fileId = fileIds().id(split.filePath);
+  if (fileId == StringIdMap::kNoId) {
+    return 0;
+  }
+  return cache->summary()->cachedBytes(fileId, split.start, split.length);
+}
+
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<ConnectorTableHandle>& tableHandle,
@@ -17,6 +17,7 @@
 
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::dwio::common {
@@ -63,6 +64,14 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.cacheStats();
   }
 
+  /// Returns the estimated number of bytes of the file range of 'split' that
+  /// are in 'cache', in memory or on SSD. Schedulers use this for sending
+  /// splits to the workers that have their data cached. The estimate comes
+  /// from AsyncDataCache::summary() and may be a few seconds stale.
+  static uint64_t cachedBytes(
+      const HiveConnectorSplit& split,
+      cache::AsyncDataCache* cache);
+
   // NOTE: this is to clear file handle cache which might affect performance,
   // and is only used for operational purposes.
   FileHandleCacheStats clearFileHandleCache() {
@@ -16,11 +16,13 @@
 
 #include "velox/connectors/hive/storage_adapters/gcs/GCSFileSystem.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/ParallelRangeReader.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/gcs/GCSUtil.h"
 #include "velox/core/Config.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -58,12 +60,43 @@ inline void checkGCSStatus(
   }
 }
 
+// The assumption here is that "position" has space for at least "length"
+// bytes.
+void readObjectRange(
+    gcs::Client& client,
+    const std::string& bucket,
+    const std::string& key,
+    uint64_t offset,
+    uint64_t length,
+    char* position) {
+  gcs::ObjectReadStream stream =
+      client.ReadObject(bucket, key, gcs::ReadRange(offset, offset + length));
+  if (!stream) {
+    checkGCSStatus(stream.status(), "Failed to get GCS object", bucket, key);
+  }
+
+  stream.read(position, length);
+  if (!stream) {
+    checkGCSStatus(stream.status(), "Failed to get read object", bucket, key);
+  }
+}
+
 class GCSReadFile final : public ReadFile {
  public:
-  GCSReadFile(const std::string& path, std::shared_ptr<gcs::Client> client)
-      : client_(std::move(client)) {
+  // Reads through 'reader' if it is not null.
+  GCSReadFile(
+      const std::string& path,
+      std::shared_ptr<gcs::Client> client,
+      ParallelRangeReader* reader = nullptr)
+      : client_(std::move(client)), reader_(reader) {
     // assumption it's a proper path
     setBucketAndKeyFromGCSPath(path, bucket_, key_);
+    // Captures copies so that a hedged request that completes after its
+    // read does not reference 'this'.
+    read_ = [client = client_, bucket = bucket_, key = key_](
+                uint64_t offset, uint64_t length, char* position) {
+      readObjectRange(*client, bucket, key, offset, length, position);
+    };
   }
 
   // Gets the length of the file.
@@ -84,18 +117,28 @@ class GCSReadFile final : public ReadFile {
     }
     length_ = (*metadata).size();
     VELOX_CHECK_GE(length_, 0);
+    // The generation changes whenever the object is overwritten.
+    etag_ = std::to_string((*metadata).generation());
   }
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    if (reader_ != nullptr && reader_->isParallel(length)) {
+      reader_->preadv(
+          read_,
+          offset,
+          {folly::Range<char*>(static_cast<char*>(buffer), length)});
+      bytesRead_ += length;
+    } else {
+      preadInternal(offset, length, static_cast<char*>(buffer));
+    }
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
     char* position = result.data();
-    preadInternal(offset, length, position);
+    pread(offset, length, position);
     return result;
   }
 
@@ -106,6 +149,11 @@ class GCSReadFile final : public ReadFile {
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. If a range pointer is nullptr, the
     // data from stream of size range.size() will be skipped.
+    if (reader_ != nullptr) {
+      const auto length = reader_->preadv(read_, offset, buffers);
+      bytesRead_ += length;
+      return length;
+    }
     size_t length = 0;
     for (const auto range : buffers) {
       length += range.size();
@@ -122,10 +170,30 @@ class GCSReadFile final : public ReadFile {
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (reader_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    for (const auto& range : buffers) {
+      bytesRead_ += range.size();
+    }
+    return reader_->preadvAsync(read_, offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return reader_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
 
+  std::string etag() const override {
+    return etag_;
+  }
+
   uint64_t memoryUsage() const override {
     return sizeof(GCSReadFile) // this class
         + sizeof(gcs::Client) // pointee
@@ -148,25 +216,17 @@ class GCSReadFile final : public ReadFile {
   // The assumption here is that "position" has space for at least "length"
   // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    gcs::ObjectReadStream stream = client_->ReadObject(
-        bucket_, key_, gcs::ReadRange(offset, offset + length));
-    if (!stream) {
-      checkGCSStatus(
-          stream.status(), "Failed to get GCS object", bucket_, key_);
-    }
-
-    stream.read(position, length);
-    if (!stream) {
-      checkGCSStatus(
-          stream.status(), "Failed to get read object", bucket_, key_);
-    }
+    readObjectRange(*client_, bucket_, key_, offset, length, position);
     bytesRead_ += length;
   }
 
   std::shared_ptr<gcs::Client> client_;
+  ParallelRangeReader* const reader_;
   std::string bucket_;
   std::string key_;
+  ParallelRangeReader::ReadFunction read_;
   std::atomic<int64_t> length_ = -1;
+  std::string etag_;
 };
 
 class GCSWriteFile final : public WriteFile {
@@ -247,9 +307,29 @@ auto constexpr kGCSInvalidPath = "File {} is not a valid gcs file";
 
 class GCSFileSystem::Impl {
  public:
-  Impl(const Config* config) : config_(config) {}
+  Impl(const Config* config) : config_(config) {
+    ParallelRangeReader::Options readerOptions;
+    readerOptions.partSize = HiveConfig::remoteReadPartSize(config_);
+    readerOptions.hedgePercentile =
+        HiveConfig::remoteReadHedgePercentile(config_);
+    readerOptions.minHedgeDelayMs =
+        HiveConfig::remoteReadMinHedgeDelayMs(config_);
+    if (readerOptions.partSize > 0 || readerOptions.hedgePercentile > 0) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          HiveConfig::remoteReadThreads(config_));
+      reader_ = std::make_unique<ParallelRangeReader>(
+          readExecutor_.get(), readerOptions);
+    }
+  }
 
-  ~Impl() = default;
+  ~Impl() {
+    if (readExecutor_ != nullptr) {
+      // Waits for the requests in flight, including the losers of hedged
+      // reads.
+      readExecutor_->join();
+      reader_.reset();
+    }
+  }
 
   // Use the input Config parameters and initialize the GCSClient.
   void initializeClient() {
@@ -283,9 +363,17 @@ class GCSFileSystem::Impl {
     return client_;
   }
 
+  // Returns the reader for split and hedged reads or nullptr if these are
+  // disabled.
+  ParallelRangeReader* reader() const {
+    return reader_.get();
+  }
+
  private:
   const Config* FOLLY_NONNULL config_;
   std::shared_ptr<gcs::Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  std::unique_ptr<ParallelRangeReader> reader_;
 };
 
 GCSFileSystem::GCSFileSystem(std::shared_ptr<const Config> config)
@@ -301,7 +389,8 @@ std::unique_ptr<ReadFile> GCSFileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto gcspath = gcsPath(path);
-  auto gcsfile = std::make_unique<GCSReadFile>(gcspath, impl_->getClient());
+  auto gcsfile = std::make_unique<GCSReadFile>(
+      gcspath, impl_->getClient(), impl_->reader());
   gcsfile->initialize();
   return gcsfile;
 }
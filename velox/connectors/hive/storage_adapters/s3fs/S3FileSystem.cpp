@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "velox/common/file/File.h"
+#include "velox/common/file/ParallelRangeReader.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -23,6 +24,7 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -69,12 +71,45 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// The assumption here is that "position" has space for at least "length"
+// bytes.
+void getObjectRange(
+    Aws::S3::S3Client* client,
+    const std::string& bucket,
+    const std::string& key,
+    uint64_t offset,
+    uint64_t length,
+    char* position) {
+  // Read the desired range of bytes.
+  Aws::S3::Model::GetObjectRequest request;
+  Aws::S3::Model::GetObjectResult result;
+
+  request.SetBucket(awsString(bucket));
+  request.SetKey(awsString(key));
+  std::stringstream ss;
+  ss << "bytes=" << offset << "-" << offset + length - 1;
+  request.SetRange(awsString(ss.str()));
+  request.SetResponseStreamFactory(AwsWriteableStreamFactory(position, length));
+  auto outcome = client->GetObject(request);
+  VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket, key);
+}
+
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // Reads through 'reader' if it is not null.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      ParallelRangeReader* reader = nullptr)
+      : client_(client), reader_(reader) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
+    // Captures copies so that a hedged request that completes after its
+    // read does not reference 'this'.
+    read_ = [client, bucket = bucket_, key = key_](
+                uint64_t offset, uint64_t length, char* position) {
+      getObjectRange(client, bucket, key, offset, length, position);
+    };
   }
 
   // Gets the length of the file.
@@ -94,18 +129,26 @@ class S3ReadFile final : public ReadFile {
         outcome, "Failed to get metadata for S3 object", bucket_, key_);
     length_ = outcome.GetResult().GetContentLength();
     VELOX_CHECK_GE(length_, 0);
+    etag_ = outcome.GetResult().GetETag();
   }
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    if (reader_ != nullptr && reader_->isParallel(length)) {
+      reader_->preadv(
+          read_,
+          offset,
+          {folly::Range<char*>(static_cast<char*>(buffer), length)});
+    } else {
+      preadInternal(offset, length, static_cast<char*>(buffer));
+    }
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
     char* position = result.data();
-    preadInternal(offset, length, position);
+    pread(offset, length, position);
     return result;
   }
 
@@ -118,6 +161,10 @@ class S3ReadFile final : public ReadFile {
     // multi-range. AWS S3 also charges by number of read requests and not size.
     // The idea here is to use a single read spanning all the ranges and then
     // populate individual ranges. We pre-allocate a buffer to support this.
+    // With a ParallelRangeReader, the spanning range may be read in parts.
+    if (reader_ != nullptr) {
+      return reader_->preadv(read_, offset, buffers);
+    }
     size_t length = 0;
     for (const auto range : buffers) {
       length += range.size();
@@ -135,10 +182,27 @@ class S3ReadFile final : public ReadFile {
     return length;
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (reader_ == nullptr) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    return reader_->preadvAsync(read_, offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return reader_ != nullptr;
+  }
+
   uint64_t size() const override {
     return length_;
   }
 
+  std::string etag() const override {
+    return etag_;
+  }
+
   uint64_t memoryUsage() const override {
     // TODO: Check if any buffers are being used by the S3 library
     return sizeof(Aws::S3::S3Client) + kS3MaxKeySize + 2 * sizeof(std::string) +
@@ -158,28 +222,17 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
-  // The assumption here is that "position" has space for at least "length"
-  // bytes.
   void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
-
-    request.SetBucket(awsString(bucket_));
-    request.SetKey(awsString(key_));
-    std::stringstream ss;
-    ss << "bytes=" << offset << "-" << offset + length - 1;
-    request.SetRange(awsString(ss.str()));
-    request.SetResponseStreamFactory(
-        AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
-    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    getObjectRange(client_, bucket_, key_, offset, length, position);
   }
 
   Aws::S3::S3Client* client_;
+  ParallelRangeReader* const reader_;
   std::string bucket_;
   std::string key_;
+  ParallelRangeReader::ReadFunction read_;
   int64_t length_ = -1;
+  std::string etag_;
 };
 
 Aws::Utils::Logging::LogLevel inferS3LogLevel(std::string level) {
@@ -524,10 +577,29 @@ class S3FileSystem::Impl {
         clientConfig,
         Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
         HiveConfig::s3UseVirtualAddressing(config_));
+
+    ParallelRangeReader::Options readerOptions;
+    readerOptions.partSize = HiveConfig::remoteReadPartSize(config_);
+    readerOptions.hedgePercentile =
+        HiveConfig::remoteReadHedgePercentile(config_);
+    readerOptions.minHedgeDelayMs =
+        HiveConfig::remoteReadMinHedgeDelayMs(config_);
+    if (readerOptions.partSize > 0 || readerOptions.hedgePercentile > 0) {
+      readExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          HiveConfig::remoteReadThreads(config_));
+      reader_ = std::make_unique<ParallelRangeReader>(
+          readExecutor_.get(), readerOptions);
+    }
     ++fileSystemCount;
   }
 
   ~Impl() {
+    if (readExecutor_ != nullptr) {
+      // Waits for the requests in flight, including the losers of hedged
+      // reads, which use 'client_'.
+      readExecutor_->join();
+      reader_.reset();
+    }
     client_.reset();
     --fileSystemCount;
   }
@@ -606,9 +678,17 @@ class S3FileSystem::Impl {
     return getAwsInstance()->getLogLevelName();
   }
 
+  // Returns the reader for split and hedged reads or nullptr if these are
+  // disabled.
+  ParallelRangeReader* reader() const {
+    return reader_.get();
+  }
+
  private:
   const Config* config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> readExecutor_;
+  std::unique_ptr<ParallelRangeReader> reader_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -624,7 +704,8 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file =
+      std::make_unique<S3ReadFile>(file, impl_->s3Client(), impl_->reader());
   s3file->initialize();
   return s3file;
 }
@@ -15,11 +15,22 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/benchmark/S3ReadBenchmark.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/Config.h"
 
 #include <fstream>
 
 DEFINE_string(s3_config, "", "Path of S3 config file");
+DEFINE_uint64(
+    s3_part_size,
+    0,
+    "If not 0, reads of at least twice this many bytes are split into parts "
+    "of about this size that are read in parallel");
+DEFINE_double(
+    s3_hedge_percentile,
+    0,
+    "If not 0, a part that is not read after this percentile of recent part "
+    "latencies is requested again");
 
 namespace facebook::velox {
 
@@ -47,4 +58,21 @@ std::shared_ptr<Config> readConfig(const std::string& filePath) {
   return std::make_shared<facebook::velox::core::MemConfig>(properties);
 }
 
+std::shared_ptr<Config> makeS3Config() {
+  std::unordered_map<std::string, std::string> properties;
+  if (!FLAGS_s3_config.empty()) {
+    properties = readConfig(FLAGS_s3_config)->valuesCopy();
+  }
+  using connector::hive::HiveConfig;
+  if (FLAGS_s3_part_size > 0) {
+    properties[HiveConfig::kRemoteReadPartSize] =
+        std::to_string(FLAGS_s3_part_size);
+  }
+  if (FLAGS_s3_hedge_percentile > 0) {
+    properties[HiveConfig::kRemoteReadHedgePercentile] =
+        std::to_string(FLAGS_s3_hedge_percentile);
+  }
+  return std::make_shared<core::MemConfig>(std::move(properties));
+}
+
 } // namespace facebook::velox
@@ -24,6 +24,10 @@ namespace facebook::velox {
 
 std::shared_ptr<Config> readConfig(const std::string& filePath);
 
+// Returns the config from --s3_config with the split and hedged read settings
+// from --s3_part_size and --s3_hedge_percentile.
+std::shared_ptr<Config> makeS3Config();
+
 class S3ReadBenchmark : public ReadBenchmark {
  public:
   // Initialize a S3ReadFile instance for the specified 'path'.
@@ -32,11 +36,7 @@ class S3ReadBenchmark : public ReadBenchmark {
         std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_threads);
 
     filesystems::registerS3FileSystem();
-    std::shared_ptr<Config> config;
-    if (!FLAGS_s3_config.empty()) {
-      config = readConfig(FLAGS_s3_config);
-    }
-    auto s3fs = filesystems::getFileSystem(FLAGS_path, config);
+    auto s3fs = filesystems::getFileSystem(FLAGS_path, makeS3Config());
     readFile_ = s3fs->openFileForRead(FLAGS_path);
 
     fileSize_ = readFile_->size();
@@ -22,6 +22,9 @@
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+
 using namespace facebook::velox;
 
 TEST(FileHandleTest, localFile) {
@@ -48,3 +51,45 @@ TEST(FileHandleTest, localFile) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, localFileIdentity) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path;
+  const auto writeFile = [&](std::string_view data, int64_t seconds) {
+    remove(filename.c_str());
+    {
+      LocalWriteFile file(filename);
+      file.append(data);
+    }
+    const struct timespec times[2] = {{seconds, 0}, {seconds, 0}};
+    ASSERT_EQ(0, utimensat(AT_FDCWD, filename.c_str(), times, 0));
+  };
+  const auto generate = [&]() {
+    FileHandleFactory factory(
+        std::make_unique<
+            SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(1000),
+        std::make_unique<FileHandleGenerator>());
+    return factory.generate(filename).second;
+  };
+
+  writeFile("foo", 1'000'000);
+  auto fileHandle = generate();
+  auto identity = fileIdentity(fileHandle->uuid.id());
+  ASSERT_TRUE(identity.has_value());
+  EXPECT_EQ(3, identity->size);
+  EXPECT_EQ(1'000'000'000'000'000L, identity->modificationTime);
+  EXPECT_EQ(identity->modificationTime, fileHandle->file->modificationTime());
+
+  // A rewrite with the same size is told apart by the modification time, so
+  // that cached data of the previous version gets dropped.
+  writeFile("bar", 2'000'000);
+  fileHandle = generate();
+  const auto newIdentity = fileIdentity(fileHandle->uuid.id());
+  ASSERT_TRUE(newIdentity.has_value());
+  EXPECT_EQ(identity->size, newIdentity->size);
+  EXPECT_NE(identity.value(), newIdentity.value());
+
+  remove(filename.c_str());
+}
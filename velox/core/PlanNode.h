@@ -1756,6 +1756,10 @@ class TopNNode : public PlanNode {
     return isPartial_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return !isPartial_ && queryConfig.topNSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TopN";
   }
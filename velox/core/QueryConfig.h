@@ -54,6 +54,29 @@ class QueryConfig {
   static constexpr const char* kQueryMaxMemoryPerNode =
       "query_max_memory_per_node";
 
+  /// Priority of the query in memory arbitration. The memory arbitrator
+  /// reclaims from and aborts the queries with lower priority first and never
+  /// takes memory from a query with higher priority than the requestor, e.g.
+  /// interactive queries with priority 1 over batch queries with priority 0.
+  static constexpr const char* kQueryPriority = "query_priority";
+
+  /// Priority of the query in CPU scheduling by a DriverScheduler. The Drivers
+  /// of a query with a positive scheduling priority are scheduled as
+  /// interactive work regardless of how long the query has run. Independent
+  /// of 'query_priority'.
+  static constexpr const char* kQuerySchedulingPriority =
+      "query_scheduling_priority";
+
+  /// CPU time a Task may use per 'task_cpu_quota_period_ms', in cores. E.g.
+  /// 2 lets the Drivers of a Task use 2 cores worth of CPU time per period.
+  /// The Drivers of a Task that has used up its quota are paused at the next
+  /// operator boundary until the start of the next period. 0 means no quota.
+  static constexpr const char* kTaskCpuQuota = "task_cpu_quota";
+
+  /// Length of the period over which 'task_cpu_quota' is enforced.
+  static constexpr const char* kTaskCpuQuotaPeriodMs =
+      "task_cpu_quota_period_ms";
+
   static constexpr const char* kCodegenConfigurationFilePath =
       "codegen.configuration_file_path";
 
@@ -125,6 +148,12 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// If true, LocalPartition enqueues each input once for all partitions and
+  /// gives each consumer the row numbers of its partition. Consumers receive
+  /// dictionary wrappers over the shared input instead of a copy of its rows.
+  static constexpr const char* kLocalExchangeSharedBuffer =
+      "local_exchange_shared_buffer";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
@@ -156,6 +185,22 @@ class QueryConfig {
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// If true, PartitionedOutput serializes dictionary and constant encoded
+  /// scalar columns as dictionaries of the distinct values of each page
+  /// instead of flattening them.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
+  /// Compression codec of the pages of remote exchanges. Both the producer
+  /// and the consumer of an exchange must have the same setting.
+  static constexpr const char* kExchangeCompressionKind =
+      "exchange_compression_codec";
+
+  /// If true, the columns of compressed exchange pages are compressed
+  /// separately and sent uncompressed if they do not compress well.
+  static constexpr const char* kExchangeColumnarCompression =
+      "exchange_columnar_compression";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -219,6 +264,10 @@ class QueryConfig {
   static constexpr const char* kTopNRowNumberSpillEnabled =
       "topn_row_number_spill_enabled";
 
+  /// TopN spilling flag, only applies if "spill_enabled" flag is set. A
+  /// partial TopN never spills.
+  static constexpr const char* kTopNSpillEnabled = "topn_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
@@ -267,6 +316,11 @@ class QueryConfig {
   static constexpr const char* kSpillWriteBufferSize =
       "spill_write_buffer_size";
 
+  /// The memory budget in bytes for reading ahead the spill files of a sorted
+  /// spill merge. It is divided among the merged files. If it is set to zero,
+  /// then spill read-ahead is disabled.
+  static constexpr const char* kSpillReadAheadBytes = "spill_read_ahead_bytes";
+
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
 
@@ -322,6 +376,34 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// If true, the hash join build makes a Bloom filter for each integer join
+  /// key for which there is no exact dynamic filter, i.e. when the keys have
+  /// too many distinct values. The Bloom filters are pushed down to the probe
+  /// side table scan like other dynamic filters.
+  static constexpr const char* kHashJoinBloomFilterEnabled =
+      "hash_join_bloom_filter_enabled";
+
+  /// The max total size in bytes of the Bloom filters made by a hash join
+  /// build. No Bloom filter is made for larger build sides.
+  static constexpr const char* kHashJoinBloomFilterMaxBytes =
+      "hash_join_bloom_filter_max_bytes";
+
+  /// The table scan stops testing a join Bloom filter if more than this
+  /// fraction of the tested values pass it.
+  static constexpr const char* kHashJoinBloomFilterMaxPassRate =
+      "hash_join_bloom_filter_max_pass_rate";
+
+  /// The max number of bytes of the normalized key prefix that OrderBy and
+  /// Window encode for each row to speed up sorting. The leading sort keys
+  /// that fit in the prefix are compared with memcmp and the remaining keys
+  /// are only compared on prefix ties. Zero disables prefix sort.
+  static constexpr const char* kPrefixSortNormalizedKeyMaxBytes =
+      "prefixsort_normalized_key_max_bytes";
+
+  /// The minimum number of rows for sorting with prefix sort. Smaller inputs
+  /// are sorted by comparing the keys in the RowContainer.
+  static constexpr const char* kPrefixSortMinRows = "prefixsort_min_rows";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -343,6 +425,22 @@ class QueryConfig {
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
   }
 
+  int32_t queryPriority() const {
+    return get<int32_t>(kQueryPriority, 0);
+  }
+
+  int32_t querySchedulingPriority() const {
+    return get<int32_t>(kQuerySchedulingPriority, 0);
+  }
+
+  double taskCpuQuota() const {
+    return get<double>(kTaskCpuQuota, 0);
+  }
+
+  uint64_t taskCpuQuotaPeriodMs() const {
+    return get<uint64_t>(kTaskCpuQuotaPeriodMs, 100);
+  }
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -393,11 +491,27 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
+  std::string exchangeCompressionKind() const {
+    return get<std::string>(kExchangeCompressionKind, "none");
+  }
+
+  bool exchangeColumnarCompression() const {
+    return get<bool>(kExchangeColumnarCompression, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  bool localExchangeSharedBuffer() const {
+    return get<bool>(kLocalExchangeSharedBuffer, false);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
@@ -530,6 +644,12 @@ class QueryConfig {
     return get<bool>(kTopNRowNumberSpillEnabled, true);
   }
 
+  /// Returns true if spilling is enabled for TopN operator. Must also check the
+  /// spillEnabled()!
+  bool topNSpillEnabled() const {
+    return get<bool>(kTopNSpillEnabled, true);
+  }
+
   /// Returns a percentage of aggregation or join input batches that will be
   /// forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -584,6 +704,10 @@ class QueryConfig {
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
   }
 
+  uint64_t spillReadAheadBytes() const {
+    return get<uint64_t>(kSpillReadAheadBytes, 0);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -662,6 +786,26 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  bool hashJoinBloomFilterEnabled() const {
+    return get<bool>(kHashJoinBloomFilterEnabled, false);
+  }
+
+  uint64_t hashJoinBloomFilterMaxBytes() const {
+    return get<uint64_t>(kHashJoinBloomFilterMaxBytes, 16UL << 20);
+  }
+
+  double hashJoinBloomFilterMaxPassRate() const {
+    return get<double>(kHashJoinBloomFilterMaxPassRate, 0.7);
+  }
+
+  uint32_t prefixSortNormalizedKeyMaxBytes() const {
+    return get<uint32_t>(kPrefixSortNormalizedKeyMaxBytes, 0);
+  }
+
+  uint32_t prefixSortMinRows() const {
+    return get<uint32_t>(kPrefixSortMinRows, 128);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
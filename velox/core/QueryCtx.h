@@ -89,6 +89,11 @@ class QueryCtx {
     return queryConfig_;
   }
 
+  /// Returns the priority of the query in memory arbitration.
+  int32_t priority() const {
+    return queryConfig_.queryPriority();
+  }
+
   Config* getConnectorConfig(const std::string& connectorId) const {
     auto it = connectorConfigs_.find(connectorId);
     if (it == connectorConfigs_.end()) {
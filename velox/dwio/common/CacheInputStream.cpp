@@ -241,11 +241,11 @@ bool CacheInputStream::loadFromSsd(
   if (ssdPin.empty()) {
     return false;
   }
-  if (ssdPin.run().size() < entry.size()) {
+  if (ssdPin.run().dataSize() < entry.size()) {
     LOG(INFO) << fmt::format(
         "IOERR: Ssd entry for {} shorter than requested {}",
         entry.toString(),
-        ssdPin.run().size());
+        ssdPin.run().dataSize());
     return false;
   }
   uint64_t usec = 0;
@@ -192,9 +192,10 @@ void CachedBufferedInput::load(const LogType) {
           if (ssdFile) {
             part->ssdPin = ssdFile->find(part->key);
             if (!part->ssdPin.empty() &&
-                part->ssdPin.run().size() < part->size) {
+                part->ssdPin.run().dataSize() < part->size) {
               LOG(INFO) << "IOERR: Ignoring SSD shorter than requested: "
-                        << part->ssdPin.run().size() << " vs " << part->size;
+                        << part->ssdPin.run().dataSize() << " vs "
+                        << part->size;
               part->ssdPin.clear();
             }
             if (!part->ssdPin.empty()) {
@@ -401,18 +402,50 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
     if (pins.empty()) {
       return pins;
     }
-    auto stats = cache::readPins(
-        pins,
-        maxCoalesceDistance_,
-        1000,
-        [&](int32_t i) { return pins[i].entry()->offset(); },
-        [&](const std::vector<CachePin>& /*pins*/,
-            int32_t /*begin*/,
-            int32_t /*end*/,
-            uint64_t offset,
-            const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
-        });
+    // If the input reads asynchronously, the coalesced ranges are read in
+    // parallel and waited for together.
+    const bool readAsync = input_->hasReadAsync();
+    std::vector<folly::SemiFuture<uint64_t>> reads;
+    std::vector<uint64_t> readSizes;
+    CoalesceIoStats stats;
+    try {
+      stats = cache::readPins(
+          pins,
+          maxCoalesceDistance_,
+          1000,
+          [&](int32_t i) { return pins[i].entry()->offset(); },
+          [&](const std::vector<CachePin>& /*pins*/,
+              int32_t /*begin*/,
+              int32_t /*end*/,
+              uint64_t offset,
+              const std::vector<folly::Range<char*>>& buffers) {
+            if (!readAsync) {
+              input_->read(buffers, offset, LogType::FILE);
+              return;
+            }
+            uint64_t size = 0;
+            for (const auto& buffer : buffers) {
+              size += buffer.size();
+            }
+            readSizes.push_back(size);
+            reads.push_back(input_->readAsync(buffers, offset, LogType::FILE));
+          });
+    } catch (const std::exception&) {
+      // The reads issued so far write into the pins, which are freed after
+      // the error.
+      folly::collectAll(std::move(reads)).wait();
+      throw;
+    }
+    if (!reads.empty()) {
+      auto results = folly::collectAll(std::move(reads)).get();
+      for (auto i = 0; i < results.size(); ++i) {
+        VELOX_CHECK_EQ(
+            results[i].value(),
+            readSizes[i],
+            "Short read from {}",
+            input_->getName());
+      }
+    }
     updateStats(stats, isPrefetch, false);
     return pins;
   }
@@ -249,6 +249,7 @@ class E2EWriterTest : public testing::Test {
         0,
         0,
         0,
+        0,
         nullptr,
         minSpillableReservationPct,
         spillableReservationGrowthPct,
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/base/RawVector.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+#include "velox/dwio/common/DecoderUtil.h"
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the DELTA_BINARY_PACKED encoding of INT32 and INT64
+/// columns. The data consists of a header with the first value followed by
+/// blocks. Each block has a minimum delta and a number of miniblocks of bit
+/// packed deltas, each with its own bit width. Decoding is done a miniblock
+/// at a time into a contiguous buffer of values from which the visitor is
+/// fed. The bit unpacking of miniblocks up to 32 bits wide uses the
+/// vectorized unpack of dwio::common.
+class DeltaBpDecoder {
+ public:
+  explicit DeltaBpDecoder(const char* FOLLY_NONNULL start)
+      : bufferStart_(start) {
+    readHeader();
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    while (numValues > 0) {
+      if (valueIndex_ == numBufferedValues_) {
+        readMiniBlock();
+      }
+      auto numSkipped =
+          std::min<int32_t>(numValues, numBufferedValues_ - valueIndex_);
+      valueIndex_ += numSkipped;
+      numValues -= numSkipped;
+    }
+  }
+
+  template <typename T>
+  T readValue() {
+    if (valueIndex_ == numBufferedValues_) {
+      readMiniBlock();
+    }
+    return static_cast<T>(values_[valueIndex_++]);
+  }
+
+  /// Reads the next 'numValues' values into 'result'.
+  template <typename T>
+  void bulkRead(uint64_t numValues, T* FOLLY_NONNULL result) {
+    while (numValues > 0) {
+      if (valueIndex_ == numBufferedValues_) {
+        readMiniBlock();
+      }
+      auto numRead =
+          std::min<uint64_t>(numValues, numBufferedValues_ - valueIndex_);
+      auto values = values_.data() + valueIndex_;
+      for (auto i = 0; i < numRead; ++i) {
+        result[i] = static_cast<T>(values[i]);
+      }
+      result += numRead;
+      valueIndex_ += numRead;
+      numValues -= numRead;
+    }
+  }
+
+  /// Reads the values at positions 'rows' into 'result'. 'initialRow' is the
+  /// row number of the first unread value of 'this'.
+  template <typename T>
+  void bulkReadRows(
+      RowSet rows,
+      T* FOLLY_NONNULL result,
+      int32_t initialRow = 0) {
+    auto current = initialRow;
+    for (auto i = 0; i < rows.size(); ++i) {
+      skip(rows[i] - current);
+      result[i] = readValue<T>();
+      current = rows[i] + 1;
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(
+      const uint64_t* FOLLY_NULLABLE nulls,
+      Visitor visitor,
+      bool useFastPath = true) {
+    using T = typename Visitor::DataType;
+    if constexpr (
+        std::is_integral_v<T> && !std::is_same_v<T, int128_t> &&
+        !std::is_same_v<T, bool>) {
+      if (useFastPath &&
+          dwio::common::useFastPath<Visitor, hasNulls>(visitor)) {
+        fastPath<hasNulls>(nulls, visitor);
+        return;
+      }
+    }
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      bool atEnd = false;
+      int32_t toSkip;
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+        toSkip = visitor.process(readValue<T>(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the number of values in the encoded data.
+  int64_t totalValueCount() const {
+    return totalValueCount_;
+  }
+
+  /// Returns the first byte after the miniblocks decoded so far. After all
+  /// values are read this is the first byte after the encoded data.
+  const char* FOLLY_NONNULL bufferStart() const {
+    return bufferStart_;
+  }
+
+ private:
+  static constexpr int32_t kMaxBitWidth = 64;
+
+  template <bool hasNulls, typename Visitor>
+  void fastPath(const uint64_t* FOLLY_NULLABLE nulls, Visitor& visitor) {
+    using T = typename Visitor::DataType;
+    constexpr bool hasFilter =
+        !std::
+            is_same_v<typename Visitor::FilterType, velox::common::AlwaysTrue>;
+    constexpr bool filterOnly =
+        std::is_same_v<typename Visitor::Extract, dwio::common::DropValues>;
+    constexpr bool hasHook =
+        !std::is_same_v<typename Visitor::HookType, dwio::common::NoHook>;
+
+    int32_t numValues = 0;
+    auto rows = visitor.rows();
+    auto numRows = visitor.numRows();
+    auto rowsAsRange = folly::Range<const int32_t*>(rows, numRows);
+    auto data = visitor.rawValues(numRows);
+    if (hasNulls) {
+      int32_t tailSkip = 0;
+      raw_vector<int32_t>* innerVector = nullptr;
+      auto outerVector = &visitor.outerNonNullRows();
+      if (Visitor::dense || rowsAsRange.back() == rowsAsRange.size() - 1) {
+        dwio::common::nonNullRowsFromDense(nulls, numRows, *outerVector);
+        if (outerVector->empty()) {
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkRead(outerVector->size(), data);
+      } else {
+        innerVector = &visitor.innerNonNullRows();
+        auto anyNulls = dwio::common::nonNullRowsFromSparse < hasFilter,
+             !hasFilter &&
+            !hasHook >
+                (nulls,
+                 rowsAsRange,
+                 *innerVector,
+                 *outerVector,
+                 (hasFilter || hasHook) ? nullptr : visitor.rawNulls(numRows),
+                 tailSkip);
+        if (anyNulls) {
+          visitor.setHasNulls();
+        }
+        if (innerVector->empty()) {
+          skip<false>(tailSkip, 0, nullptr);
+          visitor.setAllNull(hasFilter ? 0 : numRows);
+          return;
+        }
+        bulkReadRows(*innerVector, data);
+      }
+      skip<false>(tailSkip, 0, nullptr);
+      auto dataRows = innerVector
+          ? folly::Range<const int*>(innerVector->data(), innerVector->size())
+          : folly::Range<const int32_t*>(rows, outerVector->size());
+      dwio::common::processFixedWidthRun<T, filterOnly, true, Visitor::dense>(
+          dataRows,
+          0,
+          dataRows.size(),
+          outerVector->data(),
+          data,
+          hasFilter ? visitor.outputRows(numRows) : nullptr,
+          numValues,
+          visitor.filter(),
+          visitor.hook());
+    } else {
+      if (Visitor::dense) {
+        bulkRead(numRows, data);
+      } else {
+        bulkReadRows(rowsAsRange, data);
+      }
+      dwio::common::processFixedWidthRun<T, filterOnly, false, Visitor::dense>(
+          rowsAsRange,
+          0,
+          rowsAsRange.size(),
+          hasHook ? velox::iota(numRows, visitor.innerNonNullRows()) : nullptr,
+          data,
+          hasFilter ? visitor.outputRows(numRows) : nullptr,
+          numValues,
+          visitor.filter(),
+          visitor.hook());
+    }
+    visitor.setNumValues(hasFilter ? numValues : numRows);
+  }
+
+  uint64_t readUnsignedVarint() {
+    uint64_t result = 0;
+    for (int32_t shift = 0; shift < 64; shift += 7) {
+      auto byte = *reinterpret_cast<const uint8_t*>(bufferStart_++);
+      result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return result;
+      }
+    }
+    VELOX_FAIL("Invalid varint in DELTA_BINARY_PACKED data");
+  }
+
+  int64_t readZigZagVarint() {
+    auto value = readUnsignedVarint();
+    return static_cast<int64_t>((value >> 1) ^ -(value & 1));
+  }
+
+  void readHeader() {
+    valuesPerBlock_ = readUnsignedVarint();
+    miniBlocksPerBlock_ = readUnsignedVarint();
+    totalValueCount_ = readUnsignedVarint();
+    VELOX_CHECK(
+        miniBlocksPerBlock_ > 0 && valuesPerBlock_ % miniBlocksPerBlock_ == 0,
+        "Invalid DELTA_BINARY_PACKED block size {} for {} miniblocks",
+        valuesPerBlock_,
+        miniBlocksPerBlock_);
+    valuesPerMiniBlock_ = valuesPerBlock_ / miniBlocksPerBlock_;
+    VELOX_CHECK_EQ(
+        valuesPerMiniBlock_ % 32,
+        0,
+        "DELTA_BINARY_PACKED miniblock size must be a multiple of 32");
+    lastValue_ = readZigZagVarint();
+    values_.resize(std::max<int32_t>(valuesPerMiniBlock_, 1));
+    deltas_.resize(valuesPerMiniBlock_);
+    // The first value is in the header. It is served from 'values_' like the
+    // values of the miniblocks.
+    miniBlockIndex_ = miniBlocksPerBlock_;
+    if (totalValueCount_ > 0) {
+      values_[0] = lastValue_;
+      numBufferedValues_ = 1;
+      numDecodedValues_ = 1;
+    }
+  }
+
+  void readBlockHeader() {
+    minDelta_ = readZigZagVarint();
+    bitWidths_ = reinterpret_cast<const uint8_t*>(bufferStart_);
+    bufferStart_ += miniBlocksPerBlock_;
+    miniBlockIndex_ = 0;
+  }
+
+  // Decodes the next miniblock into 'values_'.
+  void readMiniBlock() {
+    VELOX_CHECK_LT(
+        numDecodedValues_,
+        totalValueCount_,
+        "Reading past end of DELTA_BINARY_PACKED data");
+    if (miniBlockIndex_ == miniBlocksPerBlock_) {
+      readBlockHeader();
+    }
+    auto bitWidth = bitWidths_[miniBlockIndex_++];
+    VELOX_CHECK_LE(bitWidth, kMaxBitWidth);
+    auto numValues = std::min<int64_t>(
+        valuesPerMiniBlock_, totalValueCount_ - numDecodedValues_);
+    auto input = reinterpret_cast<const uint8_t*>(bufferStart_);
+    // Miniblocks are padded to the full size, also the last one.
+    auto numBytes = static_cast<uint64_t>(valuesPerMiniBlock_) * bitWidth / 8;
+    bufferStart_ += numBytes;
+    if (bitWidth == 0) {
+      accumulate<uint32_t>(nullptr, numValues);
+    } else if (bitWidth <= 32) {
+      auto output = reinterpret_cast<uint32_t*>(deltas_.data());
+      dwio::common::unpack<uint32_t>(
+          input, numBytes, valuesPerMiniBlock_, bitWidth, output);
+      accumulate(reinterpret_cast<const uint32_t*>(deltas_.data()), numValues);
+    } else {
+      unpackWide(input, numValues, bitWidth, deltas_.data());
+      accumulate(deltas_.data(), numValues);
+    }
+    numDecodedValues_ += numValues;
+    numBufferedValues_ = numValues;
+    valueIndex_ = 0;
+  }
+
+  // Computes the values of the current miniblock from the previous value,
+  // 'minDelta_' and 'deltas'. A null 'deltas' means all deltas are 0. The
+  // arithmetic is done in unsigned 64 bit and wraps around as the encoding
+  // requires.
+  template <typename T>
+  void accumulate(const T* FOLLY_NULLABLE deltas, int32_t numValues) {
+    auto value = static_cast<uint64_t>(lastValue_);
+    auto minDelta = static_cast<uint64_t>(minDelta_);
+    auto values = values_.data();
+    if (deltas == nullptr) {
+      for (auto i = 0; i < numValues; ++i) {
+        value += minDelta;
+        values[i] = static_cast<int64_t>(value);
+      }
+    } else {
+      for (auto i = 0; i < numValues; ++i) {
+        value += minDelta + static_cast<uint64_t>(deltas[i]);
+        values[i] = static_cast<int64_t>(value);
+      }
+    }
+    lastValue_ = static_cast<int64_t>(value);
+  }
+
+  // Unpacks 'numValues' little endian bit fields of more than 32 bits. Reads
+  // only the bytes covered by the fields.
+  static void unpackWide(
+      const uint8_t* FOLLY_NONNULL input,
+      int32_t numValues,
+      uint8_t bitWidth,
+      uint64_t* FOLLY_NONNULL result) {
+    uint64_t bitOffset = 0;
+    for (auto i = 0; i < numValues; ++i) {
+      uint64_t value = 0;
+      int32_t numBits = 0;
+      while (numBits < bitWidth) {
+        auto bitInByte = bitOffset & 7;
+        auto numTaken = std::min<int32_t>(8 - bitInByte, bitWidth - numBits);
+        uint64_t byteBits =
+            (input[bitOffset / 8] >> bitInByte) & ((1 << numTaken) - 1);
+        value |= byteBits << numBits;
+        numBits += numTaken;
+        bitOffset += numTaken;
+      }
+      result[i] = value;
+    }
+  }
+
+  const char* FOLLY_NONNULL bufferStart_;
+
+  uint64_t valuesPerBlock_{0};
+  uint64_t miniBlocksPerBlock_{0};
+  uint64_t valuesPerMiniBlock_{0};
+  int64_t totalValueCount_{0};
+
+  // Number of values decoded into 'values_' so far, including the first value
+  // from the header.
+  int64_t numDecodedValues_{0};
+
+  // Last decoded value. Deltas of the next miniblock are added to this.
+  int64_t lastValue_{0};
+
+  // Minimum delta of the current block.
+  int64_t minDelta_{0};
+
+  // Bit widths of the miniblocks of the current block.
+  const uint8_t* FOLLY_NULLABLE bitWidths_{nullptr};
+
+  // Index of the next miniblock in the current block.
+  uint64_t miniBlockIndex_{0};
+
+  // Values of the current miniblock.
+  raw_vector<int64_t> values_;
+
+  // Unpacked deltas of the current miniblock. Used as uint32_t for bit widths
+  // up to 32.
+  raw_vector<uint64_t> deltas_;
+
+  // Number of valid values in 'values_'.
+  int32_t numBufferedValues_{0};
+
+  // Index of the next value to read in 'values_'.
+  int32_t valueIndex_{0};
+};
+
+} // namespace facebook::velox::parquet
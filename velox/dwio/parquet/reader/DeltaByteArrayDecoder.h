@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
+
+#include <string>
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the DELTA_BYTE_ARRAY encoding, also known as incremental or
+/// front compression. Each value is stored as the length of the prefix it
+/// shares with the previous value followed by the remaining suffix. The
+/// prefix lengths are DELTA_BINARY_PACKED and the suffixes are
+/// DELTA_LENGTH_BYTE_ARRAY. Since every value depends on the previous one,
+/// skipping reconstructs the skipped values. The returned ranges are valid
+/// until the next value is read.
+class DeltaByteArrayDecoder {
+ public:
+  explicit DeltaByteArrayDecoder(const char* FOLLY_NONNULL start)
+      : suffixDecoder_(decodePrefixLengths(start)) {}
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    for (auto i = 0; i < numValues; ++i) {
+      readString();
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  /// Returns the number of non-null values in the page.
+  int32_t numValues() const {
+    return prefixLengths_.size();
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(prefixIndex_, prefixLengths_.size());
+    auto prefixLength = prefixLengths_[prefixIndex_++];
+    VELOX_CHECK_LE(
+        prefixLength,
+        lastValue_.size(),
+        "DELTA_BYTE_ARRAY prefix longer than previous value");
+    auto suffix = suffixDecoder_.readString();
+    lastValue_.resize(prefixLength);
+    lastValue_.append(suffix.data(), suffix.size());
+    return folly::StringPiece(lastValue_);
+  }
+
+ private:
+  // Decodes the prefix lengths into 'prefixLengths_' and returns the start of
+  // the suffixes.
+  const char* FOLLY_NONNULL decodePrefixLengths(
+      const char* FOLLY_NONNULL start) {
+    DeltaBpDecoder prefixDecoder(start);
+    auto numPrefixes = prefixDecoder.totalValueCount();
+    prefixLengths_.resize(numPrefixes);
+    prefixDecoder.bulkRead(numPrefixes, prefixLengths_.data());
+    return prefixDecoder.bufferStart();
+  }
+
+  raw_vector<int32_t> prefixLengths_;
+
+  // Index of the next value in 'prefixLengths_'.
+  int32_t prefixIndex_{0};
+
+  DeltaLengthByteArrayDecoder suffixDecoder_;
+
+  // The previously returned value. The next value shares a prefix with this.
+  std::string lastValue_;
+};
+
+} // namespace facebook::velox::parquet
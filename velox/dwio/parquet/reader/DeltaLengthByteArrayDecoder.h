@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <folly/Range.h>
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the DELTA_LENGTH_BYTE_ARRAY encoding. The lengths of all values
+/// are DELTA_BINARY_PACKED at the start of the data and are followed by the
+/// concatenated bytes of the values. The lengths are decoded in bulk at
+/// construction, after which values are returned as ranges of the page data
+/// without copying.
+class DeltaLengthByteArrayDecoder {
+ public:
+  explicit DeltaLengthByteArrayDecoder(const char* FOLLY_NONNULL start) {
+    DeltaBpDecoder lengthDecoder(start);
+    auto numLengths = lengthDecoder.totalValueCount();
+    lengths_.resize(numLengths);
+    lengthDecoder.bulkRead(numLengths, lengths_.data());
+    bufferStart_ = lengthDecoder.bufferStart();
+  }
+
+  void skip(uint64_t numValues) {
+    skip<false>(numValues, 0, nullptr);
+  }
+
+  template <bool hasNulls>
+  inline void skip(
+      int32_t numValues,
+      int32_t current,
+      const uint64_t* FOLLY_NULLABLE nulls) {
+    if (hasNulls) {
+      numValues = bits::countNonNulls(nulls, current, current + numValues);
+    }
+    VELOX_DCHECK_LE(lengthIndex_ + numValues, lengths_.size());
+    for (auto i = 0; i < numValues; ++i) {
+      bufferStart_ += lengths_[lengthIndex_++];
+    }
+  }
+
+  template <bool hasNulls, typename Visitor>
+  void readWithVisitor(const uint64_t* FOLLY_NULLABLE nulls, Visitor visitor) {
+    int32_t current = visitor.start();
+    skip<hasNulls>(current, 0, nulls);
+    int32_t toSkip;
+    bool atEnd = false;
+    const bool allowNulls = hasNulls && visitor.allowNulls();
+    for (;;) {
+      if (hasNulls && allowNulls && bits::isBitNull(nulls, current)) {
+        toSkip = visitor.processNull(atEnd);
+      } else {
+        if (hasNulls && !allowNulls) {
+          toSkip = visitor.checkAndSkipNulls(nulls, current, atEnd);
+          if (!Visitor::dense) {
+            skip<false>(toSkip, current, nullptr);
+          }
+          if (atEnd) {
+            return;
+          }
+        }
+
+        // We are at a non-null value on a row to visit.
+        toSkip = visitor.process(readString(), atEnd);
+      }
+      ++current;
+      if (toSkip) {
+        skip<hasNulls>(toSkip, current, nulls);
+        current += toSkip;
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+
+  folly::StringPiece readString() {
+    VELOX_DCHECK_LT(lengthIndex_, lengths_.size());
+    auto length = lengths_[lengthIndex_++];
+    bufferStart_ += length;
+    return folly::StringPiece(bufferStart_ - length, length);
+  }
+
+ private:
+  raw_vector<int32_t> lengths_;
+
+  // Index of the next value in 'lengths_'.
+  int32_t lengthIndex_{0};
+
+  // First byte of the next value.
+  const char* FOLLY_NONNULL bufferStart_;
+};
+
+} // namespace facebook::velox::parquet
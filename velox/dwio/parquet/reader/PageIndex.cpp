@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/reader/Statistics.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Returns the [begin, end) rows of 'pageIndex'th page of 'offsetIndex'.
+std::pair<int64_t, int64_t> pageRows(
+    const thrift::OffsetIndex& offsetIndex,
+    int32_t pageIndex,
+    int64_t numRows) {
+  auto& locations = offsetIndex.page_locations;
+  auto begin = locations[pageIndex].first_row_index;
+  auto end = pageIndex + 1 < locations.size()
+      ? locations[pageIndex + 1].first_row_index
+      : numRows;
+  return {begin, end};
+}
+
+template <typename T>
+void readThrift(const char* data, uint64_t size, T& result) {
+  auto transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(data, size);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  result.read(&protocol);
+}
+
+struct IndexLocation {
+  uint64_t offset;
+  uint64_t length;
+  uint64_t key;
+  bool isColumnIndex;
+};
+
+} // namespace
+
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right) {
+  RowRanges result;
+  size_t i = 0;
+  size_t j = 0;
+  while (i < left.size() && j < right.size()) {
+    auto begin = std::max(left[i].first, right[j].first);
+    auto end = std::min(left[i].second, right[j].second);
+    if (begin < end) {
+      result.emplace_back(begin, end);
+    }
+    if (left[i].second < right[j].second) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return result;
+}
+
+RowRanges rowsMatchingFilter(
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    common::Filter* filter,
+    const TypePtr& type,
+    int64_t numRows) {
+  auto numPages = offsetIndex.page_locations.size();
+  RowRanges result;
+  if (columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages) {
+    // Malformed index. Read all rows.
+    result.emplace_back(0, numRows);
+    return result;
+  }
+  for (auto i = 0; i < numPages; ++i) {
+    auto [begin, end] = pageRows(offsetIndex, i, numRows);
+    if (begin >= end) {
+      continue;
+    }
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(end - begin);
+    } else {
+      if (columnIndex.__isset.null_counts &&
+          i < columnIndex.null_counts.size()) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, end - begin);
+    if (!common::testFilter(filter, columnStats.get(), end - begin, type)) {
+      continue;
+    }
+    if (!result.empty() && result.back().second == begin) {
+      result.back().second = end;
+    } else {
+      result.emplace_back(begin, end);
+    }
+  }
+  return result;
+}
+
+std::vector<bool> pagesInRowRanges(
+    const thrift::OffsetIndex& offsetIndex,
+    const RowRanges& rows,
+    int64_t numRows) {
+  auto numPages = offsetIndex.page_locations.size();
+  std::vector<bool> pages(numPages);
+  size_t rangeIndex = 0;
+  for (auto i = 0; i < numPages; ++i) {
+    auto [begin, end] = pageRows(offsetIndex, i, numRows);
+    while (rangeIndex < rows.size() && rows[rangeIndex].second <= begin) {
+      ++rangeIndex;
+    }
+    pages[i] = rangeIndex < rows.size() && rows[rangeIndex].first < end;
+  }
+  return pages;
+}
+
+void PageIndex::load(
+    const thrift::FileMetaData& fileMetaData,
+    const std::vector<uint32_t>& rowGroups,
+    const std::vector<uint32_t>& columns,
+    const std::vector<uint32_t>& filterColumns,
+    dwio::common::BufferedInput& input) {
+  std::vector<IndexLocation> locations;
+  for (auto rowGroup : rowGroups) {
+    auto& chunks = fileMetaData.row_groups[rowGroup].columns;
+    for (auto column : columns) {
+      auto& chunk = chunks[column];
+      if (chunk.__isset.offset_index_offset && chunk.offset_index_length > 0) {
+        locations.push_back(
+            {static_cast<uint64_t>(chunk.offset_index_offset),
+             static_cast<uint64_t>(chunk.offset_index_length),
+             key(rowGroup, column),
+             false});
+      }
+    }
+    for (auto column : filterColumns) {
+      auto& chunk = chunks[column];
+      if (chunk.__isset.column_index_offset && chunk.column_index_length > 0) {
+        locations.push_back(
+            {static_cast<uint64_t>(chunk.column_index_offset),
+             static_cast<uint64_t>(chunk.column_index_length),
+             key(rowGroup, column),
+             true});
+      }
+    }
+  }
+  std::sort(locations.begin(), locations.end(), [](auto& left, auto& right) {
+    return left.offset < right.offset;
+  });
+
+  std::vector<char> buffer;
+  size_t i = 0;
+  while (i < locations.size()) {
+    // Reads the run of index structures starting at 'i' with one IO.
+    auto regionStart = locations[i].offset;
+    auto regionEnd = regionStart + locations[i].length;
+    auto end = i + 1;
+    while (end < locations.size() &&
+           locations[end].offset <= regionEnd + kMaxCoalesceDistance) {
+      regionEnd =
+          std::max(regionEnd, locations[end].offset + locations[end].length);
+      ++end;
+    }
+    auto size = regionEnd - regionStart;
+    auto stream = input.read(
+        regionStart, size, dwio::common::LogType::STRIPE_INDEX);
+    buffer.resize(size);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        size, stream.get(), buffer.data(), bufferStart, bufferEnd);
+    for (; i < end; ++i) {
+      auto& location = locations[i];
+      auto data = buffer.data() + location.offset - regionStart;
+      if (location.isColumnIndex) {
+        readThrift(data, location.length, columnIndices_[location.key]);
+      } else {
+        readThrift(data, location.length, offsetIndices_[location.key]);
+      }
+    }
+  }
+}
+
+const thrift::OffsetIndex* PageIndex::offsetIndex(
+    uint32_t rowGroup,
+    uint32_t column) const {
+  auto it = offsetIndices_.find(key(rowGroup, column));
+  return it == offsetIndices_.end() ? nullptr : &it->second;
+}
+
+const thrift::ColumnIndex* PageIndex::columnIndex(
+    uint32_t rowGroup,
+    uint32_t column) const {
+  auto it = columnIndices_.find(key(rowGroup, column));
+  return it == columnIndices_.end() ? nullptr : &it->second;
+}
+
+} // namespace facebook::velox::parquet
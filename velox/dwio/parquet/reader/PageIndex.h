@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Type.h"
+
+#include <folly/container/F14Map.h>
+
+namespace facebook::velox::common {
+class Filter;
+} // namespace facebook::velox::common
+
+namespace facebook::velox::dwio::common {
+class BufferedInput;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::parquet {
+
+/// Sorted, non-overlapping [begin, end) ranges of rows relative to the start
+/// of a row group.
+using RowRanges = std::vector<std::pair<int64_t, int64_t>>;
+
+/// Returns the rows that are in both 'left' and 'right'.
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right);
+
+/// Returns the rows of the pages in 'offsetIndex' for which the statistics in
+/// 'columnIndex' may match 'filter'. 'type' is the type of the column and
+/// 'numRows' is the number of rows in the row group.
+RowRanges rowsMatchingFilter(
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    common::Filter* filter,
+    const TypePtr& type,
+    int64_t numRows);
+
+/// Returns a flag for each page in 'offsetIndex' that is true if the page has
+/// at least one row in 'rows'.
+std::vector<bool> pagesInRowRanges(
+    const thrift::OffsetIndex& offsetIndex,
+    const RowRanges& rows,
+    int64_t numRows);
+
+/// Holds the ColumnIndex and OffsetIndex structures of the column chunks
+/// where a scan may skip pages, together with the rows of each row group that
+/// remain to be read after comparing the page statistics to the filters of
+/// the scan.
+class PageIndex {
+ public:
+  /// Reads the OffsetIndex of 'columns' and the ColumnIndex of
+  /// 'filterColumns' for 'rowGroups' from 'input'. Column chunks without a
+  /// page index are left out. Nearby index structures are read together.
+  void load(
+      const thrift::FileMetaData& fileMetaData,
+      const std::vector<uint32_t>& rowGroups,
+      const std::vector<uint32_t>& columns,
+      const std::vector<uint32_t>& filterColumns,
+      dwio::common::BufferedInput& input);
+
+  /// Returns the OffsetIndex of 'column' in 'rowGroup' or nullptr if not
+  /// loaded.
+  const thrift::OffsetIndex* FOLLY_NULLABLE
+  offsetIndex(uint32_t rowGroup, uint32_t column) const;
+
+  /// Returns the ColumnIndex of 'column' in 'rowGroup' or nullptr if not
+  /// loaded.
+  const thrift::ColumnIndex* FOLLY_NULLABLE
+  columnIndex(uint32_t rowGroup, uint32_t column) const;
+
+  /// Sets the rows to read in 'rowGroup'.
+  void setRowRanges(uint32_t rowGroup, RowRanges rows) {
+    rowRanges_[rowGroup] = std::move(rows);
+  }
+
+  /// Returns the rows to read in 'rowGroup' or nullptr if all rows are read.
+  const RowRanges* FOLLY_NULLABLE rowRanges(uint32_t rowGroup) const {
+    auto it = rowRanges_.find(rowGroup);
+    return it == rowRanges_.end() ? nullptr : &it->second;
+  }
+
+ private:
+  // Gap between index structures below which they are read in one IO.
+  static constexpr uint64_t kMaxCoalesceDistance = 1 << 20;
+
+  static uint64_t key(uint32_t rowGroup, uint32_t column) {
+    return (static_cast<uint64_t>(rowGroup) << 32) | column;
+  }
+
+  folly::F14FastMap<uint64_t, thrift::OffsetIndex> offsetIndices_;
+  folly::F14FastMap<uint64_t, thrift::ColumnIndex> columnIndices_;
+  folly::F14FastMap<uint32_t, RowRanges> rowRanges_;
+};
+
+} // namespace facebook::velox::parquet
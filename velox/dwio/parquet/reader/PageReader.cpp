@@ -41,6 +41,9 @@ void PageReader::seekToPage(int64_t row) {
       numRowsInPage_ = 0;
       break;
     }
+    if (skipUnreadPage(row)) {
+      continue;
+    }
     PageHeader pageHeader = readPageHeader();
     pageStart_ = pageDataStart_ + pageHeader.compressed_page_size;
 
@@ -219,6 +222,55 @@ void PageReader::updateRowInfoAfterPageSkipped() {
   }
 }
 
+void PageReader::setPagesToRead(
+    const thrift::OffsetIndex& offsetIndex,
+    uint64_t chunkOffset,
+    std::vector<bool> pagesToRead,
+    int64_t numRowsInChunk) {
+  VELOX_CHECK(isTopLevel_);
+  VELOX_CHECK_EQ(offsetIndex.page_locations.size(), pagesToRead.size());
+  offsetIndex_ = &offsetIndex;
+  chunkOffset_ = chunkOffset;
+  pagesToRead_ = std::move(pagesToRead);
+  numRowsInChunk_ = numRowsInChunk;
+  nextIndexedPage_ = 0;
+}
+
+bool PageReader::skipUnreadPage(int64_t row) {
+  if (!offsetIndex_) {
+    return false;
+  }
+  auto& locations = offsetIndex_->page_locations;
+  while (nextIndexedPage_ < locations.size() &&
+         locations[nextIndexedPage_].offset - chunkOffset_ < pageStart_) {
+    ++nextIndexedPage_;
+  }
+  if (nextIndexedPage_ == locations.size() ||
+      locations[nextIndexedPage_].offset - chunkOffset_ != pageStart_ ||
+      pagesToRead_[nextIndexedPage_]) {
+    return false;
+  }
+  auto& location = locations[nextIndexedPage_];
+  auto endRow = nextIndexedPage_ + 1 < locations.size()
+      ? locations[nextIndexedPage_ + 1].first_row_index
+      : numRowsInChunk_;
+  VELOX_CHECK_EQ(rowOfPage_, location.first_row_index);
+  VELOX_CHECK(
+      row != kRepDefOnly && row >= endRow,
+      "Seeking to row {} in a page that is not read",
+      row);
+  skipBytes(
+      location.compressed_page_size,
+      inputStream_.get(),
+      bufferStart_,
+      bufferEnd_);
+  pageStart_ += location.compressed_page_size;
+  numRowsInPage_ = endRow - location.first_row_index;
+  updateRowInfoAfterPageSkipped();
+  ++nextIndexedPage_;
+  return true;
+}
+
 void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
   VELOX_CHECK(
       pageHeader.type == thrift::PageType::DATA_PAGE &&
@@ -666,11 +718,71 @@ void PageReader::makeDecoder() {
       }
       break;
     case Encoding::DELTA_BINARY_PACKED:
+      switch (parquetType) {
+        case thrift::Type::INT32:
+        case thrift::Type::INT64:
+          deltaBpDecoder_ = std::make_unique<DeltaBpDecoder>(pageData_);
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BINARY_PACKED is not supported for type: {}",
+              parquetType);
+      }
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      VELOX_CHECK_EQ(
+          parquetType,
+          thrift::Type::BYTE_ARRAY,
+          "DELTA_LENGTH_BYTE_ARRAY is only valid for BYTE_ARRAY");
+      deltaLengthByteArrayDecoder_ =
+          std::make_unique<DeltaLengthByteArrayDecoder>(pageData_);
+      break;
+    case Encoding::DELTA_BYTE_ARRAY:
+      switch (parquetType) {
+        case thrift::Type::BYTE_ARRAY:
+          deltaByteArrayDecoder_ =
+              std::make_unique<DeltaByteArrayDecoder>(pageData_);
+          break;
+        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+          makeFixedLenDeltaByteArrayDecoder();
+          break;
+        default:
+          VELOX_UNSUPPORTED(
+              "DELTA_BYTE_ARRAY is not supported for type: {}", parquetType);
+      }
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
 }
 
+void PageReader::makeFixedLenDeltaByteArrayDecoder() {
+  // Fixed length values are decimals read with the big endian direct decoder.
+  // Since each value depends on the previous one, the page is decoded up front
+  // into plain fixed length values.
+  DeltaByteArrayDecoder decoder(pageData_);
+  const auto typeLength = type_->typeLength_;
+  const auto numValues = decoder.numValues();
+  dwio::common::ensureCapacity<char>(
+      fixedLenValues_, numValues * typeLength, &pool_);
+  auto* values = fixedLenValues_->asMutable<char>();
+  for (auto i = 0; i < numValues; ++i) {
+    auto value = decoder.readString();
+    VELOX_CHECK_EQ(
+        static_cast<int32_t>(value.size()),
+        typeLength,
+        "DELTA_BYTE_ARRAY value size does not match the "
+        "FIXED_LEN_BYTE_ARRAY length");
+    memcpy(values + i * typeLength, value.data(), typeLength);
+  }
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          values, numValues * typeLength),
+      false,
+      typeLength,
+      true);
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
@@ -692,6 +804,14 @@ void PageReader::skip(int64_t numRows) {
   // Skip the decoder
   if (isDictionary()) {
     dictionaryIdDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_BINARY_PACKED) {
+    deltaBpDecoder_->skip(toSkip);
+  } else if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    deltaLengthByteArrayDecoder_->skip(toSkip);
+  } else if (
+      encoding_ == Encoding::DELTA_BYTE_ARRAY &&
+      type_->parquetType_ == thrift::Type::BYTE_ARRAY) {
+    deltaByteArrayDecoder_->skip(toSkip);
   } else if (directDecoder_) {
     directDecoder_->skip(toSkip);
   } else if (stringDecoder_) {
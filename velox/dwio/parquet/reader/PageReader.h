@@ -22,6 +22,9 @@
 #include "velox/dwio/common/SelectiveColumnReader.h"
 #include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaByteArrayDecoder.h"
+#include "velox/dwio/parquet/reader/DeltaLengthByteArrayDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
 #include "velox/dwio/parquet/reader/StringDecoder.h"
@@ -71,6 +74,17 @@ class PageReader {
   /// Advances 'numRows' top level rows.
   void skip(int64_t numRows);
 
+  /// Restricts reading to the data pages of 'offsetIndex' for which
+  /// 'pagesToRead' is true. The other pages are not in the input stream and
+  /// are skipped without reading their headers. 'chunkOffset' is the file
+  /// offset of the column chunk and 'numRowsInChunk' is its number of rows.
+  /// Only for top level columns.
+  void setPagesToRead(
+      const thrift::OffsetIndex& offsetIndex,
+      uint64_t chunkOffset,
+      std::vector<bool> pagesToRead,
+      int64_t numRowsInChunk);
+
   /// Decodes repdefs for 'numTopLevelRows'. Use getLengthsAndNulls()
   /// to access the lengths and nulls for the different nesting
   /// levels.
@@ -183,11 +197,19 @@ class PageReader {
   // next page.
   void updateRowInfoAfterPageSkipped();
 
+  // If the page at 'pageStart_' is a data page excluded by setPagesToRead(),
+  // skips over it and returns true. 'row' is the target row of seekToPage().
+  bool skipUnreadPage(int64_t row);
+
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Decodes a DELTA_BYTE_ARRAY page of FIXED_LEN_BYTE_ARRAY values into
+  // 'fixedLenValues_' and sets 'directDecoder_' to read them.
+  void makeFixedLenDeltaByteArrayDecoder();
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -264,6 +286,9 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
+        deltaBpDecoder_->readWithVisitor<true>(
+            nulls, visitor, nullsFromFastPath);
       } else {
         directDecoder_->readWithVisitor<true>(
             nulls, visitor, nullsFromFastPath);
@@ -272,6 +297,9 @@ class PageReader {
       if (isDictionary()) {
         auto dictVisitor = visitor.toDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
+      } else if (encoding_ == thrift::Encoding::DELTA_BINARY_PACKED) {
+        deltaBpDecoder_->readWithVisitor<false>(
+            nulls, visitor, !this->type_->type()->isShortDecimal());
       } else {
         directDecoder_->readWithVisitor<false>(
             nulls, visitor, !this->type_->type()->isShortDecimal());
@@ -295,18 +323,37 @@ class PageReader {
         dictionaryIdDecoder_->readWithVisitor<true>(nulls, dictVisitor);
       } else {
         nullsFromFastPath = false;
-        stringDecoder_->readWithVisitor<true>(nulls, visitor);
+        callStringDecoder<true>(nulls, visitor);
       }
     } else {
       if (isDictionary()) {
         auto dictVisitor = visitor.toStringDictionaryColumnVisitor();
         dictionaryIdDecoder_->readWithVisitor<false>(nullptr, dictVisitor);
       } else {
-        stringDecoder_->readWithVisitor<false>(nulls, visitor);
+        callStringDecoder<false>(nulls, visitor);
       }
     }
   }
 
+  // Calls the decoder for the non-dictionary string encoding of the current
+  // page.
+  template <bool hasNulls, typename Visitor>
+  void callStringDecoder(
+      const uint64_t* FOLLY_NULLABLE nulls,
+      Visitor visitor) {
+    switch (encoding_) {
+      case thrift::Encoding::DELTA_LENGTH_BYTE_ARRAY:
+        deltaLengthByteArrayDecoder_->readWithVisitor<hasNulls>(
+            nulls, visitor);
+        break;
+      case thrift::Encoding::DELTA_BYTE_ARRAY:
+        deltaByteArrayDecoder_->readWithVisitor<hasNulls>(nulls, visitor);
+        break;
+      default:
+        stringDecoder_->readWithVisitor<hasNulls>(nulls, visitor);
+    }
+  }
+
   template <
       typename Visitor,
       typename std::enable_if<
@@ -412,6 +459,9 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Plain values of a DELTA_BYTE_ARRAY page of FIXED_LEN_BYTE_ARRAY type.
+  BufferPtr fixedLenValues_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
@@ -429,6 +479,23 @@ class PageReader {
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
+  // Page locations of the column chunk if only some data pages are read. See
+  // setPagesToRead().
+  const thrift::OffsetIndex* FOLLY_NULLABLE offsetIndex_{nullptr};
+
+  // File offset of the column chunk. The offsets in 'offsetIndex_' are
+  // relative to the file.
+  uint64_t chunkOffset_{0};
+
+  // True for each page in 'offsetIndex_' that is in the input stream.
+  std::vector<bool> pagesToRead_;
+
+  // Number of rows in the column chunk.
+  int64_t numRowsInChunk_{0};
+
+  // Index in 'offsetIndex_' of the first data page at or after 'pageStart_'.
+  int32_t nextIndexedPage_{0};
+
   // Below members Keep state between calls to readWithVisitor().
 
   // Original rows in Visitor.
@@ -476,6 +543,9 @@ class PageReader {
   std::unique_ptr<RleBpDataDecoder> dictionaryIdDecoder_;
   std::unique_ptr<StringDecoder> stringDecoder_;
   std::unique_ptr<BooleanDecoder> booleanDecoder_;
+  std::unique_ptr<DeltaBpDecoder> deltaBpDecoder_;
+  std::unique_ptr<DeltaLengthByteArrayDecoder> deltaLengthByteArrayDecoder_;
+  std::unique_ptr<DeltaByteArrayDecoder> deltaByteArrayDecoder_;
   // Add decoders for other encodings here.
 };
 
@@ -17,16 +17,193 @@
 #include "velox/dwio/parquet/reader/ParquetData.h"
 
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
+#include "velox/type/Filter.h"
 
 namespace facebook::velox::parquet {
 
 using thrift::RowGroup;
 
+namespace {
+
+// Returns the file offset of the first page of the column chunk of
+// 'metaData'.
+uint64_t chunkReadOffset(const thrift::ColumnMetaData& metaData) {
+  uint64_t offset = metaData.data_page_offset;
+  if (metaData.__isset.dictionary_page_offset &&
+      metaData.dictionary_page_offset >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    offset = metaData.dictionary_page_offset;
+  }
+  return offset;
+}
+
+// Adds the Bloom filter hash of 'value' stored as 'physicalType' to 'hashes'.
+// Returns false if the hash of a value of 'physicalType' is not known.
+bool addIntegerHash(
+    int64_t value,
+    thrift::Type::type physicalType,
+    std::vector<uint64_t>& hashes) {
+  switch (physicalType) {
+    case thrift::Type::INT32:
+      // A value outside of the INT32 range does not occur in the column.
+      if (value >= std::numeric_limits<int32_t>::min() &&
+          value <= std::numeric_limits<int32_t>::max()) {
+        hashes.push_back(SplitBlockBloomFilter::hashInt32(value));
+      }
+      return true;
+    case thrift::Type::INT64:
+      hashes.push_back(SplitBlockBloomFilter::hashInt64(value));
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Sets 'hashes' to the Bloom filter hashes of the values that pass 'filter'
+// when stored as 'physicalType'. Returns false if 'filter' does not pass a
+// set of discrete values.
+bool bloomFilterHashes(
+    const common::Filter& filter,
+    thrift::Type::type physicalType,
+    std::vector<uint64_t>& hashes) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      return range.isSingleValue() &&
+          addIntegerHash(range.lower(), physicalType, hashes);
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      for (auto value :
+           static_cast<const common::BigintValuesUsingHashTable&>(filter)
+               .values()) {
+        if (!addIntegerHash(value, physicalType, hashes)) {
+          return false;
+        }
+      }
+      return true;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      for (auto value :
+           static_cast<const common::BigintValuesUsingBitmask&>(filter)
+               .values()) {
+        if (!addIntegerHash(value, physicalType, hashes)) {
+          return false;
+        }
+      }
+      return true;
+    case common::FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      if (!range.isSingleValue() ||
+          physicalType != thrift::Type::BYTE_ARRAY) {
+        return false;
+      }
+      hashes.push_back(SplitBlockBloomFilter::hashBytes(range.lower()));
+      return true;
+    }
+    case common::FilterKind::kBytesValues:
+      if (physicalType != thrift::Type::BYTE_ARRAY) {
+        return false;
+      }
+      for (auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        hashes.push_back(SplitBlockBloomFilter::hashBytes(value));
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Presents the byte ranges of a column chunk that are loaded as a single
+// stream over the column chunk. Positions are relative to the start of the
+// column chunk. The bytes between the ranges belong to pages that are not
+// read and may only be skipped over.
+class PageRangesInputStream : public dwio::common::SeekableInputStream {
+ public:
+  PageRangesInputStream(
+      std::vector<std::pair<uint64_t, uint64_t>> ranges,
+      std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams)
+      : ranges_(std::move(ranges)), streams_(std::move(streams)) {
+    VELOX_CHECK_EQ(ranges_.size(), streams_.size());
+  }
+
+  bool Next(const void** data, int32_t* size) override {
+    while (current_ < ranges_.size() &&
+           position_ >= ranges_[current_].second) {
+      ++current_;
+    }
+    if (current_ == ranges_.size()) {
+      return false;
+    }
+    VELOX_CHECK_GE(
+        position_,
+        ranges_[current_].first,
+        "Reading a page that is not loaded");
+    if (!streams_[current_]->Next(data, size)) {
+      return false;
+    }
+    position_ += *size;
+    return true;
+  }
+
+  void BackUp(int32_t count) override {
+    VELOX_CHECK_LT(current_, streams_.size());
+    streams_[current_]->BackUp(count);
+    position_ -= count;
+  }
+
+  bool SkipInt64(int64_t count) override {
+    VELOX_CHECK_GE(count, 0);
+    auto target = position_ + count;
+    while (current_ < ranges_.size() && ranges_[current_].second <= target) {
+      ++current_;
+    }
+    if (current_ < ranges_.size() && ranges_[current_].first < target) {
+      auto begin = std::max(position_, ranges_[current_].first);
+      streams_[current_]->SkipInt64(target - begin);
+    }
+    position_ = target;
+    return true;
+  }
+
+  google::protobuf::int64 ByteCount() const override {
+    return position_;
+  }
+
+  void seekToPosition(dwio::common::PositionProvider& /*position*/) override {
+    VELOX_UNSUPPORTED("Seeking is not supported on a page pruned column chunk");
+  }
+
+  std::string getName() const override {
+    return fmt::format("PageRangesInputStream {} ranges", ranges_.size());
+  }
+
+  size_t positionSize() override {
+    return 1;
+  }
+
+ private:
+  // [begin, end) offsets of the loaded ranges relative to the column chunk.
+  const std::vector<std::pair<uint64_t, uint64_t>> ranges_;
+
+  // Stream for each of 'ranges_'.
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
+
+  // Index of the first range that ends after 'position_'.
+  size_t current_{0};
+
+  // Offset of the next byte relative to the column chunk.
+  uint64_t position_{0};
+};
+
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, pool(), pageIndex_, input_);
 }
 
 void ParquetData::filterRowGroups(
@@ -79,9 +256,61 @@ bool ParquetData::rowGroupMatches(
         rowGroup.columns[column].meta_data.statistics,
         *type,
         rowGroup.num_rows);
-    return testFilter(filter, columnStats.get(), rowGroup.num_rows, type);
+    if (!testFilter(filter, columnStats.get(), rowGroup.num_rows, type)) {
+      return false;
+    }
   }
-  return true;
+  return bloomFilterMatches(rowGroupId, *filter);
+}
+
+bool ParquetData::bloomFilterMatches(
+    uint32_t rowGroupId,
+    const common::Filter& filter) {
+  auto& chunk = rowGroups_[rowGroupId].columns[type_->column()];
+  if (!input_ || maxRepeat_ > 0 || !type_->parquetType_.has_value() ||
+      !chunk.__isset.meta_data ||
+      !chunk.meta_data.__isset.bloom_filter_offset) {
+    return true;
+  }
+  // Filter values are compared to the stored values, which differ for
+  // decimals and unsigned integers.
+  auto kind = type_->type()->kind();
+  if (type_->type()->isDecimal() ||
+      (kind != TypeKind::TINYINT && kind != TypeKind::SMALLINT &&
+       kind != TypeKind::INTEGER && kind != TypeKind::BIGINT &&
+       kind != TypeKind::VARCHAR && kind != TypeKind::VARBINARY)) {
+    return true;
+  }
+  if (type_->logicalType_.has_value() &&
+      type_->logicalType_->__isset.INTEGER &&
+      !type_->logicalType_->INTEGER.isSigned) {
+    return true;
+  }
+  // Nulls are not in the Bloom filter.
+  if (filter.testNull()) {
+    auto& metaData = chunk.meta_data;
+    if (!metaData.__isset.statistics ||
+        !metaData.statistics.__isset.null_count ||
+        metaData.statistics.null_count > 0) {
+      return true;
+    }
+  }
+  std::vector<uint64_t> hashes;
+  if (!bloomFilterHashes(filter, type_->parquetType_.value(), hashes) ||
+      hashes.empty()) {
+    return true;
+  }
+  auto bloomFilter =
+      SplitBlockBloomFilter::read(*input_, chunk.meta_data.bloom_filter_offset);
+  if (!bloomFilter) {
+    return true;
+  }
+  for (auto hash : hashes) {
+    if (bloomFilter->mayContain(hash)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 void ParquetData::enqueueRowGroup(
@@ -89,26 +318,84 @@ void ParquetData::enqueueRowGroup(
     dwio::common::BufferedInput& input) {
   auto& chunk = rowGroups_[index].columns[type_->column()];
   streams_.resize(rowGroups_.size());
+  pagesToRead_.resize(rowGroups_.size());
   VELOX_CHECK(
       chunk.__isset.meta_data,
       "ColumnMetaData does not exist for schema Id ",
       type_->column());
   auto& metaData = chunk.meta_data;
 
-  uint64_t chunkReadOffset = metaData.data_page_offset;
-  if (metaData.__isset.dictionary_page_offset &&
-      metaData.dictionary_page_offset >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = metaData.dictionary_page_offset;
-  }
-  VELOX_CHECK_GE(chunkReadOffset, 0);
+  uint64_t readOffset = chunkReadOffset(metaData);
+  VELOX_CHECK_GE(readOffset, 0);
 
   uint64_t readSize = (metaData.codec == thrift::CompressionCodec::UNCOMPRESSED)
       ? metaData.total_uncompressed_size
       : metaData.total_compressed_size;
 
+  if (enqueuePages(index, readOffset, readSize, input)) {
+    return;
+  }
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({readOffset, readSize}, &id);
+}
+
+bool ParquetData::enqueuePages(
+    uint32_t index,
+    uint64_t chunkOffset,
+    uint64_t chunkSize,
+    dwio::common::BufferedInput& input) {
+  // Only top level columns have one value per row, so that the rows in the
+  // OffsetIndex tell which values to skip.
+  if (!pageIndex_ || maxRepeat_ > 0 || maxDefine_ > 1) {
+    return false;
+  }
+  auto* rows = pageIndex_->rowRanges(index);
+  auto* offsetIndex = pageIndex_->offsetIndex(index, type_->column());
+  if (!rows || !offsetIndex || offsetIndex->page_locations.empty()) {
+    return false;
+  }
+  auto& locations = offsetIndex->page_locations;
+  auto pages =
+      pagesInRowRanges(*offsetIndex, *rows, rowGroups_[index].num_rows);
+
+  // Ranges of bytes to read relative to 'chunkOffset'. The dictionary page, if
+  // any, precedes the first data page.
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  if (locations[0].offset < chunkOffset) {
+    return false;
+  }
+  if (locations[0].offset > chunkOffset) {
+    ranges.emplace_back(0, locations[0].offset - chunkOffset);
+  }
+  for (auto i = 0; i < locations.size(); ++i) {
+    if (locations[i].offset < chunkOffset) {
+      return false;
+    }
+    uint64_t begin = locations[i].offset - chunkOffset;
+    uint64_t end = begin + locations[i].compressed_page_size;
+    if (end > chunkSize) {
+      return false;
+    }
+    if (!pages[i]) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().second == begin) {
+      ranges.back().second = end;
+    } else {
+      ranges.emplace_back(begin, end);
+    }
+  }
+
+  std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams;
+  for (auto& range : ranges) {
+    auto id = dwio::common::StreamIdentifier(type_->column());
+    streams.push_back(input.enqueue(
+        {chunkOffset + range.first, range.second - range.first}, &id));
+  }
+  streams_[index] = std::make_unique<PageRangesInputStream>(
+      std::move(ranges), std::move(streams));
+  pagesToRead_[index] = std::move(pages);
+  return true;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -122,6 +409,13 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.codec,
       metadata.total_compressed_size);
+  if (!pagesToRead_[index].empty()) {
+    reader_->setPagesToRead(
+        *pageIndex_->offsetIndex(index, type_->column()),
+        chunkReadOffset(metadata),
+        std::move(pagesToRead_[index]),
+        rowGroups_[index].num_rows);
+  }
   return dwio::common::PositionProvider(empty);
 }
 
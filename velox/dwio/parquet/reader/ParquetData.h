@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/dwio/common/BufferUtil.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -35,14 +36,27 @@ class ParquetParams : public dwio::common::FormatParams {
   ParquetParams(
       memory::MemoryPool& pool,
       dwio::common::ColumnReaderStatistics& stats,
-      const thrift::FileMetaData& metaData)
-      : FormatParams(pool, stats), metaData_(metaData) {}
+      const thrift::FileMetaData& metaData,
+      const PageIndex* FOLLY_NULLABLE pageIndex = nullptr,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr)
+      : FormatParams(pool, stats),
+        metaData_(metaData),
+        pageIndex_(pageIndex),
+        input_(input) {}
   std::unique_ptr<dwio::common::FormatData> toFormatData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const common::ScanSpec& scanSpec) override;
 
  private:
   const thrift::FileMetaData& metaData_;
+
+  // Page level indices and the rows to read in each row group. nullptr if
+  // pages are not pruned.
+  const PageIndex* FOLLY_NULLABLE pageIndex_;
+
+  // Input for reading Bloom filters when filtering row groups. nullptr if
+  // Bloom filters are not used.
+  dwio::common::BufferedInput* FOLLY_NULLABLE input_;
 };
 
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
@@ -51,10 +65,14 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
-      memory::MemoryPool& pool)
+      memory::MemoryPool& pool,
+      const PageIndex* FOLLY_NULLABLE pageIndex = nullptr,
+      dwio::common::BufferedInput* FOLLY_NULLABLE input = nullptr)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
+        pageIndex_(pageIndex),
+        input_(input),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
@@ -187,6 +205,21 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  /// False if none of the values passing 'filter' is in the Bloom filter of
+  /// the column chunk in 'rowGroupId'. True if there is no Bloom filter or
+  /// 'filter' does not pass a set of discrete values.
+  bool bloomFilterMatches(uint32_t rowGroupId, const common::Filter& filter);
+
+  // Enqueues only the dictionary and the data pages of 'index'th row group
+  // that contain rows selected by 'pageIndex_'. 'chunkOffset' and 'chunkSize'
+  // are the file offset and size of the column chunk. Returns false if the
+  // whole column chunk must be read.
+  bool enqueuePages(
+      uint32_t index,
+      uint64_t chunkOffset,
+      uint64_t chunkSize,
+      dwio::common::BufferedInput& input);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
@@ -195,6 +228,13 @@ class ParquetData : public dwio::common::FormatData {
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
 
+  const PageIndex* FOLLY_NULLABLE pageIndex_;
+  dwio::common::BufferedInput* FOLLY_NULLABLE input_;
+
+  // Flag for each data page of the column chunk in each of 'rowGroups_' that
+  // is true if the page is read. Empty if all pages of the chunk are read.
+  std::vector<std::vector<bool>> pagesToRead_;
+
   const uint32_t maxDefine_;
   const uint32_t maxRepeat_;
   int64_t rowsInRowGroup_;
@@ -629,7 +629,12 @@ ParquetRowReader::ParquetRowReader(
   if (rowGroups_.empty()) {
     return; // TODO
   }
-  ParquetParams params(pool_, columnReaderStats_, readerBase_->fileMetaData());
+  ParquetParams params(
+      pool_,
+      columnReaderStats_,
+      readerBase_->fileMetaData(),
+      &pageIndex_,
+      &readerBase_->bufferedInput());
   auto columnSelector = std::make_shared<ColumnSelector>(
       ColumnSelector::apply(options_.getSelector(), readerBase_->schema()));
   columnReader_ = ParquetColumnReader::build(
@@ -639,6 +644,7 @@ ParquetRowReader::ParquetRowReader(
       *options_.getScanSpec());
 
   filterRowGroups();
+  filterPages();
   if (!rowGroupIds_.empty()) {
     // schedule prefetch of first row group right after reading the metadata.
     // This is usually on a split preload thread before the split goes to table
@@ -686,10 +692,115 @@ void ParquetRowReader::filterRowGroups() {
   }
 }
 
+void ParquetRowReader::filterPages() {
+  if (rowGroupIds_.empty()) {
+    return;
+  }
+  std::vector<uint32_t> columns;
+  std::vector<uint32_t> filterColumns;
+  std::vector<const dwio::common::SelectiveColumnReader*> filterReaders;
+  for (auto* child : columnReader_->children()) {
+    if (!child) {
+      continue;
+    }
+    auto& type = static_cast<const ParquetTypeWithId&>(child->fileType());
+    if (type.column() == ParquetTypeWithId::kNonLeaf ||
+        type.maxRepeat_ > 0 || type.maxDefine_ > 1) {
+      // The values of nested columns do not correspond to rows, so all of
+      // their pages are read.
+      return;
+    }
+    columns.push_back(type.column());
+    if (child->scanSpec()->filter()) {
+      filterColumns.push_back(type.column());
+      filterReaders.push_back(child);
+    }
+  }
+  if (filterColumns.empty()) {
+    return;
+  }
+  pageIndex_.load(
+      readerBase_->fileMetaData(),
+      rowGroupIds_,
+      columns,
+      filterColumns,
+      readerBase_->bufferedInput());
+
+  std::vector<uint32_t> rowGroupIds;
+  std::vector<uint64_t> firstRowOfRowGroup;
+  for (auto i = 0; i < rowGroupIds_.size(); ++i) {
+    auto rowGroup = rowGroupIds_[i];
+    int64_t numRows = rowGroups_[rowGroup].num_rows;
+    RowRanges rows = {{0, numRows}};
+    for (auto* reader : filterReaders) {
+      auto column = reader->fileType().column();
+      auto* columnIndex = pageIndex_.columnIndex(rowGroup, column);
+      auto* offsetIndex = pageIndex_.offsetIndex(rowGroup, column);
+      if (!columnIndex || !offsetIndex) {
+        continue;
+      }
+      rows = intersectRowRanges(
+          rows,
+          rowsMatchingFilter(
+              *columnIndex,
+              *offsetIndex,
+              reader->scanSpec()->filter(),
+              reader->fileType().type(),
+              numRows));
+    }
+    if (rows.empty()) {
+      ++skippedRowGroups_;
+      continue;
+    }
+    if (rows.size() > 1 || rows[0].first > 0 || rows[0].second < numRows) {
+      for (auto column : columns) {
+        if (auto* offsetIndex = pageIndex_.offsetIndex(rowGroup, column)) {
+          auto pages = pagesInRowRanges(*offsetIndex, rows, numRows);
+          skippedPages_ += std::count(pages.begin(), pages.end(), false);
+        }
+      }
+      pageIndex_.setRowRanges(rowGroup, std::move(rows));
+    }
+    rowGroupIds.push_back(rowGroup);
+    firstRowOfRowGroup.push_back(firstRowOfRowGroup_[i]);
+  }
+  rowGroupIds_ = std::move(rowGroupIds);
+  firstRowOfRowGroup_ = std::move(firstRowOfRowGroup);
+}
+
+bool ParquetRowReader::skipToRowRange() {
+  if (!currentRowRanges_) {
+    return true;
+  }
+  auto& ranges = *currentRowRanges_;
+  while (currentRowRange_ < ranges.size() &&
+         ranges[currentRowRange_].second <=
+             static_cast<int64_t>(currentRowInGroup_)) {
+    ++currentRowRange_;
+  }
+  if (currentRowRange_ == ranges.size()) {
+    currentRowInGroup_ = rowsInCurrentRowGroup_;
+    return false;
+  }
+  uint64_t firstRow = ranges[currentRowRange_].first;
+  if (firstRow > currentRowInGroup_) {
+    // The column readers skip the rows on their next read.
+    columnReader_->setReadOffset(
+        columnReader_->readOffset() + firstRow - currentRowInGroup_);
+    currentRowInGroup_ = firstRow;
+  }
+  return true;
+}
+
 int64_t ParquetRowReader::nextRowNumber() {
-  if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-      !advanceToNextRowGroup()) {
-    return kAtEnd;
+  for (;;) {
+    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+        !advanceToNextRowGroup()) {
+      return kAtEnd;
+    }
+    if (skipToRowRange()) {
+      break;
+    }
   }
   return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
 }
@@ -699,7 +810,12 @@ int64_t ParquetRowReader::nextReadSize(uint64_t size) {
   if (nextRowNumber() == kAtEnd) {
     return kAtEnd;
   }
-  return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+  auto rowsLeft = rowsInCurrentRowGroup_ - currentRowInGroup_;
+  if (currentRowRanges_) {
+    rowsLeft = (*currentRowRanges_)[currentRowRange_].second -
+        currentRowInGroup_;
+  }
+  return std::min(size, rowsLeft);
 }
 
 uint64_t ParquetRowReader::next(
@@ -730,6 +846,8 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   currentRowGroupPtr_ = &rowGroups_[rowGroupIds_[nextRowGroupIdsIdx_]];
   rowsInCurrentRowGroup_ = currentRowGroupPtr_->num_rows;
   currentRowInGroup_ = 0;
+  currentRowRanges_ = pageIndex_.rowRanges(nextRowGroupIndex);
+  currentRowRange_ = 0;
   nextRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
   return true;
@@ -738,6 +856,7 @@ bool ParquetRowReader::advanceToNextRowGroup() {
 void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
+  stats.skippedPages += skippedPages_;
 }
 
 void ParquetRowReader::resetFilterCaches() {
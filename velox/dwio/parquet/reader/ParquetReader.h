@@ -18,6 +18,7 @@
 
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 
 namespace facebook::velox::dwio::common {
@@ -78,6 +79,15 @@ class ParquetRowReader : public dwio::common::RowReader {
   // ReaderBase and determines the set of row groups to scan.
   void filterRowGroups();
 
+  // Compares the page statistics in the ColumnIndex of filtered columns to the
+  // filters and determines the rows to read in each row group selected by
+  // filterRowGroups(). Drops row groups where no page may match.
+  void filterPages();
+
+  // Skips rows of the current row group that are not in
+  // 'currentRowRanges_'. Returns false if no rows are left in the row group.
+  bool skipToRowRange();
+
   // Positions the reader tre at the start of the next row group, as determined
   // by filterRowGroups().
   bool advanceToNextRowGroup();
@@ -100,6 +110,20 @@ class ParquetRowReader : public dwio::common::RowReader {
   // Number of row groups skipped based on stats.
   int32_t skippedRowGroups_{0};
 
+  // Number of pages of the scanned columns skipped based on the ColumnIndex.
+  int64_t skippedPages_{0};
+
+  // ColumnIndex and OffsetIndex of the scanned columns and the rows to read in
+  // each row group after page level filtering.
+  PageIndex pageIndex_;
+
+  // Rows to read in the current row group. nullptr if all rows are read.
+  const RowRanges* FOLLY_NULLABLE currentRowRanges_{nullptr};
+
+  // Index of the first range in 'currentRowRanges_' that ends after
+  // 'currentRowInGroup_'.
+  size_t currentRowRange_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   RowTypePtr requestedType_;
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+
+// Odd constants for setting one bit in each word of a block.
+constexpr uint32_t kSalt[] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Upper limit for the size of a serialized BloomFilterHeader. The header has
+// a size and three single member unions, which take about 20 bytes.
+constexpr uint64_t kMaxHeaderSize = 64;
+
+inline uint32_t wordMask(uint32_t key, int32_t word) {
+  return 1U << ((key * kSalt[word]) >> 27);
+}
+
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(uint32_t numBytes)
+    : words_(
+          bits::roundUp(std::max<uint32_t>(numBytes, 1), kBytesPerBlock) /
+          sizeof(uint32_t)) {}
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(
+    const char* bitset,
+    uint32_t numBytes)
+    : words_(numBytes / sizeof(uint32_t)) {
+  VELOX_CHECK_GT(numBytes, 0);
+  VELOX_CHECK_EQ(numBytes % kBytesPerBlock, 0);
+  memcpy(words_.data(), bitset, numBytes);
+}
+
+// static
+std::unique_ptr<SplitBlockBloomFilter> SplitBlockBloomFilter::read(
+    dwio::common::BufferedInput& input,
+    uint64_t offset) {
+  auto fileSize = input.getReadFile()->size();
+  if (offset >= fileSize) {
+    return nullptr;
+  }
+  auto headerSize = std::min(kMaxHeaderSize, fileSize - offset);
+  char headerBytes[kMaxHeaderSize];
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  auto stream = input.read(
+      offset, headerSize, dwio::common::LogType::STRIPE_INDEX);
+  dwio::common::readBytes(
+      headerSize, stream.get(), headerBytes, bufferStart, bufferEnd);
+
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      headerBytes, headerSize);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  thrift::BloomFilterHeader header;
+  headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes > kMaxBytes || header.numBytes % kBytesPerBlock != 0 ||
+      offset + headerSize + header.numBytes > fileSize) {
+    return nullptr;
+  }
+
+  std::vector<char> bitset(header.numBytes);
+  bufferStart = bufferEnd = nullptr;
+  stream = input.read(
+      offset + headerSize,
+      header.numBytes,
+      dwio::common::LogType::STRIPE_INDEX);
+  dwio::common::readBytes(
+      header.numBytes, stream.get(), bitset.data(), bufferStart, bufferEnd);
+  return std::make_unique<SplitBlockBloomFilter>(
+      bitset.data(), header.numBytes);
+}
+
+bool SplitBlockBloomFilter::mayContain(uint64_t hash) const {
+  auto block = words_.data() + blockOffset(hash);
+  auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if ((block[i] & wordMask(key, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SplitBlockBloomFilter::insert(uint64_t hash) {
+  auto block = words_.data() + blockOffset(hash);
+  auto key = static_cast<uint32_t>(hash);
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= wordMask(key, i);
+  }
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hashInt32(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hashInt64(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hashBytes(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace facebook::velox::dwio::common {
+class BufferedInput;
+} // namespace facebook::velox::dwio::common
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter of a Parquet column chunk. The filter consists of
+/// 256 bit blocks. A value sets one bit in each 32 bit word of the block
+/// selected by the upper half of its 64 bit xxHash. Values are hashed in their
+/// plain encoding, i.e. little endian for integers and the bytes without the
+/// length for BYTE_ARRAY.
+class SplitBlockBloomFilter {
+ public:
+  /// Makes a filter of 'numBytes' with no bits set. 'numBytes' is rounded up
+  /// to a multiple of the block size.
+  explicit SplitBlockBloomFilter(uint32_t numBytes);
+
+  /// Makes a filter from the 'numBytes' of bitset at 'bitset'.
+  SplitBlockBloomFilter(const char* bitset, uint32_t numBytes);
+
+  /// Reads the BloomFilterHeader and bitset at 'offset' of the file of
+  /// 'input'. Returns nullptr if the filter is malformed or uses an
+  /// algorithm, hash or compression that is not supported.
+  static std::unique_ptr<SplitBlockBloomFilter> read(
+      dwio::common::BufferedInput& input,
+      uint64_t offset);
+
+  /// Returns false if no value with 'hash' has been inserted.
+  bool mayContain(uint64_t hash) const;
+
+  void insert(uint64_t hash);
+
+  uint32_t numBytes() const {
+    return words_.size() * sizeof(uint32_t);
+  }
+
+  /// Returns the bitset in the layout of a Parquet file.
+  const char* bitset() const {
+    return reinterpret_cast<const char*>(words_.data());
+  }
+
+  static uint64_t hashInt32(int32_t value);
+
+  static uint64_t hashInt64(int64_t value);
+
+  static uint64_t hashBytes(std::string_view value);
+
+  // Largest bitset accepted by read().
+  static constexpr uint32_t kMaxBytes = 128 << 20;
+
+ private:
+  static constexpr int32_t kWordsPerBlock = 8;
+  static constexpr int32_t kBytesPerBlock = kWordsPerBlock * sizeof(uint32_t);
+
+  // Returns the index of the first word of the block for 'hash'.
+  uint64_t blockOffset(uint64_t hash) const {
+    auto numBlocks = words_.size() / kWordsPerBlock;
+    return ((hash >> 32) * numBlocks >> 32) * kWordsPerBlock;
+  }
+
+  std::vector<uint32_t> words_;
+};
+
+} // namespace facebook::velox::parquet
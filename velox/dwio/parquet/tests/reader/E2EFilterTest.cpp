@@ -128,6 +128,81 @@ TEST_F(E2EFilterTest, integerDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, integerDeltaBinaryPacked) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BINARY_PACKED;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "long_null:bigint",
+      [&]() { makeAllNulls("long_null"); },
+      true,
+      {"short_val", "int_val", "long_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.enablePageIndex = true;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "long_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -9999, // rareMin
+            10000000000, // rareMax
+            true);
+      },
+      false,
+      {"short_val", "int_val", "long_val", "string_val"},
+      20);
+
+  // Ascending values make the pages of a row group cover disjoint ranges, so
+  // that a narrow range filter selects a single page of the first row group
+  // and skips the other pages.
+  rowType_ = ROW({"c0"}, {BIGINT()});
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    auto values = BaseVector::create<FlatVector<int64_t>>(
+        BIGINT(), 5'000, leafPool_.get());
+    for (auto row = 0; row < values->size(); ++row) {
+      values->set(row, i * values->size() + row);
+    }
+    batches.push_back(std::make_shared<RowVector>(
+        leafPool_.get(),
+        rowType_,
+        nullptr,
+        values->size(),
+        std::vector<VectorPtr>{values}));
+  }
+  writeToMemory(rowType_, batches, false);
+
+  auto spec = std::make_shared<ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType_);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<BigintRange>(1'000, 1'009, false));
+  std::vector<uint64_t> hitRows;
+  for (auto row = 1'000; row < 1'010; ++row) {
+    hitRows.push_back(batchPosition(0, row));
+  }
+  uint64_t time = 0;
+  readWithFilter(spec, MutationSpec{}, batches, hitRows, time, false);
+  EXPECT_LT(0, runtimeStats_.skippedPages);
+}
+
 TEST_F(E2EFilterTest, compression) {
   for (const auto compression :
        {common::CompressionKind_SNAPPY,
@@ -347,6 +422,47 @@ TEST_F(E2EFilterTest, shortDecimalDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, decimalDeltaByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "shortdecimal_val:decimal(10, 5)",
+      [&]() {
+        makeIntDistribution<int64_t>(
+            "shortdecimal_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -999, // rareMin
+            30000, // rareMax
+            true);
+      },
+      false,
+      {"shortdecimal_val"},
+      20);
+
+  testWithTypes(
+      "longdecimal_val:decimal(30, 10)",
+      [&]() {
+        makeIntDistribution<int128_t>(
+            "longdecimal_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -999, // rareMin
+            30000, // rareMax
+            true);
+      },
+      true,
+      {},
+      20);
+}
+
 TEST_F(E2EFilterTest, longDecimalDictionary) {
   // decimal(30, 10) maps to 13 bytes FLBA in Parquet.
   // decimal(37, 15) maps to 16 bytes FLBA in Parquet.
@@ -430,6 +546,42 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, stringDeltaLengthByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_LENGTH_BYTE_ARRAY;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringUnique("string_val_2");
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, stringDeltaByteArray) {
+  options_.enableDictionary = false;
+  options_.encoding =
+      facebook::velox::parquet::arrow::Encoding::DELTA_BYTE_ARRAY;
+  options_.dataPageSize = 4 * 1024;
+
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringDistribution("string_val_2", 170, false, true);
+      },
+      true,
+      {"string_val", "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/SplitBlockBloomFilter.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+
+#include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+
+// Serializes a BloomFilterHeader and the bitset of 'filter' the way they are
+// stored in a Parquet file.
+std::string serialize(const SplitBlockBloomFilter& filter) {
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(filter.numBytes());
+  header.algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+  header.hash.__set_XXHASH(thrift::XxHash());
+  header.compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocolT<
+      apache::thrift::transport::TMemoryBuffer>
+      protocol(buffer);
+  header.write(&protocol);
+  return buffer->getBufferAsString() +
+      std::string(filter.bitset(), filter.numBytes());
+}
+
+} // namespace
+
+class SplitBlockBloomFilterTest : public testing::Test {
+ protected:
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::addDefaultLeafMemoryPool();
+};
+
+TEST_F(SplitBlockBloomFilterTest, hash) {
+  // Reference values of xxHash64 with seed 0 for the bytes 0, 1, ..., n - 1.
+  const int64_t expected[] = {
+      -1205034819632174695L,
+      -1642502924627794072L,
+      5216751715308240086L,
+      -1889335612763511331L};
+  char bytes[] = {0, 1, 2};
+  for (auto i = 0; i < 4; ++i) {
+    EXPECT_EQ(
+        static_cast<uint64_t>(expected[i]),
+        SplitBlockBloomFilter::hashBytes(std::string_view(bytes, i)));
+  }
+  int32_t int32Value = 0x03020100;
+  EXPECT_EQ(
+      SplitBlockBloomFilter::hashBytes(std::string_view(
+          reinterpret_cast<const char*>(&int32Value), sizeof(int32Value))),
+      SplitBlockBloomFilter::hashInt32(int32Value));
+}
+
+TEST_F(SplitBlockBloomFilterTest, insertAndProbe) {
+  SplitBlockBloomFilter filter(16 << 10);
+  for (int64_t i = 0; i < 10'000; ++i) {
+    filter.insert(SplitBlockBloomFilter::hashInt64(i * 7));
+  }
+  for (int64_t i = 0; i < 10'000; ++i) {
+    EXPECT_TRUE(filter.mayContain(SplitBlockBloomFilter::hashInt64(i * 7)));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 10'000; ++i) {
+    numFalsePositives +=
+        filter.mayContain(SplitBlockBloomFilter::hashInt64(i * 7 + 1));
+  }
+  EXPECT_LT(numFalsePositives, 200);
+}
+
+TEST_F(SplitBlockBloomFilterTest, read) {
+  SplitBlockBloomFilter filter(1 << 10);
+  std::vector<std::string> values = {"apple", "banana", "cherry"};
+  for (auto& value : values) {
+    filter.insert(SplitBlockBloomFilter::hashBytes(value));
+  }
+  std::string prefix = "PAR1 and some column data";
+  auto data = prefix + serialize(filter) + "PAR1";
+
+  dwio::common::BufferedInput input(
+      std::make_shared<InMemoryReadFile>(data), *pool_);
+  auto readFilter = SplitBlockBloomFilter::read(input, prefix.size());
+  ASSERT_TRUE(readFilter != nullptr);
+  EXPECT_EQ(filter.numBytes(), readFilter->numBytes());
+  EXPECT_EQ(
+      0, memcmp(filter.bitset(), readFilter->bitset(), filter.numBytes()));
+  for (auto& value : values) {
+    EXPECT_TRUE(
+        readFilter->mayContain(SplitBlockBloomFilter::hashBytes(value)));
+  }
+  EXPECT_TRUE(SplitBlockBloomFilter::read(input, data.size()) == nullptr);
+}
+
+TEST_F(SplitBlockBloomFilterTest, skipRowGroups) {
+  // Two row groups of a BIGINT column, the first with even values below 2'000
+  // and the second with values from 1'000'000. The chunks have no statistics,
+  // so that only the Bloom filters can skip row groups.
+  std::string data = "PAR1";
+  std::vector<thrift::RowGroup> rowGroups(2);
+  for (auto i = 0; i < rowGroups.size(); ++i) {
+    SplitBlockBloomFilter filter(8 << 10);
+    for (int64_t j = 0; j < 1'000; ++j) {
+      filter.insert(SplitBlockBloomFilter::hashInt64(
+          i == 0 ? j * 2 : 1'000'000 + j));
+    }
+    thrift::ColumnChunk chunk;
+    chunk.__isset.meta_data = true;
+    chunk.meta_data.__set_type(thrift::Type::INT64);
+    chunk.meta_data.__set_num_values(1'000);
+    chunk.meta_data.__set_bloom_filter_offset(data.size());
+    rowGroups[i].columns.push_back(chunk);
+    rowGroups[i].__set_num_rows(1'000);
+    data += serialize(filter);
+  }
+  data += "PAR1";
+
+  dwio::common::BufferedInput input(
+      std::make_shared<InMemoryReadFile>(data), *pool_);
+  auto type = std::make_shared<ParquetTypeWithId>(
+      BIGINT(),
+      std::vector<std::shared_ptr<const dwio::common::TypeWithId>>{},
+      0,
+      0,
+      0,
+      "c0",
+      thrift::Type::INT64,
+      std::nullopt,
+      0,
+      1);
+  ParquetData parquetData(type, rowGroups, *pool_, nullptr, &input);
+
+  auto skippedRowGroups = [&](std::unique_ptr<common::Filter> filter) {
+    common::ScanSpec spec("c0");
+    spec.setFilter(std::move(filter));
+    dwio::common::FormatData::FilterRowGroupsResult result;
+    parquetData.filterRowGroups(spec, 0, dwio::common::StatsContext(), result);
+    EXPECT_EQ(rowGroups.size(), result.totalCount);
+    std::vector<bool> skipped;
+    for (auto i = 0; i < rowGroups.size(); ++i) {
+      skipped.push_back(bits::isBitSet(result.filterResult.data(), i));
+    }
+    return skipped;
+  };
+
+  EXPECT_EQ(
+      std::vector<bool>({false, true}),
+      skippedRowGroups(std::make_unique<common::BigintRange>(42, 42, false)));
+  EXPECT_EQ(
+      std::vector<bool>({true, false}),
+      skippedRowGroups(
+          common::createBigintValues({1'000'003, 1'000'005}, false)));
+  EXPECT_EQ(
+      std::vector<bool>({true, true}),
+      skippedRowGroups(std::make_unique<common::BigintRange>(41, 41, false)));
+  // Ranges are not checked against the Bloom filter.
+  EXPECT_EQ(
+      std::vector<bool>({false, false}),
+      skippedRowGroups(std::make_unique<common::BigintRange>(41, 43, false)));
+  // Nulls may be in the chunks since the null counts are not known.
+  EXPECT_EQ(
+      std::vector<bool>({false, false}),
+      skippedRowGroups(std::make_unique<common::BigintRange>(41, 41, true)));
+}
@@ -132,7 +132,11 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   }
   properties =
       properties->compression(getArrowParquetCompression(options.compression));
+  properties = properties->encoding(options.encoding);
   properties = properties->data_pagesize(options.dataPageSize);
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
   properties = properties->max_row_group_length(
       static_cast<int64_t>(flushPolicy->rowsInRowGroup()));
   properties = properties->codec_options(options.codecOptions);
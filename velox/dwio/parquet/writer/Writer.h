@@ -23,6 +23,7 @@
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Writer.h"
 #include "velox/dwio/common/WriterFactory.h"
+#include "velox/dwio/parquet/writer/arrow/Types.h"
 #include "velox/dwio/parquet/writer/arrow/util/Compression.h"
 #include "velox/vector/ComplexVector.h"
 
@@ -93,6 +94,12 @@ struct WriterOptions {
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
   double bufferGrowRatio = 1.5;
   common::CompressionKind compression = common::CompressionKind_NONE;
+  // Encoding of data pages that are not dictionary encoded, i.e. when
+  // dictionary encoding is disabled or falls back.
+  arrow::Encoding::type encoding = arrow::Encoding::PLAIN;
+  // Writes the ColumnIndex and OffsetIndex of each column chunk, which
+  // readers use to skip pages.
+  bool enablePageIndex = false;
   velox::memory::MemoryPool* memoryPool;
   // The default factory allows the writer to construct the default flush
   // policy with the configs in its ctor.
@@ -16,12 +16,15 @@
 
 #include "Driver.h"
 #include <folly/ScopeGuard.h>
+#include <folly/futures/Future.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
+#include "velox/common/memory/Numa.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
+#include "velox/exec/DriverScheduler.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
@@ -97,6 +100,16 @@ void recordSilentThrows(Operator& op) {
   }
 }
 
+// Returns the NUMA node the memory of the driver of 'ctx' is allocated from.
+// The driver keeps the node it first ran on. A driver runs on one thread at
+// a time, so this needs no synchronization.
+int32_t numaNode(DriverCtx& ctx) {
+  if (ctx.numaNode < 0) {
+    ctx.numaNode = memory::currentNumaNode();
+  }
+  return ctx.numaNode;
+}
+
 } // namespace
 
 DriverCtx::DriverCtx(
@@ -136,6 +149,7 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
           task->spillDirectory(), pipelineId, driverId, operatorId),
       queryConfig.maxSpillFileSize(),
       queryConfig.spillWriteBufferSize(),
+      queryConfig.spillReadAheadBytes(),
       queryConfig.minSpillRunSize(),
       task->queryCtx()->spillExecutor(),
       queryConfig.minSpillableReservationPct(),
@@ -239,8 +253,12 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (auto* scheduler = dynamic_cast<DriverScheduler*>(executor)) {
+    scheduler->enqueue(std::move(driver));
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -252,6 +270,7 @@ void Driver::init(
   operators_ = std::move(operators);
   curOperatorId_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  enforceCpuQuota_ = ctx_->task->hasCpuQuota();
 }
 
 void Driver::initializeOperators() {
@@ -317,6 +336,7 @@ RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  memory::ScopedNumaNode scopedNumaNode(numaNode(*self->driverCtx()));
   RowVectorPtr result;
   auto stop = runInternal(self, blockingState, result);
 
@@ -483,6 +503,9 @@ StopReason Driver::runInternal(
 
     const int32_t numOperators = operators_.size();
     ContinueFuture future;
+    if (enforceCpuQuota_) {
+      cpuQuotaCheckNanos_ = process::threadCpuNanos();
+    }
 
     for (;;) {
       for (int32_t i = numOperators - 1; i >= 0; --i) {
@@ -495,6 +518,11 @@ StopReason Driver::runInternal(
         auto op = operators_[i].get();
         VELOX_CHECK(op->isInitialized());
 
+        if (checkCpuQuota(self, op, blockingState)) {
+          guard.notThrown();
+          return StopReason::kBlock;
+        }
+
         // In case we are blocked, this index will point to the operator, whose
         // queuedTime we should update.
         curOperatorId_ = i;
@@ -702,6 +730,7 @@ void Driver::run(std::shared_ptr<Driver> self) {
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
+  memory::ScopedNumaNode scopedNumaNode(numaNode(*self->driverCtx()));
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
   auto reason = self->runInternal(self, blockingState, nullResult);
@@ -745,6 +774,29 @@ void Driver::run(std::shared_ptr<Driver> self) {
   }
 }
 
+bool Driver::checkCpuQuota(
+    std::shared_ptr<Driver>& self,
+    Operator* op,
+    std::shared_ptr<BlockingState>& blockingState) {
+  if (!enforceCpuQuota_) {
+    return false;
+  }
+  const auto cpuNanos = process::threadCpuNanos();
+  const auto waitMicros =
+      task()->chargeCpuQuota(cpuNanos - cpuQuotaCheckNanos_);
+  cpuQuotaCheckNanos_ = cpuNanos;
+  if (waitMicros == 0) {
+    return false;
+  }
+  blockingReason_ = BlockingReason::kCpuQuota;
+  blockingState = std::make_shared<BlockingState>(
+      self,
+      folly::futures::sleep(std::chrono::microseconds(waitMicros)),
+      op,
+      blockingReason_);
+  return true;
+}
+
 void Driver::initializeOperatorStats(std::vector<OperatorStats>& stats) {
   stats.resize(operators_.size(), OperatorStats(0, 0, "", ""));
   // Initialize the place in stats given by the operatorId. Use the
@@ -969,6 +1021,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForSpill";
     case BlockingReason::kYield:
       return "kYield";
+    case BlockingReason::kCpuQuota:
+      return "kCpuQuota";
   }
   VELOX_UNREACHABLE();
   return "";
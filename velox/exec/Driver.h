@@ -166,6 +166,9 @@ enum class BlockingReason {
   /// exit them because Task requested to yield or stop or after a certain time.
   /// This is the blocking reason used in such cases.
   kYield,
+  /// The Task of the Driver has used up its CPU quota for the current period.
+  /// The Driver is resumed at the start of the next period.
+  kCpuQuota,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -230,6 +233,9 @@ struct DriverCtx {
   std::shared_ptr<Task> task;
   Driver* driver;
   facebook::velox::process::ThreadDebugInfo threadDebugInfo;
+  /// NUMA node the memory of the driver is allocated from. This is the node
+  /// of the thread that first runs the driver. -1 before the first run.
+  int32_t numaNode{-1};
 
   DriverCtx(
       std::shared_ptr<Task> _task,
@@ -430,6 +436,15 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // Charges the CPU time of the thread since the last call to the CPU quota of
+  // the Task. If the quota of the current period is used up, sets
+  // 'blockingState' to resume at the start of the next period and returns
+  // true. Returns false if the Task has no CPU quota.
+  bool checkCpuQuota(
+      std::shared_ptr<Driver>& self,
+      Operator* op,
+      std::shared_ptr<BlockingState>& blockingState);
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -462,11 +477,17 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  // True if the Task has a CPU quota.
+  bool enforceCpuQuota_{false};
+  // Thread CPU time when the CPU quota of the Task was last charged.
+  uint64_t cpuQuotaCheckNanos_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
 
   friend struct DriverFactory;
+  friend class DriverScheduler;
 };
 
 using OperatorSupplier = std::function<
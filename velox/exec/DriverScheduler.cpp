@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/DriverScheduler.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/Driver.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// The scheduler and the worker index of the current thread if it is a worker
+// thread.
+struct CurrentWorker {
+  const WorkStealingDriverScheduler* scheduler{nullptr};
+  int32_t index{-1};
+};
+
+thread_local CurrentWorker currentWorker;
+
+int32_t laneIndex(WorkStealingDriverScheduler::Lane lane) {
+  return static_cast<int32_t>(lane);
+}
+} // namespace
+
+// static
+void DriverScheduler::run(std::shared_ptr<Driver> driver) {
+  Driver::run(std::move(driver));
+}
+
+WorkStealingDriverScheduler::WorkStealingDriverScheduler(
+    const Options& options)
+    : options_(options) {
+  VELOX_CHECK_GE(options_.numThreads, 0);
+  VELOX_CHECK_GT(options_.batchInterval, 0);
+  const int32_t numThreads = options_.numThreads != 0
+      ? options_.numThreads
+      : std::max<int32_t>(1, std::thread::hardware_concurrency());
+  workers_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+  // Starts the threads after all workers exist since each thread may take
+  // from the queues of the others.
+  for (auto i = 0; i < numThreads; ++i) {
+    workers_[i]->thread = std::thread([this, i]() { workerLoop(i); });
+  }
+  if (options_.timeSliceMicros > 0) {
+    timeSliceThread_ = std::thread([this]() { timeSliceLoop(); });
+  }
+}
+
+WorkStealingDriverScheduler::~WorkStealingDriverScheduler() {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    stopping_ = true;
+  }
+  workAvailable_.notify_all();
+  stopTimeSlice_.notify_all();
+  for (auto& worker : workers_) {
+    worker->thread.join();
+  }
+  if (timeSliceThread_.joinable()) {
+    timeSliceThread_.join();
+  }
+}
+
+void WorkStealingDriverScheduler::add(folly::Func func) {
+  // Functions added to the executor are typically short continuations.
+  add(Lane::kInteractive, std::move(func));
+}
+
+void WorkStealingDriverScheduler::add(Lane lane, folly::Func func) {
+  add(lane, Entry{nullptr, std::move(func), getCurrentTimeMicro()});
+}
+
+void WorkStealingDriverScheduler::enqueue(std::shared_ptr<Driver> driver) {
+  const auto lane = laneOf(*driver->task());
+  add(lane, Entry{std::move(driver), nullptr, getCurrentTimeMicro()});
+}
+
+WorkStealingDriverScheduler::Lane WorkStealingDriverScheduler::laneOf(
+    const Task& task) const {
+  if (task.schedulingPriority() > 0 ||
+      task.scheduledMicros() < options_.interactiveMicros) {
+    return Lane::kInteractive;
+  }
+  return Lane::kBatch;
+}
+
+void WorkStealingDriverScheduler::add(Lane lane, Entry entry) {
+  // Keeps work enqueued by a worker thread on that thread.
+  auto& worker = currentWorker.scheduler == this
+      ? *workers_[currentWorker.index]
+      : *workers_[nextWorker_++ % workers_.size()];
+  {
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.lanes[laneIndex(lane)].push_back(std::move(entry));
+  }
+  ++numQueued_;
+  if (numIdle_ > 0) {
+    // Takes 'mutex_' so that the notify is not lost between the check of
+    // 'numQueued_' by an idle worker and its wait.
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+    }
+    workAvailable_.notify_one();
+  }
+}
+
+void WorkStealingDriverScheduler::workerLoop(int32_t index) {
+  currentWorker = {this, index};
+  Entry entry;
+  Lane lane;
+  bool stolen;
+  for (;;) {
+    if (take(index, entry, lane, stolen)) {
+      runEntry(index, entry, lane, stolen);
+      continue;
+    }
+    std::unique_lock<std::mutex> l(mutex_);
+    ++numIdle_;
+    workAvailable_.wait(l, [&]() { return numQueued_ > 0 || stopping_; });
+    --numIdle_;
+    if (stopping_ && numQueued_ <= 0) {
+      return;
+    }
+  }
+}
+
+bool WorkStealingDriverScheduler::take(
+    int32_t index,
+    Entry& entry,
+    Lane& lane,
+    bool& stolen) {
+  if (numQueued_ <= 0) {
+    return false;
+  }
+  auto& worker = *workers_[index];
+  const bool batchFirst =
+      ++worker.numPicksSinceBatch >= options_.batchInterval;
+  const std::array<Lane, kNumLanes> lanes = batchFirst
+      ? std::array<Lane, kNumLanes>{Lane::kBatch, Lane::kInteractive}
+      : std::array<Lane, kNumLanes>{Lane::kInteractive, Lane::kBatch};
+  const int32_t numWorkers = workers_.size();
+  for (auto candidate : lanes) {
+    // Starts with the own queue of 'index', then steals from the others.
+    for (auto i = 0; i < numWorkers; ++i) {
+      if (takeFrom((index + i) % numWorkers, candidate, entry)) {
+        --numQueued_;
+        lane = candidate;
+        stolen = i != 0;
+        if (lane == Lane::kBatch) {
+          worker.numPicksSinceBatch = 0;
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool WorkStealingDriverScheduler::takeFrom(
+    int32_t index,
+    Lane lane,
+    Entry& entry) {
+  auto& worker = *workers_[index];
+  std::lock_guard<std::mutex> l(worker.mutex);
+  auto& queue = worker.lanes[laneIndex(lane)];
+  if (queue.empty()) {
+    return false;
+  }
+  entry = std::move(queue.front());
+  queue.pop_front();
+  return true;
+}
+
+void WorkStealingDriverScheduler::runEntry(
+    int32_t index,
+    Entry& entry,
+    Lane lane,
+    bool stolen) {
+  const auto startMicros = getCurrentTimeMicro();
+  const auto queuedMicros = startMicros > entry.enqueueMicros
+      ? startMicros - entry.enqueueMicros
+      : 0;
+  {
+    std::lock_guard<std::mutex> l(statsMutex_);
+    auto& laneStats = stats_.lanes[laneIndex(lane)];
+    ++laneStats.numRuns;
+    if (stolen) {
+      ++laneStats.numSteals;
+    }
+    laneStats.queuedMicros += queuedMicros;
+    laneStats.maxQueuedMicros =
+        std::max(laneStats.maxQueuedMicros, queuedMicros);
+    ++laneStats.queuedHistogram[latencyBucket(queuedMicros)];
+  }
+
+  if (entry.driver == nullptr) {
+    auto func = std::move(entry.func);
+    try {
+      func();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Function added to WorkStealingDriverScheduler threw: "
+                 << e.what();
+    }
+    return;
+  }
+
+  auto task = entry.driver->task();
+  auto& worker = *workers_[index];
+  {
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.runningTask = task;
+    worker.runningSinceMicros = startMicros;
+  }
+  DriverScheduler::run(std::move(entry.driver));
+  {
+    std::lock_guard<std::mutex> l(worker.mutex);
+    worker.runningTask.reset();
+  }
+  task->addScheduledMicros(getCurrentTimeMicro() - startMicros);
+}
+
+void WorkStealingDriverScheduler::timeSliceLoop() {
+  const auto interval = std::chrono::microseconds(
+      std::max<uint64_t>(1'000, options_.timeSliceMicros / 2));
+  std::unique_lock<std::mutex> l(mutex_);
+  for (;;) {
+    stopTimeSlice_.wait_for(l, interval, [&]() { return stopping_; });
+    if (stopping_) {
+      return;
+    }
+    if (numQueued_ <= 0) {
+      continue;
+    }
+    l.unlock();
+    const auto now = getCurrentTimeMicro();
+    for (auto& worker : workers_) {
+      std::shared_ptr<Task> task;
+      {
+        std::lock_guard<std::mutex> workerLock(worker->mutex);
+        if (worker->runningTask != nullptr &&
+            now - worker->runningSinceMicros >= options_.timeSliceMicros) {
+          task = worker->runningTask;
+        }
+      }
+      if (task != nullptr &&
+          task->yieldIfDue(now - options_.timeSliceMicros) > 0) {
+        std::lock_guard<std::mutex> statsLock(statsMutex_);
+        ++stats_.numYields;
+      }
+    }
+    l.lock();
+  }
+}
+
+WorkStealingDriverScheduler::Stats WorkStealingDriverScheduler::stats()
+    const {
+  std::lock_guard<std::mutex> l(statsMutex_);
+  return stats_;
+}
+
+// static
+int32_t WorkStealingDriverScheduler::latencyBucket(uint64_t micros) {
+  const int32_t bucket = micros == 0 ? 0 : 64 - __builtin_clzll(micros);
+  return std::min(bucket, kNumLatencyBuckets - 1);
+}
+
+std::string WorkStealingDriverScheduler::Stats::toString() const {
+  static const char* kLaneNames[kNumLanes] = {"interactive", "batch"};
+  std::string result;
+  for (auto i = 0; i < kNumLanes; ++i) {
+    const auto& lane = lanes[i];
+    result += fmt::format(
+        "{}: runs: {} steals: {} queued: avg {}us max {}us, ",
+        kLaneNames[i],
+        lane.numRuns,
+        lane.numSteals,
+        lane.numRuns == 0 ? 0 : lane.queuedMicros / lane.numRuns,
+        lane.maxQueuedMicros);
+  }
+  return result + fmt::format("yields: {}", numYields);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <folly/Executor.h>
+
+namespace facebook::velox::exec {
+
+class Driver;
+class Task;
+
+/// Executor that knows about Drivers. If the executor of the QueryCtx of a
+/// Task is a DriverScheduler, Driver::enqueue() passes the Drivers of the Task
+/// to enqueue() instead of adding them to the executor as plain functions, so
+/// that the scheduler can order them by Task. Other work added to the
+/// executor with add() is run as is.
+class DriverScheduler : public folly::Executor {
+ public:
+  /// Schedules Driver::run() of 'driver'. Called inside the mutex of the Task
+  /// of 'driver', so this must not call back into the Task.
+  virtual void enqueue(std::shared_ptr<Driver> driver) = 0;
+
+ protected:
+  // Runs 'driver' on the calling thread until it blocks, yields or finishes.
+  static void run(std::shared_ptr<Driver> driver);
+};
+
+/// DriverScheduler with a fixed set of threads, each with its own queues of
+/// runnable work. Work enqueued from one of these threads, e.g. a Driver that
+/// yields or a consumer Driver unblocked by a producer, is added to the queues
+/// of that thread so that it likely runs on the same core as the data it
+/// touches. A thread with empty queues takes work from the queues of the
+/// other threads.
+///
+/// Each thread has an interactive and a batch queue. The Drivers of a Task
+/// with a positive Task::schedulingPriority(), or that has run for less than
+/// 'Options::interactiveMicros' in total, go to the interactive queue, so that
+/// short queries are not queued behind long running ones. Threads take work
+/// from the interactive queues first, but take from the batch queues every
+/// 'Options::batchInterval' picks so that batch work is not starved.
+///
+/// A Driver that has been on thread for longer than 'Options::timeSliceMicros'
+/// while other work is queued is asked to yield via Task::yieldIfDue().
+class WorkStealingDriverScheduler : public DriverScheduler {
+ public:
+  struct Options {
+    /// Number of threads. 0 means the number of cores.
+    int32_t numThreads{0};
+
+    /// The Drivers of a Task that has run for less than this in total are in
+    /// the interactive queues.
+    uint64_t interactiveMicros{1'000'000};
+
+    /// A thread takes from the batch queues at least once every this many
+    /// picks.
+    int32_t batchInterval{4};
+
+    /// Time a Driver may stay on thread while there is queued work. 0 means
+    /// no limit.
+    uint64_t timeSliceMicros{100'000};
+  };
+
+  enum class Lane { kInteractive = 0, kBatch = 1 };
+
+  static constexpr int32_t kNumLanes = 2;
+  static constexpr int32_t kNumLatencyBuckets = 24;
+
+  struct LaneStats {
+    /// Number of Drivers and functions run.
+    uint64_t numRuns{0};
+    /// Number of runs taken from the queues of another thread.
+    uint64_t numSteals{0};
+    /// Total and maximum time from enqueue to start of run.
+    uint64_t queuedMicros{0};
+    uint64_t maxQueuedMicros{0};
+    /// Histogram of the times from enqueue to start of run. Bucket i counts
+    /// the times below 2^i us, the last bucket the times above.
+    std::array<uint64_t, kNumLatencyBuckets> queuedHistogram{};
+  };
+
+  struct Stats {
+    std::array<LaneStats, kNumLanes> lanes;
+    /// Number of times a Task was asked to yield because one of its Drivers
+    /// exceeded the time slice.
+    uint64_t numYields{0};
+
+    std::string toString() const;
+  };
+
+  explicit WorkStealingDriverScheduler(const Options& options);
+
+  /// Runs the queued work and stops the threads.
+  ~WorkStealingDriverScheduler() override;
+
+  /// Adds 'func' to the interactive lane.
+  void add(folly::Func func) override;
+
+  /// Adds 'func' to 'lane', e.g. background work to the batch lane.
+  void add(Lane lane, folly::Func func);
+
+  void enqueue(std::shared_ptr<Driver> driver) override;
+
+  Stats stats() const;
+
+  int32_t numThreads() const {
+    return workers_.size();
+  }
+
+  /// Returns the lane the Drivers of 'task' are enqueued to.
+  Lane laneOf(const Task& task) const;
+
+  static int32_t latencyBucket(uint64_t micros);
+
+ private:
+  // A Driver to run or, if 'driver' is null, a function.
+  struct Entry {
+    std::shared_ptr<Driver> driver;
+    folly::Func func;
+    uint64_t enqueueMicros{0};
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::array<std::deque<Entry>, kNumLanes> lanes;
+    // Task of the Driver on thread and the time it went on thread. Used for
+    // enforcing the time slice. Guarded by 'mutex'.
+    std::shared_ptr<Task> runningTask;
+    uint64_t runningSinceMicros{0};
+    // Number of picks since the last pick from a batch queue. Only accessed
+    // by the thread of 'this'.
+    int32_t numPicksSinceBatch{0};
+    std::thread thread;
+  };
+
+  void add(Lane lane, Entry entry);
+
+  // Runs queued work on the thread of worker 'index' until stopped.
+  void workerLoop(int32_t index);
+
+  // Takes the next entry for worker 'index' from its own queues or from the
+  // queues of the other workers. Returns false if all queues are empty.
+  bool take(int32_t index, Entry& entry, Lane& lane, bool& stolen);
+
+  bool takeFrom(int32_t index, Lane lane, Entry& entry);
+
+  void runEntry(int32_t index, Entry& entry, Lane lane, bool stolen);
+
+  // Asks the Drivers that have exceeded their time slice to yield while there
+  // is queued work.
+  void timeSliceLoop();
+
+  const Options options_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<int64_t> numQueued_{0};
+  // Round robin counter for picking the worker of work enqueued from
+  // outside of the worker threads.
+  std::atomic<uint32_t> nextWorker_{0};
+
+  std::mutex mutex_;
+  // Number of workers waiting on 'workAvailable_'. Changed under 'mutex_'.
+  std::atomic<int32_t> numIdle_{0};
+  // Signaled when work is added or 'stopping_' is set.
+  std::condition_variable workAvailable_;
+  std::condition_variable stopTimeSlice_;
+  bool stopping_{false};
+  std::thread timeSliceThread_;
+
+  mutable std::mutex statsMutex_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::exec
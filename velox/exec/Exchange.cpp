@@ -15,9 +15,27 @@
  */
 #include "velox/exec/Exchange.h"
 #include "velox/exec/Task.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
+std::unique_ptr<VectorSerde::Options> makeExchangeSerdeOptions(
+    const core::QueryConfig& queryConfig) {
+  const auto compressionKind =
+      common::stringToCompressionKind(queryConfig.exchangeCompressionKind());
+  const bool preserveEncodings =
+      queryConfig.partitionedOutputPreserveEncodings();
+  if (compressionKind == common::CompressionKind_NONE && !preserveEncodings) {
+    return nullptr;
+  }
+  auto options = std::make_unique<
+      serializer::presto::PrestoVectorSerde::PrestoOptions>();
+  options->compressionKind = compressionKind;
+  options->columnarCompression = queryConfig.exchangeColumnarCompression();
+  options->preserveEncodings = preserveEncodings;
+  return options;
+}
+
 bool Exchange::getSplits(ContinueFuture* future) {
   if (!processSplits_) {
     return false;
@@ -113,7 +131,12 @@ RowVectorPtr Exchange::getOutput() {
 
     while (!inputStream.atEnd()) {
       getSerde()->deserialize(
-          &inputStream, pool(), outputType_, &result_, resultOffset);
+          &inputStream,
+          pool(),
+          outputType_,
+          &result_,
+          resultOffset,
+          serdeOptions_.get());
       resultOffset = result_->size();
     }
   }
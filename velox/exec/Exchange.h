@@ -31,6 +31,12 @@ struct RemoteConnectorSplit : public connector::ConnectorSplit {
   }
 };
 
+/// Returns the serde options for the pages of remote exchanges set in
+/// 'queryConfig' or nullptr for the defaults. The producer and the consumer of
+/// an exchange must use the same options.
+std::unique_ptr<VectorSerde::Options> makeExchangeSerdeOptions(
+    const core::QueryConfig& queryConfig);
+
 class Exchange : public SourceOperator {
  public:
   Exchange(
@@ -48,6 +54,7 @@ class Exchange : public SourceOperator {
         preferredOutputBatchBytes_{
             driverCtx->queryConfig().preferredOutputBatchBytes()},
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
+        serdeOptions_{makeExchangeSerdeOptions(driverCtx->queryConfig())},
         exchangeClient_{std::move(exchangeClient)} {}
 
   ~Exchange() override {
@@ -84,6 +91,9 @@ class Exchange : public SourceOperator {
   /// True if this operator is responsible for fetching splits from the Task and
   /// passing these to ExchangeClient.
   const bool processSplits_;
+
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
+
   bool noMoreSplits_ = false;
 
   /// A future received from Task::getSplitOrFuture(). It will be complete when
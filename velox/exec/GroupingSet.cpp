@@ -1040,7 +1040,7 @@ bool GroupingSet::getOutputWithSpill(
     VELOX_CHECK_EQ(table_->rows()->numRows(), 0);
     spiller_->finalizeSpill();
 
-    merge_ = spiller_->startMerge();
+    merge_ = spiller_->startMerge(spillConfig_->readAheadBytes);
   }
   VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   if (merge_ == nullptr) {
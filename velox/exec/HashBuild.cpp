@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/HashBuild.h"
+#include <memory_resource>
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
@@ -41,6 +42,96 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+using JoinKeyBloomFilter =
+    common::BigintValuesUsingBloomFilter::BloomFilterType;
+
+// Allocates the bits of a join key Bloom filter from a memory pool. Holds a
+// reference to the pool since the filter is pushed down to the probe side and
+// may outlive the HashBuild operator.
+class PoolMemoryResource : public std::pmr::memory_resource {
+ public:
+  explicit PoolMemoryResource(std::shared_ptr<memory::MemoryPool> pool)
+      : pool_(std::move(pool)) {}
+
+ private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    VELOX_CHECK_LE(alignment, pool_->alignment());
+    return pool_->allocate(bytes);
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t /*alignment*/) override {
+    pool_->free(p, bytes);
+  }
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  const std::shared_ptr<memory::MemoryPool> pool_;
+};
+
+// A join key Bloom filter together with the resource its bits are allocated
+// from. 'resource' is declared first so that it outlives 'bloomFilter'.
+struct PoolJoinKeyBloomFilter {
+  explicit PoolJoinKeyBloomFilter(std::shared_ptr<memory::MemoryPool> pool)
+      : resource(std::move(pool)), bloomFilter(&resource) {}
+
+  PoolMemoryResource resource;
+  JoinKeyBloomFilter bloomFilter;
+};
+
+// Returns the size in bytes of a Bloom filter for 'numRows' values. See
+// BloomFilter::reset().
+uint64_t joinKeyBloomFilterBytes(uint64_t numRows) {
+  return sizeof(uint64_t) *
+      std::max<uint64_t>(4, bits::nextPowerOfTwo(numRows) / 4);
+}
+
+// Returns a Bloom filter on the values of the 'key'-th column of the rows in
+// 'containers', or nullptr if all values are null. 'numRows' is the total
+// number of rows in 'containers'. The bits of the Bloom filter are allocated
+// from 'pool'.
+template <typename T>
+std::shared_ptr<common::Filter> makeJoinKeyBloomFilter(
+    const std::vector<RowContainer*>& containers,
+    column_index_t key,
+    uint64_t numRows,
+    double maxPassRate,
+    memory::MemoryPool* pool) {
+  constexpr int32_t kBatch = 1024;
+  auto holder = std::make_shared<PoolJoinKeyBloomFilter>(
+      pool->shared_from_this());
+  std::shared_ptr<JoinKeyBloomFilter> bloomFilter(
+      holder, &holder->bloomFilter);
+  bloomFilter->reset(static_cast<int32_t>(numRows));
+  int64_t min = std::numeric_limits<int64_t>::max();
+  int64_t max = std::numeric_limits<int64_t>::min();
+  std::vector<char*> rows(kBatch);
+  for (auto* container : containers) {
+    const auto column = container->columnAt(key);
+    RowContainerIterator iter;
+    while (auto numListed = container->listRows(
+               &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+      for (auto i = 0; i < numListed; ++i) {
+        if (RowContainer::isNullAt(rows[i], column)) {
+          continue;
+        }
+        const int64_t value =
+            *reinterpret_cast<const T*>(rows[i] + column.offset());
+        min = std::min(min, value);
+        max = std::max(max, value);
+        bloomFilter->insert(common::BigintValuesUsingBloomFilter::hash(value));
+      }
+    }
+  }
+  if (min > max) {
+    return nullptr;
+  }
+  return std::make_shared<common::BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), maxPassRate, false);
+}
 } // namespace
 
 HashBuild::HashBuild(
@@ -776,9 +867,13 @@ bool HashBuild::finishHashBuild() {
 
   std::vector<std::unique_ptr<BaseHashTable>> otherTables;
   otherTables.reserve(peers.size());
+  // The row containers of all the tables. These are owned by 'table_' after
+  // prepareJoinTable().
+  std::vector<RowContainer*> containers{table_->rows()};
   SpillPartitionSet spillPartitions;
   for (auto* build : otherBuilds) {
     VELOX_CHECK_NOT_NULL(build->table_);
+    containers.push_back(build->table_->rows());
     otherTables.push_back(std::move(build->table_));
     if (build->spiller_ != nullptr) {
       build->spiller_->finishSpill(spillPartitions);
@@ -810,6 +905,9 @@ bool HashBuild::finishHashBuild() {
       std::move(otherTables),
       allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
                              : nullptr);
+  if (spillPartitions.empty()) {
+    makeJoinKeyBloomFilters(containers, numRows);
+  }
   addRuntimeStats();
   if (joinBridge_->setHashTable(
           std::move(table_), std::move(spillPartitions), joinHasNullKeys_)) {
@@ -822,6 +920,86 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+void HashBuild::makeJoinKeyBloomFilters(
+    const std::vector<RowContainer*>& containers,
+    uint64_t numRows) {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (!queryConfig.hashJoinBloomFilterEnabled() || numRows == 0) {
+    return;
+  }
+  // The dynamic filters are only pushed down for these join types. See
+  // HashProbe::asyncWaitForHashTable().
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return;
+  }
+  if (numRows > std::numeric_limits<int32_t>::max()) {
+    return;
+  }
+
+  // The probe makes an exact filter from the distinct values of a key if they
+  // have not overflowed and the table is not in kHash mode.
+  const auto& hashers = table_->hashers();
+  std::vector<column_index_t> keys;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    if (table_->hashMode() != BaseHashTable::HashMode::kHash &&
+        !hashers[i]->distinctOverflow()) {
+      continue;
+    }
+    switch (hashers[i]->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        keys.push_back(i);
+        break;
+      default:
+        break;
+    }
+  }
+  if (keys.empty()) {
+    return;
+  }
+
+  // The Bloom filters are allocated from the pool of 'this' and stay there
+  // for the life of the table. The limit applies to all of them together.
+  const auto numBytes = joinKeyBloomFilterBytes(numRows) * keys.size();
+  if (numBytes > queryConfig.hashJoinBloomFilterMaxBytes() ||
+      !pool()->maybeReserve(numBytes)) {
+    return;
+  }
+
+  const auto maxPassRate = queryConfig.hashJoinBloomFilterMaxPassRate();
+  std::vector<std::shared_ptr<common::Filter>> filters(hashers.size());
+  bool hasFilter = false;
+  for (auto key : keys) {
+    switch (hashers[key]->typeKind()) {
+      case TypeKind::TINYINT:
+        filters[key] = makeJoinKeyBloomFilter<int8_t>(
+            containers, key, numRows, maxPassRate, pool());
+        break;
+      case TypeKind::SMALLINT:
+        filters[key] = makeJoinKeyBloomFilter<int16_t>(
+            containers, key, numRows, maxPassRate, pool());
+        break;
+      case TypeKind::INTEGER:
+        filters[key] = makeJoinKeyBloomFilter<int32_t>(
+            containers, key, numRows, maxPassRate, pool());
+        break;
+      case TypeKind::BIGINT:
+        filters[key] = makeJoinKeyBloomFilter<int64_t>(
+            containers, key, numRows, maxPassRate, pool());
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+    hasFilter |= filters[key] != nullptr;
+  }
+  if (hasFilter) {
+    table_->setJoinKeyBloomFilters(std::move(filters));
+  }
+}
+
 void HashBuild::recordSpillStats() {
   if (spiller_ != nullptr) {
     const auto spillStats = spiller_->stats();
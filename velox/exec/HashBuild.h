@@ -105,6 +105,14 @@ class HashBuild final : public Operator {
   // barrier for the next round of hash table build operation if it needs.
   bool finishHashBuild();
 
+  // Invoked by the last build driver after the join table has been built from
+  // the rows in 'containers'. Makes a Bloom filter for each integer join key
+  // that has no exact dynamic filter and sets these in 'table_' for the probe
+  // side to push down. 'numRows' is the total number of rows in 'containers'.
+  void makeJoinKeyBloomFilters(
+      const std::vector<RowContainer*>& containers,
+      uint64_t numRows);
+
   // Invoked after the hash table has been built. It waits for any spill data to
   // process after the probe side has finished processing the previously built
   // hash table. If disk spilling is not enabled or there is no more spill data,
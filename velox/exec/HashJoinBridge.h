@@ -138,9 +138,10 @@ bool isLeftNullAwareJoinWithFilter(
 
 class HashJoinMemoryReclaimer final : public MemoryReclaimer {
  public:
-  static std::unique_ptr<memory::MemoryReclaimer> create() {
+  static std::unique_ptr<memory::MemoryReclaimer> create(
+      int32_t reclaimCost = 0) {
     return std::unique_ptr<memory::MemoryReclaimer>(
-        new HashJoinMemoryReclaimer());
+        new HashJoinMemoryReclaimer(reclaimCost));
   }
 
   uint64_t reclaim(
@@ -149,7 +150,8 @@ class HashJoinMemoryReclaimer final : public MemoryReclaimer {
       memory::MemoryReclaimer::Stats& stats) final;
 
  private:
-  HashJoinMemoryReclaimer() : MemoryReclaimer() {}
+  explicit HashJoinMemoryReclaimer(int32_t reclaimCost)
+      : MemoryReclaimer(0, reclaimCost) {}
 };
 
 /// Returns true if 'pool' is a hash build operator's memory pool. The check is
@@ -317,11 +317,13 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. The filters are made from the distinct values of
+    // the keys if the table is not in kHash mode. Otherwise, or if a key has
+    // too many distinct values, the Bloom filter made by the build is used if
+    // there is one.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
@@ -331,10 +333,18 @@ void HashProbe::asyncWaitForHashTable() {
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::shared_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(false);
+      }
+      if (filter == nullptr) {
+        filter = table_->joinKeyBloomFilter(i);
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
   }
@@ -496,9 +506,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBigintValuesUsingBloomFilter) {
     canReplaceWithDynamicFilter_ = true;
   }
 
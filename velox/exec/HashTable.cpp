@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/HashTable.h"
+
+#include <numeric>
+
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SimdUtil.h"
@@ -577,6 +580,10 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
+  if (useBatchedJoinProbe(numProbes)) {
+    batchedJoinProbe(lookup);
+    return;
+  }
   const vector_size_t* rows = lookup.rows.data();
   ProbeState state1;
   ProbeState state2;
@@ -608,6 +615,42 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::useBatchedJoinProbe(int32_t numProbes) const {
+  if (testingBatchedJoinProbe_.has_value()) {
+    return testingBatchedJoinProbe_.value();
+  }
+  return numProbes >= kJoinProbeBatchSize &&
+      capacity_ * sizeof(void*) >= kMinBatchedJoinProbeTableBytes;
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::batchedJoinProbe(HashLookup& lookup) {
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  ProbeState states[kJoinProbeBatchSize];
+  for (int32_t probeIndex = 0; probeIndex < numProbes;
+       probeIndex += kJoinProbeBatchSize) {
+    const int32_t numStates =
+        std::min(kJoinProbeBatchSize, numProbes - probeIndex);
+    for (int32_t i = 0; i < numStates; ++i) {
+      const int32_t row = rows[probeIndex + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    // The buckets of the first states have arrived by the time the last
+    // bucket is prefetched.
+    for (int32_t i = 0; i < numStates; ++i) {
+      states[i].firstProbe(*this, 0);
+    }
+    // Only rows with more than one tag match or a probe continuing past the
+    // first bucket miss the cache here.
+    for (int32_t i = 0; i < numStates; ++i) {
+      fullProbe<true>(lookup, states[i], false);
+    }
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   // Rows are nearly always consecutive.
@@ -677,7 +720,7 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
   for (; probeIndex < numProbes; ++probeIndex) {
     int32_t row = rows[probeIndex];
     states[0].preProbe(*this, lookup.hashes[row], row);
-    states[0].firstProbe(*this, 0);
+    states[0].firstProbe(*this, kKeyOffset);
     hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
   }
 }
@@ -831,42 +874,62 @@ bool HashTable<ignoreNullKeys>::canApplyParallelJoinBuild() const {
       minTableSizeForParallelJoinBuild_;
 }
 
+template <bool ignoreNullKeys>
+HashTable<ignoreNullKeys>::PartitionedRows::PartitionedRows(
+    int64_t numRows,
+    int32_t numPartitions,
+    memory::MemoryPool& pool)
+    : partitions(numRows, memory::StlAllocator<uint16_t>(pool)),
+      rows(numRows, memory::StlAllocator<char*>(pool)),
+      offsets(numPartitions + 1, 0) {}
+
+template <bool ignoreNullKeys>
+int32_t HashTable<ignoreNullKeys>::numParallelBuildPartitions() const {
+  const auto tableBytes = sizeMask_ + 1;
+  int32_t numPartitions = bits::nextPowerOfTwo(1 + otherTables_.size());
+  while (numPartitions > 1 &&
+         (capacity_ / numPartitions <= minTableSizeForParallelJoinBuild_ ||
+          tableBytes / numPartitions < kBucketSize)) {
+    numPartitions /= 2;
+  }
+  while (numPartitions < kMaxParallelBuildPartitions &&
+         tableBytes / numPartitions > kParallelBuildPartitionBytes &&
+         capacity_ / (2 * numPartitions) > minTableSizeForParallelJoinBuild_) {
+    numPartitions *= 2;
+  }
+  return numPartitions;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   TestValue::adjust(
       "facebook::velox::exec::HashTable::parallelJoinBuild", rows_->pool());
-  VELOX_CHECK_LE(1 + otherTables_.size(), std::numeric_limits<uint8_t>::max());
-  uint8_t numPartitions = 1 + otherTables_.size();
-  VELOX_CHECK_GT(
-      capacity_ / numPartitions,
-      minTableSizeForParallelJoinBuild_,
-      "Less than {} entries per partition for parallel build",
-      minTableSizeForParallelJoinBuild_);
+  const int32_t numTables = 1 + otherTables_.size();
+  const int32_t numPartitions = numParallelBuildPartitions();
+  VELOX_CHECK_LE(numPartitions, kMaxParallelBuildPartitions);
+  VELOX_CHECK(bits::isPowerOfTwo(numPartitions));
+
+  // The partitioning is in terms of ranges of bucket offset. The partition of
+  // a hash is the high bits of its bucket offset, so the bounds are equal
+  // sized and always cache line aligned.
+  const auto partitionBits = __builtin_ctz(numPartitions);
+  buildPartitionBits_ = HashBitRange(sizeBits_ - partitionBits, sizeBits_);
+  const auto partitionBytes = (sizeMask_ + 1) >> partitionBits;
+  VELOX_CHECK_EQ(0, partitionBytes % kBucketSize);
   buildPartitionBounds_.resize(numPartitions + 1);
-  // Pad the tail of buildPartitionBounds_ to max int.
-  std::fill(
-      buildPartitionBounds_.begin(),
-      buildPartitionBounds_.begin() + buildPartitionBounds_.capacity(),
-      std::numeric_limits<PartitionBoundIndexType>::max());
-
-  // The partitioning is in terms of ranges of bucket offset.
-  for (auto i = 0; i < numPartitions; ++i) {
-    // The bounds are the closes tag/row pointer group bound, always cache
-    // line aligned.
-    buildPartitionBounds_[i] =
-        bits::roundUp(((sizeMask_ + 1) / numPartitions) * i, kBucketSize);
+  for (auto i = 0; i <= numPartitions; ++i) {
+    buildPartitionBounds_[i] = partitionBytes * i;
     // Bounds must always be positive
     VELOX_CHECK_GE(
         buildPartitionBounds_[i],
         0,
         "Turn on VELOX_ENABLE_INT64_BUILD_PARTITION_BOUND to avoid integer overflow in buildPartitionBounds_");
   }
-  buildPartitionBounds_.back() = sizeMask_ + 1;
   std::vector<std::shared_ptr<AsyncSource<bool>>> partitionSteps;
   std::vector<std::shared_ptr<AsyncSource<bool>>> buildSteps;
-  // rowPartitions are used in the async threads, so declare them before the
+  // partitionedRows are used in the async threads, so declare them before the
   // sync guard.
-  std::vector<std::unique_ptr<RowPartitions>> rowPartitions;
+  std::vector<PartitionedRows> partitionedRows;
   auto sync = folly::makeGuard([&]() {
     // This is executed on returning path, possibly in unwinding, so must not
     // throw.
@@ -882,18 +945,21 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   // This step can involve large memory allocations, so there is a chance of
   // OOMs here. Do it before any async work is started to reduce the chances of
   // concurrency issues.
-  rowPartitions.reserve(numPartitions);
-  for (auto i = 0; i < numPartitions; ++i) {
-    auto* table = getTable(i);
-    rowPartitions.push_back(table->rows()->createRowPartitions(*rows_->pool()));
+  partitionedRows.reserve(numTables);
+  for (auto i = 0; i < numTables; ++i) {
+    TestValue::adjust(
+        "facebook::velox::exec::HashTable::allocatePartitionedRows",
+        rows_->pool());
+    partitionedRows.emplace_back(
+        getTable(i)->rows()->numRows(), numPartitions, *rows_->pool());
   }
 
   // The parallel table partitioning step.
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < numTables; ++i) {
     auto* table = getTable(i);
     partitionSteps.push_back(std::make_shared<AsyncSource<bool>>(
-        [this, table, rawRowPartitions = rowPartitions[i].get()]() {
-          partitionRows(*table, *rawRowPartitions);
+        [this, table, tableRows = &partitionedRows[i]]() {
+          partitionRows(*table, *tableRows);
           return std::make_unique<bool>(true);
         }));
     assert(!partitionSteps.empty()); // lint
@@ -909,8 +975,8 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   std::vector<std::vector<char*>> overflowPerPartition(numPartitions);
   for (auto i = 0; i < numPartitions; ++i) {
     buildSteps.push_back(std::make_shared<AsyncSource<bool>>(
-        [this, i, &overflowPerPartition, &rowPartitions]() {
-          buildJoinPartition(i, rowPartitions, overflowPerPartition[i]);
+        [this, i, &overflowPerPartition, &partitionedRows]() {
+          buildJoinPartition(i, partitionedRows, overflowPerPartition[i]);
           return std::make_unique<bool>(true);
         }));
     VELOX_CHECK(!buildSteps.empty());
@@ -920,6 +986,7 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
   if (error) {
     std::rethrow_exception(error);
   }
+  partitionedRows.clear();
 
   raw_vector<uint64_t> hashes;
   for (auto i = 0; i < numPartitions; ++i) {
@@ -936,77 +1003,71 @@ void HashTable<ignoreNullKeys>::parallelJoinBuild() {
         0,
         sizeMask_ + 1,
         nullptr);
-    auto table = i == 0 ? this : otherTables_[i - 1].get();
-    VELOX_CHECK_EQ(table->rows()->numRows(), table->numParallelBuildRows_);
   }
-}
-
-namespace {
-// Returns an index into 'buildPartitionBounds_' given an index into tags of the
-// HashTable.
-int32_t findPartition(
-    PartitionBoundIndexType index,
-    const PartitionBoundIndexType* bounds,
-    int32_t numPartitions) {
-  // The partition bounds are padded to batch size.
-  constexpr int32_t kBatch = xsimd::batch<PartitionBoundIndexType>::size;
-  auto indexVector = xsimd::batch<PartitionBoundIndexType>::broadcast(index);
-  for (auto i = 1; i < numPartitions; i += kBatch) {
-    auto bits = simd::toBitMask(
-        indexVector <
-        xsimd::batch<PartitionBoundIndexType>::load_unaligned(bounds + i));
-    if (bits) {
-      return i + __builtin_ctz(bits) - 1;
-    }
+  for (auto i = 0; i < numTables; ++i) {
+    auto* table = getTable(i);
+    VELOX_CHECK_EQ(table->rows()->numRows(), table->numParallelBuildRows_);
   }
-  VELOX_UNREACHABLE("Partition index out of range");
 }
-} // namespace
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::partitionRows(
     HashTable<ignoreNullKeys>& subtable,
-    RowPartitions& rowPartitions) {
+    PartitionedRows& partitionedRows) {
   constexpr int32_t kBatch = 1024;
   raw_vector<char*> rows(kBatch);
   raw_vector<uint64_t> hashes(kBatch);
-  raw_vector<uint8_t> partitions(kBatch);
+  auto& partitions = partitionedRows.partitions;
+  auto& offsets = partitionedRows.offsets;
+
+  // Counts the rows of each partition in 'offsets[partition + 1]'.
+  int64_t numRows = 0;
   RowContainerIterator iter;
-  while (auto numRows = subtable.rows_->listRows(
+  while (auto numBatchRows = subtable.rows_->listRows(
              &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
-    hashRows(folly::Range<char**>(rows.data(), numRows), true, hashes);
-    VELOX_DCHECK_EQ(
-        0,
-        buildPartitionBounds_.capacity() %
-            xsimd::batch<PartitionBoundIndexType>::size,
-        "partition bounds must be padded to SIMD width");
-    for (auto i = 0; i < numRows; ++i) {
-      auto index = bucketOffset(hashes[i]);
-      partitions[i] = findPartition(
-          index, buildPartitionBounds_.data(), buildPartitionBounds_.size());
+    hashRows(folly::Range<char**>(rows.data(), numBatchRows), true, hashes);
+    for (auto i = 0; i < numBatchRows; ++i) {
+      const auto partition = buildPartitionBits_.partition(hashes[i]);
+      partitions[numRows + i] = partition;
+      ++offsets[partition + 1];
     }
-    rowPartitions.appendPartitions(
-        folly::Range<const uint8_t*>(partitions.data(), numRows));
+    numRows += numBatchRows;
+  }
+  VELOX_CHECK_EQ(numRows, partitions.size());
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // Scatters the rows to the runs of their partitions.
+  std::vector<int64_t> nextOffsets(offsets.begin(), offsets.end() - 1);
+  auto* scatteredRows = partitionedRows.rows.data();
+  numRows = 0;
+  iter.reset();
+  while (auto numBatchRows = subtable.rows_->listRows(
+             &iter, kBatch, RowContainer::kUnlimited, rows.data())) {
+    for (auto i = 0; i < numBatchRows; ++i) {
+      scatteredRows[nextOffsets[partitions[numRows + i]]++] = rows[i];
+    }
+    numRows += numBatchRows;
   }
 }
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::buildJoinPartition(
-    uint8_t partition,
-    const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
+    int32_t partition,
+    std::vector<PartitionedRows>& partitionedRows,
     std::vector<char*>& overflow) {
   constexpr int32_t kBatch = 1024;
-  raw_vector<char*> rows(kBatch);
   raw_vector<uint64_t> hashes(kBatch);
-  int32_t numPartitions = 1 + otherTables_.size();
-  for (auto i = 0; i < numPartitions; ++i) {
+  for (auto i = 0; i < partitionedRows.size(); ++i) {
     auto table = i == 0 ? this : otherTables_[i - 1].get();
-    RowContainerIterator iter;
-    while (auto numRows = table->rows_->listPartitionRows(
-               iter, partition, kBatch, *rowPartitions[i], rows.data())) {
-      hashRows(folly::Range(rows.data(), numRows), false, hashes);
+    auto& tableRows = partitionedRows[i];
+    const auto end = tableRows.offsets[partition + 1];
+    for (auto begin = tableRows.offsets[partition]; begin < end;
+         begin += kBatch) {
+      const int32_t numRows = std::min<int64_t>(kBatch, end - begin);
+      auto* rows = tableRows.rows.data() + begin;
+      hashRows(folly::Range(rows, numRows), false, hashes);
       insertForJoin(
-          rows.data(),
+          rows,
           hashes.data(),
           numRows,
           buildPartitionBounds_[partition],
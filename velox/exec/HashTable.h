@@ -17,6 +17,7 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
+#include "velox/exec/HashBitRange.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/VectorHasher.h"
@@ -294,6 +295,22 @@ class BaseHashTable {
     return offThreadBuildTiming_;
   }
 
+  /// Sets the Bloom filters on the join keys made by the hash join build.
+  /// 'filters[i]' is the filter of the i-th key or nullptr if the key has no
+  /// Bloom filter.
+  void setJoinKeyBloomFilters(
+      std::vector<std::shared_ptr<common::Filter>> filters) {
+    VELOX_CHECK_EQ(filters.size(), hashers_.size());
+    joinKeyBloomFilters_ = std::move(filters);
+  }
+
+  /// Returns the Bloom filter on the 'key'-th join key or nullptr if there is
+  /// none.
+  std::shared_ptr<common::Filter> joinKeyBloomFilter(column_index_t key) const {
+    return key < joinKeyBloomFilters_.size() ? joinKeyBloomFilters_[key]
+                                             : nullptr;
+  }
+
  protected:
   static FOLLY_ALWAYS_INLINE size_t tableSlotSize() {
     // Each slot is 8 bytes.
@@ -307,6 +324,9 @@ class BaseHashTable {
 
   // Time spent in build outside of the calling thread.
   CpuWallTiming offThreadBuildTiming_;
+
+  // Bloom filters on the join keys. Empty if the build made none.
+  std::vector<std::shared_ptr<common::Filter>> joinKeyBloomFilters_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -504,6 +524,12 @@ class HashTable : public BaseHashTable {
     return otherTables_;
   }
 
+  /// Makes joinProbe() in kHash mode use or not use batchedJoinProbe()
+  /// regardless of the table size.
+  void testingSetBatchedJoinProbe(bool enabled) {
+    testingBatchedJoinProbe_ = enabled;
+  }
+
  private:
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
@@ -556,6 +582,22 @@ class HashTable : public BaseHashTable {
 
   static constexpr uint64_t kBucketSize = sizeof(Bucket);
 
+  // Target size of the range of buckets built by one task in
+  // parallelJoinBuild(). Small enough to stay in the L2 cache.
+  static constexpr uint64_t kParallelBuildPartitionBytes = 1 << 20;
+
+  // Max number of partitions in parallelJoinBuild().
+  static constexpr int32_t kMaxParallelBuildPartitions = 1 << 12;
+
+  // Number of probe rows whose buckets and rows are prefetched together in
+  // batchedJoinProbe().
+  static constexpr int32_t kJoinProbeBatchSize = 64;
+
+  // Min size of the bucket array for joinProbe() in kHash mode to use
+  // batchedJoinProbe(). Smaller tables mostly hit the cache and are probed 4
+  // rows at a time.
+  static constexpr uint64_t kMinBatchedJoinProbeTableBytes = 4 << 20;
+
   // Returns the bucket at byte offset 'offset' from 'table_'.
   Bucket* bucketAt(int64_t offset) const {
     VELOX_DCHECK_EQ(0, offset & (kBucketSize - 1));
@@ -676,29 +718,53 @@ class HashTable : public BaseHashTable {
   //    than a pre-defined threshold: 1000 for now.
   bool canApplyParallelJoinBuild() const;
 
-  // Builds a join table with '1 + otherTables_.size()' independent
-  // threads using 'executor_'. First all RowContainers get partition
-  // numbers assigned to each row. Next, all threads pick all rows
-  // assigned to their thread-specific partition and insert these. If
-  // a row would overflow past the end of its partition it is added to
-  // a set of overflow rows that are sequentially inserted after all
-  // else.
+  // Rows of one sub-table of a parallel join build grouped by build
+  // partition. The rows of partition 'i' are in [offsets[i], offsets[i + 1])
+  // of 'rows'.
+  struct PartitionedRows {
+    PartitionedRows(
+        int64_t numRows,
+        int32_t numPartitions,
+        memory::MemoryPool& pool);
+
+    // The partition of each row in the order of RowContainer::listRows().
+    std::vector<uint16_t, memory::StlAllocator<uint16_t>> partitions;
+    std::vector<char*, memory::StlAllocator<char*>> rows;
+    std::vector<int64_t> offsets;
+  };
+
+  // Builds a join table with '1 + otherTables_.size()' independent threads
+  // using 'buildExecutor_'. The table is divided into a power of two number
+  // of ranges of buckets, selected by the high bits of the bucket offset
+  // in 'buildPartitionBits_'. First the rows of each RowContainer are
+  // radix-partitioned in parallel into per-partition runs of row
+  // pointers. Next, each partition is built by a separate task that inserts
+  // only the rows of its runs, so that the bucket range being written stays
+  // in cache. If a row would overflow past the end of its partition it is
+  // added to a set of overflow rows that are sequentially inserted after all
+  // else. The partitions are ranges of the same table, so probes need no
+  // routing.
   void parallelJoinBuild();
 
+  // Returns the number of partitions for parallelJoinBuild(). This is a power
+  // of two that is at least the number of sub-tables and grows until each
+  // partition covers at most kParallelBuildPartitionBytes of the table.
+  int32_t numParallelBuildPartitions() const;
+
   // Inserts the rows in 'partition' from this and 'otherTables' into 'this'.
   // The rows that would have gone past the end of the partition are returned in
   // 'overflow'.
   void buildJoinPartition(
-      uint8_t partition,
-      const std::vector<std::unique_ptr<RowPartitions>>& rowPartitions,
+      int32_t partition,
+      std::vector<PartitionedRows>& partitionedRows,
       std::vector<char*>& overflow);
 
-  // Assigns a partition to each row of 'subtable' in RowPartitions of
-  // subtable's RowContainer. If 'hashMode_' is kNormalizedKeys, records the
-  // normalized key of each row below the row in its container.
+  // Groups the rows of 'subtable' by build partition into 'partitionedRows'.
+  // If 'hashMode_' is kNormalizedKeys, records the normalized key of each row
+  // below the row in its container.
   void partitionRows(
       HashTable<ignoreNullKeys>& subtable,
-      RowPartitions& rowPartitions);
+      PartitionedRows& partitionedRows);
 
   // Calculates hashes for 'rows' and returns them in 'hashes'. If
   // 'initNormalizedKeys' is true, the normalized keys are stored below each row
@@ -729,6 +795,17 @@ class HashTable : public BaseHashTable {
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Returns true if joinProbe() in kHash mode should use batchedJoinProbe().
+  bool useBatchedJoinProbe(int32_t numProbes) const;
+
+  // Join probe in kHash mode for tables that do not fit in the cache. Probes
+  // the rows in batches of kJoinProbeBatchSize in three passes: The first
+  // prefetches the first bucket of each row, the second loads the tags and
+  // prefetches the first row with a matching tag and the third compares the
+  // keys. Like this, the cache misses of a batch overlap instead of each probe
+  // waiting for its own bucket and row.
+  void batchedJoinProbe(HashLookup& lookup);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -870,6 +947,10 @@ class HashTable : public BaseHashTable {
   // of cache line  size.
   raw_vector<PartitionBoundIndexType> buildPartitionBounds_;
 
+  // The bits of the bucket offset that select the build partition of a hash
+  // in parallelJoinBuild().
+  HashBitRange buildPartitionBits_;
+
   // Executor for parallelizing hash join build. This may be the
   // executor for Drivers. If this executor is indefinitely taken by
   // other work, the thread of prepareJoinTables() will sequentially
@@ -881,6 +962,9 @@ class HashTable : public BaseHashTable {
 
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
+
+  // If set, overrides the choice of batchedJoinProbe() by table size.
+  std::optional<bool> testingBatchedJoinProbe_;
 };
 
 } // namespace facebook::velox::exec
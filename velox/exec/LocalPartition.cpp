@@ -24,6 +24,19 @@ void notify(std::vector<ContinuePromise>& promises) {
     promise.setValue();
   }
 }
+
+RowVectorPtr
+wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
+  std::vector<VectorPtr> wrappedChildren;
+  wrappedChildren.reserve(input->type()->size());
+  for (auto i = 0; i < input->type()->size(); i++) {
+    wrappedChildren.emplace_back(BaseVector::wrapInDictionary(
+        BufferPtr(nullptr), indices, size, input->childAt(i)));
+  }
+
+  return std::make_shared<RowVector>(
+      input->pool(), input->type(), BufferPtr(nullptr), size, wrappedChildren);
+}
 } // namespace
 
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
@@ -86,7 +99,7 @@ BlockingReason LocalExchangeQueue::enqueue(
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
+    queue.push(Entry{std::move(input)});
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -109,6 +122,35 @@ BlockingReason LocalExchangeQueue::enqueue(
   return BlockingReason::kNotBlocked;
 }
 
+void LocalExchangeQueue::enqueueShared(
+    std::shared_ptr<LocalExchangeSharedInput> sharedInput,
+    BufferPtr indices,
+    vector_size_t size) {
+  std::vector<ContinuePromise> consumerPromises;
+  std::vector<ContinuePromise> memoryPromises;
+  queue_.withWLock([&](auto& queue) {
+    if (closed_) {
+      if (sharedInput->release()) {
+        memoryPromises =
+            memoryManager_->decreaseMemoryUsage(sharedInput->bytes());
+      }
+      return;
+    }
+    queue.push(Entry{
+        nullptr, std::move(sharedInput), std::move(indices), size});
+    consumerPromises = std::move(consumerPromises_);
+  });
+  notify(consumerPromises);
+  notify(memoryPromises);
+}
+
+int64_t LocalExchangeQueue::releaseEntry(const Entry& entry) {
+  if (entry.sharedInput == nullptr) {
+    return entry.data->estimateFlatSize();
+  }
+  return entry.sharedInput->release() ? entry.sharedInput->bytes() : 0;
+}
+
 void LocalExchangeQueue::noMoreData() {
   std::vector<ContinuePromise> consumerPromises;
   queue_.withWLock([&](auto& queue) {
@@ -126,6 +168,7 @@ BlockingReason LocalExchangeQueue::next(
     memory::MemoryPool* pool,
     RowVectorPtr* data) {
   std::vector<ContinuePromise> memoryPromises;
+  Entry entry;
   auto blockingReason = queue_.withWLock([&](auto& queue) {
     *data = nullptr;
     if (queue.empty()) {
@@ -139,20 +182,26 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
+    entry = std::move(queue.front());
     queue.pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    memoryPromises = memoryManager_->decreaseMemoryUsage(releaseEntry(entry));
 
     return BlockingReason::kNotBlocked;
   });
   notify(memoryPromises);
+  if (entry.sharedInput != nullptr) {
+    // Wraps the rows of the shared input outside of the lock.
+    *data = wrapChildren(
+        entry.sharedInput->input(), entry.size, std::move(entry.indices));
+  } else {
+    *data = std::move(entry.data);
+  }
   return blockingReason;
 }
 
 bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+    const std::queue<Entry>& queue) const {
   if (closed_) {
     return true;
   }
@@ -174,7 +223,7 @@ void LocalExchangeQueue::close() {
   queue_.withWLock([&](auto& queue) {
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += releaseEntry(queue.front());
       queue.pop();
     }
 
@@ -251,7 +300,8 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      sharedBuffer_(ctx->queryConfig().localExchangeSharedBuffer()) {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -281,19 +331,6 @@ std::vector<vector_size_t*> getRawIndices(
   }
   return rawIndices;
 }
-
-RowVectorPtr
-wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
-  std::vector<VectorPtr> wrappedChildren;
-  wrappedChildren.reserve(input->type()->size());
-  for (auto i = 0; i < input->type()->size(); i++) {
-    wrappedChildren.emplace_back(BaseVector::wrapInDictionary(
-        BufferPtr(nullptr), indices, size, input->childAt(i)));
-  }
-
-  return std::make_shared<RowVector>(
-      input->pool(), input->type(), BufferPtr(nullptr), size, wrappedChildren);
-}
 } // namespace
 
 void LocalPartition::addInput(RowVectorPtr input) {
@@ -330,6 +367,11 @@ void LocalPartition::addInput(RowVectorPtr input) {
     return;
   }
 
+  if (sharedBuffer_) {
+    enqueueShared(input);
+    return;
+  }
+
   auto numInput = input->size();
   auto indexBuffers = allocateIndexBuffers(numPartitions_, numInput, pool());
   auto rawIndices = getRawIndices(indexBuffers);
@@ -360,6 +402,49 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 }
 
+void LocalPartition::enqueueShared(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  // The rows of partition i are at [offsets[i], offsets[i + 1]) of 'indices'.
+  std::vector<vector_size_t> offsets(numPartitions_ + 1, 0);
+  for (auto i = 0; i < numInput; ++i) {
+    ++offsets[partitions_[i] + 1];
+  }
+  int32_t numNonEmptyPartitions = 0;
+  for (auto i = 0; i < numPartitions_; ++i) {
+    if (offsets[i + 1] > 0) {
+      ++numNonEmptyPartitions;
+    }
+    offsets[i + 1] += offsets[i];
+  }
+  auto indices = allocateIndices(numInput, pool());
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  std::vector<vector_size_t> nextIndex(offsets.begin(), offsets.end() - 1);
+  for (auto i = 0; i < numInput; ++i) {
+    rawIndices[nextIndex[partitions_[i]]++] = i;
+  }
+
+  auto sharedInput = std::make_shared<LocalExchangeSharedInput>(
+      input, input->estimateFlatSize(), numNonEmptyPartitions);
+  // All queues of the exchange share the memory manager.
+  ContinueFuture future;
+  if (queues_[0]->memoryManager()->increaseMemoryUsage(
+          &future, sharedInput->bytes())) {
+    blockingReasons_.push_back(BlockingReason::kWaitForConsumer);
+    futures_.push_back(std::move(future));
+  }
+  for (auto i = 0; i < numPartitions_; ++i) {
+    const auto size = offsets[i + 1] - offsets[i];
+    if (size == 0) {
+      // Do not enqueue empty partitions.
+      continue;
+    }
+    queues_[i]->enqueueShared(
+        sharedInput,
+        BaseVector::sliceBuffer(*INTEGER(), indices, offsets[i], size, pool()),
+        size);
+  }
+}
+
 BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
   if (!futures_.empty()) {
     auto blockingReason = blockingReasons_.front();
@@ -43,6 +43,41 @@ class LocalExchangeMemoryManager {
   std::vector<ContinuePromise> promises_;
 };
 
+/// An input vector of LocalPartition in shared-buffer mode. The vector is
+/// enqueued once to each partition that has rows in it, together with the
+/// indices of these rows, instead of being wrapped in a dictionary for each
+/// partition by the producer. Its memory is counted once in
+/// LocalExchangeMemoryManager until all these partitions have dequeued or
+/// dropped their rows.
+class LocalExchangeSharedInput {
+ public:
+  LocalExchangeSharedInput(
+      RowVectorPtr input,
+      int64_t bytes,
+      int32_t numPartitions)
+      : input_(std::move(input)), bytes_(bytes), numPending_(numPartitions) {}
+
+  const RowVectorPtr& input() const {
+    return input_;
+  }
+
+  int64_t bytes() const {
+    return bytes_;
+  }
+
+  /// Called when a partition has dequeued or dropped its rows. Returns true
+  /// for the last partition. The memory of the input is then released.
+  bool release() {
+    VELOX_CHECK_GT(numPending_, 0);
+    return --numPending_ == 0;
+  }
+
+ private:
+  const RowVectorPtr input_;
+  const int64_t bytes_;
+  std::atomic<int32_t> numPending_;
+};
+
 /// Buffers data for a single partition produced by local exchange. Allows
 /// multiple producers to enqueue data and multiple consumers fetch data. Each
 /// producer must be registered with a call to 'addProducer'. 'noMoreProducers'
@@ -69,6 +104,14 @@ class LocalExchangeQueue {
   /// completed when ready to accept more data.
   BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future);
 
+  /// Used by a producer in shared-buffer mode to add the 'size' rows of the
+  /// input of 'sharedInput' at 'indices'. The memory of the input is counted
+  /// by the producer. The consumer receives the rows wrapped in dictionaries.
+  void enqueueShared(
+      std::shared_ptr<LocalExchangeSharedInput> sharedInput,
+      BufferPtr indices,
+      vector_size_t size);
+
   /// Called by a producer to indicate that no more data will be added.
   void noMoreData();
 
@@ -88,12 +131,30 @@ class LocalExchangeQueue {
   /// called before all the data has been processed. No-op otherwise.
   void close();
 
+  const std::shared_ptr<LocalExchangeMemoryManager>& memoryManager() const {
+    return memoryManager_;
+  }
+
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // Data added by a producer. Either 'data' or, in shared-buffer mode, the
+  // 'size' rows of the input of 'sharedInput' at 'indices'.
+  struct Entry {
+    RowVectorPtr data;
+    std::shared_ptr<LocalExchangeSharedInput> sharedInput;
+    BufferPtr indices;
+    vector_size_t size{0};
+  };
+
+  // Called when 'entry' is dequeued or dropped. Returns the bytes to
+  // subtract from the memory usage. This is 0 for a shared input that other
+  // partitions still reference.
+  int64_t releaseEntry(const Entry& entry);
+
+  bool isFinishedLocked(const std::queue<Entry>& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<std::queue<Entry>> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -172,9 +233,16 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  // Enqueues the rows of 'input' of each partition to its queue as a shared
+  // input with one buffer of indices.
+  void enqueueShared(const RowVectorPtr& input);
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // True if the partitions of an input share it instead of each getting a
+  // dictionary wrapper made by the producer.
+  const bool sharedBuffer_;
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
@@ -20,8 +20,10 @@
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
-std::unique_ptr<memory::MemoryReclaimer> MemoryReclaimer::create() {
-  return std::unique_ptr<memory::MemoryReclaimer>(new MemoryReclaimer());
+std::unique_ptr<memory::MemoryReclaimer> MemoryReclaimer::create(
+    int32_t reclaimCost) {
+  return std::unique_ptr<memory::MemoryReclaimer>(
+      new MemoryReclaimer(0, reclaimCost));
 }
 
 void MemoryReclaimer::enterArbitration() {
@@ -27,7 +27,8 @@ class MemoryReclaimer : public memory::MemoryReclaimer {
  public:
   virtual ~MemoryReclaimer() = default;
 
-  static std::unique_ptr<memory::MemoryReclaimer> create();
+  static std::unique_ptr<memory::MemoryReclaimer> create(
+      int32_t reclaimCost = 0);
 
   void enterArbitration() override;
 
@@ -38,6 +39,9 @@ class MemoryReclaimer : public memory::MemoryReclaimer {
 
  protected:
   MemoryReclaimer() = default;
+
+  MemoryReclaimer(int32_t queryPriority, int32_t reclaimCost)
+      : memory::MemoryReclaimer(queryPriority, reclaimCost) {}
 };
 
 /// Callback used by memory arbitration to check if a driver thread under memory
@@ -191,10 +191,17 @@ class MergeExchange : public Merge {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  /// Options for deserializing the pages of the sources. nullptr for the
+  /// defaults.
+  const VectorSerde::Options* serdeOptions() const {
+    return serdeOptions_.get();
+  }
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
  private:
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
   bool noMoreSplits_ = false;
   // Task Ids from all the splits we took to process so far.
   std::vector<std::string> remoteSourceTaskIds_;
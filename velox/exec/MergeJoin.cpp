@@ -20,6 +20,45 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+bool isSupported(core::JoinType joinType) {
+  switch (joinType) {
+    case core::JoinType::kInner:
+    case core::JoinType::kLeft:
+    case core::JoinType::kRight:
+    case core::JoinType::kFull:
+    case core::JoinType::kLeftSemiFilter:
+    case core::JoinType::kAnti:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns true if the join outputs the left-side rows with no match.
+bool outputLeftMisses(core::JoinType joinType) {
+  return core::isLeftJoin(joinType) || core::isFullJoin(joinType) ||
+      core::isAntiJoin(joinType);
+}
+
+// Returns true if the join outputs the right-side rows with no match.
+bool outputRightMisses(core::JoinType joinType) {
+  return core::isRightJoin(joinType) || core::isFullJoin(joinType);
+}
+
+bool hasNullKeys(
+    const RowVectorPtr& rowVector,
+    const std::vector<column_index_t>& keys,
+    vector_size_t index) {
+  for (auto key : keys) {
+    if (rowVector->childAt(key)->isNullAt(index)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 MergeJoin::MergeJoin(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -35,8 +74,13 @@ MergeJoin::MergeJoin(
       numKeys_{joinNode->leftKeys().size()},
       joinNode_(joinNode) {
   VELOX_USER_CHECK(
-      joinNode_->isInnerJoin() || joinNode_->isLeftJoin(),
-      "Merge join supports only inner and left joins. Other join types are not supported yet.");
+      isSupported(joinType_),
+      "Merge join doesn't support {} join",
+      core::joinTypeName(joinType_));
+  // Full outer join with a filter needs to track the misses on both sides.
+  VELOX_USER_CHECK(
+      !joinNode_->isFullJoin() || joinNode_->filter() == nullptr,
+      "Merge join doesn't support full outer join with filter");
 }
 
 void MergeJoin::initialize() {
@@ -75,8 +119,9 @@ void MergeJoin::initialize() {
   if (joinNode_->filter()) {
     initializeFilter(joinNode_->filter(), leftType, rightType);
 
-    if (joinNode_->isLeftJoin()) {
-      leftJoinTracker_ = LeftJoinTracker(outputBatchSize_, pool());
+    if (joinNode_->isLeftJoin() || joinNode_->isRightJoin() ||
+        joinNode_->isLeftSemiFilterJoin() || joinNode_->isAntiJoin()) {
+      joinTracker_ = JoinTracker(outputBatchSize_, pool());
     }
   }
   joinNode_.reset();
@@ -167,8 +212,9 @@ void MergeJoin::addInput(RowVectorPtr input) {
   input_ = std::move(input);
   index_ = 0;
 
-  if (leftJoinTracker_) {
-    leftJoinTracker_->resetLastVector();
+  // Right joins track the right-side rows, see getOutput().
+  if (joinTracker_ && !isRightJoin(joinType_)) {
+    joinTracker_->resetLastVector();
   }
 }
 
@@ -191,6 +237,15 @@ int32_t MergeJoin::compare(
   return 0;
 }
 
+int32_t MergeJoin::compare() const {
+  if (outputRightMisses(joinType_) &&
+      hasNullKeys(rightInput_, rightKeys_, rightIndex_)) {
+    return 1;
+  }
+  return compare(
+      leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
+}
+
 bool MergeJoin::findEndOfMatch(
     Match& match,
     const RowVectorPtr& input,
@@ -253,9 +308,27 @@ void MergeJoin::addOutputRowForLeftJoin(
     target->setNull(outputSize_, true);
   }
 
-  if (leftJoinTracker_) {
+  if (joinTracker_) {
     // Record left-side row with no match on the right side.
-    leftJoinTracker_->addMiss(outputSize_);
+    joinTracker_->addMiss(outputSize_);
+  }
+
+  ++outputSize_;
+}
+
+void MergeJoin::addOutputRowForRightJoin(
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) {
+  copyRow(right, rightIndex, output_, outputSize_, rightProjections_);
+
+  for (const auto& projection : leftProjections_) {
+    const auto& target = output_->childAt(projection.outputChannel);
+    target->setNull(outputSize_, true);
+  }
+
+  if (joinTracker_) {
+    // Record right-side row with no match on the left side.
+    joinTracker_->addMiss(outputSize_);
   }
 
   ++outputSize_;
@@ -273,9 +346,14 @@ void MergeJoin::addOutputRow(
     copyRow(left, leftIndex, filterInput_, outputSize_, filterLeftInputs_);
     copyRow(right, rightIndex, filterInput_, outputSize_, filterRightInputs_);
 
-    if (leftJoinTracker_) {
-      // Record left-side row with a match on the right-side.
-      leftJoinTracker_->addMatch(left, leftIndex, outputSize_);
+    if (joinTracker_) {
+      if (isRightJoin(joinType_)) {
+        // Record right-side row with a match on the left-side.
+        joinTracker_->addMatch(right, rightIndex, outputSize_);
+      } else {
+        // Record left-side row with a match on the right-side.
+        joinTracker_->addMatch(left, leftIndex, outputSize_);
+      }
     }
   }
 
@@ -347,50 +425,95 @@ void MergeJoin::prepareOutput() {
 }
 
 bool MergeJoin::addToOutput() {
+  if (!filter_ && (isLeftSemiFilterJoin(joinType_) || isAntiJoin(joinType_))) {
+    return addToOutputForSemiJoin();
+  }
+
   prepareOutput();
 
-  size_t firstLeftBatch;
-  vector_size_t leftStartIndex;
-  if (leftMatch_->cursor) {
-    firstLeftBatch = leftMatch_->cursor->batchIndex;
-    leftStartIndex = leftMatch_->cursor->index;
+  const bool rightOuter = isRightJoin(joinType_);
+  auto& outerMatch = rightOuter ? rightMatch_.value() : leftMatch_.value();
+  auto& innerMatch = rightOuter ? leftMatch_.value() : rightMatch_.value();
+
+  size_t firstOuterBatch;
+  vector_size_t outerStartIndex;
+  if (outerMatch.cursor) {
+    firstOuterBatch = outerMatch.cursor->batchIndex;
+    outerStartIndex = outerMatch.cursor->index;
   } else {
-    firstLeftBatch = 0;
-    leftStartIndex = leftMatch_->startIndex;
-  }
-
-  size_t numLefts = leftMatch_->inputs.size();
-  for (size_t l = firstLeftBatch; l < numLefts; ++l) {
-    auto left = leftMatch_->inputs[l];
-    auto leftStart = l == firstLeftBatch ? leftStartIndex : 0;
-    auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
-
-    for (auto i = leftStart; i < leftEnd; ++i) {
-      auto firstRightBatch =
-          (l == firstLeftBatch && i == leftStart && rightMatch_->cursor)
-          ? rightMatch_->cursor->batchIndex
-          : 0;
-
-      auto rightStartIndex =
-          (l == firstLeftBatch && i == leftStart && rightMatch_->cursor)
-          ? rightMatch_->cursor->index
-          : rightMatch_->startIndex;
-
-      auto numRights = rightMatch_->inputs.size();
-      for (size_t r = firstRightBatch; r < numRights; ++r) {
-        auto right = rightMatch_->inputs[r];
-        auto rightStart = r == firstRightBatch ? rightStartIndex : 0;
-        auto rightEnd =
-            r == numRights - 1 ? rightMatch_->endIndex : right->size();
-
-        for (auto j = rightStart; j < rightEnd; ++j) {
+    firstOuterBatch = 0;
+    outerStartIndex = outerMatch.startIndex;
+  }
+
+  size_t numOuters = outerMatch.inputs.size();
+  for (size_t o = firstOuterBatch; o < numOuters; ++o) {
+    const auto& outer = outerMatch.inputs[o];
+    auto outerStart = o == firstOuterBatch ? outerStartIndex : 0;
+    auto outerEnd = o == numOuters - 1 ? outerMatch.endIndex : outer->size();
+
+    for (auto i = outerStart; i < outerEnd; ++i) {
+      const bool resume =
+          o == firstOuterBatch && i == outerStart && innerMatch.cursor;
+      auto firstInnerBatch = resume ? innerMatch.cursor->batchIndex : 0;
+      auto innerStartIndex =
+          resume ? innerMatch.cursor->index : innerMatch.startIndex;
+
+      auto numInners = innerMatch.inputs.size();
+      for (size_t n = firstInnerBatch; n < numInners; ++n) {
+        const auto& inner = innerMatch.inputs[n];
+        auto innerStart = n == firstInnerBatch ? innerStartIndex : 0;
+        auto innerEnd =
+            n == numInners - 1 ? innerMatch.endIndex : inner->size();
+
+        for (auto j = innerStart; j < innerEnd; ++j) {
           if (outputSize_ == outputBatchSize_) {
-            leftMatch_->setCursor(l, i);
-            rightMatch_->setCursor(r, j);
+            outerMatch.setCursor(o, i);
+            innerMatch.setCursor(n, j);
             return true;
           }
-          addOutputRow(left, i, right, j);
+          if (rightOuter) {
+            addOutputRow(inner, j, outer, i);
+          } else {
+            addOutputRow(outer, i, inner, j);
+          }
+        }
+      }
+    }
+  }
+
+  leftMatch_.reset();
+  rightMatch_.reset();
+
+  return outputSize_ == outputBatchSize_;
+}
+
+bool MergeJoin::addToOutputForSemiJoin() {
+  prepareOutput();
+
+  if (isLeftSemiFilterJoin(joinType_)) {
+    size_t firstBatch;
+    vector_size_t startIndex;
+    if (leftMatch_->cursor) {
+      firstBatch = leftMatch_->cursor->batchIndex;
+      startIndex = leftMatch_->cursor->index;
+    } else {
+      firstBatch = 0;
+      startIndex = leftMatch_->startIndex;
+    }
+
+    size_t numLefts = leftMatch_->inputs.size();
+    for (size_t l = firstBatch; l < numLefts; ++l) {
+      const auto& left = leftMatch_->inputs[l];
+      auto leftStart = l == firstBatch ? startIndex : 0;
+      auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
+
+      for (auto i = leftStart; i < leftEnd; ++i) {
+        if (outputSize_ == outputBatchSize_) {
+          leftMatch_->setCursor(l, i);
+          return true;
         }
+        copyRow(left, i, output_, outputSize_, leftProjections_);
+        ++outputSize_;
       }
     }
   }
@@ -407,14 +530,7 @@ vector_size_t firstNonNull(
     const std::vector<column_index_t>& keys,
     vector_size_t start = 0) {
   for (auto i = start; i < rowVector->size(); ++i) {
-    bool hasNull = false;
-    for (auto key : keys) {
-      if (rowVector->childAt(key)->isNullAt(i)) {
-        hasNull = true;
-        break;
-      }
-    }
-    if (!hasNull) {
+    if (!hasNullKeys(rowVector, keys, i)) {
       return i;
     }
   }
@@ -423,6 +539,14 @@ vector_size_t firstNonNull(
 }
 } // namespace
 
+vector_size_t MergeJoin::nextRightIndex(vector_size_t start) const {
+  if (outputRightMisses(joinType_)) {
+    // Rows with null keys are added to the output as misses.
+    return start;
+  }
+  return firstNonNull(rightInput_, rightKeys_, start);
+}
+
 RowVectorPtr MergeJoin::getOutput() {
   // Make sure to have is-blocked or needs-input as true if returning null
   // output. Otherwise, Driver assumes the operator is finished.
@@ -466,7 +590,10 @@ RowVectorPtr MergeJoin::getOutput() {
         }
 
         if (rightInput_) {
-          rightIndex_ = firstNonNull(rightInput_, rightKeys_);
+          if (joinTracker_ && isRightJoin(joinType_)) {
+            joinTracker_->resetLastVector();
+          }
+          rightIndex_ = nextRightIndex(0);
           if (rightIndex_ == rightInput_->size()) {
             // Ran out of rows on the right side.
             rightInput_ = nullptr;
@@ -486,7 +613,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
   // Check if we ran out of space in the output vector in the middle of the
   // match.
   if (leftMatch_ && leftMatch_->cursor) {
-    VELOX_CHECK(rightMatch_ && rightMatch_->cursor);
+    VELOX_CHECK(rightMatch_);
 
     // Not all rows from the last match fit in the output. Continue producing
     // results from the current match.
@@ -525,8 +652,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
-        rightIndex_ =
-            firstNonNull(rightInput_, rightKeys_, rightMatch_->endIndex);
+        rightIndex_ = nextRightIndex(rightMatch_->endIndex);
         if (rightIndex_ == rightInput_->size()) {
           rightInput_ = nullptr;
         }
@@ -551,29 +677,63 @@ RowVectorPtr MergeJoin::doGetOutput() {
   }
 
   if (!input_ || !rightInput_) {
-    if (isLeftJoin(joinType_)) {
-      if (input_ && noMoreRightInput_) {
-        prepareOutput();
-        while (true) {
-          if (outputSize_ == outputBatchSize_) {
-            return std::move(output_);
-          }
+    if (outputLeftMisses(joinType_) && input_ && noMoreRightInput_) {
+      prepareOutput();
+      while (true) {
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
 
-          addOutputRowForLeftJoin(input_, index_);
+        addOutputRowForLeftJoin(input_, index_);
 
-          ++index_;
-          if (index_ == input_->size()) {
-            // Ran out of rows on the left side.
-            input_ = nullptr;
-            return nullptr;
-          }
+        ++index_;
+        if (index_ == input_->size()) {
+          // Ran out of rows on the left side.
+          input_ = nullptr;
+          return nullptr;
         }
       }
+    }
 
+    if (outputRightMisses(joinType_) && rightInput_ && noMoreInput_) {
+      prepareOutput();
+      while (true) {
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
+
+        ++rightIndex_;
+        if (rightIndex_ == rightInput_->size()) {
+          // Ran out of rows on the right side.
+          rightInput_ = nullptr;
+          return nullptr;
+        }
+      }
+    }
+
+    if (isFullJoin(joinType_)) {
+      // Both sides are fully processed once there is no more input on either
+      // side.
+      if (noMoreInput_ && noMoreRightInput_ && output_) {
+        output_->resize(outputSize_);
+        return std::move(output_);
+      }
+    } else if (outputLeftMisses(joinType_)) {
       if (noMoreInput_ && output_) {
         output_->resize(outputSize_);
         return std::move(output_);
       }
+    } else if (isRightJoin(joinType_)) {
+      if (noMoreRightInput_ && !rightInput_) {
+        if (output_) {
+          output_->resize(outputSize_);
+          return std::move(output_);
+        }
+        // The remaining left-side rows have no match.
+        input_ = nullptr;
+      }
     } else {
       if (noMoreInput_ || noMoreRightInput_) {
         if (output_) {
@@ -594,7 +754,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
   for (;;) {
     // Catch up input_ with rightInput_.
     while (compareResult < 0) {
-      if (isLeftJoin(joinType_)) {
+      if (outputLeftMisses(joinType_)) {
         prepareOutput();
 
         if (outputSize_ == outputBatchSize_) {
@@ -615,7 +775,17 @@ RowVectorPtr MergeJoin::doGetOutput() {
 
     // Catch up rightInput_ with input_.
     while (compareResult > 0) {
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, rightIndex_ + 1);
+      if (outputRightMisses(joinType_)) {
+        prepareOutput();
+
+        if (outputSize_ == outputBatchSize_) {
+          return std::move(output_);
+        }
+
+        addOutputRowForRightJoin(rightInput_, rightIndex_);
+      }
+
+      rightIndex_ = nextRightIndex(rightIndex_ + 1);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -666,7 +836,7 @@ RowVectorPtr MergeJoin::doGetOutput() {
       }
 
       index_ = endIndex;
-      rightIndex_ = firstNonNull(rightInput_, rightKeys_, endRightIndex);
+      rightIndex_ = nextRightIndex(endRightIndex);
       if (rightIndex_ == rightInput_->size()) {
         // Ran out of rows on the right side.
         rightInput_ = nullptr;
@@ -694,8 +864,8 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
   auto rawIndices = indices->asMutable<vector_size_t>();
   vector_size_t numPassed = 0;
 
-  if (leftJoinTracker_) {
-    const auto& filterRows = leftJoinTracker_->matchingRows(numRows);
+  if (joinTracker_) {
+    const auto& filterRows = joinTracker_->matchingRows(numRows);
 
     if (!filterRows.hasSelections()) {
       // No matches in the output, no need to evaluate the filter.
@@ -704,12 +874,22 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
 
     evaluateFilter(filterRows);
 
-    // If all matches for a given left-side row fail the filter, add a row to
-    // the output with nulls for the right-side columns.
+    const bool semiJoin = isLeftSemiFilterJoin(joinType_);
+    const bool antiJoin = isAntiJoin(joinType_);
+    const auto& missProjections =
+        isRightJoin(joinType_) ? leftProjections_ : rightProjections_;
+
+    // If all matches for a given left-side row (right-side row for right join)
+    // fail the filter, add a row to the output with nulls for the other side
+    // columns. Left semi join doesn't output such rows.
     auto onMiss = [&](auto row) {
+      if (semiJoin) {
+        return;
+      }
+
       rawIndices[numPassed++] = row;
 
-      for (auto& projection : rightProjections_) {
+      for (auto& projection : missProjections) {
         auto target = output->childAt(projection.outputChannel);
         target->setNull(row, true);
       }
@@ -720,9 +900,13 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
         const bool passed = !decodedFilterResult_.isNullAt(i) &&
             decodedFilterResult_.valueAt<bool>(i);
 
-        leftJoinTracker_->processFilterResult(i, passed, onMiss);
+        const bool firstPassed =
+            joinTracker_->processFilterResult(i, passed, onMiss);
 
-        if (passed) {
+        // Left semi join outputs a left-side row once, for the first match
+        // that passes the filter. Anti join outputs only the left-side rows
+        // for which no match passes the filter.
+        if (semiJoin ? firstPassed : (passed && !antiJoin)) {
           rawIndices[numPassed++] = i;
         }
       } else {
@@ -733,7 +917,7 @@ RowVectorPtr MergeJoin::applyFilter(const RowVectorPtr& output) {
     }
 
     if (!leftMatch_) {
-      leftJoinTracker_->noMoreFilterResults(onMiss);
+      joinTracker_->noMoreFilterResults(onMiss);
     }
   } else {
     filterRows_.resize(numRows);
@@ -771,6 +955,12 @@ void MergeJoin::evaluateFilter(const SelectivityVector& rows) {
 }
 
 bool MergeJoin::isFinished() {
+  if (outputRightMisses(joinType_)) {
+    // The right-side rows with no match are added to the output after all
+    // the left-side input has been processed.
+    return noMoreInput_ && input_ == nullptr && noMoreRightInput_ &&
+        rightInput_ == nullptr && !leftMatch_ && output_ == nullptr;
+  }
   return noMoreInput_ && input_ == nullptr;
 }
 
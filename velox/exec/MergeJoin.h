@@ -64,10 +64,15 @@ class MergeJoin : public Operator {
       vector_size_t otherIndex);
 
   // Compare rows on the left and right at index_ and rightIndex_ respectively.
-  int32_t compare() const {
-    return compare(
-        leftKeys_, input_, index_, rightKeys_, rightInput_, rightIndex_);
-  }
+  // For right and full outer joins, a right-side row with nulls in the join
+  // keys doesn't match any row and compares greater than the left-side row, so
+  // that it is added to the output as a miss.
+  int32_t compare() const;
+
+  // Returns the index of the first right-side row at or after 'start' to
+  // process. Skips rows with nulls in the join keys unless the join outputs
+  // right-side rows with no match.
+  vector_size_t nextRightIndex(vector_size_t start) const;
 
   // Compare two rows on the left: index_ and index.
   int32_t compareLeft(vector_size_t index) const {
@@ -162,8 +167,18 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ positions if these are set. Clears leftMatch_ and
   // rightMatch_ if all rows were added. Updates leftMatchCursor_ and
   // rightMatchCursor_ if output_ filled up before all rows were added.
+  //
+  // Right joins iterate over the right-side rows in the outer loop, so that
+  // all output rows for a given right-side row are adjacent.
   bool addToOutput();
 
+  // Appends the rows of leftMatch_ to output_ for a left semi join and skips
+  // them for an anti join. Used when there is no join filter, so a left-side
+  // row is added at most once regardless of the number of matches. Returns
+  // true if output_ is full. Sets the cursor of leftMatch_ if output_ filled
+  // up before all the rows were added.
+  bool addToOutputForSemiJoin();
+
   // Adds one row of output by copying values from left and right batches at the
   // specified rows. Advances outputSize_. Assumes that output_ has room.
   //
@@ -184,6 +199,13 @@ class MergeJoin : public Operator {
       const RowVectorPtr& left,
       vector_size_t leftIndex);
 
+  /// Adds one row of output for a right-side row with no left-side match.
+  /// Copies values from the 'rightIndex' row of 'right' and fills in nulls
+  /// for columns that correspond to the left side.
+  void addOutputRowForRightJoin(
+      const RowVectorPtr& right,
+      vector_size_t rightIndex);
+
   /// Evaluates join filter on 'filterInput_' and returns 'output' that contains
   /// a subset of rows on which the filter passed. Returns nullptr if no rows
   /// passed the filter.
@@ -195,7 +217,7 @@ class MergeJoin : public Operator {
 
   /// As we populate the results of the left join, we track whether a given
   /// output row is a result of a match between left and right sides or a miss.
-  /// We use LeftJoinTracker::addMatch and addMiss methods for that.
+  /// We use JoinTracker::addMatch and addMiss methods for that.
   ///
   /// Once we have a batch of output, we evaluate the filter on a subset of rows
   /// which correspond to matches between left and right sides. There is no
@@ -207,8 +229,12 @@ class MergeJoin : public Operator {
   /// block, we keep the subset of passing rows. However, if the filter failed
   /// on all rows in such a block, we add one of these rows back and update
   /// build-side columns to null.
-  struct LeftJoinTracker {
-    LeftJoinTracker(vector_size_t numRows, memory::MemoryPool* pool)
+  ///
+  /// Right joins track right-side rows the same way. Left semi joins keep the
+  /// first passing row of each block and anti joins keep a row only for the
+  /// blocks where the filter failed on all rows.
+  struct JoinTracker {
+    JoinTracker(vector_size_t numRows, memory::MemoryPool* pool)
         : matchingRows_{numRows, false} {
       leftRowNumbers_ = AlignedBuffer::allocate<vector_size_t>(numRows, pool);
       rawLeftRowNumbers_ = leftRowNumbers_->asMutable<vector_size_t>();
@@ -265,9 +291,10 @@ class MergeJoin : public Operator {
     /// with the first row. Calls 'onMiss' if the filter failed on all output
     /// rows that correspond to a single left-side row. Use
     /// 'noMoreFilterResults' to make sure 'onMiss' is called for the last
-    /// left-side row.
+    /// left-side row. Returns true if the filter passed on 'outputIndex' and
+    /// failed on all earlier rows for the same left-side row.
     template <typename TOnMiss>
-    void processFilterResult(
+    bool processFilterResult(
         vector_size_t outputIndex,
         bool passed,
         TOnMiss onMiss) {
@@ -283,9 +310,11 @@ class MergeJoin : public Operator {
         currentRow_ = outputIndex;
       }
 
-      if (passed) {
+      if (passed && !currentRowPassed_) {
         currentRowPassed_ = true;
+        return true;
       }
+      return false;
     }
 
     /// Called when all rows from the current output batch are processed and the
@@ -336,7 +365,7 @@ class MergeJoin : public Operator {
     bool currentRowPassed_{false};
   };
 
-  std::optional<LeftJoinTracker> leftJoinTracker_{std::nullopt};
+  std::optional<JoinTracker> joinTracker_{std::nullopt};
 
   // Maximum number of rows in the output batch.
   const uint32_t outputBatchSize_;
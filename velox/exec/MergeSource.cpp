@@ -161,7 +161,8 @@ class MergeExchangeSource : public MergeSource {
           &inputStream_.value(),
           mergeExchange_->pool(),
           mergeExchange_->outputType(),
-          &data);
+          &data,
+          mergeExchange_->serdeOptions());
 
       auto lockedStats = mergeExchange_->stats().wlock();
       lockedStats->addInputVector(data->estimateFlatSize(), data->size());
@@ -59,6 +59,7 @@ OrderBy::OrderBy(
     sortCompareFlags.push_back(
         fromSortOrderToCompareFlags(orderByNode->sortingOrders()[i]));
   }
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
   sortBuffer_ = std::make_unique<SortBuffer>(
       outputType_,
       sortColumnIndices,
@@ -67,7 +68,10 @@ OrderBy::OrderBy(
       &nonReclaimableSection_,
       &numSpillRuns_,
       spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
-      operatorCtx_->driverCtx()->queryConfig().orderBySpillMemoryThreshold());
+      queryConfig.orderBySpillMemoryThreshold(),
+      PrefixSortConfig{
+          queryConfig.prefixSortNormalizedKeyMaxBytes(),
+          queryConfig.prefixSortMinRows()});
 }
 
 void OrderBy::addInput(RowVectorPtr input) {
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/exec/Exchange.h"
 #include "velox/exec/OutputBufferManager.h"
 #include "velox/exec/Task.h"
 
@@ -64,7 +65,7 @@ BlockingReason Destination::advance(
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
-    current_->createStreamTree(rowType, rowsInCurrent_);
+    current_->createStreamTree(rowType, rowsInCurrent_, serdeOptions_);
   }
   current_->append(
       output, folly::Range(&rangesToSerialize_[0], rangesToSerialize_.size()));
@@ -138,7 +139,9 @@ PartitionedOutput::PartitionedOutput(
       bufferReleaseFn_([task = operatorCtx_->task()]() {}),
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
-                            .maxPartitionedOutputBufferSize()) {
+                            .maxPartitionedOutputBufferSize()),
+      serdeOptions_(makeExchangeSerdeOptions(
+          ctx->task->queryCtx()->queryConfig())) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -179,8 +182,8 @@ void PartitionedOutput::initializeDestinations() {
   if (destinations_.empty()) {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
-      destinations_.push_back(
-          std::make_unique<detail::Destination>(taskId, i, pool()));
+      destinations_.push_back(std::make_unique<detail::Destination>(
+          taskId, i, pool(), serdeOptions_.get()));
     }
   }
 }
@@ -28,8 +28,12 @@ class Destination {
   Destination(
       const std::string& taskId,
       int destination,
-      memory::MemoryPool* pool)
-      : taskId_(taskId), destination_(destination), pool_(pool) {
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* serdeOptions = nullptr)
+      : taskId_(taskId),
+        destination_(destination),
+        pool_(pool),
+        serdeOptions_(serdeOptions) {
     setTargetSizePct();
   }
 
@@ -93,6 +97,8 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* const pool_;
+  // Options for serializing to 'current_'. Owned by the PartitionedOutput.
+  const VectorSerde::Options* const serdeOptions_;
   // Bytes serialized in 'current_'
   uint64_t bytesInCurrent_{0};
   // Number of rows serialized in 'current_'
@@ -196,6 +202,8 @@ class PartitionedOutput : public Operator {
   const std::weak_ptr<exec::OutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
+  // Options for serializing the output pages. nullptr for the defaults.
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+
+#include <folly/lang/Bits.h>
+
+#include "velox/buffer/Buffer.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Strings get at least this many bytes of prefix. A string key is not encoded
+// if fewer bytes are left.
+constexpr uint32_t kMinStringPrefixBytes = 4;
+
+// Returns the number of bytes that encode a value of 'kind' after the null
+// byte when 'available' bytes are left in the prefix. Returns 0 if the value
+// cannot be encoded.
+uint32_t encodedValueSize(TypeKind kind, uint32_t available) {
+  uint32_t size = 0;
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      size = 1;
+      break;
+    case TypeKind::SMALLINT:
+      size = 2;
+      break;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      size = 4;
+      break;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      size = 8;
+      break;
+    case TypeKind::TIMESTAMP:
+      // Seconds followed by nanos, which are less than 10^9.
+      size = 12;
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return available >= kMinStringPrefixBytes ? available : 0;
+    default:
+      return 0;
+  }
+  return size <= available ? size : 0;
+}
+
+bool isStringKind(TypeKind kind) {
+  return kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+}
+
+template <typename T>
+inline void encodeBigEndian(T value, char* out) {
+  value = folly::Endian::big(value);
+  memcpy(out, &value, sizeof(T));
+}
+
+// Flips the sign bit so that signed integers compare as unsigned.
+template <typename T>
+inline void encodeInteger(T value, char* out) {
+  using U = std::make_unsigned_t<T>;
+  constexpr U kSignBit = U(1) << (sizeof(U) * 8 - 1);
+  encodeBigEndian<U>(static_cast<U>(value) ^ kSignBit, out);
+}
+
+// Orders negative values before positive ones by flipping all bits of
+// negative values and the sign bit of positive ones. -0 is encoded as 0 and
+// all NaNs as one NaN that is greater than infinity, which matches
+// SimpleVector::comparePrimitiveAsc().
+template <typename T, typename U>
+inline void encodeFloatingPoint(T value, char* out) {
+  if (std::isnan(value)) {
+    value = std::numeric_limits<T>::quiet_NaN();
+  } else if (value == 0) {
+    value = 0;
+  }
+  U bits;
+  memcpy(&bits, &value, sizeof(U));
+  constexpr U kSignBit = U(1) << (sizeof(U) * 8 - 1);
+  encodeBigEndian<U>((bits & kSignBit) ? ~bits : bits ^ kSignBit, out);
+}
+
+// A row pointer with the prefix of its keys.
+template <int32_t kNumWords>
+struct PrefixEntry {
+  uint64_t words[kNumWords];
+  char* row;
+};
+
+// Returns the number of words of the PrefixEntry for a prefix of
+// 'prefixSize' bytes.
+int32_t prefixWords(uint32_t prefixSize) {
+  const auto numWords = bits::roundUp(prefixSize, 8) / 8;
+  if (numWords <= 4) {
+    return numWords;
+  }
+  return numWords <= 8 ? 8 : 16;
+}
+
+} // namespace
+
+PrefixSort::PrefixSort(
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    uint32_t maxNormalizedKeyBytes)
+    : rowContainer_(rowContainer), compareFlags_(compareFlags) {
+  const auto& keyTypes = rowContainer_->keyTypes();
+  VELOX_CHECK_LE(compareFlags_.size(), keyTypes.size());
+  maxNormalizedKeyBytes =
+      std::min(maxNormalizedKeyBytes, kMaxNormalizedKeyBytes);
+  for (; firstUnencodedKey_ < compareFlags_.size(); ++firstUnencodedKey_) {
+    const auto kind = keyTypes[firstUnencodedKey_]->kind();
+    if (prefixSize_ >= maxNormalizedKeyBytes) {
+      break;
+    }
+    const auto size =
+        encodedValueSize(kind, maxNormalizedKeyBytes - prefixSize_ - 1);
+    if (size == 0) {
+      break;
+    }
+    encodings_.push_back(
+        {rowContainer_->columnAt(firstUnencodedKey_),
+         kind,
+         compareFlags_[firstUnencodedKey_],
+         prefixSize_,
+         size});
+    prefixSize_ += 1 + size;
+    if (isStringKind(kind)) {
+      // Strings longer than the prefix are compared in the RowContainer. The
+      // keys after the string cannot be encoded.
+      break;
+    }
+  }
+}
+
+// static
+uint32_t PrefixSort::prefixSize(
+    const std::vector<TypePtr>& keyTypes,
+    uint32_t maxNormalizedKeyBytes) {
+  maxNormalizedKeyBytes =
+      std::min(maxNormalizedKeyBytes, kMaxNormalizedKeyBytes);
+  uint32_t size = 0;
+  for (const auto& type : keyTypes) {
+    if (size >= maxNormalizedKeyBytes) {
+      break;
+    }
+    const auto valueSize =
+        encodedValueSize(type->kind(), maxNormalizedKeyBytes - size - 1);
+    if (valueSize == 0) {
+      break;
+    }
+    size += 1 + valueSize;
+    if (isStringKind(type->kind())) {
+      break;
+    }
+  }
+  return size;
+}
+
+// static
+uint64_t PrefixSort::maxRequiredBytes(
+    const RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    const PrefixSortConfig& config,
+    uint64_t numRows) {
+  if (config.maxNormalizedKeyBytes == 0 || numRows < config.minNumRows) {
+    return 0;
+  }
+  const auto& keyTypes = rowContainer->keyTypes();
+  VELOX_CHECK_LE(compareFlags.size(), keyTypes.size());
+  const std::vector<TypePtr> sortKeyTypes(
+      keyTypes.begin(), keyTypes.begin() + compareFlags.size());
+  const auto numWords =
+      prefixWords(prefixSize(sortKeyTypes, config.maxNormalizedKeyBytes));
+  if (numWords == 0) {
+    return 0;
+  }
+  return numRows * (numWords * sizeof(uint64_t) + sizeof(char*));
+}
+
+// static
+void PrefixSort::sort(
+    RowContainer* rowContainer,
+    const std::vector<CompareFlags>& compareFlags,
+    const PrefixSortConfig& config,
+    memory::MemoryPool* pool,
+    std::vector<char*>& rows) {
+  if (config.maxNormalizedKeyBytes > 0 && rows.size() >= config.minNumRows) {
+    PrefixSort prefixSort(
+        rowContainer, compareFlags, config.maxNormalizedKeyBytes);
+    switch (prefixWords(prefixSort.prefixSize_)) {
+      case 0:
+        // The first key cannot be encoded.
+        break;
+      case 1:
+        return prefixSort.sortWithPrefix<1>(pool, rows);
+      case 2:
+        return prefixSort.sortWithPrefix<2>(pool, rows);
+      case 3:
+        return prefixSort.sortWithPrefix<3>(pool, rows);
+      case 4:
+        return prefixSort.sortWithPrefix<4>(pool, rows);
+      case 8:
+        return prefixSort.sortWithPrefix<8>(pool, rows);
+      default:
+        return prefixSort.sortWithPrefix<16>(pool, rows);
+    }
+  }
+
+  std::sort(
+      rows.begin(),
+      rows.end(),
+      [&](const char* leftRow, const char* rightRow) {
+        for (auto i = 0; i < compareFlags.size(); ++i) {
+          if (auto result = rowContainer->compare(
+                  leftRow, rightRow, i, compareFlags[i])) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+}
+
+template <int32_t kNumWords>
+void PrefixSort::sortWithPrefix(
+    memory::MemoryPool* pool,
+    std::vector<char*>& rows) {
+  using Entry = PrefixEntry<kNumWords>;
+  static_assert(std::is_trivially_copyable_v<Entry>);
+  VELOX_DCHECK_LE(prefixSize_, sizeof(Entry::words));
+
+  const auto numRows = rows.size();
+  auto buffer = AlignedBuffer::allocate<char>(numRows * sizeof(Entry), pool);
+  auto* entries = buffer->asMutable<Entry>();
+  for (size_t i = 0; i < numRows; ++i) {
+    auto& entry = entries[i];
+    memset(entry.words, 0, sizeof(entry.words));
+    encode(rows[i], reinterpret_cast<char*>(entry.words));
+    entry.row = rows[i];
+  }
+
+  if (firstUnencodedKey_ == compareFlags_.size()) {
+    std::sort(
+        entries, entries + numRows, [](const Entry& left, const Entry& right) {
+          return memcmp(left.words, right.words, sizeof(left.words)) < 0;
+        });
+  } else {
+    std::sort(
+        entries,
+        entries + numRows,
+        [this](const Entry& left, const Entry& right) {
+          if (auto result =
+                  memcmp(left.words, right.words, sizeof(left.words))) {
+            return result < 0;
+          }
+          return lessOnTie(left.row, right.row);
+        });
+  }
+
+  for (size_t i = 0; i < numRows; ++i) {
+    rows[i] = entries[i].row;
+  }
+}
+
+void PrefixSort::encode(const char* row, char* prefix) const {
+  for (const auto& encoding : encodings_) {
+    auto* out = prefix + encoding.offset;
+    const bool nullsFirst = encoding.flags.nullsFirst;
+    if (RowContainer::isNullAt(row, encoding.column)) {
+      // The value bytes are left as zeros.
+      out[0] = nullsFirst ? 0 : 1;
+      continue;
+    }
+    out[0] = nullsFirst ? 1 : 0;
+    ++out;
+    const auto* value = row + encoding.column.offset();
+    switch (encoding.kind) {
+      case TypeKind::BOOLEAN:
+        out[0] = *reinterpret_cast<const bool*>(value) ? 1 : 0;
+        break;
+      case TypeKind::TINYINT:
+        encodeInteger(*reinterpret_cast<const int8_t*>(value), out);
+        break;
+      case TypeKind::SMALLINT:
+        encodeInteger(*reinterpret_cast<const int16_t*>(value), out);
+        break;
+      case TypeKind::INTEGER:
+        encodeInteger(*reinterpret_cast<const int32_t*>(value), out);
+        break;
+      case TypeKind::BIGINT:
+        encodeInteger(*reinterpret_cast<const int64_t*>(value), out);
+        break;
+      case TypeKind::REAL:
+        encodeFloatingPoint<float, uint32_t>(
+            *reinterpret_cast<const float*>(value), out);
+        break;
+      case TypeKind::DOUBLE:
+        encodeFloatingPoint<double, uint64_t>(
+            *reinterpret_cast<const double*>(value), out);
+        break;
+      case TypeKind::TIMESTAMP: {
+        const auto& timestamp = *reinterpret_cast<const Timestamp*>(value);
+        encodeInteger(timestamp.getSeconds(), out);
+        encodeBigEndian(static_cast<uint32_t>(timestamp.getNanos()), out + 8);
+        break;
+      }
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY: {
+        // Shorter strings are padded with zeros, so that a string is never
+        // after a longer string that it is a prefix of.
+        std::string storage;
+        auto string = HashStringAllocator::contiguousString(
+            *reinterpret_cast<const StringView*>(value), storage);
+        memcpy(
+            out,
+            string.data(),
+            std::min<size_t>(string.size(), encoding.size));
+        break;
+      }
+      default:
+        VELOX_UNREACHABLE();
+    }
+    if (!encoding.flags.ascending) {
+      for (uint32_t i = 0; i < encoding.size; ++i) {
+        out[i] = ~out[i];
+      }
+    }
+  }
+}
+
+bool PrefixSort::lessOnTie(const char* left, const char* right) const {
+  for (auto i = firstUnencodedKey_; i < compareFlags_.size(); ++i) {
+    if (auto result =
+            rowContainer_->compare(left, right, i, compareFlags_[i])) {
+      return result < 0;
+    }
+  }
+  return false;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Specifies when and how rows are sorted with PrefixSort.
+struct PrefixSortConfig {
+  /// The max number of bytes of the normalized key prefix of a row. Zero
+  /// disables prefix sort.
+  uint32_t maxNormalizedKeyBytes{0};
+
+  /// The minimum number of rows for sorting with prefix sort.
+  uint32_t minNumRows{128};
+};
+
+/// Sorts rows of a RowContainer by their leading key columns. The keys of each
+/// row are encoded into a fixed width normalized key prefix that compares with
+/// memcmp in the same order as RowContainer::compare() with the CompareFlags
+/// of the keys. The prefixes are stored contiguously next to the row pointers
+/// and sorted with std::sort. Keys are encoded in order until the prefix is
+/// full or a key cannot be encoded. Strings are encoded by their first bytes,
+/// so no key after a string is encoded. The keys that are not fully encoded
+/// are only compared in the RowContainer when the prefixes are equal.
+///
+/// Encodes fixed width keys of BOOLEAN, TINYINT, SMALLINT, INTEGER, BIGINT,
+/// REAL, DOUBLE and TIMESTAMP type and VARCHAR and VARBINARY keys. Each key
+/// starts with a byte that orders nulls before or after the values.
+class PrefixSort {
+ public:
+  /// Sorts 'rows' of 'rowContainer' by the first 'compareFlags.size()' key
+  /// columns of 'rowContainer'. Uses std::sort with RowContainer::compare()
+  /// if prefix sort is disabled in 'config', if there are fewer than
+  /// 'config.minNumRows' rows or if the first key cannot be encoded. The
+  /// prefixes are allocated from 'pool'.
+  static void sort(
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const PrefixSortConfig& config,
+      memory::MemoryPool* pool,
+      std::vector<char*>& rows);
+
+  /// Returns the number of bytes that sort() allocates from the pool for
+  /// sorting 'numRows' rows of 'rowContainer' with the same 'compareFlags'
+  /// and 'config'. Returns 0 if the rows are not sorted with prefixes.
+  static uint64_t maxRequiredBytes(
+      const RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      const PrefixSortConfig& config,
+      uint64_t numRows);
+
+  /// Returns the number of prefix bytes that encode the keys of 'keyTypes'
+  /// with at most 'maxNormalizedKeyBytes'. Returns 0 if no key can be
+  /// encoded.
+  static uint32_t prefixSize(
+      const std::vector<TypePtr>& keyTypes,
+      uint32_t maxNormalizedKeyBytes);
+
+  /// The largest prefix that is encoded regardless of the configured size.
+  static constexpr uint32_t kMaxNormalizedKeyBytes = 128;
+
+ private:
+  struct KeyEncoding {
+    RowColumn column;
+    TypeKind kind;
+    CompareFlags flags;
+    // Offset of the null byte of the key in the prefix.
+    uint32_t offset;
+    // Number of bytes of the value after the null byte.
+    uint32_t size;
+  };
+
+  PrefixSort(
+      RowContainer* rowContainer,
+      const std::vector<CompareFlags>& compareFlags,
+      uint32_t maxNormalizedKeyBytes);
+
+  template <int32_t kNumWords>
+  void sortWithPrefix(memory::MemoryPool* pool, std::vector<char*>& rows);
+
+  // Writes the normalized key prefix of 'row' to 'prefix'.
+  void encode(const char* row, char* prefix) const;
+
+  // Compares the keys of 'left' and 'right' from 'firstUnencodedKey_' on.
+  // Returns true if 'left' is before 'right'.
+  bool lessOnTie(const char* left, const char* right) const;
+
+  RowContainer* const rowContainer_;
+  const std::vector<CompareFlags>& compareFlags_;
+  std::vector<KeyEncoding> encodings_;
+  uint32_t prefixSize_{0};
+  // The first key that is not completely determined by the prefix.
+  // 'compareFlags_.size()' if prefix ties mean equal keys.
+  uint32_t firstUnencodedKey_{0};
+};
+
+} // namespace facebook::velox::exec
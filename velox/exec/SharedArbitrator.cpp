@@ -16,6 +16,8 @@
 
 #include "velox/exec/SharedArbitrator.h"
 
+#include <optional>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
@@ -57,6 +59,21 @@ std::string memoryPoolAbortMessage(
       << victim->treeMemoryUsage();
   return out.str();
 }
+
+// Returns the priority of the query of root memory 'pool'. This is the highest
+// priority of the reclaimers of the root pool and of its task pools, which
+// carry the priority of the query config.
+int32_t queryPriority(const MemoryPool& pool) {
+  int32_t priority =
+      pool.reclaimer() == nullptr ? 0 : pool.reclaimer()->queryPriority();
+  pool.visitChildren([&](MemoryPool* child) {
+    if (child->reclaimer() != nullptr) {
+      priority = std::max(priority, child->reclaimer()->queryPriority());
+    }
+    return true;
+  });
+  return priority;
+}
 } // namespace
 
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
@@ -66,11 +83,36 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] "
+      "PRIORITY[{}]]",
       pool->root()->name(),
       reclaimable,
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      priority);
+}
+
+std::string SharedArbitrator::QueryStats::toString() const {
+  std::string histogram;
+  for (auto i = 0; i < kNumLatencyBuckets; ++i) {
+    if (latencyHistogram[i] != 0) {
+      histogram += i == kNumLatencyBuckets - 1
+          ? fmt::format(" >={}us:{}", 1UL << (i - 1), latencyHistogram[i])
+          : fmt::format(" <{}us:{}", 1UL << i, latencyHistogram[i]);
+    }
+  }
+  return fmt::format(
+      "PRIORITY[{}] NUM_REQUESTS[{}] ARBITRATION_TIME[{}] LATENCY[{}]",
+      priority,
+      numRequests,
+      succinctMicros(arbitrationTimeUs),
+      histogram);
+}
+
+// static
+int32_t SharedArbitrator::latencyBucket(uint64_t micros) {
+  const int32_t bucket = micros == 0 ? 0 : 64 - __builtin_clzll(micros);
+  return std::min(bucket, kNumLatencyBuckets - 1);
 }
 
 void SharedArbitrator::sortCandidatesByFreeCapacity(
@@ -99,6 +141,9 @@ void SharedArbitrator::sortCandidatesByReclaimableMemory(
         if (!rhs.reclaimable) {
           return true;
         }
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -114,6 +159,7 @@ SharedArbitrator::findCandidateWithLargestCapacity(
     const std::vector<Candidate>& candidates) const {
   VELOX_CHECK(!candidates.empty());
   int32_t candidateIdx{-1};
+  int32_t minPriority{0};
   int64_t maxCapacity{-1};
   for (int32_t i = 0; i < candidates.size(); ++i) {
     const bool isCandidate = candidates[i].pool == requestor;
@@ -121,12 +167,18 @@ SharedArbitrator::findCandidateWithLargestCapacity(
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    // Aborting a query without capacity frees nothing.
+    if (capacity == 0 && !isCandidate) {
+      continue;
+    }
+    const int32_t priority = candidates[i].priority;
+    if (candidateIdx == -1 || priority < minPriority) {
+      candidateIdx = i;
+      minPriority = priority;
       maxCapacity = capacity;
       continue;
     }
-    if (capacity < maxCapacity) {
+    if (priority > minPriority || capacity < maxCapacity) {
       continue;
     }
     if (capacity > maxCapacity) {
@@ -164,10 +216,23 @@ void SharedArbitrator::reserveMemory(MemoryPool* pool, uint64_t /*unused*/) {
 }
 
 void SharedArbitrator::releaseMemory(MemoryPool* pool) {
-  std::lock_guard<std::mutex> l(mutex_);
-  ++numReleases_;
-  const uint64_t freedBytes = pool->shrink(0);
-  incrementFreeCapacityLocked(freedBytes);
+  std::optional<QueryStats> queryStats;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++numReleases_;
+    auto it = queryStats_.find(pool->name());
+    if (it != queryStats_.end()) {
+      queryStats = std::move(it->second);
+      queryStats_.erase(it);
+    }
+    const uint64_t freedBytes = pool->shrink(0);
+    incrementFreeCapacityLocked(freedBytes);
+  }
+  if (queryStats.has_value()) {
+    VELOX_MEM_LOG_EVERY_MS(INFO, 1000)
+        << "Arbitration stats of memory pool " << pool->name() << ": "
+        << queryStats->toString();
+  }
 }
 
 std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
@@ -178,7 +243,11 @@ std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
     uint64_t reclaimableBytes;
     const bool reclaimable = pool->reclaimableBytes(reclaimableBytes);
     candidates.push_back(
-        {reclaimable, reclaimableBytes, pool->freeBytes(), pool.get()});
+        {reclaimable,
+         reclaimableBytes,
+         pool->freeBytes(),
+         pool.get(),
+         queryPriority(*pool)});
   }
   return candidates;
 }
@@ -378,15 +447,22 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
     MemoryPool* requestor,
     std::vector<Candidate>& candidates,
     uint64_t targetBytes) {
-  // Sort candidate memory pools based on their reclaimable memory.
+  // Sort candidate memory pools based on their priority and reclaimable
+  // memory.
   sortCandidatesByReclaimableMemory(candidates);
 
+  const int32_t requestorPriority = queryPriority(*requestor);
   int64_t freedBytes{0};
   for (const auto& candidate : candidates) {
     VELOX_CHECK_LT(freedBytes, targetBytes);
-    if (!candidate.reclaimable || candidate.reclaimableBytes == 0) {
+    if (!candidate.reclaimable) {
       break;
     }
+    // Never reclaims from a query with higher priority than the requestor.
+    if (candidate.reclaimableBytes == 0 ||
+        candidate.priority > requestorPriority) {
+      continue;
+    }
     const int64_t bytesToReclaim = std::max<int64_t>(
         targetBytes - freedBytes, memoryPoolTransferCapacity_);
     VELOX_CHECK_GT(bytesToReclaim, 0);
@@ -506,6 +582,24 @@ MemoryArbitrator::Stats SharedArbitrator::statsLocked() const {
   return stats;
 }
 
+std::unordered_map<std::string, SharedArbitrator::QueryStats>
+SharedArbitrator::queryStats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return queryStats_;
+}
+
+void SharedArbitrator::recordQueryArbitration(
+    MemoryPool* requestor,
+    uint64_t timeUs) {
+  const int32_t priority = queryPriority(*requestor);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& stats = queryStats_[requestor->name()];
+  stats.priority = priority;
+  ++stats.numRequests;
+  stats.arbitrationTimeUs += timeUs;
+  ++stats.latencyHistogram[latencyBucket(timeUs)];
+}
+
 std::string SharedArbitrator::toString() const {
   std::lock_guard<std::mutex> l(mutex_);
   return toStringLocked();
@@ -539,6 +633,8 @@ SharedArbitrator::ScopedArbitration::~ScopedArbitration() {
       std::chrono::duration_cast<std::chrono::microseconds>(
           std::chrono::steady_clock::now() - startTime_);
   arbitrator_->arbitrationTimeUs_ += arbitrationTime.count();
+  arbitrator_->recordQueryArbitration(
+      requestor_->root(), arbitrationTime.count());
   arbitrator_->finishArbitration();
 }
 
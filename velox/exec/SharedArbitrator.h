@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <array>
+#include <unordered_map>
+
 #include "velox/common/memory/MemoryArbitrator.h"
 
 #include "velox/common/future/VeloxPromise.h"
@@ -33,6 +36,13 @@ namespace facebook::velox::exec {
 /// aborting a query. For Prestissimo-on-Spark, we can configure it to
 /// reclaim from a running query through techniques such as disk-spilling,
 /// partial aggregation or persistent shuffle data flushes.
+///
+/// Each query has a priority given by the reclaimers of its root and task
+/// memory pools. The arbitrator reclaims from the queries with lower priority
+/// first, and within a query from the plan nodes with lower reclaim cost
+/// first. It never reclaims from or aborts a query with higher priority than
+/// the requestor, so that an interactive query is not aborted to make room
+/// for a batch query.
 class SharedArbitrator : public memory::MemoryArbitrator {
  public:
   explicit SharedArbitrator(const Config& config);
@@ -64,12 +74,38 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   std::string toString() const final;
 
+  /// Latency buckets are powers of 2 microseconds, i.e. bucket i counts the
+  /// arbitration requests that took [2^(i-1), 2^i) us.
+  static constexpr int32_t kNumLatencyBuckets = 32;
+
+  /// The arbitration stats of a query.
+  struct QueryStats {
+    int32_t priority{0};
+    uint64_t numRequests{0};
+    /// The total time of the arbitration requests including the queue time.
+    uint64_t arbitrationTimeUs{0};
+    /// Histogram of the arbitration request latencies including the queue
+    /// time.
+    std::array<uint64_t, kNumLatencyBuckets> latencyHistogram{};
+
+    std::string toString() const;
+  };
+
+  /// Returns the arbitration stats of the running queries keyed by the name
+  /// of their root memory pools.
+  std::unordered_map<std::string, QueryStats> queryStats() const;
+
+  /// Returns the latency bucket for 'micros'.
+  static int32_t latencyBucket(uint64_t micros);
+
   // The candidate memory pool stats used by arbitration.
   struct Candidate {
     bool reclaimable{false};
     uint64_t reclaimableBytes{0};
     uint64_t freeBytes{0};
     MemoryPool* pool;
+    // The priority of the query of 'pool'.
+    int32_t priority{0};
 
     std::string toString() const;
   };
@@ -108,14 +144,18 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   static std::vector<Candidate> getCandidateStats(
       const std::vector<std::shared_ptr<MemoryPool>>& pools);
 
+  // Sorts the reclaimable candidates first, by priority and then by
+  // reclaimable memory.
   void sortCandidatesByReclaimableMemory(
       std::vector<Candidate>& candidates) const;
 
   void sortCandidatesByFreeCapacity(std::vector<Candidate>& candidates) const;
 
-  // Finds the candidate with the largest capacity. For 'requestor', the
-  // capacity for comparison including its current capacity and the capacity to
-  // grow.
+  // Finds the candidate with the lowest priority and the largest capacity
+  // within that priority. For 'requestor', the capacity for comparison
+  // including its current capacity and the capacity to grow. As 'requestor'
+  // is one of 'candidates', a query with higher priority than 'requestor' is
+  // never selected.
   const Candidate& findCandidateWithLargestCapacity(
       MemoryPool* requestor,
       uint64_t targetBytes,
@@ -144,7 +184,8 @@ class SharedArbitrator : public memory::MemoryArbitrator {
       std::vector<Candidate>& candidates,
       uint64_t targetBytes);
 
-  // Invoked to reclaim used memory capacity from 'candidates'.
+  // Invoked to reclaim used memory capacity from 'candidates' with no higher
+  // priority than 'requestor'.
   //
   // NOTE: the function might sort 'candidates' based on each candidate's
   // reclaimable memory internally.
@@ -184,6 +225,9 @@ class SharedArbitrator : public memory::MemoryArbitrator {
 
   Stats statsLocked() const;
 
+  // Records an arbitration request of 'requestor' which took 'timeUs'.
+  void recordQueryArbitration(MemoryPool* requestor, uint64_t timeUs);
+
   mutable std::mutex mutex_;
   uint64_t freeCapacity_{0};
   // Indicates if there is a running arbitration request or not.
@@ -193,6 +237,10 @@ class SharedArbitrator : public memory::MemoryArbitrator {
   // execution.
   std::vector<ContinuePromise> waitPromises_;
 
+  // The arbitration stats of the running queries keyed by the name of their
+  // root memory pools. Removed on releaseMemory().
+  std::unordered_map<std::string, QueryStats> queryStats_;
+
   tsan_atomic<uint64_t> numRequests_{0};
   std::atomic<uint64_t> numSucceeded_{0};
   tsan_atomic<uint64_t> numAborted_{0};
@@ -28,14 +28,16 @@ SortBuffer::SortBuffer(
     tsan_atomic<bool>* nonReclaimableSection,
     uint32_t* numSpillRuns,
     const common::SpillConfig* spillConfig,
-    uint64_t spillMemoryThreshold)
+    uint64_t spillMemoryThreshold,
+    const PrefixSortConfig& prefixSortConfig)
     : input_(input),
       sortCompareFlags_(sortCompareFlags),
       pool_(pool),
       nonReclaimableSection_(nonReclaimableSection),
       numSpillRuns_(numSpillRuns),
       spillConfig_(spillConfig),
-      spillMemoryThreshold_(spillMemoryThreshold) {
+      spillMemoryThreshold_(spillMemoryThreshold),
+      prefixSortConfig_(prefixSortConfig) {
   VELOX_CHECK_GE(input_->size(), sortCompareFlags_.size());
   VELOX_CHECK_GT(sortCompareFlags_.size(), 0);
   VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags_.size());
@@ -108,6 +110,8 @@ void SortBuffer::noMoreInput() {
     return;
   }
 
+  ensureSortFits();
+
   if (spiller_ == nullptr) {
     VELOX_CHECK_EQ(numInputRows_, data_->numRows());
     updateEstimatedOutputRowSize();
@@ -116,19 +120,10 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
-            }
-          }
-          return false;
-        });
+    PrefixSort::sort(
+        data_.get(), sortCompareFlags_, prefixSortConfig_, pool_, sortedRows_);
+    // The prefixes are freed after the sort.
+    pool_->release();
   } else {
     // Spill the remaining in-memory state to disk if spilling has been
     // triggered on this sort buffer. This is to simplify query OOM prevention
@@ -142,7 +137,7 @@ void SortBuffer::noMoreInput() {
     VELOX_CHECK_LE(spiller_->stats().spilledPartitions, 1);
 
     VELOX_CHECK_NULL(spillMerger_);
-    spillMerger_ = spiller_->startMerge();
+    spillMerger_ = spiller_->startMerge(spillConfig_->readAheadBytes);
   }
 }
 
@@ -262,6 +257,28 @@ void SortBuffer::ensureInputFits(const VectorPtr& input) {
   spill();
 }
 
+void SortBuffer::ensureSortFits() {
+  // Check if spilling is enabled or not.
+  if (spillConfig_ == nullptr || spiller_ != nullptr || numInputRows_ == 0) {
+    return;
+  }
+
+  const uint64_t sortBytes = numInputRows_ * sizeof(char*) +
+      PrefixSort::maxRequiredBytes(
+          data_.get(), sortCompareFlags_, prefixSortConfig_, numInputRows_);
+  if (pool_->availableReservation() >= sortBytes) {
+    return;
+  }
+  {
+    exec::ReclaimableSectionGuard guard(nonReclaimableSection_);
+    if (pool_->maybeReserve(sortBytes)) {
+      return;
+    }
+  }
+
+  spill();
+}
+
 void SortBuffer::updateEstimatedOutputRowSize() {
   const auto optionalRowSize = data_->estimateRowSize();
   if (!optionalRowSize.has_value() || optionalRowSize.value() == 0) {
@@ -19,6 +19,7 @@
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/exec/Spill.h"
 #include "velox/vector/BaseVector.h"
@@ -38,7 +39,8 @@ class SortBuffer {
       tsan_atomic<bool>* nonReclaimableSection,
       uint32_t* numSpillRuns,
       const common::SpillConfig* spillConfig = nullptr,
-      uint64_t spillMemoryThreshold = 0);
+      uint64_t spillMemoryThreshold = 0,
+      const PrefixSortConfig& prefixSortConfig = {});
 
   void addInput(const VectorPtr& input);
 
@@ -76,6 +78,10 @@ class SortBuffer {
  private:
   // Ensures there is sufficient memory reserved to process 'input'.
   void ensureInputFits(const VectorPtr& input);
+  // Reserves memory for sorting the in-memory rows after all input is
+  // received, i.e. the sorted row pointers and the prefixes of PrefixSort.
+  // Spills all rows if the reservation fails.
+  void ensureSortFits();
   void updateEstimatedOutputRowSize();
   // Invoked to initialize or reset the reusable output buffer to get output.
   void prepareOutput(uint32_t maxOutputRows);
@@ -97,6 +103,8 @@ class SortBuffer {
   //
   // NOTE: 'spillMemoryThreshold_' only applies if disk spilling is enabled.
   const uint64_t spillMemoryThreshold_;
+  // Configures the sort of the in-memory rows with PrefixSort.
+  const PrefixSortConfig prefixSortConfig_;
 
   // The column projection map between 'input_' and 'spillerStoreType_' as sort
   // buffer stores the sort columns first in 'data_'.
@@ -43,11 +43,13 @@ SortWindowBuild::SortWindowBuild(
     const std::shared_ptr<const core::WindowNode>& node,
     velox::memory::MemoryPool* pool,
     const common::SpillConfig* spillConfig,
-    tsan_atomic<bool>* nonReclaimableSection)
+    tsan_atomic<bool>* nonReclaimableSection,
+    const PrefixSortConfig& prefixSortConfig)
     : WindowBuild(node, pool, spillConfig, nonReclaimableSection),
       numPartitionKeys_{node->partitionKeys().size()},
       spillCompareFlags_{
-          makeSpillCompareFlags(numPartitionKeys_, node->sortingOrders())} {
+          makeSpillCompareFlags(numPartitionKeys_, node->sortingOrders())},
+      prefixSortConfig_{prefixSortConfig} {
   allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
   allKeyInfo_.insert(
       allKeyInfo_.cend(), partitionKeyInfo_.begin(), partitionKeyInfo_.end());
@@ -129,6 +131,27 @@ void SortWindowBuild::ensureInputFits(const RowVectorPtr& input) {
   spill();
 }
 
+void SortWindowBuild::ensureSortFits() {
+  if (spillConfig_ == nullptr || spiller_ != nullptr) {
+    return;
+  }
+
+  const uint64_t sortBytes = numRows_ * sizeof(char*) +
+      PrefixSort::maxRequiredBytes(
+          data_.get(), spillCompareFlags_, prefixSortConfig_, numRows_);
+  if (data_->pool()->availableReservation() >= sortBytes) {
+    return;
+  }
+  {
+    ReclaimableSectionGuard guard(nonReclaimableSection_);
+    if (data_->pool()->maybeReserve(sortBytes)) {
+      return;
+    }
+  }
+
+  spill();
+}
+
 void SortWindowBuild::setupSpiller() {
   VELOX_CHECK_NULL(spiller_);
 
@@ -147,6 +170,17 @@ void SortWindowBuild::setupSpiller() {
 }
 
 void SortWindowBuild::spill() {
+  if (merge_ != nullptr) {
+    // The remaining partitions are read back from spill. 'data_' only has the
+    // partition being output.
+    return;
+  }
+
+  if (!partitionStartRows_.empty()) {
+    spillUnprocessedPartitions();
+    return;
+  }
+
   if (spiller_ == nullptr) {
     setupSpiller();
   }
@@ -156,6 +190,38 @@ void SortWindowBuild::spill() {
   data_->pool()->release();
 }
 
+void SortWindowBuild::spillUnprocessedPartitions() {
+  VELOX_CHECK_NULL(spiller_);
+
+  // The rows of the partitions after 'currentPartition_' are contiguous in
+  // 'sortedRows_' and already sorted by partition and sorting keys.
+  const auto startRow = partitionStartRows_[currentPartition_ + 1];
+  if (startRow == sortedRows_.size()) {
+    // All partitions have been output.
+    return;
+  }
+
+  setupSpiller();
+  auto spillRows = folly::Range<char**>(
+      sortedRows_.data() + startRow, sortedRows_.size() - startRow);
+  spiller_->spill(spillRows);
+  spiller_->finalizeSpill();
+  merge_ = spiller_->startMerge(spillConfig_->readAheadBytes);
+
+  if (currentPartition_ < 0) {
+    sortedRows_.clear();
+    data_->clear();
+  } else {
+    // The WindowPartition of 'currentPartition_' references its rows in
+    // 'data_' and 'sortedRows_', so only erase the spilled rows. Shrinking
+    // 'sortedRows_' does not reallocate it.
+    data_->eraseRows(spillRows);
+    sortedRows_.resize(startRow);
+  }
+  partitionStartRows_.clear();
+  data_->pool()->release();
+}
+
 void SortWindowBuild::computePartitionStartRows() {
   partitionStartRows_.reserve(numRows_);
   auto partitionCompare = [&](const char* lhs, const char* rhs) -> bool {
@@ -182,20 +248,22 @@ void SortWindowBuild::computePartitionStartRows() {
 }
 
 void SortWindowBuild::sortPartitions() {
-  // This is a very inefficient but easy implementation to order the input rows
-  // by partition keys + sort keys.
-  // Sort the pointers to the rows in RowContainer (data_) instead of sorting
-  // the rows.
+  // Order the input rows by partition keys + sort keys. Sort the pointers to
+  // the rows in RowContainer (data_) instead of sorting the rows.
+  // 'spillCompareFlags_' has the flags of all these keys in the order of
+  // 'allKeyInfo_'.
   sortedRows_.resize(numRows_);
   RowContainerIterator iter;
   data_->listRows(&iter, numRows_, sortedRows_.data());
 
-  std::sort(
-      sortedRows_.begin(),
-      sortedRows_.end(),
-      [this](const char* leftRow, const char* rightRow) {
-        return compareRowsWithKeys(leftRow, rightRow, allKeyInfo_);
-      });
+  PrefixSort::sort(
+      data_.get(),
+      spillCompareFlags_,
+      prefixSortConfig_,
+      data_->pool(),
+      sortedRows_);
+  // The prefixes are freed after the sort.
+  data_->pool()->release();
 
   computePartitionStartRows();
 }
@@ -205,13 +273,15 @@ void SortWindowBuild::noMoreInput() {
     return;
   }
 
+  ensureSortFits();
+
   if (spiller_ != nullptr) {
     // Spill remaining data to avoid running out of memory while sort-merging
     // spilled data.
     spill();
 
     spiller_->finalizeSpill();
-    merge_ = spiller_->startMerge();
+    merge_ = spiller_->startMerge(spillConfig_->readAheadBytes);
   } else {
     // At this point we have seen all the input rows. The operator is
     // being prepared to output rows now.
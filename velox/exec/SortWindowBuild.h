@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/WindowBuild.h"
 
@@ -30,7 +31,8 @@ class SortWindowBuild : public WindowBuild {
       const std::shared_ptr<const core::WindowNode>& node,
       velox::memory::MemoryPool* pool,
       const common::SpillConfig* spillConfig,
-      tsan_atomic<bool>* nonReclaimableSection);
+      tsan_atomic<bool>* nonReclaimableSection,
+      const PrefixSortConfig& prefixSortConfig = {});
 
   bool needsInput() override {
     // No partitions are available yet, so can consume input rows.
@@ -57,8 +59,18 @@ class SortWindowBuild : public WindowBuild {
  private:
   void ensureInputFits(const RowVectorPtr& input);
 
+  // Reserves memory for sorting the rows after all input is received, i.e.
+  // the sorted row pointers and the prefixes of PrefixSort. Spills all rows if
+  // the reservation fails.
+  void ensureSortFits();
+
   void setupSpiller();
 
+  // Spills the sorted rows of the partitions that have not been output yet
+  // after noMoreInput(). The rows of the partition being output stay in
+  // 'data_' and the rest is read back from spill one partition at a time.
+  void spillUnprocessedPartitions();
+
   // Main sorting function loop done after all input rows are received
   // by WindowBuild.
   void sortPartitions();
@@ -81,6 +93,9 @@ class SortWindowBuild : public WindowBuild {
   // Used to sort 'data_' while spilling.
   const std::vector<CompareFlags> spillCompareFlags_;
 
+  // Configures the sort of the input rows with PrefixSort.
+  const PrefixSortConfig prefixSortConfig_;
+
   // allKeyInfo_ is a combination of (partitionKeyInfo_ and sortKeyInfo_).
   // It is used to perform a full sorting of the input rows to be able to
   // separate partitions and sort the rows in it. The rows are output in
@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/Spill.h"
+
+#include <folly/futures/Future.h>
+
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/OperatorUtils.h"
@@ -46,12 +49,58 @@ folly::Synchronized<SpillStats>& localSpillStats() {
 
 std::atomic<int32_t> SpillFile::ordinalCounter_;
 
+SpillInput::~SpillInput() {
+  if (readAhead_.valid()) {
+    readAhead_.wait();
+  }
+}
+
 void SpillInput::next(bool /*throwIfPastEnd*/) {
-  int32_t readBytes = std::min(input_->size() - offset_, buffer_->capacity());
-  VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
-  setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  input_->pread(offset_, readBytes, buffer_->asMutable<char>());
-  offset_ += readBytes;
+  if (readAhead_.valid()) {
+    const auto readBytes = std::move(readAhead_).get();
+    VELOX_CHECK_EQ(
+        readBytes,
+        static_cast<uint64_t>(readAheadBytes_),
+        "Short read of spill file");
+    std::swap(buffer_, readAheadBuffer_);
+    setRange({buffer_->asMutable<uint8_t>(), readAheadBytes_, 0});
+    offset_ += readAheadBytes_;
+  } else {
+    int32_t readBytes =
+        std::min(input_->size() - offset_, buffer_->capacity());
+    VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
+    setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
+    input_->pread(offset_, readBytes, buffer_->asMutable<char>());
+    offset_ += readBytes;
+  }
+  startReadAhead();
+}
+
+void SpillInput::startReadAhead() {
+  if (readAheadBuffer_ == nullptr || offset_ >= size_) {
+    return;
+  }
+  readAheadBytes_ =
+      std::min<uint64_t>(size_ - offset_, readAheadBuffer_->capacity());
+  auto* data = readAheadBuffer_->asMutable<char>();
+  if (input_->hasPreadvAsync()) {
+    readAhead_ = input_->preadvAsync(
+        offset_, {folly::Range<char*>(data, readAheadBytes_)});
+    return;
+  }
+  if (executor_ == nullptr) {
+    return;
+  }
+  readAhead_ = folly::via(
+                   executor_,
+                   [input = input_.get(),
+                    offset = offset_,
+                    bytes = readAheadBytes_,
+                    data]() -> uint64_t {
+                     input->pread(offset, bytes, data);
+                     return bytes;
+                   })
+                   .semi();
 }
 
 void SpillMergeStream::pop() {
@@ -127,16 +176,27 @@ WriteFile& SpillFile::output() {
   return *output_;
 }
 
-void SpillFile::startRead() {
+void SpillFile::startRead(
+    uint64_t readAheadBufferSize,
+    folly::Executor* executor) {
   constexpr uint64_t kMaxReadBufferSize =
       (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
   VELOX_CHECK(!output_);
   VELOX_CHECK(!input_);
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
-  auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(fileSize_, kMaxReadBufferSize), pool_);
-  input_ = std::make_unique<SpillInput>(std::move(file), std::move(buffer));
+  uint64_t bufferSize = std::min<uint64_t>(fileSize_, kMaxReadBufferSize);
+  BufferPtr readAheadBuffer;
+  readAheadBufferSize = std::min(readAheadBufferSize, kMaxReadBufferSize);
+  // There is nothing to read ahead if the file fits in one buffer.
+  if (readAheadBufferSize > 0 && fileSize_ > readAheadBufferSize &&
+      (file->hasPreadvAsync() || executor != nullptr)) {
+    bufferSize = readAheadBufferSize;
+    readAheadBuffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  }
+  auto buffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  input_ = std::make_unique<SpillInput>(
+      std::move(file), std::move(buffer), std::move(readAheadBuffer), executor);
 }
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
@@ -376,13 +436,22 @@ uint64_t SpillState::appendToPartition(
 
 std::unique_ptr<TreeOfLosers<SpillMergeStream>> SpillState::startMerge(
     int32_t partition,
-    std::unique_ptr<SpillMergeStream>&& extra) {
+    std::unique_ptr<SpillMergeStream>&& extra,
+    uint64_t readAheadBytes,
+    folly::Executor* executor) {
   VELOX_CHECK_LT(partition, files_.size());
   std::vector<std::unique_ptr<SpillMergeStream>> result;
   auto list = std::move(files_[partition]);
   if (list != nullptr) {
-    for (auto& file : list->files()) {
-      result.push_back(FileSpillMergeStream::create(std::move(file)));
+    auto files = list->files();
+    uint64_t readAheadBufferSize =
+        files.empty() ? 0 : readAheadBytes / files.size();
+    if (readAheadBufferSize < kMinReadAheadBufferSize) {
+      readAheadBufferSize = 0;
+    }
+    for (auto& file : files) {
+      result.push_back(FileSpillMergeStream::create(
+          std::move(file), readAheadBufferSize, executor));
     }
   }
   if (extra != nullptr) {
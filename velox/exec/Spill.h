@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/F14Set.h>
 
 #include "velox/common/compression/Compression.h"
@@ -35,14 +36,29 @@ namespace facebook::velox::exec {
 /// remainingSize() APIs do not work properly.
 class SpillInput : public ByteInputStream {
  public:
-  // Reads from 'input' using 'buffer' for buffering reads.
-  SpillInput(std::unique_ptr<ReadFile>&& input, BufferPtr buffer)
+  // Reads from 'input' using 'buffer' for buffering reads. If
+  // 'readAheadBuffer' is set, it must have the same capacity as 'buffer' and
+  // the next buffer of 'input' is read into it asynchronously while 'buffer'
+  // is consumed. The read-ahead uses the native async read of 'input' if it
+  // has one, e.g. io_uring for local files, or else runs on 'executor'. If
+  // neither is available, 'input' is read synchronously.
+  SpillInput(
+      std::unique_ptr<ReadFile>&& input,
+      BufferPtr buffer,
+      BufferPtr readAheadBuffer = nullptr,
+      folly::Executor* executor = nullptr)
       : input_(std::move(input)),
         buffer_(std::move(buffer)),
+        readAheadBuffer_(std::move(readAheadBuffer)),
+        executor_(executor),
         size_(input_->size()) {
     next(true);
   }
 
+  // Waits for the read-ahead in progress, if any, as it writes into
+  // 'readAheadBuffer_'.
+  ~SpillInput() override;
+
   // True if all of the file has been read into vectors.
   bool atEnd() const override {
     return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
@@ -51,11 +67,22 @@ class SpillInput : public ByteInputStream {
  private:
   void next(bool throwIfPastEnd) override;
 
+  // Starts reading the bytes after 'offset_' into 'readAheadBuffer_' if
+  // read-ahead is enabled and there is more to read.
+  void startReadAhead();
+
   std::unique_ptr<ReadFile> input_;
   BufferPtr buffer_;
+  BufferPtr readAheadBuffer_;
+  folly::Executor* const executor_;
   const uint64_t size_;
   // Offset of first byte not in 'buffer_'
   uint64_t offset_ = 0;
+  // The read of 'readAheadBytes_' bytes at 'offset_' into 'readAheadBuffer_'
+  // in progress. Not valid if there is no read-ahead.
+  folly::SemiFuture<uint64_t> readAhead_{
+      folly::SemiFuture<uint64_t>::makeEmpty()};
+  int32_t readAheadBytes_{0};
 };
 
 /// Represents a spill file that is first in write mode and then
@@ -110,7 +137,12 @@ class SpillFile {
 
   /// Prepares 'this' for reading. Positions the read at the first row of
   /// content. The caller must call output() and finishWrite() before this.
-  void startRead();
+  /// If 'readAheadBufferSize' is not zero, reads the file in buffers of this
+  /// size and reads the next buffer ahead, on 'executor' if the file has no
+  /// native async read. See SpillInput.
+  void startRead(
+      uint64_t readAheadBufferSize = 0,
+      folly::Executor* executor = nullptr);
 
   bool nextBatch(RowVectorPtr& rowVector);
 
@@ -413,8 +445,10 @@ class SpillMergeStream : public MergeStream {
 class FileSpillMergeStream : public SpillMergeStream {
  public:
   static std::unique_ptr<SpillMergeStream> create(
-      std::unique_ptr<SpillFile> spillFile) {
-    spillFile->startRead();
+      std::unique_ptr<SpillFile> spillFile,
+      uint64_t readAheadBufferSize = 0,
+      folly::Executor* executor = nullptr) {
+    spillFile->startRead(readAheadBufferSize, executor);
     auto* spillStream = new FileSpillMergeStream(std::move(spillFile));
     spillStream->nextBatch();
     return std::unique_ptr<SpillMergeStream>(spillStream);
@@ -675,10 +709,18 @@ class SpillState {
 
   /// Starts reading values for 'partition'. If 'extra' is non-null, it can be
   /// a stream of rows from a RowContainer so as to merge unspilled data with
-  /// spilled data.
+  /// spilled data. 'readAheadBytes' is the memory budget for reading ahead
+  /// the spill files, divided among them. If it gives each file less than
+  /// kMinReadAheadBufferSize, the files are read without read-ahead.
+  /// 'executor' runs the read-ahead of files without native async read.
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge(
       int32_t partition,
-      std::unique_ptr<SpillMergeStream>&& extra);
+      std::unique_ptr<SpillMergeStream>&& extra,
+      uint64_t readAheadBytes = 0,
+      folly::Executor* executor = nullptr);
+
+  /// The smallest read-ahead buffer per spill file in startMerge().
+  static constexpr uint64_t kMinReadAheadBufferSize = 64 << 10;
 
   bool hasFiles(int32_t partition) const {
     return partition < files_.size() && files_[partition];
@@ -464,6 +464,30 @@ void Spiller::spill(const RowContainerIterator& startRowIter) {
   return spill(&startRowIter);
 }
 
+void Spiller::spill(folly::Range<char**> rows) {
+  CHECK_NOT_FINALIZED();
+  VELOX_CHECK_EQ(type_, Type::kOrderBy);
+  VELOX_CHECK_EQ(state_.maxPartitions(), 1);
+  checkEmptySpillRuns();
+
+  if (rows.empty()) {
+    return;
+  }
+  if (!state_.isPartitionSpilled(0)) {
+    state_.setPartitionSpilled(0);
+  }
+
+  auto& run = spillRuns_[0];
+  run.rows.insert(run.rows.end(), rows.begin(), rows.end());
+  for (const auto* row : rows) {
+    run.numBytes += container_->rowSize(row);
+  }
+  // The caller has sorted the rows, so they are written in order.
+  run.sorted = true;
+  runSpill();
+  checkEmptySpillRuns();
+}
+
 void Spiller::spill(const RowContainerIterator* startRowIter) {
   CHECK_NOT_FINALIZED();
   VELOX_CHECK_NE(type_, Type::kHashJoinProbe);
@@ -535,7 +559,8 @@ void Spiller::finalizeSpill() {
   }
 }
 
-std::unique_ptr<TreeOfLosers<SpillMergeStream>> Spiller::startMerge() {
+std::unique_ptr<TreeOfLosers<SpillMergeStream>> Spiller::startMerge(
+    uint64_t readAheadBytes) {
   CHECK_FINALIZED();
 
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
@@ -548,7 +573,8 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>> Spiller::startMerge() {
         needSort(), "Can't sort merge the unsorted spill data: {}", toString());
   }
 
-  auto merger = state_.startMerge(0, spillMergeStreamOverRows(0));
+  auto merger = state_.startMerge(
+      0, spillMergeStreamOverRows(0), readAheadBytes, executor_);
   if (merger != nullptr && type_ == Type::kAggregateOutput) {
     VELOX_CHECK_EQ(
         merger->numStreams(),
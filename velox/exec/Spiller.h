@@ -113,6 +113,13 @@ class Spiller {
   /// The caller needs to erase them from the row container.
   void spill(const RowContainerIterator& startRowIter);
 
+  /// Spills 'rows' of the row container as one sorted run. 'rows' must already
+  /// be sorted on the sorting keys. This is only used by 'kOrderBy' spiller
+  /// type to spill the rows which are not output yet after the operator has
+  /// sorted its input. The spilled rows still stay in the row container and
+  /// the caller needs to erase them.
+  void spill(folly::Range<char**> rows);
+
   /// Append 'spillVector' into the spill file of given 'partition'. It is now
   /// only used by the spilling operator which doesn't need data sort, such as
   /// hash join build and hash join probe.
@@ -124,7 +131,11 @@ class Spiller {
   /// Invoked to finalize the spiller and flush any buffered spill to disk.
   void finalizeSpill();
 
-  std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge();
+  /// Starts the sorted merge of the spilled data. 'readAheadBytes' is the
+  /// memory budget for reading ahead the spill files. See
+  /// SpillState::startMerge().
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge(
+      uint64_t readAheadBytes = 0);
 
   /// Extracts up to 'maxRows' or 'maxBytes' from 'rows' into 'spillVector'. The
   /// extract starts at nextBatchIndex and updates nextBatchIndex to be the
@@ -40,6 +40,14 @@ using facebook::velox::common::testutil::TestValue;
 namespace facebook::velox::exec {
 
 namespace {
+// Returns the CPU quota per period of 'periodMicros' from 'config'.
+uint64_t cpuQuotaNanos(const core::QueryConfig& config, uint64_t periodMicros) {
+  const auto quota = config.taskCpuQuota();
+  VELOX_USER_CHECK_GE(
+      quota, 0, "{} must not be negative", core::QueryConfig::kTaskCpuQuota);
+  return static_cast<uint64_t>(quota * periodMicros * 1'000);
+}
+
 // RAII helper class to satisfy given promises and notify listeners of an event
 // connected to the promises outside of the mutex that guards the promises.
 // Inactive on creation. Must be activated explicitly by calling 'activate'.
@@ -161,6 +169,21 @@ std::string makeUuid() {
 bool isHashJoinOperator(const std::string& operatorType) {
   return (operatorType == "HashBuild") || (operatorType == "HashProbe");
 }
+
+// Returns the memory reclaim cost of the plan node of an operator given
+// 'operatorType'. The plan nodes with lower cost are reclaimed first. A
+// table writer reclaims by flushing the data it has to write anyway. The other
+// spillable operators spill their state to read it back once. A hash join
+// build spill also makes the probe side spill.
+int32_t nodeReclaimCost(const std::string& operatorType) {
+  if (operatorType == "TableWrite") {
+    return 0;
+  }
+  if (isHashJoinOperator(operatorType)) {
+    return 2;
+  }
+  return 1;
+}
 } // namespace
 
 std::string taskStateString(TaskState state) {
@@ -261,7 +284,15 @@ Task::Task(
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(onError),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
-      bufferManager_(OutputBufferManager::getInstance()) {}
+      bufferManager_(OutputBufferManager::getInstance()),
+      cpuQuotaPeriodMicros_(
+          std::max<uint64_t>(
+              1, queryCtx_->queryConfig().taskCpuQuotaPeriodMs()) *
+          1'000),
+      cpuQuotaNanos_(
+          cpuQuotaNanos(queryCtx_->queryConfig(), cpuQuotaPeriodMicros_)),
+      schedulingPriority_(
+          queryCtx_->queryConfig().querySchedulingPriority()) {}
 
 Task::~Task() {
   // TODO(spershin): Temporary code designed to reveal what causes SIGABRT in
@@ -352,26 +383,28 @@ void Task::initTaskPool() {
 
 velox::memory::MemoryPool* Task::getOrAddNodePool(
     const core::PlanNodeId& planNodeId,
-    bool isHashJoinNode) {
+    const std::string& operatorType) {
   if (nodePools_.count(planNodeId) == 1) {
     return nodePools_[planNodeId];
   }
   childPools_.push_back(pool_->addAggregateChild(
-      fmt::format("node.{}", planNodeId), createNodeReclaimer(isHashJoinNode)));
+      fmt::format("node.{}", planNodeId), createNodeReclaimer(operatorType)));
   auto* nodePool = childPools_.back().get();
   nodePools_[planNodeId] = nodePool;
   return nodePool;
 }
 
 std::unique_ptr<memory::MemoryReclaimer> Task::createNodeReclaimer(
-    bool isHashJoinNode) const {
+    const std::string& operatorType) const {
   if (pool()->reclaimer() == nullptr) {
     return nullptr;
   }
   // Sets memory reclaimer for the parent node memory pool on the first child
   // operator construction which has set memory reclaimer.
-  return isHashJoinNode ? HashJoinMemoryReclaimer::create()
-                        : exec::MemoryReclaimer::create();
+  const int32_t reclaimCost = nodeReclaimCost(operatorType);
+  return isHashJoinOperator(operatorType)
+      ? HashJoinMemoryReclaimer::create(reclaimCost)
+      : exec::MemoryReclaimer::create(reclaimCost);
 }
 
 std::unique_ptr<memory::MemoryReclaimer> Task::createExchangeClientReclaimer()
@@ -397,8 +430,7 @@ velox::memory::MemoryPool* Task::addOperatorPool(
     int pipelineId,
     uint32_t driverId,
     const std::string& operatorType) {
-  auto* nodePool =
-      getOrAddNodePool(planNodeId, isHashJoinOperator(operatorType));
+  auto* nodePool = getOrAddNodePool(planNodeId, operatorType);
   childPools_.push_back(nodePool->addLeafChild(fmt::format(
       "op.{}.{}.{}.{}", planNodeId, pipelineId, driverId, operatorType)));
   return childPools_.back().get();
@@ -1887,6 +1919,8 @@ TaskStats Task::taskStats() const {
   TaskStats taskStats = taskStats_;
 
   taskStats.numTotalDrivers = drivers_.size();
+  taskStats.numCpuQuotaThrottles = numCpuQuotaThrottles_;
+  taskStats.cpuQuotaThrottledTimeMs = cpuQuotaThrottledMicros_ / 1'000;
 
   // Add stats of the drivers (their operators) that are still running.
   for (const auto& driver : drivers_) {
@@ -2408,6 +2442,36 @@ StopReason Task::shouldStop() {
   return StopReason::kNone;
 }
 
+uint64_t Task::chargeCpuQuota(uint64_t cpuNanos) {
+  if (cpuQuotaNanos_ == 0) {
+    return 0;
+  }
+  const auto now = getCurrentTimeMicro();
+  auto periodStart = cpuQuotaPeriodStartMicros_.load();
+  if (now >= periodStart + cpuQuotaPeriodMicros_) {
+    // Starts a new period. If Drivers race here, one of them resets the usage
+    // and the others see its period start.
+    const auto newPeriodStart =
+        now - (now - periodStart) % cpuQuotaPeriodMicros_;
+    if (cpuQuotaPeriodStartMicros_.compare_exchange_strong(
+            periodStart, newPeriodStart)) {
+      cpuQuotaUsedNanos_ = 0;
+      periodStart = newPeriodStart;
+    }
+  }
+  if ((cpuQuotaUsedNanos_ += cpuNanos) <= cpuQuotaNanos_) {
+    return 0;
+  }
+  const auto periodEnd = periodStart + cpuQuotaPeriodMicros_;
+  if (periodEnd <= now) {
+    return 0;
+  }
+  const auto waitMicros = periodEnd - now;
+  ++numCpuQuotaThrottles_;
+  cpuQuotaThrottledMicros_ += waitMicros;
+  return waitMicros;
+}
+
 int32_t Task::yieldIfDue(uint64_t startTimeMicros) {
   if (onThreadSince_ < startTimeMicros) {
     std::lock_guard<std::mutex> l(mutex_);
@@ -2511,8 +2575,9 @@ void Task::testingVisitDrivers(const std::function<void(Driver*)>& callback) {
 
 std::unique_ptr<memory::MemoryReclaimer> Task::MemoryReclaimer::create(
     const std::shared_ptr<Task>& task) {
+  VELOX_CHECK_NOT_NULL(task);
   return std::unique_ptr<memory::MemoryReclaimer>(
-      new Task::MemoryReclaimer(task));
+      new Task::MemoryReclaimer(task, task->queryCtx()->priority()));
 }
 
 uint64_t Task::MemoryReclaimer::reclaim(
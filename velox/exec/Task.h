@@ -545,6 +545,37 @@ class Task : public std::enable_shared_from_this<Task> {
   /// 'this' at the time of requesting yield. Returns 0 if yield not requested.
   int32_t yieldIfDue(uint64_t startTimeMicros);
 
+  /// Adds 'micros' to the time the Drivers of 'this' have been on thread in a
+  /// DriverScheduler.
+  void addScheduledMicros(uint64_t micros) {
+    scheduledMicros_ += micros;
+  }
+
+  /// Returns the total time the Drivers of 'this' have been on thread in a
+  /// DriverScheduler.
+  uint64_t scheduledMicros() const {
+    return scheduledMicros_;
+  }
+
+  /// Returns the priority of 'this' in CPU scheduling. See
+  /// QueryConfig::kQuerySchedulingPriority.
+  int32_t schedulingPriority() const {
+    return schedulingPriority_;
+  }
+
+  /// Charges 'cpuNanos' of CPU time used by a Driver of 'this' to the CPU
+  /// quota of the current period. Returns the time in microseconds until the
+  /// start of the next period if the quota of the current period is used up.
+  /// The Driver is then expected to go off thread for that time. Returns 0 if
+  /// the Driver may continue or if 'this' has no CPU quota.
+  uint64_t chargeCpuQuota(uint64_t cpuNanos);
+
+  /// Returns true if the Drivers of 'this' are limited by a CPU quota. A
+  /// quota that rounds to less than 1ns per period is no quota.
+  bool hasCpuQuota() const {
+    return cpuQuotaNanos_ > 0;
+  }
+
   /// Once 'pauseRequested_' is set, it will not be cleared until
   /// task::resume(). It is therefore OK to read it without a mutex
   /// from a thread that this flag concerns.
@@ -630,14 +661,15 @@ class Task : public std::enable_shared_from_this<Task> {
   // to ensure lifetime and returns a raw pointer.
   memory::MemoryPool* getOrAddNodePool(
       const core::PlanNodeId& planNodeId,
-      bool isHashJoinNode = false);
+      const std::string& operatorType = "");
 
   // Creates a memory reclaimer instance for a plan node if the task memory
-  // pool has set memory reclaimer. If 'isHashJoinNode' is true, it creates a
-  // customized instance for hash join plan node, otherwise creates a default
-  // memory reclaimer.
+  // pool has set memory reclaimer. If 'operatorType' is a hash join operator,
+  // it creates a customized instance for hash join plan node, otherwise creates
+  // a default memory reclaimer. The reclaimer priority orders the plan nodes
+  // by their reclaim cost given by 'operatorType'.
   std::unique_ptr<memory::MemoryReclaimer> createNodeReclaimer(
-      bool isHashJoinNode) const;
+      const std::string& operatorType) const;
 
   // Creates a memory reclaimer instance for an exchange client if the task
   // memory pool has set memory reclaimer. We don't support to reclaim memory
@@ -680,7 +712,8 @@ class Task : public std::enable_shared_from_this<Task> {
         override;
 
    private:
-    explicit MemoryReclaimer(const std::shared_ptr<Task>& task) : task_(task) {
+    MemoryReclaimer(const std::shared_ptr<Task>& task, int32_t queryPriority)
+        : exec::MemoryReclaimer(queryPriority, 0), task_(task) {
       VELOX_CHECK_NOT_NULL(task);
     }
 
@@ -1023,6 +1056,21 @@ class Task : public std::enable_shared_from_this<Task> {
   // one thread running. Used to decide if continuous run should be
   // interrupted by yieldIfDue().
   tsan_atomic<uint64_t> onThreadSince_{0};
+  // Time the Drivers of 'this' have been on thread in a DriverScheduler.
+  std::atomic<uint64_t> scheduledMicros_{0};
+
+  // CPU quota per period from the QueryConfig. 0 means no quota.
+  const uint64_t cpuQuotaPeriodMicros_;
+  const uint64_t cpuQuotaNanos_;
+  // Scheduling priority from the QueryConfig. Read by a DriverScheduler on
+  // each enqueue of a Driver, so it is not parsed from the config each time.
+  const int32_t schedulingPriority_;
+  // Start of the current period and the CPU time charged to it.
+  std::atomic<uint64_t> cpuQuotaPeriodStartMicros_{0};
+  std::atomic<uint64_t> cpuQuotaUsedNanos_{0};
+  // Number of times and total time Drivers were paused for the CPU quota.
+  std::atomic<uint64_t> numCpuQuotaThrottles_{0};
+  std::atomic<uint64_t> cpuQuotaThrottledMicros_{0};
   // Promises for the futures returned to callers of requestPause() or
   // terminate(). They are fulfilled when the last thread stops
   // running for 'this'.
@@ -91,6 +91,12 @@ struct TaskStats {
   /// Drivers blocked for various reasons. Based on enum BlockingReason.
   std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
 
+  /// Number of times a Driver was paused because the task used up its CPU
+  /// quota, see QueryConfig::kTaskCpuQuota.
+  uint64_t numCpuQuotaThrottles{0};
+  /// Total time in ms the Drivers were paused for the CPU quota.
+  uint64_t cpuQuotaThrottledTimeMs{0};
+
   /// Output buffer's memory utilization ratio measured as
   /// current buffer usage / max buffer size
   double outputBufferUtilization{0};
@@ -20,6 +20,67 @@
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+// Returns the channels of the sorting keys followed by the other channels of
+// 'outputType'.
+std::vector<column_index_t> reorderInputChannels(
+    const RowTypePtr& outputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys) {
+  std::vector<column_index_t> channels;
+  channels.reserve(outputType->size());
+  std::vector<bool> isSortingKey(outputType->size());
+  for (const auto& key : sortingKeys) {
+    const auto channel = exprToChannel(key.get(), outputType);
+    VELOX_USER_CHECK_NE(
+        channel, kConstantChannel, "TopN doesn't allow constant sorting keys");
+    isSortingKey[channel] = true;
+    channels.push_back(channel);
+  }
+  for (column_index_t i = 0; i < outputType->size(); ++i) {
+    if (!isSortingKey[i]) {
+      channels.push_back(i);
+    }
+  }
+  return channels;
+}
+
+RowTypePtr reorderInputType(
+    const RowTypePtr& outputType,
+    const std::vector<column_index_t>& channels) {
+  std::vector<std::string> names;
+  names.reserve(channels.size());
+  std::vector<TypePtr> types;
+  types.reserve(channels.size());
+  for (auto channel : channels) {
+    names.push_back(outputType->nameOf(channel));
+    types.push_back(outputType->childAt(channel));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+std::vector<CompareFlags> makeSpillCompareFlags(
+    const std::vector<core::SortOrder>& sortingOrders) {
+  std::vector<CompareFlags> compareFlags;
+  compareFlags.reserve(sortingOrders.size());
+  for (const auto& order : sortingOrders) {
+    compareFlags.push_back(
+        {order.isNullsFirst(), order.isAscending(), false /*equalsOnly*/});
+  }
+  return compareFlags;
+}
+
+// Returns a [start, end) slice of the 'types' vector.
+std::vector<TypePtr>
+slice(const std::vector<TypePtr>& types, int32_t start, int32_t end) {
+  std::vector<TypePtr> result;
+  result.reserve(end - start);
+  for (auto i = start; i < end; ++i) {
+    result.push_back(types[i]);
+  }
+  return result;
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -29,40 +90,39 @@ TopN::TopN(
           topNNode->outputType(),
           operatorId,
           topNNode->id(),
-          "TopN"),
+          "TopN",
+          topNNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       count_(topNNode->count()),
-      data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
+      inputChannels_(
+          reorderInputChannels(outputType_, topNNode->sortingKeys())),
+      inputType_(reorderInputType(outputType_, inputChannels_)),
+      spillCompareFlags_(makeSpillCompareFlags(topNNode->sortingOrders())),
+      data_(std::make_unique<RowContainer>(
+          slice(inputType_->children(), 0, spillCompareFlags_.size()),
+          slice(
+              inputType_->children(),
+              spillCompareFlags_.size(),
+              inputType_->size()),
+          pool())),
       comparator_(
-          outputType_,
+          inputType_,
           topNNode->sortingKeys(),
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {
-  const auto numColumns{outputType_->children().size()};
-  const auto numSortingKeys{topNNode->sortingKeys().size()};
-  sortingKeyColumns_.reserve(numSortingKeys);
-  std::vector<bool> isSortingKey(numColumns);
-  for (const auto& key : topNNode->sortingKeys()) {
-    sortingKeyColumns_.emplace_back(exprToChannel(key.get(), outputType_));
-    isSortingKey[sortingKeyColumns_.back()] = true;
-  }
-  if (numColumns > numSortingKeys) {
-    nonKeyColumns_.reserve(numColumns - numSortingKeys);
-    for (column_index_t i = 0; i < numColumns; ++i) {
-      if (!isSortingKey[i]) {
-        nonKeyColumns_.emplace_back(i);
-      }
-    }
-  }
-}
+      decodedVectors_(inputType_->size()) {}
 
 void TopN::addInput(RowVectorPtr input) {
-  for (const auto col : sortingKeyColumns_) {
-    decodedVectors_[col].decode(*input->childAt(col));
+  ensureInputFits(input);
+
+  const auto numSortingKeys = spillCompareFlags_.size();
+  for (auto i = 0; i < numSortingKeys; ++i) {
+    decodedVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
 
-  const bool hasNonKeyColumn{!nonKeyColumns_.empty()};
+  const bool hasNonKeyColumn{inputChannels_.size() > numSortingKeys};
   // Maps passed rows of 'data_' to the corresponding input row number. These
   // input rows of non-key columns are later stored into data_.
   folly::F14FastMap<void*, vector_size_t> passedRows;
@@ -82,7 +142,7 @@ void TopN::addInput(RowVectorPtr input) {
     }
 
     data_->initializeFields(newRow);
-    for (const auto col : sortingKeyColumns_) {
+    for (auto col = 0; col < numSortingKeys; ++col) {
       data_->store(decodedVectors_[col], row, newRow, col);
     }
 
@@ -93,8 +153,8 @@ void TopN::addInput(RowVectorPtr input) {
   }
 
   if (hasNonKeyColumn && !passedRows.empty()) {
-    for (const auto col : nonKeyColumns_) {
-      decodedVectors_[col].decode(*input->childAt(col));
+    for (auto col = numSortingKeys; col < inputChannels_.size(); ++col) {
+      decodedVectors_[col].decode(*input->childAt(inputChannels_[col]));
       for (const auto [dataRow, inputRow] : passedRows) {
         data_->store(
             decodedVectors_[col],
@@ -111,6 +171,10 @@ RowVectorPtr TopN::getOutput() {
     return nullptr;
   }
 
+  if (merge_ != nullptr) {
+    return getOutputFromSpill();
+  }
+
   const auto numRowsToReturn = std::min<vector_size_t>(
       outputBatchSize_, rows_.size() - numRowsReturned_);
   VELOX_CHECK_GT(numRowsToReturn, 0);
@@ -118,20 +182,77 @@ RowVectorPtr TopN::getOutput() {
   auto result = BaseVector::create<RowVector>(
       outputType_, numRowsToReturn, operatorCtx_->pool());
 
-  for (auto i = 0; i < outputType_->size(); ++i) {
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
     data_->extractColumn(
         rows_.data() + numRowsReturned_,
         numRowsToReturn,
         i,
-        result->childAt(i));
+        result->childAt(inputChannels_[i]));
   }
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
   return result;
 }
 
+RowVectorPtr TopN::getOutputFromSpill() {
+  VELOX_CHECK_NOT_NULL(merge_);
+
+  // The merge produces the rows of all spilled runs in sort order. The first
+  // 'count_' of these are the result. The rest are never read.
+  const auto numRowsToReturn = std::min<vector_size_t>(
+      outputBatchSize_, count_ - numRowsReturned_);
+  VELOX_CHECK_GT(numRowsToReturn, 0);
+
+  auto result =
+      BaseVector::create<RowVector>(outputType_, numRowsToReturn, pool());
+  vector_size_t index = 0;
+  while (index < numRowsToReturn) {
+    auto next = merge_->next();
+    if (next == nullptr) {
+      break;
+    }
+    for (auto i = 0; i < inputChannels_.size(); ++i) {
+      result->childAt(inputChannels_[i])
+          ->copy(
+              next->current().childAt(i).get(),
+              index,
+              next->currentIndex(),
+              1);
+    }
+    ++index;
+    next->pop();
+  }
+  numRowsReturned_ += index;
+
+  if (index < numRowsToReturn || numRowsReturned_ == count_) {
+    finished_ = true;
+    // Closes the spill files.
+    merge_.reset();
+  }
+
+  if (index == 0) {
+    return nullptr;
+  }
+  result->resize(index);
+  return result;
+}
+
 void TopN::noMoreInput() {
   Operator::noMoreInput();
+
+  if (spiller_ != nullptr) {
+    // Spill the remaining rows to merge them with the spilled runs without
+    // holding them in memory.
+    spill();
+
+    spiller_->finalizeSpill();
+    recordSpillStats(spiller_->stats());
+
+    merge_ = spiller_->startMerge(spillConfig_->readAheadBytes);
+    outputBatchSize_ = outputBatchRows(estimatedOutputRowSize_);
+    return;
+  }
+
   if (topRows_.empty()) {
     finished_ = true;
     return;
@@ -148,4 +269,135 @@ void TopN::noMoreInput() {
 bool TopN::isFinished() {
   return finished_;
 }
+
+void TopN::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+  VELOX_CHECK(!nonReclaimableSection_);
+
+  if (data_->numRows() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  if (noMoreInput_) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING)
+        << "Can't reclaim from topN operator which has started producing output: "
+        << pool()->name()
+        << ", usage: " << succinctBytes(pool()->currentBytes())
+        << ", reservation: " << succinctBytes(pool()->reservedBytes());
+    return;
+  }
+
+  spill();
+}
+
+void TopN::ensureInputFits(const RowVectorPtr& input) {
+  if (!canSpill()) {
+    // Spilling is disabled.
+    return;
+  }
+
+  if (data_->numRows() == 0) {
+    // Nothing to spill.
+    return;
+  }
+
+  // Test-only spill path.
+  if (spillConfig_->testSpillPct > 0) {
+    spill();
+    return;
+  }
+
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const auto outOfLineBytesPerRow = outOfLineBytes / data_->numRows();
+
+  // At most 'count_' rows are kept. Once there are 'count_' rows, new rows
+  // reuse the rows they replace and only variable width data grows.
+  const auto numNewRows = std::min<int64_t>(
+      input->size(),
+      std::max<int64_t>(0, count_ - static_cast<int64_t>(topRows_.size())));
+  const auto incrementBytes = data_->sizeIncrement(
+      numNewRows, outOfLineBytesPerRow * input->size());
+
+  const auto currentUsage = pool()->currentBytes();
+  const auto minReservationBytes =
+      currentUsage * spillConfig_->minSpillableReservationPct / 100;
+  const auto availableReservationBytes = pool()->availableReservation();
+
+  // First to check if we have sufficient minimal memory reservation.
+  if (availableReservationBytes >= minReservationBytes) {
+    if (freeRows > numNewRows &&
+        (outOfLineBytes == 0 ||
+         outOfLineFreeBytes >= outOfLineBytesPerRow * input->size())) {
+      // Enough free rows for input rows and enough variable length free space.
+      return;
+    }
+  }
+
+  // Check if we can increase reservation. The increment is the largest of twice
+  // the maximum increment from this input and 'spillableReservationGrowthPct_'
+  // of the current memory usage.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  {
+    ReclaimableSectionGuard guard(this);
+    if (pool()->maybeReserve(targetIncrementBytes)) {
+      return;
+    }
+  }
+
+  spill();
+}
+
+void TopN::spill() {
+  if (data_->numRows() == 0) {
+    return;
+  }
+
+  if (spiller_ == nullptr) {
+    setupSpiller();
+  }
+
+  updateEstimatedOutputRowSize();
+
+  spiller_->spill();
+  topRows_ = decltype(topRows_)(comparator_);
+  data_->clear();
+  pool()->release();
+}
+
+void TopN::setupSpiller() {
+  VELOX_CHECK_NULL(spiller_);
+
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kOrderBy,
+      data_.get(),
+      inputType_,
+      spillCompareFlags_.size(),
+      spillCompareFlags_,
+      spillConfig_->filePath,
+      spillConfig_->writeBufferSize,
+      spillConfig_->compressionKind,
+      memory::spillMemoryPool(),
+      spillConfig_->executor);
+}
+
+void TopN::updateEstimatedOutputRowSize() {
+  const auto optionalRowSize = data_->estimateRowSize();
+  if (!optionalRowSize.has_value()) {
+    return;
+  }
+
+  const auto rowSize = optionalRowSize.value();
+  if (!estimatedOutputRowSize_.has_value() ||
+      rowSize > estimatedOutputRowSize_.value()) {
+    estimatedOutputRowSize_ = rowSize;
+  }
+}
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -43,14 +44,43 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  /// Spills the buffered rows while receiving input. Memory is not reclaimed
+  /// after noMoreInput(): the rows to output are then at most 'count_' rows in
+  /// 'data_' or the rows being merged from spill, which are both needed for
+  /// producing the output.
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
+  // Spills the rows of 'data_' if spilling is enabled and there is not enough
+  // memory to add 'input'.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Sorts, spills and clears all of 'data_'. Clears 'topRows_'.
+  void spill();
+
+  void setupSpiller();
+
+  void updateEstimatedOutputRowSize();
+
+  // Merges the spilled runs and returns the next batch of the first 'count_'
+  // rows.
+  RowVectorPtr getOutputFromSpill();
+
   const int32_t count_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
 
-  std::vector<column_index_t> sortingKeyColumns_;
-  std::vector<column_index_t> nonKeyColumns_;
+  // The columns of 'data_' and of the spilled rows: the sorting keys followed
+  // by the other columns. 'inputChannels_' has the output channel of each
+  // column.
+  const std::vector<column_index_t> inputChannels_;
+  const RowTypePtr inputType_;
+
+  // Compare flags of the sorting key columns of 'data_'. Used to sort 'data_'
+  // while spilling.
+  const std::vector<CompareFlags> spillCompareFlags_;
 
   // As the inputs are added to TopN operator, we use topRows_ (a priority
   // queue) to keep track of the pointers to rows stored in the
@@ -66,7 +96,20 @@ class TopN : public Operator {
   std::priority_queue<char*, std::vector<char*>, RowComparator> topRows_;
   std::vector<char*> rows_;
 
+  // Decoded input columns in the order of the columns of 'data_'.
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Max 'data_->estimateRowSize()' across all spilled runs and the rows in
+  // 'data_' at the end of input.
+  std::optional<int64_t> estimatedOutputRowSize_;
+
+  // Spiller for the contents of 'data_'. Each spilled run has at most 'count_'
+  // rows.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Used to sort-merge the spilled runs. Reset after 'count_' rows are
+  // returned.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
 };
 } // namespace facebook::velox::exec
@@ -283,7 +283,7 @@ void TopNRowNumber::noMoreInput() {
     spiller_->finalizeSpill();
     recordSpillStats(spiller_->stats());
 
-    merge_ = spiller_->startMerge();
+    merge_ = spiller_->startMerge(spillConfig_->readAheadBytes);
   } else {
     outputRows_.resize(outputBatchSize_);
   }
@@ -241,6 +241,11 @@ class VectorHasher {
     return hasRange_ || !distinctOverflow_;
   }
 
+  // Returns true if there were too many distinct values to keep track of.
+  bool distinctOverflow() const {
+    return distinctOverflow_;
+  }
+
   // Returns an instance of the filter corresponding to a set of unique values.
   // Returns null if distinctOverflow_ is true.
   std::unique_ptr<common::Filter> getFilter(bool nullAllowed) const;
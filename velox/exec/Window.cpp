@@ -44,8 +44,15 @@ Window::Window(
     windowBuild_ = std::make_unique<StreamingWindowBuild>(
         windowNode, pool(), spillConfig, &nonReclaimableSection_);
   } else {
+    const auto& queryConfig = driverCtx->queryConfig();
     windowBuild_ = std::make_unique<SortWindowBuild>(
-        windowNode, pool(), spillConfig, &nonReclaimableSection_);
+        windowNode,
+        pool(),
+        spillConfig,
+        &nonReclaimableSection_,
+        PrefixSortConfig{
+            queryConfig.prefixSortNormalizedKeyMaxBytes(),
+            queryConfig.prefixSortMinRows()});
   }
 }
 
@@ -155,13 +162,16 @@ void Window::reclaim(
   VELOX_CHECK(!nonReclaimableSection_);
 
   if (noMoreInput_) {
-    ++stats.numNonReclaimableAttempts;
-    // TODO Add support for spilling after noMoreInput().
-    LOG(WARNING)
-        << "Can't reclaim from window operator which has started producing output: "
-        << pool()->name()
-        << ", usage: " << succinctBytes(pool()->currentBytes())
-        << ", reservation: " << succinctBytes(pool()->reservedBytes());
+    // Spills the partitions which are not output yet. The spill stats are
+    // recorded here if the build had not spilled before noMoreInput().
+    const bool spilled = windowBuild_->spilledStats().has_value();
+    windowBuild_->spill();
+    if (spilled) {
+      return;
+    }
+    if (auto spillStats = windowBuild_->spilledStats()) {
+      recordSpillStats(spillStats.value());
+    }
     return;
   }
 
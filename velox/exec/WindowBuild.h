@@ -44,7 +44,9 @@ class WindowBuild {
   // Adds new input rows to the WindowBuild.
   virtual void addInput(RowVectorPtr input) = 0;
 
-  // Can be called any time before noMoreInput().
+  // Spills the input rows. Can be called any time before noMoreInput(). After
+  // noMoreInput(), spills the partitions that have not been output yet. The
+  // partition returned by the last nextPartition() stays in memory.
   virtual void spill() = 0;
 
   /// Returns the spiller stats including total bytes and rows spilled so far.
@@ -40,6 +40,10 @@ DEFINE_int64(
     32,
     "task-wide buffer in local exchange");
 DEFINE_int64(exchange_buffer_mb, 32, "task-wide buffer in remote exchange");
+DEFINE_int32(
+    dictionary_cardinality,
+    100,
+    "Number of distinct values of the dictionary encoded columns");
 
 /// Benchmarks repartition/exchange with different batch sizes,
 /// numbers of destinations and data type mixes.  Generates a plan
@@ -61,7 +65,10 @@ struct Counters {
   int64_t usec{0};
 
   std::string toString() {
-    return fmt::format("{} MB/s", (bytes / (1024 * 1024.0)) / (usec / 1.0e6));
+    return fmt::format(
+        "{} MB/s {} bytes/row",
+        (bytes / (1024 * 1024.0)) / (usec / 1.0e6),
+        bytes / std::max<int64_t>(1, rows));
   }
 };
 
@@ -78,14 +85,47 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  /// Makes batches of a flat partitioning key 'c0', dictionary encoded
+  /// columns with 'cardinality' distinct values and a constant column, like
+  /// the output of a scan of dictionary encoded files or of a join.
+  std::vector<RowVectorPtr> makeDictionaryRows(
+      int32_t numVectors,
+      int32_t rowsPerVector,
+      int32_t cardinality) {
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < numVectors; ++i) {
+      auto indices = makeIndices(
+          rowsPerVector, [&](auto row) { return (row * 7) % cardinality; });
+      auto strings = makeFlatVector<std::string>(cardinality, [](auto row) {
+        return fmt::format("dictionary encoded string {}", row);
+      });
+      auto longs = makeFlatVector<int64_t>(
+          cardinality, [](auto row) { return row * 1'000'003; });
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(rowsPerVector, [](auto row) { return row; }),
+          wrapInDictionary(indices, rowsPerVector, strings),
+          wrapInDictionary(indices, rowsPerVector, longs),
+          BaseVector::createConstant(
+              VARCHAR(),
+              std::string("constant string"),
+              rowsPerVector,
+              pool()),
+      }));
+    }
+    return vectors;
+  }
+
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      bool preserveEncodings = false) {
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    configSettings_[core::QueryConfig::kPartitionedOutputPreserveEncodings] =
+        preserveEncodings ? "true" : "false";
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
@@ -152,11 +192,15 @@ class ExchangeBenchmark : public VectorTestBase {
     counters.usec += elapsed;
   }
 
+  // Runs a local partition from 'taskWidth' producers, or from a single
+  // producer if 'singleProducer' is true, to 'taskWidth' consumers.
   void runLocal(
       std::vector<RowVectorPtr>& vectors,
       int32_t taskWidth,
       int32_t numTasks,
-      Counters& counters) {
+      Counters& counters,
+      bool singleProducer = false,
+      bool sharedBuffer = false) {
     assert(!vectors.empty());
     std::vector<std::shared_ptr<Task>> tasks;
     counters.bytes = vectors[0]->retainedSize() * vectors.size() * numTasks *
@@ -168,7 +212,7 @@ class ExchangeBenchmark : public VectorTestBase {
     }
     core::PlanNodeId exchangeId;
     auto plan = exec::test::PlanBuilder()
-                    .values(vectors, true)
+                    .values(vectors, !singleProducer)
                     .localPartition({"c0"})
                     .capturePlanNodeId(exchangeId)
                     .singleAggregation({}, aggregates)
@@ -181,7 +225,8 @@ class ExchangeBenchmark : public VectorTestBase {
     threads.reserve(numTasks);
     auto expected =
         makeRowVector({makeFlatVector<int64_t>(1, [&](auto /*row*/) {
-          return vectors.size() * vectors[0]->size() * taskWidth;
+          return vectors.size() * vectors[0]->size() *
+              (singleProducer ? 1 : taskWidth);
         })});
 
     std::mutex mutex;
@@ -193,6 +238,9 @@ class ExchangeBenchmark : public VectorTestBase {
                   .config(
                       core::QueryConfig::kMaxLocalExchangeBufferSize,
                       fmt::format("{}", FLAGS_local_exchange_buffer_mb << 20))
+                  .config(
+                      core::QueryConfig::kLocalExchangeSharedBuffer,
+                      sharedBuffer ? "true" : "false")
                   .maxDrivers(taskWidth)
                   .assertResults(expected);
           {
@@ -300,12 +348,18 @@ std::vector<RowVectorPtr> flat10k;
 std::vector<RowVectorPtr> deep10k;
 std::vector<RowVectorPtr> flat50;
 std::vector<RowVectorPtr> deep50;
+std::vector<RowVectorPtr> dictionary10k;
 
 Counters flat10kCounters;
 Counters deep10kCounters;
 Counters flat50Counters;
 Counters deep50Counters;
 Counters localFlat10kCounters;
+Counters localFlat10kSharedCounters;
+Counters localFlat10kOneToNCounters;
+Counters localFlat10kOneToNSharedCounters;
+Counters dictionary10kCounters;
+Counters dictionary10kPreserveCounters;
 
 BENCHMARK(exchangeFlat10k) {
   bm.run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
@@ -323,11 +377,59 @@ BENCHMARK_RELATIVE(exchangeDeep50) {
   bm.run(deep50, FLAGS_width, FLAGS_task_width, deep50Counters);
 }
 
+// Compares flattening the dictionary and constant columns in PartitionedOutput
+// to serializing them with page dictionaries. The bytes/row in the printed
+// counters are the wire size.
+BENCHMARK(exchangeDictionary10k) {
+  bm.run(dictionary10k, FLAGS_width, FLAGS_task_width, dictionary10kCounters);
+}
+
+BENCHMARK_RELATIVE(exchangeDictionary10kPreserveEncodings) {
+  bm.run(
+      dictionary10k,
+      FLAGS_width,
+      FLAGS_task_width,
+      dictionary10kPreserveCounters,
+      true);
+}
+
 BENCHMARK(localFlat10k) {
   bm.runLocal(
       flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
 }
 
+// Local partition from N producers to N consumers with the producers sharing
+// each input between the consumers instead of wrapping it per consumer.
+BENCHMARK_RELATIVE(localFlat10kShared) {
+  bm.runLocal(
+      flat10k,
+      FLAGS_width,
+      FLAGS_num_local_tasks,
+      localFlat10kSharedCounters,
+      false,
+      true);
+}
+
+// Local partition from 1 producer to N consumers.
+BENCHMARK(localFlat10kOneToN) {
+  bm.runLocal(
+      flat10k,
+      FLAGS_width,
+      FLAGS_num_local_tasks,
+      localFlat10kOneToNCounters,
+      true);
+}
+
+BENCHMARK_RELATIVE(localFlat10kOneToNShared) {
+  bm.runLocal(
+      flat10k,
+      FLAGS_width,
+      FLAGS_num_local_tasks,
+      localFlat10kOneToNSharedCounters,
+      true,
+      true);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -379,12 +481,18 @@ int main(int argc, char** argv) {
   deep10k = bm.makeRows(deepType, 10, 10000);
   flat50 = bm.makeRows(flatType, 2000, 50);
   deep50 = bm.makeRows(deepType, 2000, 50);
+  dictionary10k =
+      bm.makeDictionaryRows(10, 10000, FLAGS_dictionary_cardinality);
 
   folly::runBenchmarks();
   std::cout << "flat10k: " << flat10kCounters.toString() << std::endl
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
-            << "deep50: " << deep50Counters.toString() << std::endl;
+            << "deep50: " << deep50Counters.toString() << std::endl
+            << "dictionary10k: " << dictionary10kCounters.toString()
+            << std::endl
+            << "dictionary10k preserve encodings: "
+            << dictionary10kPreserveCounters.toString() << std::endl;
   return 0;
   return 0;
 }
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTable.h"
+#include "velox/exec/VectorHasher.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/hash/Hash.h>
+#include <folly/init/Init.h>
+
+DEFINE_int32(probe_batch_size, 10'000, "Number of rows in a probe batch");
+DEFINE_int32(num_probe_batches, 100, "Number of probe batches per iteration");
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::test;
+
+namespace {
+
+// Measures HashTable::joinProbe() in kHash mode with and without batched
+// prefetching. The build side has two BIGINT keys. The probe keys are in
+// random order so that consecutive probes have no cache locality. Each
+// iteration reports the time per probe row.
+class HashJoinProbeBenchmark : public VectorTestBase {
+ public:
+  // Makes a join table of 'numRows' rows and probe batches where 'hitPct'
+  // percent of the rows have a match. Does nothing if the data is already
+  // made.
+  void makeData(int64_t numRows, int32_t hitPct) {
+    if (numRows == numRows_ && hitPct == hitPct_) {
+      return;
+    }
+    table_.reset();
+    probeBatches_.clear();
+    numRows_ = numRows;
+    hitPct_ = hitPct;
+
+    std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+    keyHashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 0));
+    keyHashers.push_back(std::make_unique<VectorHasher>(BIGINT(), 1));
+    table_ = HashTable<true>::createForJoin(
+        std::move(keyHashers), {}, true, false, 1'000, pool());
+    // Small tables would otherwise be in kNormalizedKey mode.
+    table_->testingSetHashMode(BaseHashTable::HashMode::kHash, 0);
+    auto* rowContainer = table_->rows();
+    const auto nextOffset = rowContainer->nextOffset();
+    constexpr int32_t kBuildBatchSize = 10'000;
+    for (int64_t start = 0; start < numRows; start += kBuildBatchSize) {
+      const auto size = std::min<int64_t>(kBuildBatchSize, numRows - start);
+      auto batch = makeKeys(size, [&](auto row) { return start + row; });
+      std::vector<DecodedVector> decoded;
+      for (auto& child : batch->children()) {
+        decoded.emplace_back(*child);
+      }
+      for (auto row = 0; row < size; ++row) {
+        char* newRow = rowContainer->newRow();
+        if (nextOffset) {
+          *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+        }
+        for (auto i = 0; i < decoded.size(); ++i) {
+          rowContainer->store(decoded[i], row, newRow, i);
+        }
+      }
+    }
+    table_->prepareJoinTable({});
+    VELOX_CHECK_EQ(table_->hashMode(), BaseHashTable::HashMode::kHash);
+    LOG(INFO) << "Made table " << table_->toString();
+
+    // Keys at and above 'numRows' miss.
+    const int64_t keyRange = numRows * 100 / hitPct;
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    for (auto i = 0; i < FLAGS_num_probe_batches; ++i) {
+      probeBatches_.push_back(makeKeys(FLAGS_probe_batch_size, [&](auto) {
+        return folly::Random::rand64(keyRange, rng);
+      }));
+    }
+  }
+
+  // Probes all the probe batches and returns the number of probe rows.
+  unsigned probe(bool batched) {
+    table_->testingSetBatchedJoinProbe(batched);
+    HashLookup lookup(table_->hashers());
+    auto& hashers = table_->hashers();
+    int64_t numHits = 0;
+    for (const auto& batch : probeBatches_) {
+      SelectivityVector rows(batch->size());
+      lookup.reset(batch->size());
+      for (auto i = 0; i < hashers.size(); ++i) {
+        hashers[i]->decode(*batch->childAt(i), rows);
+        hashers[i]->hash(rows, i > 0, lookup.hashes);
+      }
+      lookup.rows.resize(batch->size());
+      std::iota(lookup.rows.begin(), lookup.rows.end(), 0);
+      table_->joinProbe(lookup);
+      for (auto row : lookup.rows) {
+        numHits += lookup.hits[row] != nullptr;
+      }
+    }
+    folly::doNotOptimizeAway(numHits);
+    return probeBatches_.size() * FLAGS_probe_batch_size;
+  }
+
+ private:
+  // Makes the two key columns for the key numbers given by 'keyAt'.
+  template <typename KeyAt>
+  RowVectorPtr makeKeys(vector_size_t size, KeyAt keyAt) {
+    std::vector<int64_t> keys(size);
+    for (auto i = 0; i < size; ++i) {
+      keys[i] = keyAt(i);
+    }
+    return makeRowVector({
+        makeFlatVector<int64_t>(
+            size, [&](auto row) { return folly::hash::twang_mix64(keys[row]); }),
+        makeFlatVector<int64_t>(size, [&](auto row) { return keys[row] * 7; }),
+    });
+  }
+
+  int64_t numRows_{0};
+  int32_t hitPct_{0};
+  std::unique_ptr<HashTable<true>> table_;
+  std::vector<RowVectorPtr> probeBatches_;
+};
+
+std::unique_ptr<HashJoinProbeBenchmark> benchmark;
+
+} // namespace
+
+#define JOIN_PROBE_BENCHMARKS(name, numRows, hitPct)  \
+  BENCHMARK_MULTI(name##Interleaved) {                \
+    folly::BenchmarkSuspender suspender;              \
+    benchmark->makeData(numRows, hitPct);             \
+    suspender.dismiss();                              \
+    return benchmark->probe(false);                   \
+  }                                                   \
+  BENCHMARK_RELATIVE_MULTI(name##Batched) {           \
+    folly::BenchmarkSuspender suspender;              \
+    benchmark->makeData(numRows, hitPct);             \
+    suspender.dismiss();                              \
+    return benchmark->probe(true);                    \
+  }                                                   \
+  BENCHMARK_DRAW_LINE();
+
+// Fits in the L2 cache.
+JOIN_PROBE_BENCHMARKS(hit16K, 16 << 10, 100);
+
+// About the size of the LLC.
+JOIN_PROBE_BENCHMARKS(hit256K, 256 << 10, 100);
+JOIN_PROBE_BENCHMARKS(miss256K, 256 << 10, 10);
+
+// Several times the size of the LLC.
+JOIN_PROBE_BENCHMARKS(hit4M, 4 << 20, 100);
+JOIN_PROBE_BENCHMARKS(miss4M, 4 << 20, 10);
+JOIN_PROBE_BENCHMARKS(hit16M, 16 << 20, 100);
+JOIN_PROBE_BENCHMARKS(miss16M, 16 << 20, 10);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  benchmark = std::make_unique<HashJoinProbeBenchmark>();
+  folly::runBenchmarks();
+  benchmark.reset();
+  return 0;
+}
@@ -19,6 +19,7 @@
 
 #include "velox/dwio/common/tests/utils/DataFiles.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/exec/RowContainer.h"
 #include "velox/external/timsort/TimSort.hpp"
 #include "velox/type/StringView.h"
@@ -156,6 +157,35 @@ void rowContainerTimSortBenchmark(uint32_t iterations, size_t cardinality) {
   }
 }
 
+template <typename T>
+void rowContainerPrefixSortBenchmark(uint32_t iterations, size_t cardinality) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::addDefaultLeafMemoryPool();
+  VectorMaker vectorMaker(pool.get());
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  const velox::exec::PrefixSortConfig config{
+      velox::exec::PrefixSort::kMaxNormalizedKeyBytes, 0};
+
+  for (size_t k = 0; k < iterations; ++k) {
+    auto data =
+        genTestData<T>(cardinality, CppToType<T>::create(), true, false, false);
+    auto vector =
+        vectorMaker.encodedVector<T>(VectorEncoding::Simple::FLAT, data.data());
+    DecodedVector decoded(*vector);
+    // Create row container.
+    std::vector<TypePtr> types{vector->type()};
+    // Store the vector in the rowContainer.
+    auto rowContainer =
+        std::make_unique<velox::exec::RowContainer>(types, pool.get());
+    int size = vector->size();
+    auto rows = store(*rowContainer, decoded, size);
+    suspender.dismiss();
+    velox::exec::PrefixSort::sort(
+        rowContainer.get(), compareFlags, config, pool.get(), rows);
+    suspender.rehire();
+  }
+}
+
 void BM_Int64_stdSort(uint32_t iterations, size_t cardinality) {
   rowContainerStdSortBenchmark<int64_t>(iterations, cardinality);
 }
@@ -164,6 +194,10 @@ void BM_Int64_timSort(uint32_t iterations, size_t cardinality) {
   rowContainerTimSortBenchmark<int64_t>(iterations, cardinality);
 }
 
+void BM_Int64_prefixSort(uint32_t iterations, size_t cardinality) {
+  rowContainerPrefixSortBenchmark<int64_t>(iterations, cardinality);
+}
+
 void BM_STR_stdSort(uint32_t iterations) {
   folly::BenchmarkSuspender suspender;
   auto pool = memory::addDefaultLeafMemoryPool();
@@ -213,22 +247,52 @@ void BM_STR_timSort(uint32_t iterations) {
     suspender.rehire();
   }
 }
+
+void BM_STR_prefixSort(uint32_t iterations) {
+  folly::BenchmarkSuspender suspender;
+  auto pool = memory::addDefaultLeafMemoryPool();
+  VectorMaker vectorMaker(pool.get());
+  const std::vector<CompareFlags> compareFlags{CompareFlags{}};
+  const velox::exec::PrefixSortConfig config{
+      velox::exec::PrefixSort::kMaxNormalizedKeyBytes, 0};
+  auto data = getDataFromFile();
+  auto vector =
+      vectorMaker.encodedVector<StringView>(VectorEncoding::Simple::FLAT, data);
+  DecodedVector decoded(*vector);
+  // Create row container.
+  std::vector<TypePtr> types{vector->type()};
+  // Store the vector in the rowContainer.
+  auto rowContainer =
+      std::make_unique<velox::exec::RowContainer>(types, pool.get());
+  int size = vector->size();
+  auto rows = store(*rowContainer, decoded, size);
+  for (size_t k = 0; k < iterations; ++k) {
+    suspender.dismiss();
+    velox::exec::PrefixSort::sort(
+        rowContainer.get(), compareFlags, config, pool.get(), rows);
+    suspender.rehire();
+  }
+}
 } // namespace
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 100k_uni_noseq, 100000);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_timSort, 100k_uni_noseq, 100000);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_prefixSort, 100k_uni_noseq, 100000);
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 10k_uni_noseq, 10000);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_timSort, 10k_uni_noseq, 10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_prefixSort, 10k_uni_noseq, 10000);
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(BM_Int64_stdSort, 1k_uni_noseq, 1000);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_timSort, 1k_uni_noseq, 1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_Int64_prefixSort, 1k_uni_noseq, 1000);
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK_NAMED_PARAM(BM_STR_stdSort, RealWorldData_stdSort);
 BENCHMARK_RELATIVE_NAMED_PARAM(BM_STR_timSort, RealWorldData_timSort);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_STR_prefixSort, RealWorldData_prefixSort);
 BENCHMARK_DRAW_LINE();
 } // namespace facebook::velox::test
 
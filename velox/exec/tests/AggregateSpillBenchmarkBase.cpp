@@ -69,13 +69,20 @@ void AggregateSpillBenchmarkBase::setUp() {
 }
 
 void AggregateSpillBenchmarkBase::run() {
-  MicrosecondTimer timer(&executionTimeUs_);
+  {
+    MicrosecondTimer timer(&executionTimeUs_);
+    if (spillerType_ == Spiller::Type::kAggregateInput) {
+      for (auto i = 0; i < FLAGS_spiller_benchmark_num_spill_runs; ++i) {
+        spiller_->spill();
+      }
+    } else {
+      spiller_->spill(RowContainerIterator{});
+    }
+    rowContainer_->clear();
+  }
   if (spillerType_ == Spiller::Type::kAggregateInput) {
-    spiller_->spill();
-  } else {
-    spiller_->spill(RowContainerIterator{});
+    merge();
   }
-  rowContainer_->clear();
 }
 
 void AggregateSpillBenchmarkBase::printStats() const {
@@ -89,10 +96,13 @@ void AggregateSpillBenchmarkBase::printStats() const {
             << "] cumulative memory usage["
             << succinctBytes(memStats.cumulativeBytes) << "]";
   LOG(INFO) << spiller_->stats().toString();
+  printMergeStats();
   // List files under file path.
-  SpillPartitionSet partitionSet;
-  spiller_->finishSpill(partitionSet);
-  VELOX_CHECK_EQ(partitionSet.size(), 1);
+  if (numMergedRows_ == 0) {
+    SpillPartitionSet partitionSet;
+    spiller_->finishSpill(partitionSet);
+    VELOX_CHECK_EQ(partitionSet.size(), 1);
+  }
   const auto files = fs_->list(spillDir_);
   for (const auto& file : files) {
     auto rfile = fs_->openFileForRead(file);
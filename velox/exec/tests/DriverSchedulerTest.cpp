@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/DriverScheduler.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/exec/Task.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+using Lane = WorkStealingDriverScheduler::Lane;
+
+int32_t laneIndex(Lane lane) {
+  return static_cast<int32_t>(lane);
+}
+
+// Waits until 'count' reaches 'expected'. Fails instead of hanging if it does
+// not within 'timeout'.
+void waitFor(
+    const std::atomic<int32_t>& count,
+    int32_t expected,
+    std::chrono::seconds timeout = std::chrono::seconds(60)) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (count < expected) {
+    ASSERT_LT(std::chrono::steady_clock::now(), deadline)
+        << "Timed out waiting for " << expected << ", got " << count;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+  }
+}
+} // namespace
+
+class DriverSchedulerTest : public OperatorTestBase {
+ protected:
+  std::unique_ptr<WorkStealingDriverScheduler> makeScheduler(
+      int32_t numThreads,
+      uint64_t interactiveMicros = 1'000'000,
+      uint64_t timeSliceMicros = 100'000) {
+    WorkStealingDriverScheduler::Options options;
+    options.numThreads = numThreads;
+    options.interactiveMicros = interactiveMicros;
+    options.timeSliceMicros = timeSliceMicros;
+    return std::make_unique<WorkStealingDriverScheduler>(options);
+  }
+
+  std::shared_ptr<core::QueryCtx> makeQueryCtx(
+      folly::Executor* executor,
+      std::unordered_map<std::string, std::string> config = {}) {
+    return std::make_shared<core::QueryCtx>(
+        executor, core::QueryConfig(std::move(config)));
+  }
+
+  std::vector<RowVectorPtr> makeVectors() {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+          1'000, [i](auto row) { return (i * 1'000 + row) % 37; })}));
+    }
+    return vectors;
+  }
+
+  // Runs a query with one producer and 4 consumers of a local partition on
+  // 'queryCtx' and returns its Task.
+  std::shared_ptr<Task> runQuery(
+      const std::shared_ptr<core::QueryCtx>& queryCtx) {
+    auto vectors = makeVectors();
+    createDuckDbTable(vectors);
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .localPartition({"c0"})
+                    .singleAggregation({"c0"}, {"count(1)"})
+                    .planNode();
+    return AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .queryCtx(queryCtx)
+        .maxDrivers(4)
+        .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+  }
+};
+
+TEST_F(DriverSchedulerTest, add) {
+  std::atomic<int32_t> count{0};
+  {
+    auto scheduler = makeScheduler(4);
+    EXPECT_EQ(scheduler->numThreads(), 4);
+    for (auto i = 0; i < 1'000; ++i) {
+      scheduler->add([&]() { ++count; });
+    }
+    ASSERT_NO_FATAL_FAILURE(waitFor(count, 1'000));
+    const auto stats = scheduler->stats();
+    EXPECT_EQ(stats.lanes[laneIndex(Lane::kInteractive)].numRuns, 1'000);
+    EXPECT_EQ(stats.lanes[laneIndex(Lane::kBatch)].numRuns, 0);
+
+    // The destructor runs the work that is still queued.
+    for (auto i = 0; i < 1'000; ++i) {
+      scheduler->add([&]() { ++count; });
+    }
+  }
+  EXPECT_EQ(count, 2'000);
+}
+
+TEST_F(DriverSchedulerTest, steal) {
+  auto scheduler = makeScheduler(2);
+  constexpr int32_t kNumFuncs = 20;
+  std::atomic<int32_t> count{0};
+  // The functions added from a worker thread go to the queue of that thread.
+  // The other thread takes them from there.
+  scheduler->add([&]() {
+    for (auto i = 0; i < kNumFuncs; ++i) {
+      scheduler->add([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2)); // NOLINT
+        ++count;
+      });
+    }
+  });
+  ASSERT_NO_FATAL_FAILURE(waitFor(count, kNumFuncs));
+  const auto stats = scheduler->stats();
+  EXPECT_EQ(stats.lanes[laneIndex(Lane::kInteractive)].numRuns, kNumFuncs + 1);
+  EXPECT_GT(stats.lanes[laneIndex(Lane::kInteractive)].numSteals, 0);
+  EXPECT_LT(stats.lanes[laneIndex(Lane::kInteractive)].numSteals, kNumFuncs);
+}
+
+TEST_F(DriverSchedulerTest, query) {
+  auto scheduler = makeScheduler(4);
+  auto task = runQuery(makeQueryCtx(scheduler.get()));
+  const auto stats = scheduler->stats();
+  EXPECT_GT(stats.lanes[laneIndex(Lane::kInteractive)].numRuns, 0);
+  EXPECT_EQ(stats.lanes[laneIndex(Lane::kBatch)].numRuns, 0);
+  EXPECT_GT(task->scheduledMicros(), 0);
+  EXPECT_EQ(scheduler->laneOf(*task), Lane::kInteractive);
+}
+
+TEST_F(DriverSchedulerTest, lanes) {
+  // All Tasks are past the interactive time.
+  auto scheduler = makeScheduler(4, 0);
+  auto task = runQuery(makeQueryCtx(scheduler.get()));
+  EXPECT_EQ(scheduler->laneOf(*task), Lane::kBatch);
+  auto stats = scheduler->stats();
+  EXPECT_GT(stats.lanes[laneIndex(Lane::kBatch)].numRuns, 0);
+  const auto numInteractiveRuns =
+      stats.lanes[laneIndex(Lane::kInteractive)].numRuns;
+
+  // A query with a positive scheduling priority stays interactive.
+  task = runQuery(makeQueryCtx(
+      scheduler.get(), {{core::QueryConfig::kQuerySchedulingPriority, "1"}}));
+  EXPECT_EQ(task->schedulingPriority(), 1);
+  EXPECT_EQ(scheduler->laneOf(*task), Lane::kInteractive);
+  stats = scheduler->stats();
+  EXPECT_GT(
+      stats.lanes[laneIndex(Lane::kInteractive)].numRuns, numInteractiveRuns);
+  EXPECT_FALSE(stats.toString().empty());
+
+  // The priority in memory arbitration does not affect scheduling.
+  task = runQuery(makeQueryCtx(
+      scheduler.get(), {{core::QueryConfig::kQueryPriority, "1"}}));
+  EXPECT_EQ(task->schedulingPriority(), 0);
+  EXPECT_EQ(scheduler->laneOf(*task), Lane::kBatch);
+}
+
+TEST_F(DriverSchedulerTest, batchInterval) {
+  // One thread so that the order of runs is the order of picks.
+  auto scheduler = makeScheduler(1);
+  std::atomic<int32_t> count{0};
+  std::atomic<bool> blocked{false};
+  folly::Baton<> release;
+  // Only accessed on the worker thread.
+  std::string order;
+  // Keeps the worker busy while the work below is queued. This is the first
+  // pick since the last batch pick.
+  scheduler->add([&]() {
+    blocked = true;
+    release.wait();
+  });
+  while (!blocked) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+  }
+  constexpr int32_t kNumInteractive = 8;
+  constexpr int32_t kNumBatch = 2;
+  for (auto i = 0; i < kNumInteractive; ++i) {
+    scheduler->add(Lane::kInteractive, [&]() {
+      order += 'I';
+      ++count;
+    });
+  }
+  for (auto i = 0; i < kNumBatch; ++i) {
+    scheduler->add(Lane::kBatch, [&]() {
+      order += 'B';
+      ++count;
+    });
+  }
+  release.post();
+  ASSERT_NO_FATAL_FAILURE(waitFor(count, kNumInteractive + kNumBatch));
+
+  // With the default batch interval of 4, every 4th pick is from the batch
+  // queue although interactive work is queued.
+  EXPECT_EQ(order, "IIBIIIBIII");
+  const auto stats = scheduler->stats();
+  EXPECT_EQ(stats.lanes[laneIndex(Lane::kBatch)].numRuns, kNumBatch);
+  EXPECT_EQ(
+      stats.lanes[laneIndex(Lane::kInteractive)].numRuns, kNumInteractive + 1);
+}
+
+TEST_F(DriverSchedulerTest, timeSlice) {
+  // One thread with a 10ms time slice.
+  auto scheduler = makeScheduler(1, 1'000'000, 10'000);
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 100; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        10'000, [i](auto row) { return i * 10'000 + row; })}));
+  }
+  // Runs for well over the time slice.
+  auto plan = PlanBuilder()
+                  .values(vectors, false, 20)
+                  .project({"c0 * 3 + c0 % 7 AS p0", "c0 / 5 - c0 % 11 AS p1"})
+                  .filter("p0 > p1")
+                  .singleAggregation({}, {"count(1)", "sum(p1)"})
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  // Keeps other work queued while the query runs, so that the Driver of the
+  // query is asked to yield when its time slice is up.
+  std::atomic<bool> done{false};
+  std::atomic<int32_t> numFuncs{0};
+  std::thread adder([&]() {
+    while (!done) {
+      scheduler->add([&]() { ++numFuncs; });
+      std::this_thread::sleep_for(std::chrono::milliseconds(1)); // NOLINT
+    }
+  });
+  auto task = AssertQueryBuilder(plan)
+                  .queryCtx(makeQueryCtx(scheduler.get()))
+                  .assertResults(expected);
+  done = true;
+  adder.join();
+
+  const auto stats = scheduler->stats();
+  EXPECT_GT(stats.numYields, 0);
+  EXPECT_GT(numFuncs, 0);
+}
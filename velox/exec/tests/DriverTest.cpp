@@ -1027,6 +1027,50 @@ TEST_F(DriverTest, nonVeloxOperatorException) {
       "Operator::getOutput failed for [operator: Throw, plan node ID: 1]");
 }
 
+TEST_F(DriverTest, cpuQuota) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 100; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        10'000, [i](auto row) { return i * 10'000 + row; })}));
+  }
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 * 3 + c0 % 7 AS p0", "c0 / 5 - c0 % 11 AS p1"})
+                  .filter("p0 > p1")
+                  .singleAggregation({}, {"count(1)", "sum(p1)"})
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+
+  // 0.01 cores is 100us of CPU time per 10ms period, which the query exceeds
+  // many times over.
+  auto task = AssertQueryBuilder(plan)
+                  .config(core::QueryConfig::kTaskCpuQuota, "0.01")
+                  .config(core::QueryConfig::kTaskCpuQuotaPeriodMs, "10")
+                  .assertResults(expected);
+  auto stats = task->taskStats();
+  EXPECT_GT(stats.numCpuQuotaThrottles, 0);
+  EXPECT_GT(stats.cpuQuotaThrottledTimeMs, 0);
+
+  task = AssertQueryBuilder(plan).assertResults(expected);
+  stats = task->taskStats();
+  EXPECT_EQ(stats.numCpuQuotaThrottles, 0);
+  EXPECT_EQ(stats.cpuQuotaThrottledTimeMs, 0);
+
+  // A quota that rounds to 0ns per period is not enforced.
+  task = AssertQueryBuilder(plan)
+             .config(core::QueryConfig::kTaskCpuQuota, "1e-12")
+             .config(core::QueryConfig::kTaskCpuQuotaPeriodMs, "10")
+             .assertResults(expected);
+  EXPECT_FALSE(task->hasCpuQuota());
+  EXPECT_EQ(task->taskStats().numCpuQuotaThrottles, 0);
+
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .config(core::QueryConfig::kTaskCpuQuota, "-1")
+          .copyResults(pool()),
+      "task_cpu_quota must not be negative");
+}
+
 DEBUG_ONLY_TEST_F(DriverTest, driverSuspensionRaceWithTaskPause) {
   struct {
     int numDrivers;
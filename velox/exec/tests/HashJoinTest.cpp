@@ -4446,6 +4446,104 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterPushdown) {
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 10'000;
+  // More distinct keys than the VectorHashers keep track of, so there is no
+  // exact dynamic filter on the build keys.
+  const int32_t numRowsBuild = VectorHasher::kMaxDistinct + 10'000;
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<int64_t>(
+            numRowsProbe, [&](auto row) { return row * 5 + i; }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(exec::Split(makeHiveConnectorSplit(file->path)));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  std::vector<RowVectorPtr> buildVectors{makeRowVector({
+      makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row * 7; }),
+      makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; }),
+  })};
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0", "c1 AS u_c1"})
+                       .planNode();
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(ROW({"c0", "c1"}, {BIGINT(), BIGINT()}))
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    buildSide,
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  for (bool bloomFilterEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("bloomFilterEnabled: {}", bloomFilterEnabled));
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(op)
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .injectSpill(false)
+        .config(
+            core::QueryConfig::kHashJoinBloomFilterEnabled,
+            bloomFilterEnabled ? "true" : "false")
+        .referenceQuery(
+            "SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          if (!bloomFilterEnabled) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(numRowsProbe * numSplits, getInputPositions(task, 1));
+            return;
+          }
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // A Bloom filter is not exact, so it cannot replace the join.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          // About 1 in 7 probe keys match.
+          ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 4);
+        })
+        .run();
+  }
+
+  // No Bloom filter is made if it does not fit in the size limit.
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(op)
+      .makeInputSplits(makeInputSplits(probeScanId))
+      .injectSpill(false)
+      .config(core::QueryConfig::kHashJoinBloomFilterEnabled, "true")
+      .config(core::QueryConfig::kHashJoinBloomFilterMaxBytes, "16")
+      .referenceQuery("SELECT t.c0, t.c1, u.c1 FROM t, u WHERE t.c0 = u.c0")
+      .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+        ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+        ASSERT_EQ(numRowsProbe * numSplits, getInputPositions(task, 1));
+      })
+      .run();
+}
+
 TEST_F(HashJoinTest, dynamicFiltersWithSkippedSplits) {
   const int32_t numSplits = 20;
   const int32_t numNonSkippedSplits = 10;
@@ -110,6 +110,13 @@ class HashTableTest : public testing::TestWithParam<bool>,
     ASSERT_EQ(topTable_->hashMode(), mode);
     LOG(INFO) << "Made table " << describeTable();
     testProbe();
+    if (mode == BaseHashTable::HashMode::kHash) {
+      // Probes with and without batched prefetching regardless of table size.
+      topTable_->testingSetBatchedJoinProbe(true);
+      testProbe();
+      topTable_->testingSetBatchedJoinProbe(false);
+      testProbe();
+    }
     testEraseEveryN(3);
     testProbe();
     testEraseEveryN(4);
@@ -813,9 +820,9 @@ TEST_P(HashTableTest, offsetOverflowLoadTags) {
   }
 }
 
-DEBUG_ONLY_TEST_P(HashTableTest, failureInCreateRowPartitions) {
+DEBUG_ONLY_TEST_P(HashTableTest, failureInAllocatePartitionedRows) {
   // This tests an issue in parallelJoinBuild where an exception in
-  // createRowPartitions could lead to concurrency issues in async table
+  // allocating the partitioned rows could lead to concurrency issues in async table
   // partitioning threads.
 
   // It is only relevant when the parallel join build is enabled.
@@ -849,10 +856,10 @@ DEBUG_ONLY_TEST_P(HashTableTest, failureInCreateRowPartitions) {
       "Triggering expected failure in allocation";
 
   // Fail when allocating memory for the third table.  So we know 2
-  // RowPartitions have been created.
+  // PartitionedRows have been created.
   std::atomic_int allocateCount{0};
   SCOPED_TESTVALUE_SET(
-      "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
+      "facebook::velox::exec::HashTable::allocatePartitionedRows",
       std::function<void(void*)>(([&](void*) {
         if (++allocateCount >= 3) {
           VELOX_FAIL(expectedFailureMessage);
@@ -897,7 +904,7 @@ DEBUG_ONLY_TEST_P(HashTableTest, failureInCreateRowPartitions) {
       std::function<void(void*)>([&](void*) { isParallelBuild = true; }));
 
   // We expect this to trigger the exception from the TestValue we set for
-  // allocateNonContiguous.
+  // allocatePartitionedRows.
   // Set hash mode to HASH and numNew to something much larger than the
   // capacity to trigger a rehash.
   VELOX_ASSERT_THROW(
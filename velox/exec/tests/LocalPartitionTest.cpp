@@ -229,8 +229,10 @@ TEST_F(LocalPartitionTest, maxBufferSizeGather) {
 TEST_F(LocalPartitionTest, maxBufferSizePartition) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
-    vectors.emplace_back(makeRowVector({makeFlatVector<int32_t>(
-        100, [i](auto row) { return -71 + i * 10 + row; })}));
+    vectors.emplace_back(makeRowVector(
+        {makeFlatVector<int32_t>(
+             100, [i](auto row) { return -71 + i * 10 + row; }),
+         makeFlatVector<int64_t>(100, [i](auto row) { return i * row; })}));
   }
 
   createDuckDbTable(vectors);
@@ -257,10 +259,10 @@ TEST_F(LocalPartitionTest, maxBufferSizePartition) {
                         scanNode(),
                         scanNode(),
                     })
-                .partialAggregation({"c0"}, {"count(1)"})
+                .partialAggregation({"c0"}, {"count(1)", "sum(c1)"})
                 .planNode();
 
-  auto makeQueryBuilder = [&](const char* bufferSize) {
+  auto makeQueryBuilder = [&](const char* bufferSize, bool sharedBuffer) {
     AssertQueryBuilder queryBuilder(op, duckDbQueryRunner_);
     queryBuilder.maxDrivers(2);
     for (auto i = 0; i < filePaths.size(); ++i) {
@@ -269,18 +271,71 @@ TEST_F(LocalPartitionTest, maxBufferSizePartition) {
     }
     queryBuilder.config(
         core::QueryConfig::kMaxLocalExchangeBufferSize, bufferSize);
+    queryBuilder.config(
+        core::QueryConfig::kLocalExchangeSharedBuffer,
+        sharedBuffer ? "true" : "false");
     return queryBuilder;
   };
 
-  // Set an artificially low buffer size limit to trigger blocking behavior.
-  auto task = makeQueryBuilder("100").assertResults(
-      "SELECT c0, count(1) FROM tmp GROUP BY 1");
-  verifyExchangeSourceOperatorStats(task, 2100, 42);
+  // With a shared buffer, each input is counted once against the limit for
+  // both partitions.
+  for (bool sharedBuffer : {false, true}) {
+    SCOPED_TRACE(fmt::format("sharedBuffer: {}", sharedBuffer));
+
+    // Set an artificially low buffer size limit to trigger blocking behavior.
+    auto task = makeQueryBuilder("100", sharedBuffer)
+                    .assertResults(
+                        "SELECT c0, count(1), sum(c1) FROM tmp GROUP BY 1");
+    verifyExchangeSourceOperatorStats(task, 2100, 42);
+
+    // Re-run with higher memory limit (enough to hold ~10 vectors at a time).
+    task = makeQueryBuilder("10240", sharedBuffer)
+               .assertResults(
+                   "SELECT c0, count(1), sum(c1) FROM tmp GROUP BY 1");
+    verifyExchangeSourceOperatorStats(task, 2100, 42);
+  }
+}
+
+TEST_F(LocalPartitionTest, sharedBufferEarlyCompletion) {
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 100; ++i) {
+    data.push_back(makeRowVector({makeFlatSequence(i * 100, 100)}));
+  }
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .localPartition(
+              {"c0"},
+              {PlanBuilder(planNodeIdGenerator).values(data).planNode()})
+          .limit(0, 2, true)
+          .planNode();
+
+  // The consumers finish after their first rows while the producer is
+  // blocked on the buffer size limit. Closing the queues releases the shared
+  // inputs queued for both partitions and unblocks the producer.
+  CursorParameters params;
+  params.planNode = plan;
+  params.maxDrivers = 2;
+  params.queryCtx = std::make_shared<core::QueryCtx>(
+      executor_.get(),
+      core::QueryConfig({
+          {core::QueryConfig::kMaxLocalExchangeBufferSize, "1024"},
+          {core::QueryConfig::kLocalExchangeSharedBuffer, "true"},
+      }));
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+
+  vector_size_t numRows = 0;
+  for (const auto& result : results) {
+    numRows += result->size();
+  }
+  // Each of the 2 drivers returns 2 rows.
+  ASSERT_EQ(numRows, 4);
 
-  // Re-run with higher memory limit (enough to hold ~10 vectors at a time).
-  task = makeQueryBuilder("10240").assertResults(
-      "SELECT c0, count(1) FROM tmp GROUP BY 1");
-  verifyExchangeSourceOperatorStats(task, 2100, 42);
+  auto task = cursor->task();
+  waitForTaskCompletion(task, exec::kFinished);
+  cursor.reset();
+  assertTaskReferenceCount(task, 1);
 }
 
 TEST_F(LocalPartitionTest, blockingOnLocalExchangeQueue) {
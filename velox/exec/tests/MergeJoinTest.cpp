@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -178,6 +179,53 @@ class MergeJoinTest : public HiveConnectorTestBase {
     assertQuery(
         makeCursorParameters(plan, 10'000),
         "SELECT t.c0, t.c1, u.c1 FROM t LEFT JOIN u ON t.c0 = u.c0");
+
+    auto testJoinType = [&](core::JoinType joinType,
+                            const std::vector<std::string>& outputLayout,
+                            const std::string& duckDbSql) {
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(left)
+                      .mergeJoin(
+                          {"c0"},
+                          {"u_c0"},
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(right)
+                              .project({"c1 as u_c1", "c0 as u_c0"})
+                              .planNode(),
+                          "",
+                          outputLayout,
+                          joinType)
+                      .planNode();
+
+      for (auto batchSize : {16, 1024, 10'000}) {
+        assertQuery(makeCursorParameters(plan, batchSize), duckDbSql);
+      }
+    };
+
+    // Test RIGHT join.
+    testJoinType(
+        core::JoinType::kRight,
+        {"c0", "c1", "u_c1"},
+        "SELECT t.c0, t.c1, u.c1 FROM t RIGHT JOIN u ON t.c0 = u.c0");
+
+    // Test FULL OUTER join.
+    testJoinType(
+        core::JoinType::kFull,
+        {"c0", "c1", "u_c1"},
+        "SELECT t.c0, t.c1, u.c1 FROM t FULL OUTER JOIN u ON t.c0 = u.c0");
+
+    // Test LEFT SEMI join.
+    testJoinType(
+        core::JoinType::kLeftSemiFilter,
+        {"c0", "c1"},
+        "SELECT t.c0, t.c1 FROM t WHERE EXISTS (SELECT * FROM u WHERE t.c0 = u.c0)");
+
+    // Test ANTI join.
+    testJoinType(
+        core::JoinType::kAnti,
+        {"c0", "c1"},
+        "SELECT t.c0, t.c1 FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t.c0 = u.c0)");
   }
 };
 
@@ -415,6 +463,168 @@ TEST_F(MergeJoinTest, leftJoinFilter) {
   }
 }
 
+TEST_F(MergeJoinTest, rightJoinFilter) {
+  // Each row on the right side has at most one match on the left side.
+  auto left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>({0, 10, 20, 30, 40, 50}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5}),
+      });
+
+  auto right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>({0, 5, 10, 15, 20, 25, 30, 35, 40, 45, 50}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = [&](const std::string& filter) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values({left})
+        .mergeJoin(
+            {"t_c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+            filter,
+            {"t_c1", "u_c0", "u_c1"},
+            core::JoinType::kRight)
+        .planNode();
+  };
+
+  for (auto batchSize : {1, 3, 16}) {
+    assertQuery(
+        makeCursorParameters(plan("(t_c1 + u_c1) % 2 = 0"), batchSize),
+        "SELECT t_c1, u_c0, u_c1 FROM t RIGHT JOIN u ON t_c0 = u_c0 AND (t_c1 + u_c1) % 2 = 0");
+  }
+
+  // A right-side row with multiple matches on the left side.
+  left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>({10, 10, 10, 10, 10, 10}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5}),
+      });
+
+  right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>({5, 10, 10}),
+          makeFlatVector<int32_t>({0, 0, 1}),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  for (auto batchSize : {1, 3, 16}) {
+    for (auto filter :
+         {"t_c1 + u_c1 > 3",
+          "t_c1 + u_c1 < 3",
+          "t_c1 + u_c1 > 100",
+          "t_c1 + u_c1 < 100"}) {
+      assertQuery(
+          makeCursorParameters(plan(filter), batchSize),
+          fmt::format(
+              "SELECT t_c1, u_c0, u_c1 FROM t RIGHT JOIN u ON t_c0 = u_c0 AND {}",
+              filter));
+    }
+  }
+}
+
+TEST_F(MergeJoinTest, semiAndAntiJoinFilter) {
+  // Left-side rows with no match, one match and multiple matches.
+  auto left = makeRowVector(
+      {"t_c0", "t_c1"},
+      {
+          makeFlatVector<int32_t>({5, 10, 10, 15, 20, 25}),
+          makeFlatVector<int32_t>({0, 0, 1, 2, 3, 4}),
+      });
+
+  auto right = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>({10, 10, 10, 10, 20, 30}),
+          makeFlatVector<int32_t>({0, 1, 2, 3, 4, 5}),
+      });
+
+  createDuckDbTable("t", {left});
+  createDuckDbTable("u", {right});
+
+  auto plan = [&](const std::string& filter, core::JoinType joinType) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values({left})
+        .mergeJoin(
+            {"t_c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+            filter,
+            {"t_c0", "t_c1"},
+            joinType)
+        .planNode();
+  };
+
+  for (auto batchSize : {1, 3, 16}) {
+    for (auto filter :
+         {"t_c1 + u_c1 > 3",
+          "t_c1 + u_c1 < 3",
+          "t_c1 + u_c1 > 100",
+          "t_c1 + u_c1 < 100"}) {
+      SCOPED_TRACE(fmt::format("batchSize: {}, filter: {}", batchSize, filter));
+      assertQuery(
+          makeCursorParameters(
+              plan(filter, core::JoinType::kLeftSemiFilter), batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1 FROM t WHERE EXISTS (SELECT * FROM u WHERE t_c0 = u_c0 AND {})",
+              filter));
+      assertQuery(
+          makeCursorParameters(plan(filter, core::JoinType::kAnti), batchSize),
+          fmt::format(
+              "SELECT t_c0, t_c1 FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t_c0 = u_c0 AND {})",
+              filter));
+    }
+  }
+}
+
+TEST_F(MergeJoinTest, unsupportedJoins) {
+  auto left = makeRowVector({"t_c0"}, {makeFlatVector<int32_t>({1, 2, 3})});
+  auto right = makeRowVector({"u_c0"}, {makeFlatVector<int32_t>({0, 2, 5})});
+
+  auto plan = [&](const std::string& filter,
+                  const std::vector<std::string>& outputLayout,
+                  core::JoinType joinType) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values({left})
+        .mergeJoin(
+            {"t_c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+            filter,
+            outputLayout,
+            joinType)
+        .planNode();
+  };
+
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan(
+                             "t_c0 + u_c0 > 0",
+                             {"t_c0", "u_c0"},
+                             core::JoinType::kFull))
+          .copyResults(pool()),
+      "Merge join doesn't support full outer join with filter");
+
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(
+          plan("", {"u_c0"}, core::JoinType::kRightSemiFilter))
+          .copyResults(pool()),
+      "Merge join doesn't support RIGHT SEMI (FILTER) join");
+}
+
 // Verify that both left-side and right-side pipelines feeding the merge join
 // always run single-threaded.
 TEST_F(MergeJoinTest, numDrivers) {
@@ -538,6 +748,49 @@ TEST_F(MergeJoinTest, nullKeys) {
              .planNode();
   AssertQueryBuilder(plan, duckDbQueryRunner_)
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
+
+  // Right join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kRight)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t RIGHT JOIN u ON t.t0 = u.u0");
+
+  // Full outer join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0", "u0"},
+                 core::JoinType::kFull)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT * FROM t FULL OUTER JOIN u ON t.t0 = u.u0");
+
+  // Anti join.
+  plan = PlanBuilder(planNodeIdGenerator)
+             .values({left})
+             .mergeJoin(
+                 {"t0"},
+                 {"u0"},
+                 PlanBuilder(planNodeIdGenerator).values({right}).planNode(),
+                 "",
+                 {"t0"},
+                 core::JoinType::kAnti)
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults(
+          "SELECT * FROM t WHERE NOT EXISTS (SELECT * FROM u WHERE t.t0 = u.u0)");
 }
 
 TEST_F(MergeJoinTest, complexTypedFilter) {
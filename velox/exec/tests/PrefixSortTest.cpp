@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/exec/tests/utils/RowContainerTestBase.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+class PrefixSortTest : public exec::test::RowContainerTestBase {
+ protected:
+  std::vector<char*> store(RowContainer& container, const RowVectorPtr& data) {
+    std::vector<DecodedVector> decodedVectors;
+    for (auto& vector : data->children()) {
+      decodedVectors.emplace_back(*vector);
+    }
+    std::vector<char*> rows;
+    for (auto i = 0; i < data->size(); ++i) {
+      rows.push_back(container.newRow());
+      for (auto j = 0; j < decodedVectors.size(); ++j) {
+        container.store(decodedVectors[j], i, rows.back(), j);
+      }
+    }
+    return rows;
+  }
+
+  // Sorts the rows of 'data' on all columns with 'compareFlags' using
+  // PrefixSort with prefixes of 'maxNormalizedKeyBytes' and checks that the
+  // keys are in the same order as after sorting with RowContainer::compare().
+  void testSort(
+      const RowVectorPtr& data,
+      const std::vector<CompareFlags>& compareFlags,
+      uint32_t maxNormalizedKeyBytes) {
+    SCOPED_TRACE(
+        fmt::format("maxNormalizedKeyBytes: {}", maxNormalizedKeyBytes));
+    RowContainer container(asRowType(data->type())->children(), pool());
+    auto expected = store(container, data);
+    auto compareKeys = [&](const char* left, const char* right) {
+      for (auto i = 0; i < compareFlags.size(); ++i) {
+        if (auto result = container.compare(left, right, i, compareFlags[i])) {
+          return result;
+        }
+      }
+      return 0;
+    };
+    auto actual = expected;
+    std::sort(
+        expected.begin(),
+        expected.end(),
+        [&](const char* left, const char* right) {
+          return compareKeys(left, right) < 0;
+        });
+    PrefixSort::sort(
+        &container,
+        compareFlags,
+        PrefixSortConfig{maxNormalizedKeyBytes, 0},
+        pool(),
+        actual);
+    ASSERT_EQ(expected.size(), actual.size());
+    for (auto i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(0, compareKeys(expected[i], actual[i])) << "at row " << i;
+    }
+  }
+
+  // Returns all combinations of ascending and nulls first for 'numKeys' keys.
+  static std::vector<std::vector<CompareFlags>> allCompareFlags(
+      int32_t numKeys) {
+    std::vector<std::vector<CompareFlags>> result;
+    for (auto mask = 0; mask < (1 << (2 * numKeys)); ++mask) {
+      std::vector<CompareFlags> flags;
+      for (auto i = 0; i < numKeys; ++i) {
+        flags.push_back(
+            {(mask & (1 << (2 * i))) != 0,
+             (mask & (1 << (2 * i + 1))) != 0,
+             false,
+             CompareFlags::NullHandlingMode::kNullAsValue});
+      }
+      result.push_back(std::move(flags));
+    }
+    return result;
+  }
+};
+
+TEST_F(PrefixSortTest, prefixSize) {
+  EXPECT_EQ(
+      1 + 8 + 1 + 4, PrefixSort::prefixSize({BIGINT(), INTEGER()}, 128));
+  // Stops at the key that does not fit.
+  EXPECT_EQ(1 + 8, PrefixSort::prefixSize({BIGINT(), INTEGER()}, 12));
+  EXPECT_EQ(0, PrefixSort::prefixSize({BIGINT()}, 8));
+  // Strings take the rest of the prefix and end the prefix.
+  EXPECT_EQ(32, PrefixSort::prefixSize({VARCHAR(), BIGINT()}, 32));
+  EXPECT_EQ(
+      1 + 2 + 128 - 3,
+      PrefixSort::prefixSize({SMALLINT(), VARBINARY(), BIGINT()}, 1'000));
+  // Stops at a type that is not supported.
+  EXPECT_EQ(
+      1 + 1, PrefixSort::prefixSize({BOOLEAN(), ARRAY(BIGINT()), REAL()}, 64));
+  EXPECT_EQ(0, PrefixSort::prefixSize({MAP(BIGINT(), BIGINT())}, 64));
+  EXPECT_EQ(
+      1 + 12 + 1 + 1, PrefixSort::prefixSize({TIMESTAMP(), TINYINT()}, 64));
+}
+
+TEST_F(PrefixSortTest, maxRequiredBytes) {
+  RowContainer container({BIGINT(), INTEGER(), VARCHAR()}, pool());
+  const std::vector<CompareFlags> oneKey(1);
+  const std::vector<CompareFlags> twoKeys(2);
+  // 9 prefix bytes take 2 words, 14 bytes too.
+  EXPECT_EQ(
+      1'000 * (2 * 8 + 8),
+      PrefixSort::maxRequiredBytes(&container, oneKey, {128, 0}, 1'000));
+  EXPECT_EQ(
+      1'000 * (2 * 8 + 8),
+      PrefixSort::maxRequiredBytes(&container, twoKeys, {128, 0}, 1'000));
+  // The string takes the rest of the prefix.
+  EXPECT_EQ(
+      1'000 * (16 * 8 + 8),
+      PrefixSort::maxRequiredBytes(
+          &container, std::vector<CompareFlags>(3), {128, 0}, 1'000));
+  // No prefix sort.
+  EXPECT_EQ(0, PrefixSort::maxRequiredBytes(&container, oneKey, {0, 0}, 1'000));
+  EXPECT_EQ(0, PrefixSort::maxRequiredBytes(&container, oneKey, {8, 0}, 1'000));
+  EXPECT_EQ(
+      0, PrefixSort::maxRequiredBytes(&container, oneKey, {128, 2'000}, 1'000));
+}
+
+TEST_F(PrefixSortTest, multipleKeys) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return row % 7 - 3; },
+          [](auto row) { return row % 11 == 0; }),
+      makeFlatVector<std::string>(
+          size,
+          [](auto row) {
+            return fmt::format("a shared string prefix {}", row % 13);
+          },
+          [](auto row) { return row % 17 == 0; }),
+      makeFlatVector<int32_t>(
+          size,
+          [](auto row) { return row % 5 - 2; },
+          [](auto row) { return row % 19 == 0; }),
+  });
+
+  for (const auto& flags : allCompareFlags(3)) {
+    for (auto maxNormalizedKeyBytes : {9, 10, 16, 30, 128}) {
+      testSort(data, flags, maxNormalizedKeyBytes);
+    }
+  }
+}
+
+TEST_F(PrefixSortTest, fixedWidthKeys) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<bool>(
+          size,
+          [](auto row) { return row % 3 == 0; },
+          [](auto row) { return row % 23 == 0; }),
+      makeFlatVector<int8_t>(
+          size,
+          [](auto row) { return row % 255 - 127; },
+          [](auto row) { return row % 29 == 0; }),
+      makeFlatVector<int16_t>(
+          size, [](auto row) { return (row % 5) * 10'000 - 20'000; }),
+      makeFlatVector<Timestamp>(
+          size,
+          [](auto row) { return Timestamp(row % 3 - 1, (row % 4) * 1'000); },
+          [](auto row) { return row % 31 == 0; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+  });
+
+  for (const auto& flags : allCompareFlags(2)) {
+    auto allFlags = flags;
+    allFlags.insert(allFlags.end(), flags.begin(), flags.end());
+    allFlags.push_back(flags[0]);
+    for (auto maxNormalizedKeyBytes : {2, 4, 7, 20, 128}) {
+      testSort(data, allFlags, maxNormalizedKeyBytes);
+    }
+  }
+}
+
+TEST_F(PrefixSortTest, floatingPoint) {
+  const std::vector<double> values = {
+      0.0,
+      -0.0,
+      1.5,
+      -1.5,
+      std::numeric_limits<double>::infinity(),
+      -std::numeric_limits<double>::infinity(),
+      std::numeric_limits<double>::quiet_NaN(),
+      -std::numeric_limits<double>::quiet_NaN(),
+      std::numeric_limits<double>::max(),
+      std::numeric_limits<double>::lowest(),
+      std::numeric_limits<double>::denorm_min(),
+      -std::numeric_limits<double>::denorm_min()};
+  const vector_size_t size = values.size() * 10;
+  auto data = makeRowVector({
+      makeFlatVector<double>(
+          size,
+          [&](auto row) { return values[row % values.size()]; },
+          [](auto row) { return row % 7 == 0; }),
+      makeFlatVector<float>(
+          size,
+          [&](auto row) {
+            return static_cast<float>(values[(row / 3) % values.size()]);
+          },
+          [](auto row) { return row % 5 == 0; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+  });
+
+  for (const auto& flags : allCompareFlags(3)) {
+    testSort(data, flags, 128);
+  }
+}
+
+TEST_F(PrefixSortTest, fuzzer) {
+  VectorFuzzer fuzzer(
+      {.vectorSize = 500,
+       .nullRatio = 0.1,
+       .stringLength = 20,
+       .stringVariableLength = true},
+      pool());
+  const std::vector<TypePtr> types = {
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      TIMESTAMP(),
+      ARRAY(INTEGER())};
+  for (auto i = 0; i < 20; ++i) {
+    SCOPED_TRACE(fmt::format("Iteration #: {}", i));
+    std::vector<TypePtr> keyTypes;
+    for (auto j = 0; j < 3; ++j) {
+      keyTypes.push_back(types[folly::Random::rand32(types.size())]);
+    }
+    auto data = fuzzer.fuzzInputRow(
+        ROW({"c0", "c1", "c2"}, std::move(keyTypes)));
+    const auto& allFlags = allCompareFlags(3);
+    const auto& flags = allFlags[folly::Random::rand32(allFlags.size())];
+    for (auto maxNormalizedKeyBytes : {8, 16, 128}) {
+      testSort(data, flags, maxNormalizedKeyBytes);
+    }
+  }
+}
+
+} // namespace
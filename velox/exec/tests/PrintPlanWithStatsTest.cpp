@@ -207,6 +207,7 @@ TEST_F(PrintPlanWithStatsTest, innerJoinWithTableScan) {
        {"          runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
        {"          runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+       {"          skippedPages        [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedSplitBytes   [ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
        {"          skippedSplits       [ ]* sum: 0, count: 1, min: 0, max: 0"},
        {"          skippedStrides      [ ]* sum: 0, count: 1, min: 0, max: 0"},
@@ -298,6 +299,7 @@ TEST_F(PrintPlanWithStatsTest, partialAggregateWithTableScan) {
          {"        runningAddInputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningFinishWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
          {"        runningGetOutputWallNanos\\s+sum: .+, count: 1, min: .+, max: .+"},
+         {"        skippedPages     [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedSplitBytes[ ]* sum: 0B, count: 1, min: 0B, max: 0B"},
          {"        skippedSplits    [ ]* sum: 0, count: 1, min: 0, max: 0"},
          {"        skippedStrides   [ ]* sum: 0, count: 1, min: 0, max: 0"},
@@ -44,7 +44,20 @@ class SortBufferTest : public OperatorTestBase {
 
   common::SpillConfig getSpillConfig(const std::string& spillFilePath) const {
     return common::SpillConfig(
-        spillFilePath, 0, 0, 0, executor_.get(), 5, 10, 0, 0, 0, 0, 0, "none");
+        spillFilePath,
+        0,
+        0,
+        0,
+        0,
+        executor_.get(),
+        5,
+        10,
+        0,
+        0,
+        0,
+        0,
+        0,
+        "none");
   }
 
   const RowTypePtr inputType_ = ROW(
@@ -279,6 +292,7 @@ TEST_F(SortBufferTest, batchOutput) {
         filePath,
         1000,
         0,
+        0,
         1000,
         executor_.get(),
         5,
@@ -373,6 +387,7 @@ TEST_F(SortBufferTest, spill) {
         filePath,
         1000,
         0,
+        0,
         1000,
         executor_.get(),
         100,
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -708,6 +709,48 @@ TEST_P(SpillTest, spillPartitionSpilt) {
   }
 }
 
+TEST_P(SpillTest, spillStateWithReadAhead) {
+  // Each sorted run has the values congruent to its run number modulo
+  // 'kNumRuns' so that the merge alternates between all runs, which are
+  // larger than their read-ahead buffers.
+  constexpr int32_t kNumRuns = 8;
+  constexpr int32_t kNumRowsPerRun = 100'000;
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  const std::vector<uint64_t> readAheadBytesList = {
+      0, kNumRuns * SpillState::kMinReadAheadBufferSize, 64 << 20};
+  for (const auto readAheadBytes : readAheadBytesList) {
+    SCOPED_TRACE(fmt::format("readAheadBytes {}", readAheadBytes));
+    SpillState state(
+        tempDir_->path + "/readAhead",
+        1,
+        1,
+        {},
+        kGB,
+        0,
+        compressionKind_,
+        pool(),
+        &stats_);
+    state.setPartitionSpilled(0);
+    for (int32_t run = 0; run < kNumRuns; ++run) {
+      state.appendToPartition(
+          0,
+          makeRowVector({makeFlatVector<int64_t>(
+              kNumRowsPerRun,
+              [&](auto row) { return row * kNumRuns + run; })}));
+      state.finishWrite(0);
+    }
+    auto merge = state.startMerge(0, nullptr, readAheadBytes, executor.get());
+    for (int64_t i = 0; i < kNumRuns * kNumRowsPerRun; ++i) {
+      auto stream = merge->next();
+      ASSERT_NE(stream, nullptr);
+      ASSERT_EQ(
+          stream->decoded(0).valueAt<int64_t>(stream->currentIndex()), i);
+      stream->pop();
+    }
+    ASSERT_EQ(merge->next(), nullptr);
+  }
+}
+
 TEST_P(SpillTest, nonExistSpillFileOnDeletion) {
   const int32_t numRowsPerBatch = 50;
   std::vector<RowVectorPtr> batches;
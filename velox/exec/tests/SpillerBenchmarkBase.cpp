@@ -23,6 +23,7 @@
 #include "velox/common/compression/Compression.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Spiller.h"
 #include "velox/exec/tests/SpillerBenchmarkBase.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
@@ -46,6 +47,11 @@ DEFINE_string(
     spiller_benchmark_spiller_type,
     "AGGREGATE_INPUT",
     "The spiller type name.");
+DEFINE_uint32(
+    spiller_benchmark_num_spill_runs,
+    1,
+    "The number of sorted runs to spill, each with all the spill vectors. "
+    "Applies to the aggregate input spiller");
 DEFINE_uint32(
     spiller_benchmark_num_spill_vectors,
     10'000,
@@ -74,6 +80,10 @@ DEFINE_uint64(
     spiller_benchmark_write_buffer_size,
     1 << 20,
     "The spill write buffer size");
+DEFINE_uint64(
+    spiller_benchmark_read_ahead_bytes,
+    0,
+    "The memory budget for reading ahead the spill files in a sorted merge");
 
 using namespace facebook::velox::memory;
 
@@ -138,6 +148,35 @@ void SpillerBenchmarkBase::printStats() const {
   }
 }
 
+void SpillerBenchmarkBase::merge() {
+  spiller_->finalizeSpill();
+  MicrosecondTimer timer(&mergeTimeUs_);
+  auto merger = spiller_->startMerge(FLAGS_spiller_benchmark_read_ahead_bytes);
+  if (merger == nullptr) {
+    return;
+  }
+  for (auto* stream = merger->next(); stream != nullptr;
+       stream = merger->next()) {
+    ++numMergedRows_;
+    stream->pop();
+  }
+}
+
+void SpillerBenchmarkBase::printMergeStats() const {
+  if (numMergedRows_ == 0) {
+    return;
+  }
+  const auto spilledBytes = spiller_->stats().spilledBytes;
+  const auto mergeTimeUs = std::max<uint64_t>(1, mergeTimeUs_);
+  LOG(INFO) << "merged " << numMergedRows_ << " rows from "
+            << succinctBytes(spilledBytes) << " of spill files in "
+            << succinctMicros(mergeTimeUs_) << " with "
+            << succinctBytes(FLAGS_spiller_benchmark_read_ahead_bytes)
+            << " read-ahead: "
+            << succinctBytes(spilledBytes * 1'000'000 / mergeTimeUs) << "/s, "
+            << numMergedRows_ * 1'000'000 / mergeTimeUs << " rows/s";
+}
+
 void SpillerBenchmarkBase::cleanup() {
   LOG(INFO) << "Remove spill dir: " << spillDir_;
   fs_->rmdir(spillDir_);
@@ -29,11 +29,13 @@ DECLARE_string(spiller_benchmark_name);
 DECLARE_string(spiller_benchmark_path);
 DECLARE_string(spiller_benchmark_spiller_type);
 DECLARE_uint32(spiller_benchmark_num_key_columns);
+DECLARE_uint32(spiller_benchmark_num_spill_runs);
 DECLARE_uint32(spiller_benchmark_num_spill_vectors);
 DECLARE_uint32(spiller_benchmark_spill_executor_size);
 DECLARE_uint32(spiller_benchmark_spill_vector_size);
 DECLARE_uint64(spiller_benchmark_max_spill_file_size);
 DECLARE_uint64(spiller_benchmark_min_spill_run_size);
+DECLARE_uint64(spiller_benchmark_read_ahead_bytes);
 DECLARE_uint64(spiller_benchmark_write_buffer_size);
 
 namespace facebook::velox::exec::test {
@@ -57,6 +59,14 @@ class SpillerBenchmarkBase {
   virtual void cleanup();
 
  protected:
+  /// Reads back the spilled data of 'spiller_' in a sorted merge with
+  /// --spiller_benchmark_read_ahead_bytes of read-ahead and measures the
+  /// merge time.
+  void merge();
+
+  /// Prints out the merge throughput if merge() has run.
+  void printMergeStats() const;
+
   std::shared_ptr<velox::memory::MemoryPool> rootPool_;
   std::shared_ptr<velox::memory::MemoryPool> pool_;
   RowTypePtr rowType_;
@@ -71,5 +81,7 @@ class SpillerBenchmarkBase {
   std::unique_ptr<Spiller> spiller_;
   // Stats.
   uint64_t executionTimeUs_{0};
+  uint64_t mergeTimeUs_{0};
+  uint64_t numMergedRows_{0};
 };
 } // namespace facebook::velox::exec::test
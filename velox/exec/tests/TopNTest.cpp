@@ -14,14 +14,22 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
 
 class TopNTest : public OperatorTestBase {
  protected:
+  TopNTest() {
+    filesystems::registerLocalFileSystem();
+  }
+
   static std::vector<std::string> getSortOrderSqls() {
     return {"NULLS LAST", "NULLS FIRST", "DESC NULLS FIRST", "DESC NULLS LAST"};
   }
@@ -234,6 +242,90 @@ TEST_F(TopNTest, multiBatch) {
   testSingleKey(vectors, "c2", 2'500);
 }
 
+TEST_F(TopNTest, spill) {
+  const vector_size_t batchSize = 1'000;
+  const int32_t numBatches = 5;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < numBatches; ++i) {
+    // Unique keys, so that the first rows are the same in any valid order.
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return row * numBatches + i; });
+    auto c1 = makeFlatVector<int32_t>(
+        batchSize, [](vector_size_t row) { return row; }, nullEvery(7));
+    auto c2 = makeFlatVector<StringView>(batchSize, [](vector_size_t row) {
+      return StringView::makeInline(std::to_string(row));
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  auto spillDirectory = TempDirectoryPath::create();
+  for (const auto& sortOrder : {"ASC", "DESC"}) {
+    for (auto limit : {1, 700, 2'500, 10'000}) {
+      SCOPED_TRACE(fmt::format("{} limit {}", sortOrder, limit));
+      const auto key = fmt::format("c0 {}", sortOrder);
+      core::PlanNodeId topNId;
+      auto plan = PlanBuilder()
+                      .values(vectors)
+                      .project({"c1", "c2", "c0"})
+                      .topN({key}, limit, false)
+                      .capturePlanNodeId(topNId)
+                      .planNode();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .config(core::QueryConfig::kPreferredOutputBatchRows, "300")
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kTopNSpillEnabled, "true")
+              .config(core::QueryConfig::kTestingSpillPct, "100")
+              .spillDirectory(spillDirectory->path)
+              .assertResults(
+                  fmt::format(
+                      "SELECT c1, c2, c0 FROM tmp ORDER BY {} LIMIT {}",
+                      key,
+                      limit),
+                  {{2}});
+
+      auto planStats = exec::toPlanStats(task->taskStats());
+      const auto& stats = planStats.at(topNId);
+      ASSERT_GT(stats.spilledBytes, 0);
+      ASSERT_GT(stats.spilledRows, 0);
+      ASSERT_GT(stats.spilledFiles, 0);
+      ASSERT_GT(stats.spilledPartitions, 0);
+      // A spilled run has at most 'limit' rows.
+      ASSERT_LE(stats.spilledRows, numBatches * std::min(limit, batchSize));
+    }
+  }
+}
+
+TEST_F(TopNTest, partialNoSpill) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](vector_size_t row) { return row * 5 + i; }),
+        makeFlatVector<int32_t>(1'000, [](vector_size_t row) { return row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto spillDirectory = TempDirectoryPath::create();
+  core::PlanNodeId topNId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .topN({"c0"}, 100, true)
+                  .capturePlanNodeId(topNId)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kSpillEnabled, "true")
+                  .config(core::QueryConfig::kTopNSpillEnabled, "true")
+                  .config(core::QueryConfig::kTestingSpillPct, "100")
+                  .spillDirectory(spillDirectory->path)
+                  .assertResults("SELECT * FROM tmp ORDER BY c0 LIMIT 100");
+
+  auto planStats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(planStats.at(topNId).spilledBytes, 0);
+}
+
 TEST_F(TopNTest, empty) {
   vector_size_t batchSize = 1'000;
   std::vector<RowVectorPtr> vectors;
@@ -15,6 +15,7 @@
  */
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -23,6 +24,7 @@
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
 using namespace facebook::velox::exec::test;
+using namespace facebook::velox::common::testutil;
 
 namespace facebook::velox::window::test {
 
@@ -182,6 +184,68 @@ TEST_F(WindowTest, spill) {
   ASSERT_GT(stats.spilledPartitions, 0);
 }
 
+DEBUG_ONLY_TEST_F(WindowTest, spillDuringOutput) {
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"d", "p", "s"},
+      {
+          // Payload.
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          // Partition key.
+          makeFlatVector<int16_t>(size, [](auto row) { return row % 11; }),
+          // Sorting key.
+          makeFlatVector<int32_t>(size, [](auto row) { return row; }),
+      });
+
+  createDuckDbTable({data});
+
+  // Reclaims from the Window operator before the 'numOutputs'-th call to
+  // getOutput() after noMoreInput(). 0 spills before any partition is output.
+  for (const auto numOutputs : {0, 1, 3}) {
+    SCOPED_TRACE(fmt::format("numOutputs: {}", numOutputs));
+    core::PlanNodeId windowId;
+    auto plan = PlanBuilder()
+                    .values(split(data, 10))
+                    .window({"row_number() over (partition by p order by s)"})
+                    .capturePlanNodeId(windowId)
+                    .planNode();
+
+    std::atomic_int32_t numGetOutputs{0};
+    memory::MemoryReclaimer::Stats reclaimerStats;
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::getOutput",
+        std::function<void(exec::Operator*)>([&](exec::Operator* op) {
+          if (op->operatorType() != "Window" || op->needsInput()) {
+            return;
+          }
+          if (numGetOutputs++ != numOutputs) {
+            return;
+          }
+          ASSERT_TRUE(op->canReclaim());
+          op->reclaim(0, reclaimerStats);
+        }));
+
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "50")
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kWindowSpillEnabled, "true")
+            .spillDirectory(spillDirectory->path)
+            .maxDrivers(1)
+            .assertResults(
+                "SELECT *, row_number() over (partition by p order by s) FROM tmp");
+
+    ASSERT_EQ(reclaimerStats.numNonReclaimableAttempts, 0);
+    auto taskStats = exec::toPlanStats(task->taskStats());
+    const auto& stats = taskStats.at(windowId);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_LE(stats.spilledRows, size);
+    ASSERT_EQ(stats.spilledPartitions, 1);
+  }
+}
+
 TEST_F(WindowTest, missingFunctionSignature) {
   auto input = {makeRowVector({
       makeFlatVector<int64_t>({1, 2, 3}),
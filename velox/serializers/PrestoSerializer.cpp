@@ -14,12 +14,17 @@
  * limitations under the License.
  */
 #include "velox/serializers/PrestoSerializer.h"
+
+#include <folly/container/F14Map.h>
+#include <folly/io/Cursor.h>
+
 #include "velox/common/base/Crc.h"
 #include "velox/common/base/RawVector.h"
 #include "velox/common/memory/ByteStream.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
 #include "velox/vector/DictionaryVector.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
@@ -29,6 +34,14 @@ namespace {
 constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
+// Velox specific. Set together with kCompressedBitMask if the columns of the
+// page are compressed separately.
+constexpr int8_t kColumnarCompressionBitMask = 8;
+// Columns of fewer bytes are not compressed with columnar compression.
+constexpr int32_t kMinColumnCompressionSize = 256;
+// Number of leading bytes of a column that are compressed to decide whether
+// to compress the column with columnar compression.
+constexpr int32_t kColumnCompressionSampleSize = 4 << 10;
 static inline const std::string_view kRLE{"RLE"};
 static inline const std::string_view kDictionary{"DICTIONARY"};
 
@@ -91,6 +104,10 @@ bool isCompressedBitSet(int8_t codec) {
   return (codec & kCompressedBitMask) == kCompressedBitMask;
 }
 
+bool isColumnarCompressionBitSet(int8_t codec) {
+  return (codec & kColumnarCompressionBitMask) == kColumnarCompressionBitMask;
+}
+
 bool isEncryptedBit(int8_t codec) {
   return (codec & kEncryptedBitMask) == kEncryptedBitMask;
 }
@@ -1041,6 +1058,70 @@ void readColumns(
   }
 }
 
+// Reads the columns of a page written with columnar compression. Reads the
+// uncompressed columns directly from 'source' and decompresses the others one
+// at a time.
+void readCompressedColumns(
+    ByteInputStream* source,
+    folly::io::Codec& codec,
+    velox::memory::MemoryPool* pool,
+    const std::vector<TypePtr>& types,
+    std::vector<VectorPtr>& results,
+    vector_size_t resultOffset,
+    bool useLosslessTimestamp) {
+  const auto numColumns = source->read<int32_t>();
+  VELOX_USER_CHECK_EQ(
+      numColumns,
+      types.size(),
+      "Number of columns in serialized data doesn't match "
+      "number of columns requested for deserialization");
+
+  std::vector<TypePtr> columnType(1);
+  std::vector<VectorPtr> columnResult(1);
+  for (int32_t i = 0; i < numColumns; ++i) {
+    const auto uncompressedSize = source->read<int32_t>();
+    const auto compressedSize = source->read<int32_t>();
+    columnType[0] = types[i];
+    columnResult[0] = std::move(results[i]);
+    if (compressedSize == 0) {
+      readColumns(
+          source,
+          pool,
+          columnType,
+          columnResult,
+          resultOffset,
+          useLosslessTimestamp);
+    } else {
+      // Decompresses from the page without a copy if the compressed column
+      // is contiguous.
+      std::unique_ptr<folly::IOBuf> compressed;
+      const auto view = source->nextView(compressedSize);
+      if (view.size() == compressedSize) {
+        compressed = folly::IOBuf::wrapBuffer(view.data(), view.size());
+      } else {
+        compressed = folly::IOBuf::create(compressedSize);
+        memcpy(compressed->writableData(), view.data(), view.size());
+        source->readBytes(
+            compressed->writableData() + view.size(),
+            compressedSize - view.size());
+        compressed->append(compressedSize);
+      }
+      auto uncompressed = codec.uncompress(compressed.get(), uncompressedSize);
+      ByteRange byteRange{
+          uncompressed->writableData(), (int32_t)uncompressed->length(), 0};
+      ByteInputStream columnSource({byteRange});
+      readColumns(
+          &columnSource,
+          pool,
+          columnType,
+          columnResult,
+          resultOffset,
+          useLosslessTimestamp);
+    }
+    results[i] = std::move(columnResult[0]);
+  }
+}
+
 void writeInt32(OutputStream* out, int32_t value) {
   out->write(reinterpret_cast<char*>(&value), sizeof(value));
 }
@@ -1077,6 +1158,28 @@ class CountingOutputStream : public OutputStream {
   std::streampos pos_{0};
 };
 
+// State of a DICTIONARY VectorStream that collects the distinct values of
+// the rows appended to a page. See PrestoOptions::preserveEncodings.
+struct PageDictionary {
+  // Position in the page dictionary of each distinct non-null value, keyed on
+  // the bytes of the value.
+  folly::F14FastMap<std::string, int32_t> positions;
+  // Position of null in the page dictionary or -1 if there is no null.
+  int32_t nullPosition{-1};
+  // Number of values in the page dictionary.
+  int32_t size{0};
+  // The last appended vector. Holds its base vector live so that the address
+  // of 'lastBase' cannot be reused for a different vector.
+  VectorPtr lastVector;
+  const BaseVector* lastBase{nullptr};
+  // Page dictionary position of the rows of 'lastBase' that have been
+  // appended. Avoids hashing the same value more than once per vector.
+  folly::F14FastMap<vector_size_t, int32_t> basePositions;
+  // Reusable decoding state.
+  SelectivityVector rows;
+  DecodedVector decoded;
+};
+
 // Appendable container for serialized values. To append a value at a
 // time, call appendNull or appendNonNull first. Then call
 // appendLength if the type has a length. A null value has a length of
@@ -1212,6 +1315,20 @@ class VectorStream {
     return children_[index].get();
   }
 
+  // Makes a DICTIONARY stream collect the distinct values of the page in its
+  // dictionary instead of taking the dictionary of an encoded vector.
+  void enablePageDictionary() {
+    VELOX_CHECK(encoding_ == VectorEncoding::Simple::DICTIONARY);
+    VELOX_CHECK_EQ(0, nonNullCount_);
+    pageDictionary_ = std::make_unique<PageDictionary>();
+  }
+
+  // Returns the page dictionary state or nullptr if this stream does not
+  // collect a page dictionary.
+  PageDictionary* pageDictionary() const {
+    return pageDictionary_.get();
+  }
+
   // Returns the size to flush to OutputStream before calling `flush`.
   size_t serializedSize() {
     CountingOutputStream out;
@@ -1221,6 +1338,16 @@ class VectorStream {
 
   // Writes out the accumulated contents. Does not change the state.
   void flush(OutputStream* out) {
+    if (pageDictionary_ != nullptr && pageDictionary_->size == 1) {
+      // All rows have the same value. The page dictionary is the value of
+      // an RLE column.
+      writeInt32(out, kRLE.size());
+      out->write(kRLE.data(), kRLE.size());
+      writeInt32(out, nonNullCount_);
+      children_[0]->flush(out);
+      return;
+    }
+
     out->write(reinterpret_cast<char*>(header_.buffer), header_.size);
 
     if (encoding_.has_value()) {
@@ -1326,6 +1453,7 @@ class VectorStream {
   ByteStream lengths_;
   ByteStream values_;
   std::vector<std::unique_ptr<VectorStream>> children_;
+  std::unique_ptr<PageDictionary> pageDictionary_;
 };
 
 template <>
@@ -1771,6 +1899,83 @@ void serializeEncodedColumn(
   }
 }
 
+template <typename T>
+std::string pageDictionaryKey(const T& value) {
+  return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <>
+std::string pageDictionaryKey(const StringView& value) {
+  return std::string(value.data(), value.size());
+}
+
+// Appends the rows of 'vector' in 'ranges' to the DICTIONARY 'stream' as
+// positions in the page dictionary. Adds the values not yet in the page
+// dictionary to the dictionary child stream. 'vector' may have any encoding.
+template <TypeKind Kind>
+void serializeToPageDictionary(
+    const VectorPtr& vector,
+    const folly::Range<const IndexRange*>& ranges,
+    VectorStream* stream) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto& dictionary = *stream->pageDictionary();
+  auto& rows = dictionary.rows;
+  rows.resize(vector->size());
+  rows.clearAll();
+  for (const auto& range : ranges) {
+    rows.setValidRange(range.begin, range.begin + range.size, true);
+  }
+  rows.updateBounds();
+  auto& decoded = dictionary.decoded;
+  decoded.decode(*vector, rows);
+  if (decoded.base() != dictionary.lastBase) {
+    dictionary.lastVector = vector;
+    dictionary.lastBase = decoded.base();
+    dictionary.basePositions.clear();
+  }
+
+  auto* values = stream->childAt(0);
+  for (const auto& range : ranges) {
+    stream->appendNonNull(range.size);
+    const auto end = range.begin + range.size;
+    for (auto row = range.begin; row < end; ++row) {
+      if (decoded.isNullAt(row)) {
+        if (dictionary.nullPosition < 0) {
+          dictionary.nullPosition = dictionary.size++;
+          values->appendNull();
+        }
+        stream->appendOne<int32_t>(dictionary.nullPosition);
+        continue;
+      }
+      auto [it, isNewRow] =
+          dictionary.basePositions.emplace(decoded.index(row), 0);
+      if (isNewRow) {
+        const auto value = decoded.valueAt<T>(row);
+        auto [position, isNewValue] = dictionary.positions.emplace(
+            pageDictionaryKey(value), dictionary.size);
+        if (isNewValue) {
+          ++dictionary.size;
+          values->appendNonNull();
+          values->appendOne(value);
+        }
+        it->second = position->second;
+      }
+      stream->appendOne<int32_t>(it->second);
+    }
+  }
+}
+
+// Returns true if the column of 'type' whose first appended vector is
+// 'vector' is serialized with a page dictionary when preserving encodings.
+bool usePageDictionary(const TypePtr& type, const BaseVector& vector) {
+  if (!type->isPrimitiveType() || type->kind() == TypeKind::UNKNOWN) {
+    return false;
+  }
+  const auto encoding = vector.encoding();
+  return encoding == VectorEncoding::Simple::DICTIONARY ||
+      encoding == VectorEncoding::Simple::CONSTANT;
+}
+
 void expandRepeatedRanges(
     const BaseVector* vector,
     const vector_size_t* rawOffsets,
@@ -2043,9 +2248,17 @@ class PrestoVectorSerializer : public VectorSerializer {
       int32_t numRows,
       StreamArena* streamArena,
       bool useLosslessTimestamp,
-      common::CompressionKind compressionKind)
+      common::CompressionKind compressionKind,
+      bool preserveEncodings = false,
+      bool columnarCompression = false,
+      float maxColumnCompressionRatio = 0.8)
       : streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(compressionKind)) {
+        codec_(common::compressionKindToCodec(compressionKind)),
+        useLosslessTimestamp_(useLosslessTimestamp),
+        preserveEncodings_(preserveEncodings && encodings.empty()),
+        columnarCompression_(columnarCompression),
+        maxColumnCompressionRatio_(maxColumnCompressionRatio),
+        initialNumRows_(numRows) {
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -2054,8 +2267,14 @@ class PrestoVectorSerializer : public VectorSerializer {
       if (!encodings.empty()) {
         encoding = encodings[i];
       }
+      // With 'preserveEncodings_' the streams are made for the encodings of
+      // the first appended vector. Until then they are empty.
       streams_[i] = std::make_unique<VectorStream>(
-          types[i], encoding, streamArena, numRows, useLosslessTimestamp);
+          types[i],
+          encoding,
+          streamArena,
+          preserveEncodings_ ? 0 : numRows,
+          useLosslessTimestamp);
     }
   }
 
@@ -2064,9 +2283,22 @@ class PrestoVectorSerializer : public VectorSerializer {
       const folly::Range<const IndexRange*>& ranges) override {
     auto newRows = rangesTotalSize(ranges);
     if (newRows > 0) {
+      if (preserveEncodings_ && numRows_ == 0) {
+        initializeEncodedStreams(*vector);
+      }
       numRows_ += newRows;
       for (int32_t i = 0; i < vector->childrenSize(); ++i) {
-        serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
+        auto* stream = streams_[i].get();
+        if (stream->pageDictionary() != nullptr) {
+          VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+              serializeToPageDictionary,
+              vector->childAt(i)->typeKind(),
+              vector->childAt(i),
+              ranges,
+              stream);
+        } else {
+          serializeColumn(vector->childAt(i).get(), ranges, stream);
+        }
       }
     }
   }
@@ -2074,6 +2306,9 @@ class PrestoVectorSerializer : public VectorSerializer {
   void appendEncoded(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) {
+    VELOX_CHECK(
+        !preserveEncodings_,
+        "Encoded serialization does not support preserveEncodings");
     auto newRows = rangesTotalSize(ranges);
     if (newRows > 0) {
       numRows_ += newRows;
@@ -2085,6 +2320,17 @@ class PrestoVectorSerializer : public VectorSerializer {
   }
 
   size_t maxSerializedSize() const override {
+    if (needCompression(*codec_) && columnarCompression_) {
+      size_t dataSize = 4; // streams_.size()
+      for (auto& stream : streams_) {
+        const auto columnSize = stream->serializedSize();
+        const auto maxCompressedSize = codec_->maxCompressedLength(columnSize);
+        // Uncompressed and compressed sizes, then the column.
+        dataSize += 8 + std::max<size_t>(columnSize, maxCompressedSize);
+      }
+      return kHeaderSize + dataSize;
+    }
+
     size_t dataSize = 4; // streams_.size()
     for (auto& stream : streams_) {
       dataSize += stream->serializedSize();
@@ -2113,6 +2359,30 @@ class PrestoVectorSerializer : public VectorSerializer {
   }
 
  private:
+  // Makes the streams for the first vector appended with
+  // 'preserveEncodings_'. Dictionary and constant encoded scalar columns get
+  // a DICTIONARY stream with a page dictionary, the others a flat stream.
+  void initializeEncodedStreams(const RowVector& vector) {
+    const auto numRows = std::max(1, initialNumRows_);
+    for (int32_t i = 0; i < streams_.size(); ++i) {
+      const auto& child = vector.childAt(i);
+      std::optional<VectorEncoding::Simple> encoding = std::nullopt;
+      const bool pageDictionary = usePageDictionary(child->type(), *child);
+      if (pageDictionary) {
+        encoding = VectorEncoding::Simple::DICTIONARY;
+      }
+      streams_[i] = std::make_unique<VectorStream>(
+          child->type(),
+          encoding,
+          streamArena_,
+          numRows,
+          useLosslessTimestamp_);
+      if (pageDictionary) {
+        streams_[i]->enablePageDictionary();
+      }
+    }
+  }
+
   void flushUncompressed(
       int32_t numRows,
       OutputStream* out,
@@ -2226,6 +2496,118 @@ class PrestoVectorSerializer : public VectorSerializer {
     output->seekp(endSize);
   }
 
+  // Like flushCompressed() but compresses each column separately. The data
+  // is the number of columns followed by the uncompressed size, the
+  // compressed size and the bytes of each column. A compressed size of 0
+  // means that the column is not compressed. The uncompressed size in the
+  // header is the size of the uncompressed data.
+  void flushColumnarCompressed(
+      int32_t numRows,
+      OutputStream* output,
+      PrestoOutputStreamListener* listener) {
+    const int32_t offset = output->tellp();
+    char codec = kCompressedBitMask | kColumnarCompressionBitMask;
+    if (listener) {
+      codec |= kCheckSumBitMask;
+    }
+
+    // Pause CRC computation
+    if (listener) {
+      listener->pause();
+    }
+
+    writeInt32(output, numRows);
+    output->write(&codec, 1);
+
+    // Make space for uncompressedSizeInBytes & sizeInBytes
+    writeInt32(output, 0);
+    writeInt32(output, 0);
+    // Write zero checksum.
+    writeInt64(output, 0);
+
+    // Number of columns and stream content. Unpause CRC.
+    if (listener) {
+      listener->resume();
+    }
+    writeInt32(output, streams_.size());
+
+    int32_t uncompressedSize = sizeof(int32_t);
+    for (auto& stream : streams_) {
+      IOBufOutputStream out(
+          *(streamArena_->pool()), nullptr, stream->serializedSize());
+      stream->flush(&out);
+      const int32_t columnSize = out.tellp();
+      VELOX_CHECK_LE(
+          columnSize,
+          codec_->maxUncompressedLength(),
+          "UncompressedSize exceeds limit");
+      uncompressedSize += columnSize;
+      auto column = out.getIOBuf();
+      auto compressed = compressColumn(*column, columnSize);
+      writeInt32(output, columnSize);
+      if (compressed == nullptr) {
+        writeInt32(output, 0);
+        writeIOBuf(*column, output);
+      } else {
+        writeInt32(output, compressed->computeChainDataLength());
+        writeIOBuf(*compressed, output);
+      }
+    }
+
+    // Pause CRC computation
+    if (listener) {
+      listener->pause();
+    }
+
+    // Fill in uncompressedSizeInBytes & sizeInBytes
+    const int32_t size = (int32_t)output->tellp() - offset;
+    const int32_t compressedSize = size - kHeaderSize;
+    int64_t crc = 0;
+    if (listener) {
+      crc = computeChecksum(listener, codec, numRows, compressedSize);
+    }
+
+    output->seekp(offset + kSizeInBytesOffset);
+    writeInt32(output, uncompressedSize);
+    writeInt32(output, compressedSize);
+    writeInt64(output, crc);
+    output->seekp(offset + size);
+  }
+
+  // Returns 'column' of 'size' bytes compressed or nullptr if it does not
+  // compress to at most 'maxColumnCompressionRatio_' of its size. A large
+  // column is compressed only if a sample of its first bytes compresses well
+  // enough, so that incompressible data is not compressed in full.
+  std::unique_ptr<folly::IOBuf> compressColumn(
+      const folly::IOBuf& column,
+      int32_t size) {
+    if (size < kMinColumnCompressionSize) {
+      return nullptr;
+    }
+    if (size > 2 * kColumnCompressionSampleSize) {
+      folly::io::Cursor cursor(&column);
+      std::unique_ptr<folly::IOBuf> sample;
+      cursor.clone(sample, kColumnCompressionSampleSize);
+      const auto compressedSample = codec_->compress(sample.get());
+      if (compressedSample->computeChainDataLength() >
+          kColumnCompressionSampleSize * maxColumnCompressionRatio_) {
+        return nullptr;
+      }
+    }
+    auto compressed = codec_->compress(&column);
+    if (compressed->computeChainDataLength() >
+        size * maxColumnCompressionRatio_) {
+      return nullptr;
+    }
+    return compressed;
+  }
+
+  static void writeIOBuf(const folly::IOBuf& iobuf, OutputStream* out) {
+    for (const auto& range : iobuf) {
+      out->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+  }
+
   // Writes the contents to 'stream' in wire format
   void flushInternal(int32_t numRows, OutputStream* out) {
     auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
@@ -2236,6 +2618,8 @@ class PrestoVectorSerializer : public VectorSerializer {
 
     if (!needCompression(*codec_)) {
       flushUncompressed(numRows, out, listener);
+    } else if (columnarCompression_) {
+      flushColumnarCompressed(numRows, out, listener);
     } else {
       flushCompressed(numRows, out, listener);
     }
@@ -2246,6 +2630,12 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  const bool useLosslessTimestamp_;
+  const bool preserveEncodings_;
+  const bool columnarCompression_;
+  const float maxColumnCompressionRatio_;
+  // Number of rows to size the streams for.
+  const int32_t initialNumRows_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
 };
@@ -2270,7 +2660,10 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
       numRows,
       streamArena,
       prestoOptions.useLosslessTimestamp,
-      prestoOptions.compressionKind);
+      prestoOptions.compressionKind,
+      prestoOptions.preserveEncodings,
+      prestoOptions.columnarCompression,
+      prestoOptions.maxColumnCompressionRatio);
 }
 
 void PrestoVectorSerde::serializeEncoded(
@@ -2347,6 +2740,15 @@ void PrestoVectorSerde::deserialize(
         "number of columns requested for deserialization");
     readColumns(
         source, pool, childTypes, children, resultOffset, useLosslessTimestamp);
+  } else if (isColumnarCompressionBitSet(pageCodecMarker)) {
+    readCompressedColumns(
+        source,
+        *codec,
+        pool,
+        childTypes,
+        children,
+        resultOffset,
+        useLosslessTimestamp);
   } else {
     auto compressBuf = folly::IOBuf::create(compressedSize);
     source->readBytes(compressBuf->writableData(), compressedSize);
@@ -41,6 +41,19 @@ class PrestoVectorSerde : public VectorSerde {
     common::CompressionKind compressionKind{
         common::CompressionKind::CompressionKind_NONE};
     std::vector<VectorEncoding::Simple> encodings;
+    // If true, scalar columns that are dictionary or constant encoded in the
+    // first vector appended to a serializer are serialized as DICTIONARY,
+    // keeping the indices of the rows and a dictionary of the distinct values
+    // of the page instead of flattening them. The column is RLE if the page
+    // has a single distinct value. Only applies if 'encodings' is empty.
+    bool preserveEncodings{false};
+    // If true and 'compressionKind' is not NONE, each column of a page is
+    // compressed separately and the deserializer decompresses one column at a
+    // time. A column is sent uncompressed if a sample of it does not compress
+    // to at most 'maxColumnCompressionRatio' of its size. Pages compressed
+    // this way are readable only by Velox.
+    bool columnarCompression{false};
+    float maxColumnCompressionRatio{0.8};
   };
 
   void estimateSerializedSize(
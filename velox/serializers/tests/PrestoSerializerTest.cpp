@@ -15,6 +15,7 @@
  */
 #include "velox/serializers/PrestoSerializer.h"
 #include <folly/Random.h>
+#include <folly/hash/Hash.h>
 #include <gtest/gtest.h>
 #include <vector>
 #include "velox/common/base/tests/GTestUtils.h"
@@ -62,6 +63,10 @@ class PrestoSerializerTest
     common::CompressionKind kind = GetParam();
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind};
+    paramOptions.preserveEncodings =
+        serdeOptions != nullptr && serdeOptions->preserveEncodings;
+    paramOptions.columnarCompression =
+        serdeOptions != nullptr && serdeOptions->columnarCompression;
     return paramOptions;
   }
 
@@ -436,6 +441,154 @@ TEST_P(PrestoSerializerTest, encodings) {
   testEncodedRoundTrip(data);
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodings) {
+  // Two batches whose dictionaries have different bases with overlapping
+  // values.
+  auto baseArray = makeArrayVector<int32_t>({{1, 2}, {3}});
+  auto makeBatch = [&](const VectorPtr& strings, BufferPtr nulls) {
+    constexpr vector_size_t kSize = 100;
+    auto indices =
+        makeIndices(kSize, [&](auto row) { return row % strings->size(); });
+    auto arrayIndices = makeIndices(kSize, [](auto row) { return row % 2; });
+    return makeRowVector({
+        BaseVector::wrapInDictionary(nulls, indices, kSize, strings),
+        BaseVector::createConstant(INTEGER(), 7, kSize, pool_.get()),
+        makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+        BaseVector::wrapInDictionary(nullptr, arrayIndices, kSize, baseArray),
+    });
+  };
+  auto first = makeBatch(
+      makeFlatVector<std::string>({"apple", "banana", "cherry", "apple"}),
+      makeNulls(100, [](auto row) { return row % 10 == 0; }));
+  auto second = makeBatch(
+      makeFlatVector<std::string>({"cherry", "date", "apple"}), nullptr);
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.preserveEncodings = true;
+  auto serializeBatches = [&](bool preserveEncodings) {
+    auto paramOptions = getParamSerdeOptions(&options);
+    paramOptions.preserveEncodings = preserveEncodings;
+    StreamArena arena(pool_.get());
+    auto serializer = serde_->createSerializer(
+        asRowType(first->type()), 190, &arena, &paramOptions);
+    std::vector<IndexRange> firstRanges{{0, 50}, {60, 40}};
+    serializer->append(
+        first, folly::Range(firstRanges.data(), firstRanges.size()));
+    std::vector<IndexRange> secondRanges{{0, 100}};
+    serializer->append(
+        second, folly::Range(secondRanges.data(), secondRanges.size()));
+    std::ostringstream output;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+    return output.str();
+  };
+  const auto serialized = serializeBatches(true);
+
+  auto expected = BaseVector::create<RowVector>(first->type(), 190, pool());
+  expected->copy(first.get(), 0, 0, 50);
+  expected->copy(first.get(), 50, 60, 40);
+  expected->copy(second.get(), 90, 0, 100);
+
+  auto deserialized =
+      deserialize(asRowType(first->type()), serialized, &options);
+  assertEqualVectors(expected, deserialized);
+
+  // The strings are a dictionary of the 4 distinct values and null.
+  auto strings = deserialized->childAt(0);
+  ASSERT_EQ(strings->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(strings->valueVector()->size(), 5);
+  ASSERT_EQ(
+      deserialized->childAt(1)->encoding(), VectorEncoding::Simple::CONSTANT);
+  ASSERT_EQ(deserialized->childAt(2)->encoding(), VectorEncoding::Simple::FLAT);
+  // Complex types are flattened.
+  ASSERT_EQ(
+      deserialized->childAt(3)->encoding(), VectorEncoding::Simple::ARRAY);
+
+  ASSERT_LT(serialized.size(), serializeBatches(false).size());
+}
+
+TEST_P(PrestoSerializerTest, columnarCompression) {
+  constexpr vector_size_t kSize = 10'000;
+  // Compressible, incompressible and constant columns.
+  auto data = makeRowVector({
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) { return fmt::format("repeated string {}", row % 10); }),
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (int64_t)folly::hash::twang_mix64(row); }),
+      makeConstant<int32_t>(1, kSize),
+  });
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.columnarCompression = true;
+  std::ostringstream out;
+  serialize(data, &out, &options);
+  auto deserialized = deserialize(asRowType(data->type()), out.str(), &options);
+  assertEqualVectors(data, deserialized);
+
+  // The page header is numRows(4) | codec(1) | uncompressedSize(4) |
+  // compressedSize(4) | checksum(8). With columnar compression, the data is
+  // the number of columns followed by the uncompressed size, the compressed
+  // size and the bytes of each column.
+  constexpr int32_t kCodecOffset = 4;
+  constexpr int32_t kHeaderSize = 21;
+  constexpr char kCompressedBitMask = 1;
+  constexpr char kColumnarCompressionBitMask = 8;
+  const auto page = out.str();
+  const auto readInt32 = [&](size_t offset) {
+    int32_t value;
+    memcpy(&value, page.data() + offset, sizeof(value));
+    return value;
+  };
+  const auto codec = page[kCodecOffset];
+  if (GetParam() == common::CompressionKind_NONE) {
+    // Without a codec, the page is written uncompressed as usual.
+    EXPECT_EQ(0, codec & (kCompressedBitMask | kColumnarCompressionBitMask));
+    EXPECT_EQ(readInt32(kCodecOffset + 1), readInt32(kCodecOffset + 5));
+  } else {
+    ASSERT_EQ(
+        kCompressedBitMask | kColumnarCompressionBitMask,
+        codec & (kCompressedBitMask | kColumnarCompressionBitMask));
+    ASSERT_EQ(3, readInt32(kHeaderSize));
+    std::vector<int32_t> compressedSizes;
+    size_t offset = kHeaderSize + sizeof(int32_t);
+    for (auto i = 0; i < 3; ++i) {
+      const auto uncompressedSize = readInt32(offset);
+      const auto compressedSize = readInt32(offset + sizeof(int32_t));
+      compressedSizes.push_back(compressedSize);
+      offset += 2 * sizeof(int32_t) +
+          (compressedSize == 0 ? uncompressedSize : compressedSize);
+    }
+    EXPECT_EQ(page.size(), offset);
+    // The repeated strings and the flattened constant are compressed. The
+    // random integers do not compress and take the uncompressed path.
+    EXPECT_LT(0, compressedSizes[0]);
+    EXPECT_EQ(0, compressedSizes[1]);
+    EXPECT_LT(0, compressedSizes[2]);
+  }
+
+  // Pages that are appended to one vector.
+  auto paramOptions = getParamSerdeOptions(&options);
+  std::ostringstream pages;
+  for (const auto& split : split(data, 3)) {
+    serialize(split, &pages, &options);
+  }
+  auto byteStream = toByteStream(pages.str());
+  RowVectorPtr result;
+  while (!byteStream.atEnd()) {
+    serde_->deserialize(
+        &byteStream,
+        pool_.get(),
+        asRowType(data->type()),
+        &result,
+        result == nullptr ? 0 : result->size(),
+        &paramOptions);
+  }
+  assertEqualVectors(data, result);
+}
+
 TEST_P(PrestoSerializerTest, scatterEncoded) {
   // Makes a struct with nulls and constant/dictionary encoded children. The
   // children need to get gaps where the parent struct has a null.
@@ -20,6 +20,8 @@
 #include <set>
 #include <string>
 
+#include <folly/String.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/type/Filter.h"
 
@@ -94,6 +96,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBigintValuesUsingBloomFilter:
+      strKind = "BigintValuesUsingBloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +136,8 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBigintValuesUsingBloomFilter,
+       "kBigintValuesUsingBloomFilter"},
   };
 }
 
@@ -190,6 +197,8 @@ void Filter::registerSerDe() {
       NegatedBigintValuesUsingBitmask::create);
   registry.Register(
       "HugeintValuesUsingHashTable", HugeintValuesUsingHashTable::create);
+  registry.Register(
+      "BigintValuesUsingBloomFilter", BigintValuesUsingBloomFilter::create);
   registry.Register("FloatRange", AbstractRange::create);
   registry.Register("DoubleRange", AbstractRange::create);
   registry.Register("BytesRange", BytesRange::create);
@@ -489,6 +498,51 @@ bool NegatedBigintValuesUsingBitmask::testingEquals(const Filter& other) const {
       nonNegated_->testingEquals(*(otherNegatedBigintValues->nonNegated_));
 }
 
+folly::dynamic BigintValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("BigintValuesUsingBloomFilter");
+  obj["min"] = min_;
+  obj["max"] = max_;
+  obj["maxPassRate"] = maxPassRate_;
+  std::string bloomFilter(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bloomFilter.data());
+  obj["bloomFilter"] = folly::hexlify(bloomFilter);
+  return obj;
+}
+
+FilterPtr BigintValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto min = obj["min"].asInt();
+  auto max = obj["max"].asInt();
+  auto maxPassRate = obj["maxPassRate"].asDouble();
+  std::string serialized;
+  VELOX_CHECK(
+      folly::unhexlify(obj["bloomFilter"].asString(), serialized),
+      "Malformed serialized Bloom filter");
+  auto bloomFilter = std::make_shared<BloomFilterType>();
+  bloomFilter->merge(serialized.data());
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      min, max, std::move(bloomFilter), maxPassRate, nullAllowed);
+}
+
+bool BigintValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloomFilter =
+      dynamic_cast<const BigintValuesUsingBloomFilter*>(&other);
+  if (otherBloomFilter == nullptr || !Filter::testingBaseEquals(other) ||
+      min_ != otherBloomFilter->min_ || max_ != otherBloomFilter->max_ ||
+      maxPassRate_ != otherBloomFilter->maxPassRate_) {
+    return false;
+  }
+  const auto size = bloomFilter_->serializedSize();
+  if (size != otherBloomFilter->bloomFilter_->serializedSize()) {
+    return false;
+  }
+  std::string bits(size, '\0');
+  std::string otherBits(size, '\0');
+  bloomFilter_->serialize(bits.data());
+  otherBloomFilter->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 template <>
 folly::dynamic FloatingPointRange<float>::serialize() const {
   auto obj = AbstractRange::serializeBase("FloatRange");
@@ -807,6 +861,49 @@ bool BigintValuesUsingBitmask::testInt64Range(
   return !(min > max_ || max < min_);
 }
 
+BigintValuesUsingBloomFilter::BigintValuesUsingBloomFilter(
+    int64_t min,
+    int64_t max,
+    std::shared_ptr<const BloomFilterType> bloomFilter,
+    double maxPassRate,
+    bool nullAllowed)
+    : Filter(true, nullAllowed, FilterKind::kBigintValuesUsingBloomFilter),
+      min_(min),
+      max_(max),
+      bloomFilter_(std::move(bloomFilter)),
+      maxPassRate_(maxPassRate) {
+  VELOX_CHECK_LE(min_, max_);
+  VELOX_CHECK_NOT_NULL(bloomFilter_);
+  VELOX_CHECK(bloomFilter_->isSet(), "Bloom filter must be initialized");
+}
+
+bool BigintValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (min > max_ || max < min_) {
+    return false;
+  }
+
+  if (min == max) {
+    return bloomFilter_->mayContain(hash(min));
+  }
+
+  return true;
+}
+
+void BigintValuesUsingBloomFilter::updatePassRate() const {
+  if (numPassed_ > maxPassRate_ * numTested_) {
+    disabled_ = true;
+  }
+  numTested_ = 0;
+  numPassed_ = 0;
+}
+
 BigintValuesUsingHashTable::BigintValuesUsingHashTable(
     int64_t min,
     int64_t max,
@@ -1820,6 +1917,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintRange>(lower_, upper_, false);
@@ -1914,6 +2012,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2007,6 +2106,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingHashTable>(*this, false);
@@ -2098,6 +2198,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2181,6 +2282,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
@@ -2220,6 +2322,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
@@ -2250,11 +2353,75 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
   }
 }
 
+std::unique_ptr<Filter> BigintValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return clone(false);
+    case FilterKind::kBigintRange:
+    case FilterKind::kBigintValuesUsingBloomFilter: {
+      // Keeps the Bloom filter of 'this' with the intersection of the ranges.
+      const bool bothNullAllowed = nullAllowed_ && other->testNull();
+      int64_t min;
+      int64_t max;
+      if (other->kind() == FilterKind::kBigintRange) {
+        auto otherRange = static_cast<const BigintRange*>(other);
+        min = std::max(min_, otherRange->lower());
+        max = std::min(max_, otherRange->upper());
+      } else {
+        auto otherBloomFilter =
+            static_cast<const BigintValuesUsingBloomFilter*>(other);
+        min = std::max(min_, otherBloomFilter->min());
+        max = std::min(max_, otherBloomFilter->max());
+      }
+      if (min > max) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<BigintValuesUsingBloomFilter>(
+          min, max, bloomFilter_, maxPassRate_, bothNullAllowed);
+    }
+    case FilterKind::kBigintValuesUsingHashTable:
+    case FilterKind::kBigintValuesUsingBitmask: {
+      // The values of 'other' that may pass 'this'.
+      const auto values = other->kind() ==
+              FilterKind::kBigintValuesUsingHashTable
+          ? static_cast<const BigintValuesUsingHashTable*>(other)->values()
+          : static_cast<const BigintValuesUsingBitmask*>(other)->values();
+      std::vector<int64_t> valuesToKeep;
+      for (auto value : values) {
+        if (value >= min_ && value <= max_ &&
+            bloomFilter_->mayContain(hash(value))) {
+          valuesToKeep.push_back(value);
+        }
+      }
+      return createBigintValues(
+          valuesToKeep, nullAllowed_ && other->testNull());
+    }
+    case FilterKind::kNegatedBigintRange:
+    case FilterKind::kNegatedBigintValuesUsingHashTable:
+    case FilterKind::kNegatedBigintValuesUsingBitmask:
+    case FilterKind::kBigintMultiRange: {
+      // There is no filter for the conjunction of a Bloom filter and these.
+      // The Bloom filter is dropped and only its range is kept. This passes a
+      // superset of the values, which is allowed for a Bloom filter.
+      BigintRange range(min_, max_, nullAllowed_);
+      return other->mergeWith(&range);
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
   switch (other->kind()) {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBigintValuesUsingBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull: {
       std::vector<std::unique_ptr<BigintRange>> ranges;
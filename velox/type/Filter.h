@@ -18,13 +18,16 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <memory_resource>
 #include <sstream>
 #include <string>
 #include <vector>
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +59,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBigintValuesUsingBloomFilter,
 };
 
 class Filter;
@@ -1212,6 +1216,124 @@ class NegatedBigintValuesUsingBitmask final : public Filter {
   std::unique_ptr<BigintValuesUsingBitmask> nonNegated_;
 };
 
+/// Filter for integral data types that passes a superset of a large set of
+/// values, e.g. the keys of a hash join build side. Values outside of [min,
+/// max] fail. Other values pass if they may be in a Bloom filter, so there may
+/// be false positives and the filter must not be used where an exact result is
+/// needed. The filter turns off its Bloom filter test if more than
+/// 'maxPassRate' of the values tested in a window of kPassRateWindow values
+/// pass, since then the test costs more than it saves. The pass rate is
+/// tracked in the filter, so an instance must not be used from multiple
+/// threads at the same time. clone() makes an instance with a fresh pass
+/// rate.
+class BigintValuesUsingBloomFilter final : public Filter {
+ public:
+  /// Number of values tested before the pass rate is checked.
+  static constexpr int32_t kPassRateWindow = 10'000;
+
+  /// The polymorphic allocator lets the maker of the filter choose where the
+  /// bits are allocated, e.g. from a memory pool.
+  using BloomFilterType =
+      BloomFilter<std::pmr::polymorphic_allocator<uint64_t>>;
+
+  /// @param min Minimum value.
+  /// @param max Maximum value.
+  /// @param bloomFilter Bloom filter of the hashes of the values that pass,
+  /// as returned by hash().
+  /// @param maxPassRate The Bloom filter test is turned off if more than this
+  /// fraction of values pass.
+  /// @param nullAllowed Null values are passing the filter if true.
+  BigintValuesUsingBloomFilter(
+      int64_t min,
+      int64_t max,
+      std::shared_ptr<const BloomFilterType> bloomFilter,
+      double maxPassRate,
+      bool nullAllowed);
+
+  BigintValuesUsingBloomFilter(
+      const BigintValuesUsingBloomFilter& other,
+      bool nullAllowed)
+      : BigintValuesUsingBloomFilter(
+            other.min_,
+            other.max_,
+            other.bloomFilter_,
+            other.maxPassRate_,
+            nullAllowed) {}
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<BigintValuesUsingBloomFilter>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  /// Returns the hash of 'value' that is inserted into the Bloom filter.
+  static uint64_t hash(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  bool testInt64(int64_t value) const final {
+    if (value < min_ || value > max_) {
+      return false;
+    }
+    if (disabled_) {
+      return true;
+    }
+    const bool passed = bloomFilter_->mayContain(hash(value));
+    numPassed_ += passed;
+    if (++numTested_ == kPassRateWindow) {
+      updatePassRate();
+    }
+    return passed;
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  int64_t min() const {
+    return min_;
+  }
+
+  int64_t max() const {
+    return max_;
+  }
+
+  /// Returns true if the Bloom filter test has been turned off because of a
+  /// high pass rate.
+  bool isDisabled() const {
+    return disabled_;
+  }
+
+  std::string toString() const final {
+    return fmt::format(
+        "BigintValuesUsingBloomFilter: [{}, {}] {}{}",
+        min_,
+        max_,
+        nullAllowed_ ? "with nulls" : "no nulls",
+        disabled_ ? " disabled" : "");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  // Turns off the Bloom filter test if too many values of the last window
+  // passed and starts a new window.
+  void updatePassRate() const;
+
+  const int64_t min_;
+  const int64_t max_;
+  const std::shared_ptr<const BloomFilterType> bloomFilter_;
+  const double maxPassRate_;
+
+  mutable int32_t numTested_{0};
+  mutable int32_t numPassed_{0};
+  mutable bool disabled_{false};
+};
+
 /// Base class for range filters on floating point and string data types.
 class AbstractRange : public Filter {
  public:
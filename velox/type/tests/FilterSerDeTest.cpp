@@ -110,6 +110,19 @@ TEST_F(FilterSerDeTest, valuesFilters) {
   }
 }
 
+TEST_F(FilterSerDeTest, bloomFilter) {
+  auto bloomFilter =
+      std::make_shared<BigintValuesUsingBloomFilter::BloomFilterType>();
+  bloomFilter->reset(100);
+  for (auto i = 0; i < 100; ++i) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(i * 7));
+  }
+  for (auto nullAllowed : {false, true}) {
+    testSerde(
+        BigintValuesUsingBloomFilter(0, 700, bloomFilter, 0.5, nullAllowed));
+  }
+}
+
 TEST_F(FilterSerDeTest, rangeFilters) {
   FloatRange floatRange(1.0, true, true, 124.5, false, true, false);
   testSerde(floatRange);
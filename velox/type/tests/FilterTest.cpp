@@ -454,6 +454,104 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+namespace {
+std::unique_ptr<BigintValuesUsingBloomFilter> makeBloomFilter(
+    const std::vector<int64_t>& values,
+    double maxPassRate,
+    bool nullAllowed) {
+  auto bloomFilter =
+      std::make_shared<BigintValuesUsingBloomFilter::BloomFilterType>();
+  bloomFilter->reset(values.size());
+  for (auto value : values) {
+    bloomFilter->insert(BigintValuesUsingBloomFilter::hash(value));
+  }
+  return std::make_unique<BigintValuesUsingBloomFilter>(
+      *std::min_element(values.begin(), values.end()),
+      *std::max_element(values.begin(), values.end()),
+      std::move(bloomFilter),
+      maxPassRate,
+      nullAllowed);
+}
+} // namespace
+
+TEST(FilterTest, bigintValuesUsingBloomFilter) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 10'000; ++i) {
+    values.push_back(i * 3);
+  }
+  auto filter = makeBloomFilter(values, 1, false);
+  for (auto value : values) {
+    ASSERT_TRUE(filter->testInt64(value));
+  }
+  EXPECT_FALSE(filter->testNull());
+  EXPECT_FALSE(filter->testInt64(-3));
+  EXPECT_FALSE(filter->testInt64(values.back() + 3));
+  int32_t numFalsePositives = 0;
+  for (auto value : values) {
+    numFalsePositives += filter->testInt64(value + 1);
+  }
+  EXPECT_LT(numFalsePositives, values.size() / 20);
+
+  EXPECT_TRUE(filter->testInt64Range(10, 20, false));
+  EXPECT_TRUE(filter->testInt64Range(3, 3, false));
+  EXPECT_FALSE(filter->testInt64Range(-10, -1, false));
+  EXPECT_FALSE(filter->testInt64Range(30'000, 40'000, false));
+
+  // Merging with a range keeps the Bloom filter.
+  auto merged = filter->mergeWith(BigintRange(100, 200, false).clone().get());
+  ASSERT_EQ(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(102));
+  EXPECT_FALSE(merged->testInt64(99));
+  EXPECT_FALSE(merged->testInt64(201));
+  merged = BigintRange(-10, -1, false).mergeWith(filter.get());
+  EXPECT_EQ(merged->kind(), FilterKind::kAlwaysFalse);
+
+  // Merging with a list of values makes an exact filter.
+  merged = createBigintValues({3, 6, 30'000}, false)->mergeWith(filter.get());
+  ASSERT_NE(merged->kind(), FilterKind::kBigintValuesUsingBloomFilter);
+  EXPECT_TRUE(merged->testInt64(3));
+  EXPECT_TRUE(merged->testInt64(6));
+  EXPECT_FALSE(merged->testInt64(30'000));
+
+  // Merging with a negated filter keeps the range of the Bloom filter.
+  merged = filter->mergeWith(NegatedBigintRange(0, 5, false).clone().get());
+  EXPECT_FALSE(merged->testInt64(3));
+  EXPECT_TRUE(merged->testInt64(9));
+  EXPECT_FALSE(merged->testInt64(-1));
+}
+
+TEST(FilterTest, bigintValuesUsingBloomFilterAdaptivity) {
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(i * 2);
+  }
+  auto filter = makeBloomFilter(values, 0.6, false);
+
+  // Half of the values pass. The filter stays enabled.
+  const auto kWindow = BigintValuesUsingBloomFilter::kPassRateWindow;
+  int32_t numPassed = 0;
+  for (auto i = 0; i < 2 * kWindow; ++i) {
+    numPassed += filter->testInt64(i % 2000);
+  }
+  EXPECT_FALSE(filter->isDisabled());
+  EXPECT_LT(numPassed, 2 * kWindow * 0.6);
+
+  // All values pass. The filter turns itself off after a window.
+  for (auto i = 0; i < kWindow; ++i) {
+    ASSERT_TRUE(filter->testInt64(values[i % values.size()]));
+  }
+  EXPECT_TRUE(filter->isDisabled());
+  EXPECT_TRUE(filter->testInt64(1));
+  // The range is still checked.
+  EXPECT_FALSE(filter->testInt64(-1));
+  EXPECT_FALSE(filter->testInt64(2'000));
+
+  // A clone starts with a fresh pass rate.
+  auto copy = filter->clone();
+  EXPECT_FALSE(
+      static_cast<BigintValuesUsingBloomFilter*>(copy.get())->isDisabled());
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =